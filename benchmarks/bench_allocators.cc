@@ -0,0 +1,104 @@
+#include <memory>
+#include <memory_resource>
+#include <vector>
+
+#include "icb/AVLSet.h"
+#include "icb/hash_table.h"
+#include "icb/linkedlist.h"
+#include "icb/vector.h"
+
+#include "bench_common.h"
+
+// the containers one request builds, all drawing from the same allocator
+template <typename Allocator> struct WorkingSet
+{
+    using Traits = std::allocator_traits<Allocator>;
+    template <typename T> using Rebind = typename Traits::template rebind_alloc<T>;
+
+    icb::HashTable<uint64_t, uint64_t, icb::Hash<uint64_t>, std::equal_to<>,
+                   Rebind<std::pair<const uint64_t, uint64_t>>>
+        index;
+    icb::LinkedList<uint64_t, Rebind<uint64_t>> queue;
+    icb::AVLSet<uint64_t, Rebind<uint64_t>> ordered;
+    icb::Vector<uint64_t, Rebind<uint64_t>> results;
+
+    explicit WorkingSet(const Allocator &allocator)
+        : index(HT_INIT_CAPACITY, icb::Hash<uint64_t>(), std::equal_to<>(), allocator), queue(allocator),
+          ordered(allocator), results(allocator)
+    {
+    }
+
+    uint64_t Serve(const std::vector<uint64_t> &keys)
+    {
+        for (uint64_t key : keys)
+        {
+            index.Insert(key, key >> 3);
+            queue.PushBack(key);
+        }
+        for (size_t i = 0; i < keys.size(); i += 8)
+        {
+            ordered.Insert(keys[i]);
+        }
+
+        uint64_t sum = 0;
+        while (!queue.Empty())
+        {
+            if (const uint64_t *value = index.FindPtr(queue.Front()))
+            {
+                results.PushBack(*value);
+                sum += *value;
+            }
+            queue.PopFront();
+        }
+        return sum + results.Size();
+    }
+};
+
+// requests made one after the other, each one builds its working set and drops it; reports per key
+template <typename MakeResource>
+static void requests(const char *name, const std::vector<uint64_t> &keys, size_t count, MakeResource &&makeResource)
+{
+    double ns = bench::TimeNs([&] {
+        for (size_t request = 0; request < count; ++request)
+        {
+            auto resource = makeResource();
+            WorkingSet<std::pmr::polymorphic_allocator<uint64_t>> set(&*resource);
+            bench::Consume(set.Serve(keys));
+        }
+    });
+    bench::Report(name, count * keys.size(), ns);
+}
+
+int main(int argc, char **argv)
+{
+    size_t size = bench::Arg(argc, argv, 1, 10'000);
+    size_t count = bench::Arg(argc, argv, 2, 1'000);
+
+    const std::vector<uint64_t> keys = bench::RandomKeys(size);
+    std::printf("requests of %zu keys, times per key\n", size);
+
+    double ns = bench::TimeNs([&] {
+        for (size_t request = 0; request < count; ++request)
+        {
+            WorkingSet<std::allocator<uint64_t>> set{std::allocator<uint64_t>()};
+            bench::Consume(set.Serve(keys));
+        }
+    });
+    bench::Report("std::allocator", count * keys.size(), ns);
+
+    requests("pmr, new_delete_resource", keys, count, [] {
+        return std::pmr::new_delete_resource();
+    });
+
+    requests("pmr, unsynchronized_pool_resource", keys, count, [] {
+        return std::make_unique<std::pmr::unsynchronized_pool_resource>();
+    });
+
+    // the arena's buffer outlives the requests, each one starts again from its beginning
+    std::vector<std::byte> buffer(size * 256);
+    requests("pmr, monotonic_buffer_resource arena", keys, count, [&] {
+        return std::make_unique<std::pmr::monotonic_buffer_resource>(buffer.data(), buffer.size());
+    });
+
+    return 0;
+}
@@ -0,0 +1,64 @@
+#include "icb/hash_table.h"
+
+#include "bench_common.h"
+
+#include <memory>
+
+// lookups on a table far bigger than the last level cache, one at a time vs FindBatch
+int main(int argc, char **argv)
+{
+    size_t count = bench::Arg(argc, argv, 1, 8'000'000);
+    size_t lookups = bench::Arg(argc, argv, 2, 4'000'000);
+    std::printf("HashTable batched lookups, %zu keys, %zu lookups\n", count, lookups);
+
+    auto keys = bench::RandomKeys(count);
+    icb::HashTable<uint64_t, uint64_t> table(count);
+    for (size_t i = 0; i < keys.size(); ++i)
+        table.Insert(keys[i], i);
+
+    // random order, so consecutive lookups don't share cache lines; every other one misses
+    auto probes = bench::RandomKeys(lookups, 7);
+    for (size_t i = 0; i < probes.size(); ++i)
+        probes[i] = i % 2 ? probes[i] : keys[probes[i] % count];
+
+    double ns = bench::TimeNs([&] {
+        uint64_t sum = 0;
+        for (uint64_t key : probes)
+        {
+            const uint64_t *value = table.FindPtr(key);
+            sum += value ? *value : 0;
+        }
+        bench::Consume(sum);
+    });
+    bench::Report("FindPtr loop", probes.size(), ns);
+
+    std::vector<uint64_t *> out(probes.size());
+    ns = bench::TimeNs([&] {
+        table.FindBatch(probes, out);
+        uint64_t sum = 0;
+        for (uint64_t *value : out)
+            sum += value ? *value : 0;
+        bench::Consume(sum);
+    });
+    bench::Report("FindBatch", probes.size(), ns);
+
+    ns = bench::TimeNs([&] {
+        uint64_t found = 0;
+        for (uint64_t key : probes)
+            found += table.Contains(key);
+        bench::Consume(found);
+    });
+    bench::Report("Contains loop", probes.size(), ns);
+
+    std::unique_ptr<bool[]> hits(new bool[probes.size()]);
+    ns = bench::TimeNs([&] {
+        table.ContainsBatch(probes, std::span<bool>(hits.get(), probes.size()));
+        uint64_t found = 0;
+        for (size_t i = 0; i < probes.size(); ++i)
+            found += hits[i];
+        bench::Consume(found);
+    });
+    bench::Report("ContainsBatch", probes.size(), ns);
+
+    return 0;
+}
@@ -0,0 +1,95 @@
+#include "icb/bloom_filter.h"
+#include "icb/filtered_hash_table.h"
+#include "icb/hash_table.h"
+
+#include <algorithm>
+#include <random>
+
+#include "bench_common.h"
+
+int main(int argc, char **argv)
+{
+    size_t count = bench::Arg(argc, argv, 1, 10'000'000);
+    std::printf("BloomFilter, %zu keys\n", count);
+
+    auto keys = bench::RandomKeys(count);
+    auto misses = bench::RandomKeys(count, 1ULL << 40);
+
+    std::printf("\nfalse positive rate at capacity\n");
+    for (size_t bitsPerKey : {8, 10, 12, 16})
+    {
+        icb::BloomFilter<uint64_t> filter(count, bitsPerKey);
+        for (uint64_t key : keys)
+            filter.Insert(key);
+
+        size_t falsePositives = 0;
+        for (uint64_t key : misses)
+            falsePositives += filter.MayContain(key);
+        std::printf("    %2zu bits per key: %.3f%% (%zu bytes)\n", bitsPerKey,
+                    100.0 * static_cast<double>(falsePositives) / static_cast<double>(count), filter.SizeInBytes());
+    }
+
+    std::printf("\n");
+    icb::BloomFilter<uint64_t> filter(count);
+    double ns = bench::TimeNs([&] {
+        for (uint64_t key : keys)
+            filter.Insert(key);
+    });
+    bench::Report("BloomFilter insert", count, ns);
+
+    ns = bench::TimeNs([&] {
+        uint64_t found = 0;
+        for (uint64_t key : keys)
+            found += filter.MayContain(key);
+        bench::Consume(found);
+    });
+    bench::Report("BloomFilter query hit", count, ns);
+
+    ns = bench::TimeNs([&] {
+        uint64_t found = 0;
+        for (uint64_t key : misses)
+            found += filter.MayContain(key);
+        bench::Consume(found);
+    });
+    bench::Report("BloomFilter query miss", count, ns);
+
+    icb::HashTable<uint64_t, uint64_t> table(count);
+    icb::FilteredHashTable<uint64_t, uint64_t> filtered(count);
+    ns = bench::TimeNs([&] {
+        for (size_t i = 0; i < keys.size(); ++i)
+            table.Insert(keys[i], i);
+    });
+    bench::Report("HashTable insert", count, ns);
+    ns = bench::TimeNs([&] {
+        for (size_t i = 0; i < keys.size(); ++i)
+            filtered.Insert(keys[i], i);
+    });
+    bench::Report("FilteredHashTable insert", count, ns);
+
+    // the filter's branch is unpredictable once hits are common, and each mispredicted hit stalls on the table
+    for (size_t hitPercent : {0, 1, 10, 50})
+    {
+        std::vector<uint64_t> lookups(misses.begin(), misses.begin() + count / 100 * (100 - hitPercent));
+        lookups.insert(lookups.end(), keys.begin(), keys.begin() + count / 100 * hitPercent);
+        std::shuffle(lookups.begin(), lookups.end(), std::mt19937_64(7));
+
+        std::printf("\n%zu%% hits\n", hitPercent);
+        ns = bench::TimeNs([&] {
+            uint64_t found = 0;
+            for (uint64_t key : lookups)
+                found += table.Contains(key);
+            bench::Consume(found);
+        });
+        bench::Report("HashTable lookup", lookups.size(), ns);
+
+        ns = bench::TimeNs([&] {
+            uint64_t found = 0;
+            for (uint64_t key : lookups)
+                found += filtered.Contains(key);
+            bench::Consume(found);
+        });
+        bench::Report("FilteredHashTable lookup", lookups.size(), ns);
+    }
+
+    return 0;
+}
@@ -0,0 +1,53 @@
+#include <algorithm>
+#include <thread>
+#include <utility>
+
+#include "icb/hash_table.h"
+
+#include "bench_common.h"
+
+// building a table from a batch of pairs: an Insert loop against BulkInsert, then Rehash, on 1, 2, 4, ... threads
+int main(int argc, char **argv)
+{
+    size_t count = bench::Arg(argc, argv, 1, 4'000'000);
+    size_t maxThreads = bench::Arg(argc, argv, 2, std::max(1u, std::thread::hardware_concurrency()));
+    std::printf("HashTable bulk build of %zu keys, up to %zu threads (%u hardware threads)\n", count, maxThreads,
+                std::thread::hardware_concurrency());
+
+    std::vector<std::pair<uint64_t, uint64_t>> pairs;
+    pairs.reserve(count);
+    for (uint64_t key : bench::RandomKeys(count))
+    {
+        pairs.emplace_back(key, key);
+    }
+
+    {
+        icb::HashTable<uint64_t, uint64_t> table;
+        double ns = bench::TimeNs([&] {
+            for (const auto &[key, value] : pairs)
+            {
+                table.Insert(key, value);
+            }
+        });
+        bench::Report("HashTable Insert loop", count, ns);
+        bench::Consume(table.Size());
+    }
+
+    char name[64];
+    for (size_t threads = 1; threads <= maxThreads; threads *= 2)
+    {
+        icb::ThreadPool pool(threads);
+        icb::HashTable<uint64_t, uint64_t> table;
+
+        double ns = bench::TimeNs([&] { table.BulkInsert(pairs.begin(), pairs.end(), pool); });
+        std::snprintf(name, sizeof(name), "HashTable BulkInsert, %zu threads", threads);
+        bench::Report(name, count, ns);
+
+        ns = bench::TimeNs([&] { table.Rehash(table.BucketCount() * 2, pool); });
+        std::snprintf(name, sizeof(name), "HashTable Rehash x2, %zu threads", threads);
+        bench::Report(name, count, ns);
+        bench::Consume(table.Size());
+    }
+
+    return 0;
+}
@@ -0,0 +1,102 @@
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+#include "icb/clock_cache.h"
+#include "icb/lru_cache.h"
+
+#include "bench_common.h"
+
+// read-through caching of a Zipfian trace: a miss puts the key, as if it had been loaded from somewhere slower
+struct LockedLRU
+{
+    std::mutex mutex;
+    icb::LRUCache<uint64_t, uint64_t> cache;
+
+    LockedLRU(size_t capacity) : cache(capacity)
+    {
+    }
+
+    bool Access(uint64_t key)
+    {
+        std::lock_guard lock(mutex);
+        if (cache.Get(key))
+        {
+            return true;
+        }
+        cache.Put(key, key);
+        return false;
+    }
+};
+
+struct Clock
+{
+    icb::ConcurrentClockCache<uint64_t, uint64_t> cache;
+
+    Clock(size_t capacity) : cache(capacity)
+    {
+    }
+
+    bool Access(uint64_t key)
+    {
+        if (cache.Visit(key, [](const uint64_t &value) { bench::Consume(value); }))
+        {
+            return true;
+        }
+        cache.Put(key, key);
+        return false;
+    }
+};
+
+template <typename Cache>
+static void run(const char *name, size_t capacity, const std::vector<uint64_t> &trace, unsigned threads)
+{
+    Cache cache(capacity);
+    std::atomic<size_t> hits = 0;
+
+    double ns = bench::TimeNs([&] {
+        std::vector<std::thread> workers;
+        for (unsigned t = 0; t < threads; ++t)
+        {
+            workers.emplace_back([&, t] {
+                size_t local = 0;
+                for (size_t i = t; i < trace.size(); i += threads)
+                {
+                    local += cache.Access(trace[i]);
+                }
+                hits += local;
+            });
+        }
+        for (auto &worker : workers)
+            worker.join();
+    });
+
+    char label[128];
+    std::snprintf(label, sizeof(label), "%s, %u threads", name, threads);
+    bench::Report(label, trace.size(), ns);
+    std::printf("    hit rate %.2f%%\n", 100.0 * static_cast<double>(hits.load()) / static_cast<double>(trace.size()));
+}
+
+int main(int argc, char **argv)
+{
+    size_t count = bench::Arg(argc, argv, 1, 4'000'000);
+    size_t universe = bench::Arg(argc, argv, 2, 1'000'000);
+    unsigned maxThreads = static_cast<unsigned>(bench::Arg(argc, argv, 3, 4));
+
+    for (double skew : {0.8, 0.99, 1.2})
+    {
+        auto trace = bench::ZipfKeys(count, universe, skew);
+
+        for (size_t capacity : {universe / 100, universe / 10})
+        {
+            std::printf("Zipf skew %.2f, %zu accesses over %zu keys, capacity %zu\n", skew, count, universe, capacity);
+            for (unsigned threads = 1; threads <= maxThreads; threads *= 2)
+            {
+                run<LockedLRU>("LRUCache behind a mutex", capacity, trace, threads);
+                run<Clock>("ConcurrentClockCache", capacity, trace, threads);
+            }
+        }
+    }
+
+    return 0;
+}
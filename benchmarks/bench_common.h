@@ -0,0 +1,95 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+namespace bench
+{
+using Clock = std::chrono::steady_clock;
+
+// results are folded into this so the optimizer can't drop the measured work
+inline volatile uint64_t g_sink = 0;
+
+inline void Consume(uint64_t value)
+{
+    g_sink = g_sink + value;
+}
+
+template <typename Fn> double TimeNs(Fn &&fn)
+{
+    auto start = Clock::now();
+    fn();
+    return std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+}
+
+inline void Report(const char *name, size_t ops, double ns)
+{
+    std::printf("%-48s %10.2f ns/op %10.2f Mops/s\n", name, ns / static_cast<double>(ops),
+                static_cast<double>(ops) * 1e3 / ns);
+}
+
+// argv[index] as a number, or fallback when not given
+inline size_t Arg(int argc, char **argv, int index, size_t fallback)
+{
+    return argc > index ? static_cast<size_t>(std::strtoull(argv[index], nullptr, 10)) : fallback;
+}
+
+// distinct pseudo-random keys, deterministic across runs
+inline std::vector<uint64_t> RandomKeys(size_t count, uint64_t seed = 42)
+{
+    std::vector<uint64_t> keys(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        // splitmix64 finalizer is a bijection, so distinct inputs stay distinct
+        uint64_t z = (i + seed) * 0x9e3779b97f4a7c15ULL;
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        keys[i] = z ^ (z >> 31);
+    }
+    return keys;
+}
+
+/*
+ * count draws from a Zipfian distribution over [0, universe): key k comes up in proportion to 1 / (k + 1)^skew.
+ * Sampled by inverting a precomputed CDF; the ranks are scrambled so hot keys don't sit next to each other.
+ */
+inline std::vector<uint64_t> ZipfKeys(size_t count, size_t universe, double skew, uint64_t seed = 42)
+{
+    std::vector<double> cdf(universe);
+    double sum = 0.0;
+    for (size_t k = 0; k < universe; ++k)
+    {
+        sum += 1.0 / std::pow(static_cast<double>(k + 1), skew);
+        cdf[k] = sum;
+    }
+
+    std::vector<uint64_t> ids = RandomKeys(universe, seed);
+    std::vector<uint64_t> keys(count);
+    uint64_t state = seed;
+    for (size_t i = 0; i < count; ++i)
+    {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        const double u = static_cast<double>(state >> 11) * 0x1.0p-53 * sum;
+        const size_t rank = static_cast<size_t>(std::lower_bound(cdf.begin(), cdf.end(), u) - cdf.begin());
+        keys[i] = ids[std::min(rank, universe - 1)];
+    }
+    return keys;
+}
+
+inline std::vector<std::string> StringKeys(size_t count, uint64_t seed = 42)
+{
+    std::vector<std::string> keys;
+    keys.reserve(count);
+    for (uint64_t key : RandomKeys(count, seed))
+    {
+        keys.push_back("key:" + std::to_string(key));
+    }
+    return keys;
+}
+} // namespace bench
@@ -0,0 +1,86 @@
+#include <mutex>
+#include <thread>
+
+#include "icb/concurrent_hash_table.h"
+#include "icb/hash_table.h"
+
+#include "bench_common.h"
+
+// the setup ConcurrentHashTable replaces: one HashTable behind one mutex
+struct GlobalLockTable
+{
+    std::mutex mutex;
+    icb::HashTable<uint64_t, uint64_t> table;
+
+    void Insert(uint64_t key, uint64_t value)
+    {
+        std::lock_guard lock(mutex);
+        table.Insert(key, value);
+    }
+
+    bool Contains(uint64_t key)
+    {
+        std::lock_guard lock(mutex);
+        return table.Contains(key);
+    }
+};
+
+// every thread does opsPerThread operations, writePercent of them inserts and the rest lookups
+template <typename Table>
+static void run(const char *name, Table &table, const std::vector<uint64_t> &keys, unsigned threads,
+                size_t opsPerThread, unsigned writePercent)
+{
+    double ns = bench::TimeNs([&] {
+        std::vector<std::thread> workers;
+        for (unsigned t = 0; t < threads; ++t)
+        {
+            workers.emplace_back([&, t] {
+                uint64_t found = 0;
+                size_t index = t * 7919;
+                for (size_t i = 0; i < opsPerThread; ++i)
+                {
+                    index = (index + 104729) % keys.size();
+                    if (i % 100 < writePercent)
+                        table.Insert(keys[index], i);
+                    else
+                        found += table.Contains(keys[index]);
+                }
+                bench::Consume(found);
+            });
+        }
+        for (auto &worker : workers)
+            worker.join();
+    });
+
+    char label[128];
+    std::snprintf(label, sizeof(label), "%s, %u threads", name, threads);
+    bench::Report(label, threads * opsPerThread, ns);
+}
+
+int main(int argc, char **argv)
+{
+    size_t count = bench::Arg(argc, argv, 1, 1'000'000);
+    size_t opsPerThread = bench::Arg(argc, argv, 2, 2'000'000);
+    unsigned maxThreads = static_cast<unsigned>(bench::Arg(argc, argv, 3, std::thread::hardware_concurrency()));
+    unsigned writePercent = 10;
+
+    std::printf("%zu keys, %zu ops per thread, %u%% inserts (Mops/s are totals over all threads)\n", count,
+                opsPerThread, writePercent);
+
+    auto keys = bench::RandomKeys(count);
+
+    for (unsigned threads = 1; threads <= maxThreads; threads *= 2)
+    {
+        GlobalLockTable global;
+        for (size_t i = 0; i < count / 2; ++i)
+            global.Insert(keys[i], i);
+        run("HashTable + global mutex", global, keys, threads, opsPerThread, writePercent);
+
+        icb::ConcurrentHashTable<uint64_t, uint64_t> sharded(threads * 16);
+        for (size_t i = 0; i < count / 2; ++i)
+            sharded.Insert(keys[i], i);
+        run("ConcurrentHashTable", sharded, keys, threads, opsPerThread, writePercent);
+    }
+
+    return 0;
+}
@@ -0,0 +1,86 @@
+#include <vector>
+
+#include "icb/fixed_hash_table.h"
+#include "icb/hash_table.h"
+#include "icb/robin_hood_hash_table.h"
+#include "icb/small_vector.h"
+#include "icb/static_vector.h"
+#include "icb/vector.h"
+
+#include "bench_common.h"
+
+constexpr size_t TABLE_SIZE = 32;
+constexpr size_t VECTOR_SIZE = 16;
+
+/*
+ * Short-lived lookup tables, the way a parser or a request handler builds one per call: fill with TABLE_SIZE keys,
+ * look every one of them up twice, drop it. The growing tables start at their default capacity.
+ */
+template <typename Table> static void buildLookupDrop(const char *name, const std::vector<uint64_t> &keys)
+{
+    const size_t tables = keys.size() / TABLE_SIZE;
+    double ns = bench::TimeNs([&] {
+        for (size_t t = 0; t < tables; ++t)
+        {
+            const uint64_t *batch = keys.data() + t * TABLE_SIZE;
+            Table table;
+            for (size_t i = 0; i < TABLE_SIZE; ++i)
+            {
+                table.Insert(batch[i], i);
+            }
+            uint64_t sum = 0;
+            for (size_t round = 0; round < 2; ++round)
+            {
+                for (size_t i = 0; i < TABLE_SIZE; ++i)
+                {
+                    if (const uint64_t *value = table.FindPtr(batch[i]))
+                    {
+                        sum += *value;
+                    }
+                }
+            }
+            bench::Consume(sum);
+        }
+    });
+    bench::Report(name, tables * TABLE_SIZE, ns);
+}
+
+// scratch vectors of VECTOR_SIZE elements, filled, summed and dropped
+template <typename Vec> static void scratchVectors(const char *name, size_t count)
+{
+    double ns = bench::TimeNs([&] {
+        for (size_t v = 0; v < count; ++v)
+        {
+            Vec vector;
+            for (size_t i = 0; i < VECTOR_SIZE; ++i)
+            {
+                vector.PushBack(static_cast<uint32_t>(v + i));
+            }
+            uint64_t sum = 0;
+            for (uint32_t value : vector)
+            {
+                sum += value;
+            }
+            bench::Consume(sum);
+        }
+    });
+    bench::Report(name, count, ns);
+}
+
+int main(int argc, char **argv)
+{
+    size_t count = bench::Arg(argc, argv, 1, 1'000'000);
+
+    const std::vector<uint64_t> keys = bench::RandomKeys(count);
+    std::printf("tables of %zu uint64_t keys, built, looked up twice and dropped, times per key\n", TABLE_SIZE);
+    buildLookupDrop<icb::HashTable<uint64_t, uint64_t>>("HashTable", keys);
+    buildLookupDrop<icb::RobinHoodHashTable<uint64_t, uint64_t>>("RobinHoodHashTable", keys);
+    buildLookupDrop<icb::FixedHashTable<uint64_t, uint64_t, TABLE_SIZE>>("FixedHashTable<32>", keys);
+
+    std::printf("\nscratch vectors of %zu uint32_t, times per vector\n", VECTOR_SIZE);
+    scratchVectors<icb::Vector<uint32_t>>("Vector", count);
+    scratchVectors<icb::SmallVector<uint32_t, VECTOR_SIZE>>("SmallVector<16>", count);
+    scratchVectors<icb::StaticVector<uint32_t, VECTOR_SIZE>>("StaticVector<16>", count);
+
+    return 0;
+}
@@ -0,0 +1,64 @@
+#include "icb/flat_hash_table.h"
+#include "icb/frozen_hash_table.h"
+#include "icb/hash_table.h"
+
+#include <algorithm>
+#include <random>
+
+#include "bench_common.h"
+
+template <typename Table>
+void lookups(const char *name, const Table &table, const std::vector<uint64_t> &keys,
+             const std::vector<uint64_t> &misses)
+{
+    std::string label(name);
+
+    double ns = bench::TimeNs([&] {
+        uint64_t sum = 0;
+        for (uint64_t key : keys)
+            sum += *table.Find(key);
+        bench::Consume(sum);
+    });
+    bench::Report((label + " find hit").c_str(), keys.size(), ns);
+
+    ns = bench::TimeNs([&] {
+        uint64_t found = 0;
+        for (uint64_t key : misses)
+            found += table.Contains(key);
+        bench::Consume(found);
+    });
+    bench::Report((label + " find miss").c_str(), misses.size(), ns);
+}
+
+int main(int argc, char **argv)
+{
+    size_t count = bench::Arg(argc, argv, 1, 10'000'000);
+    std::printf("FrozenHashTable, %zu keys\n", count);
+
+    auto keys = bench::RandomKeys(count);
+    auto misses = bench::RandomKeys(count, 1ULL << 40);
+
+    icb::HashTable<uint64_t, uint64_t> table(count);
+    for (size_t i = 0; i < keys.size(); ++i)
+        table.Insert(keys[i], i);
+
+    // look up in a different order than the nodes were allocated in, the chained table would be prefetched otherwise
+    auto lookupKeys = keys;
+    std::shuffle(lookupKeys.begin(), lookupKeys.end(), std::mt19937_64(7));
+
+    icb::FrozenHashTable<uint64_t, uint64_t> frozen;
+    double ns = bench::TimeNs([&] { frozen = table.Freeze(); });
+    bench::Report("Freeze (build)", count, ns);
+    std::printf("    %.3f s total, %.2f bytes per key besides the pairs\n", ns / 1e9,
+                static_cast<double>(frozen.BucketCount() * sizeof(uint32_t)) / static_cast<double>(count));
+
+    lookups("HashTable", table, lookupKeys, misses);
+    lookups("FrozenHashTable", frozen, lookupKeys, misses);
+
+    icb::FlatHashTable<uint64_t, uint64_t> flat(count);
+    for (size_t i = 0; i < keys.size(); ++i)
+        flat.Insert(keys[i], i);
+    lookups("FlatHashTable", flat, lookupKeys, misses);
+
+    return 0;
+}
@@ -0,0 +1,78 @@
+#include "icb/hash.h"
+#include "icb/hash_table.h"
+
+#include <algorithm>
+#include <functional>
+#include <random>
+#include <string>
+#include <string_view>
+
+#include "bench_common.h"
+
+// what the tables used before icb::Hash: std::hash, remixed
+template <typename T> struct MixedStdHash
+{
+    size_t operator()(const T &key) const noexcept
+    {
+        return icb::detail::Mix(std::hash<T>{}(key));
+    }
+};
+
+template <typename Hasher, typename Key> void hashing(const char *name, const std::vector<Key> &keys, size_t rounds)
+{
+    Hasher hasher;
+    double ns = bench::TimeNs([&] {
+        size_t sum = 0;
+        for (size_t round = 0; round < rounds; ++round)
+            for (const Key &key : keys)
+                sum += hasher(key);
+        bench::Consume(sum);
+    });
+    bench::Report(name, keys.size() * rounds, ns);
+}
+
+// how evenly the hasher spreads keys that only differ in their high bits, as e.g. aligned addresses do
+template <typename Hasher> void spread(const char *name, size_t count)
+{
+    icb::HashTable<uint64_t, uint64_t, Hasher> table(count);
+    double ns = bench::TimeNs([&] {
+        for (uint64_t i = 0; i < count; ++i)
+            table.Insert(i << 20, i);
+    });
+    bench::Report(name, count, ns);
+
+    icb::HashTableStats stats = table.Stats();
+    std::printf("    max chain %zu, average probe length %.3f, %zu of %zu buckets empty\n", stats.maxChainLength,
+                stats.averageProbeLength, stats.emptyBuckets, stats.bucketCount);
+}
+
+int main(int argc, char **argv)
+{
+    size_t count = bench::Arg(argc, argv, 1, 1'000'000);
+    std::printf("Hash functions, %zu keys\n", count);
+
+    auto ints = bench::RandomKeys(count);
+    hashing<MixedStdHash<uint64_t>>("std::hash + mix, uint64_t", ints, 10);
+    hashing<icb::Hash<uint64_t>>("icb::Hash, uint64_t", ints, 10);
+
+    for (size_t length : {4, 8, 16, 32, 64, 256, 1024})
+    {
+        std::mt19937_64 random(length);
+        std::vector<std::string> strings(1024, std::string(length, ' '));
+        for (std::string &string : strings)
+            for (char &c : string)
+                c = static_cast<char>('a' + random() % 26);
+
+        // a few megabytes of string bytes per measurement
+        size_t rounds = std::max<size_t>(1, (64 << 20) / (strings.size() * length));
+        std::printf("\n%zu byte strings\n", length);
+        hashing<std::hash<std::string>>("std::hash", strings, rounds);
+        hashing<icb::Hash<std::string>>("icb::Hash", strings, rounds);
+    }
+
+    std::printf("\nHashTable insert of keys spaced 2^20 apart\n");
+    spread<std::hash<uint64_t>>("std::hash", std::min<size_t>(count, 20'000));
+    spread<icb::Hash<uint64_t>>("icb::Hash", std::min<size_t>(count, 20'000));
+
+    return 0;
+}
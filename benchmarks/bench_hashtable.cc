@@ -0,0 +1,56 @@
+#include "icb/flat_hash_table.h"
+#include "icb/hash_table.h"
+
+#include "bench_common.h"
+
+template <typename Table, typename K> void run(const char *name, const std::vector<K> &keys, const std::vector<K> &misses)
+{
+    std::string label(name);
+    Table table(keys.size());
+
+    double ns = bench::TimeNs([&] {
+        for (size_t i = 0; i < keys.size(); ++i)
+            table.Insert(keys[i], i);
+    });
+    bench::Report((label + " insert").c_str(), keys.size(), ns);
+
+    ns = bench::TimeNs([&] {
+        uint64_t sum = 0;
+        for (const K &key : keys)
+            sum += *table.Find(key);
+        bench::Consume(sum);
+    });
+    bench::Report((label + " find hit").c_str(), keys.size(), ns);
+
+    ns = bench::TimeNs([&] {
+        uint64_t found = 0;
+        for (const K &key : misses)
+            found += table.Find(key).has_value();
+        bench::Consume(found);
+    });
+    bench::Report((label + " find miss").c_str(), misses.size(), ns);
+
+    ns = bench::TimeNs([&] {
+        for (const K &key : keys)
+            table.Erase(key);
+    });
+    bench::Report((label + " erase").c_str(), keys.size(), ns);
+}
+
+int main(int argc, char **argv)
+{
+    size_t count = bench::Arg(argc, argv, 1, 1'000'000);
+    std::printf("HashTable vs FlatHashTable, %zu keys\n", count);
+
+    auto keys = bench::RandomKeys(count);
+    auto misses = bench::RandomKeys(count, 1ULL << 40);
+    run<icb::HashTable<uint64_t, uint64_t>>("HashTable<uint64_t>", keys, misses);
+    run<icb::FlatHashTable<uint64_t, uint64_t>>("FlatHashTable<uint64_t>", keys, misses);
+
+    auto strings = bench::StringKeys(count);
+    auto stringMisses = bench::StringKeys(count, 1ULL << 40);
+    run<icb::HashTable<std::string, uint64_t>>("HashTable<std::string>", strings, stringMisses);
+    run<icb::FlatHashTable<std::string, uint64_t>>("FlatHashTable<std::string>", strings, stringMisses);
+
+    return 0;
+}
@@ -0,0 +1,119 @@
+#include <cstdlib>
+#include <iterator>
+#include <new>
+#include <vector>
+
+#include "icb/intrusive_list.h"
+#include "icb/linkedlist.h"
+
+#include "bench_common.h"
+
+// counts calls to operator new
+namespace
+{
+size_t g_allocations = 0;
+} // namespace
+
+void *operator new(size_t size)
+{
+    ++g_allocations;
+    if (void *block = std::malloc(size ? size : 1))
+        return block;
+    throw std::bad_alloc();
+}
+
+void operator delete(void *ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, size_t) noexcept
+{
+    std::free(ptr);
+}
+
+constexpr size_t WHEEL_SLOTS = 256;
+
+// a timer wheel: every timer sits in the list of the slot it fires in, rescheduling moves it to another slot
+struct IntrusiveTimer : icb::ListHook<>
+{
+    uint64_t deadline = 0;
+};
+
+struct PointerTimer
+{
+    uint64_t deadline = 0;
+    size_t slot = 0;
+    icb::LinkedList<PointerTimer *>::Iterator position;
+};
+
+static void intrusive(const std::vector<uint64_t> &picks, size_t timerCount)
+{
+    std::vector<IntrusiveTimer> timers(timerCount);
+    std::vector<icb::IntrusiveList<IntrusiveTimer>> wheel(WHEEL_SLOTS);
+    for (size_t i = 0; i < timerCount; ++i)
+    {
+        timers[i].deadline = i;
+        wheel[i % WHEEL_SLOTS].PushBack(timers[i]);
+    }
+
+    const size_t allocationsBefore = g_allocations;
+    double ns = bench::TimeNs([&] {
+        for (uint64_t pick : picks)
+        {
+            IntrusiveTimer &timer = timers[pick % timerCount];
+            wheel[timer.deadline % WHEEL_SLOTS].Remove(timer);
+            timer.deadline += pick;
+            wheel[timer.deadline % WHEEL_SLOTS].PushBack(timer);
+        }
+    });
+    bench::Report("IntrusiveList", picks.size(), ns);
+    std::printf("    %.4f allocations per op\n",
+                static_cast<double>(g_allocations - allocationsBefore) / static_cast<double>(picks.size()));
+
+    for (auto &slot : wheel)
+        slot.Clear();
+}
+
+static void pointers(const std::vector<uint64_t> &picks, size_t timerCount)
+{
+    std::vector<PointerTimer> timers(timerCount);
+    std::vector<icb::LinkedList<PointerTimer *>> wheel(WHEEL_SLOTS);
+    for (size_t i = 0; i < timerCount; ++i)
+    {
+        timers[i].deadline = i;
+        timers[i].slot = i % WHEEL_SLOTS;
+        wheel[timers[i].slot].PushBack(&timers[i]);
+        timers[i].position = std::prev(wheel[timers[i].slot].end());
+    }
+
+    const size_t allocationsBefore = g_allocations;
+    double ns = bench::TimeNs([&] {
+        for (uint64_t pick : picks)
+        {
+            PointerTimer &timer = timers[pick % timerCount];
+            timer.deadline += pick;
+            wheel[timer.slot].Erase(timer.position);
+            timer.slot = timer.deadline % WHEEL_SLOTS;
+            wheel[timer.slot].PushBack(&timer);
+            timer.position = std::prev(wheel[timer.slot].end());
+        }
+    });
+    bench::Report("LinkedList<Timer *> + stored iterator", picks.size(), ns);
+    std::printf("    %.4f allocations per op\n",
+                static_cast<double>(g_allocations - allocationsBefore) / static_cast<double>(picks.size()));
+}
+
+int main(int argc, char **argv)
+{
+    size_t timerCount = bench::Arg(argc, argv, 1, 100'000);
+    size_t ops = bench::Arg(argc, argv, 2, 10'000'000);
+
+    std::vector<uint64_t> picks = bench::RandomKeys(ops);
+
+    std::printf("reschedule %zu times among %zu timers on a wheel of %zu slots\n", ops, timerCount, WHEEL_SLOTS);
+    intrusive(picks, timerCount);
+    pointers(picks, timerCount);
+
+    return 0;
+}
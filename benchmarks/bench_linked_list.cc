@@ -0,0 +1,249 @@
+#include <algorithm>
+#include <cstdlib>
+#include <list>
+#include <new>
+#include <vector>
+
+#include "icb/linkedlist.h"
+
+#include "bench_common.h"
+
+// counts calls to operator new
+namespace
+{
+size_t g_allocations = 0;
+} // namespace
+
+void *operator new(size_t size)
+{
+    ++g_allocations;
+    if (void *block = std::malloc(size ? size : 1))
+        return block;
+    throw std::bad_alloc();
+}
+
+void operator delete(void *ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, size_t) noexcept
+{
+    std::free(ptr);
+}
+
+void *operator new(size_t size, std::align_val_t alignment)
+{
+    ++g_allocations;
+    const size_t align = static_cast<size_t>(alignment);
+    if (void *block = std::aligned_alloc(align, (size + align - 1) & ~(align - 1)))
+        return block;
+    throw std::bad_alloc();
+}
+
+void operator delete(void *ptr, std::align_val_t) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, size_t, std::align_val_t) noexcept
+{
+    std::free(ptr);
+}
+
+// a queue of queueSize elements: every op pushes at the back and pops the front
+template <typename List> static void churn(const char *name, List &list, size_t queueSize, size_t ops)
+{
+    for (size_t i = 0; i < queueSize; ++i)
+        list.push_back(i);
+
+    const size_t allocationsBefore = g_allocations;
+    double ns = bench::TimeNs([&] {
+        for (size_t i = 0; i < ops; ++i)
+        {
+            list.push_back(i);
+            bench::Consume(list.front());
+            list.pop_front();
+        }
+    });
+    bench::Report(name, ops, ns);
+    std::printf("    %.4f allocations per op\n",
+                static_cast<double>(g_allocations - allocationsBefore) / static_cast<double>(ops));
+}
+
+// lowercase adapters, so std::list and icb::LinkedList go through the same loops
+template <typename T> struct IcbList : icb::LinkedList<T>
+{
+    using icb::LinkedList<T>::LinkedList;
+
+    void push_back(const T &value)
+    {
+        this->PushBack(value);
+    }
+    void pop_front()
+    {
+        this->PopFront();
+    }
+    T &front()
+    {
+        return this->Front();
+    }
+};
+
+/*
+ * Two lists grown side by side, as when several containers fill up at once, then one of them is walked.
+ * Only the first list built here gets a fresh heap. The later ones get the chunks earlier lists freed, in whatever
+ * order malloc recycles them, as a long-running process would: per-node lists walk much slower then, pooled ones
+ * don't care.
+ */
+template <typename List> static void traverse(const char *name, List &a, List &b, size_t count)
+{
+    const size_t allocationsBefore = g_allocations;
+    for (size_t i = 0; i < count; ++i)
+    {
+        a.push_back(i);
+        b.push_back(i);
+    }
+    std::printf("%-48s %.4f allocations per element\n", name,
+                static_cast<double>(g_allocations - allocationsBefore) / static_cast<double>(2 * count));
+
+    uint64_t sum = 0;
+    double ns = bench::TimeNs([&] {
+        for (int round = 0; round < 10; ++round)
+            for (const auto &value : a)
+                sum += value;
+    });
+    bench::Consume(sum);
+    bench::Report("    traversal", 10 * count, ns);
+}
+
+static void reportAllocations(size_t allocationsBefore, size_t elements)
+{
+    std::printf("    %.4f allocations per element\n",
+                static_cast<double>(g_allocations - allocationsBefore) / static_cast<double>(elements));
+}
+
+// what callers did before Sort: copy into a vector, sort there, rebuild the list
+template <typename T> static void copySortRebuild(icb::LinkedList<T> &list)
+{
+    std::vector<T> values(list.begin(), list.end());
+    std::sort(values.begin(), values.end());
+    list = icb::LinkedList<T>(values.begin(), values.end());
+}
+
+// like traverse, only the first list built gets nodes in allocation order, later ones sort scattered nodes
+static void sorting(size_t count)
+{
+    std::vector<uint64_t> keys = bench::RandomKeys(count, 7);
+
+    {
+        std::list<uint64_t> list(keys.begin(), keys.end());
+        const size_t allocationsBefore = g_allocations;
+        double ns = bench::TimeNs([&] { list.sort(); });
+        bench::Report("std::list::sort", count, ns);
+        reportAllocations(allocationsBefore, count);
+        bench::Consume(list.front());
+    }
+    {
+        icb::LinkedList<uint64_t> list(keys.begin(), keys.end());
+        const size_t allocationsBefore = g_allocations;
+        double ns = bench::TimeNs([&] { list.Sort(); });
+        bench::Report("LinkedList::Sort", count, ns);
+        reportAllocations(allocationsBefore, count);
+        bench::Consume(list.Front());
+    }
+    {
+        icb::LinkedList<uint64_t>::Pool pool;
+        icb::LinkedList<uint64_t> list(pool);
+        for (uint64_t key : keys)
+            list.PushBack(key);
+        const size_t allocationsBefore = g_allocations;
+        double ns = bench::TimeNs([&] { list.Sort(); });
+        bench::Report("LinkedList::Sort (pool)", count, ns);
+        reportAllocations(allocationsBefore, count);
+        bench::Consume(list.Front());
+    }
+    {
+        icb::LinkedList<uint64_t> list(keys.begin(), keys.end());
+        const size_t allocationsBefore = g_allocations;
+        double ns = bench::TimeNs([&] { copySortRebuild(list); });
+        bench::Report("copy to vector, std::sort, rebuild", count, ns);
+        reportAllocations(allocationsBefore, count);
+        bench::Consume(list.Front());
+    }
+}
+
+static void merging(size_t count)
+{
+    std::vector<uint64_t> a = bench::RandomKeys(count, 1);
+    std::vector<uint64_t> b = bench::RandomKeys(count, 2);
+    std::sort(a.begin(), a.end());
+    std::sort(b.begin(), b.end());
+
+    {
+        icb::LinkedList<uint64_t> x(a.begin(), a.end()), y(b.begin(), b.end());
+        const size_t allocationsBefore = g_allocations;
+        double ns = bench::TimeNs([&] { x.Merge(y); });
+        bench::Report("LinkedList::Merge", 2 * count, ns);
+        reportAllocations(allocationsBefore, 2 * count);
+        bench::Consume(x.Back());
+    }
+    {
+        icb::LinkedList<uint64_t> x(a.begin(), a.end()), y(b.begin(), b.end());
+        const size_t allocationsBefore = g_allocations;
+        double ns = bench::TimeNs([&] {
+            std::vector<uint64_t> left(x.begin(), x.end()), right(y.begin(), y.end());
+            std::vector<uint64_t> merged(left.size() + right.size());
+            std::merge(left.begin(), left.end(), right.begin(), right.end(), merged.begin());
+            x = icb::LinkedList<uint64_t>(merged.begin(), merged.end());
+            y.Clear();
+        });
+        bench::Report("copy to vectors, std::merge, rebuild", 2 * count, ns);
+        reportAllocations(allocationsBefore, 2 * count);
+        bench::Consume(x.Back());
+    }
+}
+
+int main(int argc, char **argv)
+{
+    size_t count = bench::Arg(argc, argv, 1, 1'000'000);
+    size_t ops = bench::Arg(argc, argv, 2, 10'000'000);
+
+    std::printf("queue churn, %zu ops over a queue of 1000\n", ops);
+    {
+        std::list<uint64_t> list;
+        churn("std::list", list, 1000, ops);
+    }
+    {
+        IcbList<uint64_t> list;
+        churn("LinkedList (own free list)", list, 1000, ops);
+    }
+    {
+        IcbList<uint64_t>::Pool pool;
+        IcbList<uint64_t> list(pool);
+        churn("LinkedList (pool)", list, 1000, ops);
+    }
+
+    std::printf("\nbuild two lists of %zu side by side, walk one\n", count);
+    {
+        std::list<uint64_t> a, b;
+        traverse("std::list", a, b, count);
+    }
+    {
+        IcbList<uint64_t> a, b;
+        traverse("LinkedList (own nodes)", a, b, count);
+    }
+    {
+        IcbList<uint64_t>::Pool poolA, poolB;
+        IcbList<uint64_t> a(poolA), b(poolB);
+        traverse("LinkedList (a pool per list)", a, b, count);
+    }
+
+    std::printf("\nsort %zu random elements\n", count);
+    sorting(count);
+
+    std::printf("\nmerge two sorted lists of %zu\n", count);
+    merging(count);
+
+    return 0;
+}
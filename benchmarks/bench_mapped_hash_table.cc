@@ -0,0 +1,72 @@
+#include "icb/hash_table.h"
+#include "icb/mapped_hash_table.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <random>
+
+#include "bench_common.h"
+
+int main(int argc, char **argv)
+{
+    size_t count = bench::Arg(argc, argv, 1, 10'000'000);
+    std::printf("MappedHashTable, %zu keys\n", count);
+
+    auto keys = bench::RandomKeys(count);
+    auto misses = bench::RandomKeys(count, 1ULL << 40);
+    std::string path = (std::filesystem::temp_directory_path() / "icb_bench_mapped_hash_table.bin").string();
+
+    icb::HashTable<uint64_t, uint64_t> table(count);
+    for (size_t i = 0; i < keys.size(); ++i)
+        table.Insert(keys[i], i);
+
+    double ns = bench::TimeNs([&] { icb::MappedHashTable<uint64_t, uint64_t>::Write(table, path); });
+    bench::Report("Write", count, ns);
+
+    // what a process has to do before its first lookup: rebuild the table, or just map the file
+    ns = bench::TimeNs([&] {
+        icb::HashTable<uint64_t, uint64_t> rebuilt(count);
+        for (size_t i = 0; i < keys.size(); ++i)
+            rebuilt.Insert(keys[i], i);
+        bench::Consume(rebuilt.Size());
+    });
+    std::printf("%-48s %10.3f ms\n", "HashTable startup (Insert all)", ns / 1e6);
+
+    ns = bench::TimeNs([&] {
+        icb::MappedHashTable<uint64_t, uint64_t> opened(path);
+        bench::Consume(opened.Size());
+    });
+    std::printf("%-48s %10.3f ms\n", "MappedHashTable startup (map file)", ns / 1e6);
+
+    icb::MappedHashTable<uint64_t, uint64_t> mapped(path);
+
+    auto lookupKeys = keys;
+    std::shuffle(lookupKeys.begin(), lookupKeys.end(), std::mt19937_64(7));
+
+    ns = bench::TimeNs([&] {
+        uint64_t sum = 0;
+        for (uint64_t key : lookupKeys)
+            sum += *table.Find(key);
+        bench::Consume(sum);
+    });
+    bench::Report("HashTable find hit", count, ns);
+
+    ns = bench::TimeNs([&] {
+        uint64_t sum = 0;
+        for (uint64_t key : lookupKeys)
+            sum += *mapped.FindPtr(key);
+        bench::Consume(sum);
+    });
+    bench::Report("MappedHashTable find hit", count, ns);
+
+    ns = bench::TimeNs([&] {
+        uint64_t found = 0;
+        for (uint64_t key : misses)
+            found += mapped.Contains(key);
+        bench::Consume(found);
+    });
+    bench::Report("MappedHashTable find miss", count, ns);
+
+    std::filesystem::remove(path);
+    return 0;
+}
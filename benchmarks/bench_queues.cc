@@ -0,0 +1,159 @@
+#include <atomic>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include "icb/linkedlist.h"
+#include "icb/mpmc_queue.h"
+#include "icb/spsc_queue.h"
+
+#include "bench_common.h"
+
+constexpr size_t QUEUE_CAPACITY = 1024;
+
+// the baseline: a LinkedList behind a mutex, one node per message
+struct LockedList
+{
+    std::mutex mutex;
+    icb::LinkedList<uint64_t> list;
+
+    bool TryPush(uint64_t value)
+    {
+        std::lock_guard lock(mutex);
+        list.PushBack(value);
+        return true;
+    }
+
+    std::optional<uint64_t> TryPop()
+    {
+        std::lock_guard lock(mutex);
+        if (list.Empty())
+            return std::nullopt;
+        uint64_t value = list.Front();
+        list.PopFront();
+        return value;
+    }
+};
+
+struct Spsc : icb::SPSCQueue<uint64_t>
+{
+    Spsc() : icb::SPSCQueue<uint64_t>(QUEUE_CAPACITY)
+    {
+    }
+};
+
+struct Mpmc : icb::MPMCQueue<uint64_t>
+{
+    Mpmc() : icb::MPMCQueue<uint64_t>(QUEUE_CAPACITY)
+    {
+    }
+};
+
+// producers push messages between them, consumers pop until all have arrived; reports messages per second
+template <typename Queue> static void throughput(const char *name, size_t producers, size_t consumers, size_t messages)
+{
+    Queue queue;
+    std::atomic<size_t> popped = 0;
+    std::atomic<bool> start = false;
+    std::vector<std::thread> threads;
+
+    for (size_t p = 0; p < producers; ++p)
+    {
+        threads.emplace_back([&, p] {
+            while (!start.load())
+                std::this_thread::yield();
+            for (size_t i = p; i < messages; i += producers)
+                while (!queue.TryPush(i))
+                    std::this_thread::yield();
+        });
+    }
+    for (size_t c = 0; c < consumers; ++c)
+    {
+        threads.emplace_back([&] {
+            uint64_t sum = 0;
+            while (popped.load(std::memory_order_relaxed) < messages)
+            {
+                if (std::optional<uint64_t> value = queue.TryPop())
+                {
+                    sum += *value;
+                    popped.fetch_add(1, std::memory_order_relaxed);
+                }
+                else
+                {
+                    std::this_thread::yield();
+                }
+            }
+            bench::Consume(sum);
+        });
+    }
+
+    double ns = bench::TimeNs([&] {
+        start = true;
+        for (std::thread &thread : threads)
+            thread.join();
+    });
+    bench::Report(name, messages, ns);
+}
+
+// one message bounces between two threads through a pair of queues; reports the round trip
+template <typename Queue> static void latency(const char *name, size_t roundTrips)
+{
+    Queue ping, pong;
+    std::thread echo([&] {
+        for (size_t i = 0; i < roundTrips; ++i)
+        {
+            std::optional<uint64_t> value;
+            while (!(value = ping.TryPop()))
+                std::this_thread::yield();
+            while (!pong.TryPush(*value + 1))
+                std::this_thread::yield();
+        }
+    });
+
+    uint64_t sum = 0;
+    double ns = bench::TimeNs([&] {
+        for (size_t i = 0; i < roundTrips; ++i)
+        {
+            while (!ping.TryPush(i))
+                std::this_thread::yield();
+            std::optional<uint64_t> value;
+            while (!(value = pong.TryPop()))
+                std::this_thread::yield();
+            sum += *value;
+        }
+    });
+    echo.join();
+    bench::Consume(sum);
+    bench::Report(name, roundTrips, ns);
+}
+
+int main(int argc, char **argv)
+{
+    size_t messages = bench::Arg(argc, argv, 1, 4'000'000);
+    size_t threads = bench::Arg(argc, argv, 2, 4);
+    size_t roundTrips = bench::Arg(argc, argv, 3, 100'000);
+
+    // with fewer cores than threads the yields dominate, and the numbers say more about the scheduler
+    std::printf("%u hardware threads, queues of %zu\n", std::thread::hardware_concurrency(), QUEUE_CAPACITY);
+
+    std::printf("\nthroughput 1 -> 1, %zu messages\n", messages);
+    throughput<LockedList>("mutex + LinkedList", 1, 1, messages);
+    throughput<Spsc>("SPSCQueue", 1, 1, messages);
+    throughput<Mpmc>("MPMCQueue", 1, 1, messages);
+
+    std::printf("\nthroughput 1 -> %zu\n", threads);
+    throughput<LockedList>("mutex + LinkedList", 1, threads, messages);
+    throughput<Mpmc>("MPMCQueue", 1, threads, messages);
+
+    std::printf("\nthroughput %zu -> %zu\n", threads, threads);
+    throughput<LockedList>("mutex + LinkedList", threads, threads, messages);
+    throughput<Mpmc>("MPMCQueue", threads, threads, messages);
+
+    std::printf("\nround trip latency 1 <-> 1, %zu trips\n", roundTrips);
+    latency<LockedList>("mutex + LinkedList", roundTrips);
+    latency<Spsc>("SPSCQueue", roundTrips);
+    latency<Mpmc>("MPMCQueue", roundTrips);
+
+    return 0;
+}
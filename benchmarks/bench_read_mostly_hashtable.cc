@@ -0,0 +1,113 @@
+#include <atomic>
+#include <shared_mutex>
+#include <thread>
+
+#include "icb/concurrent_hash_table.h"
+#include "icb/hash_table.h"
+#include "icb/read_mostly_hash_table.h"
+
+#include "bench_common.h"
+
+struct SharedLockTable
+{
+    mutable std::shared_mutex mutex;
+    icb::HashTable<uint64_t, uint64_t> table;
+
+    bool Contains(uint64_t key) const
+    {
+        std::shared_lock lock(mutex);
+        return table.Contains(key);
+    }
+
+    void InsertOrAssign(uint64_t key, uint64_t value)
+    {
+        std::unique_lock lock(mutex);
+        table.InsertOrAssign(key, value);
+    }
+};
+
+/*
+ * Reader threads look keys up for a fixed time while one writer keeps updating values,
+ * roughly one write per `readsPerWrite` reads of a single reader.
+ */
+template <typename Table>
+static void run(const char *name, Table &table, const std::vector<uint64_t> &keys, unsigned readers,
+                double seconds, size_t readsPerWrite)
+{
+    std::atomic<bool> stop{false};
+    std::atomic<uint64_t> totalReads{0};
+
+    std::vector<std::thread> threads;
+    for (unsigned t = 0; t < readers; ++t)
+    {
+        threads.emplace_back([&, t] {
+            uint64_t reads = 0, found = 0;
+            size_t index = t * 7919;
+            while (!stop.load(std::memory_order_relaxed))
+            {
+                for (int i = 0; i < 256; ++i)
+                {
+                    index = (index + 104729) % keys.size();
+                    found += table.Contains(keys[index]);
+                }
+                reads += 256;
+            }
+            totalReads += reads;
+            bench::Consume(found);
+        });
+    }
+
+    std::thread writer([&] {
+        size_t index = 0;
+        // ~20ns per read, so this sleep spaces writes out to about one per readsPerWrite reads
+        auto pause = std::chrono::nanoseconds(readsPerWrite * 20);
+        while (!stop.load(std::memory_order_relaxed))
+        {
+            index = (index + 15485863) % keys.size();
+            table.InsertOrAssign(keys[index], index);
+            std::this_thread::sleep_for(pause);
+        }
+    });
+
+    std::this_thread::sleep_for(std::chrono::duration<double>(seconds));
+    stop.store(true);
+    for (auto &thread : threads)
+        thread.join();
+    writer.join();
+
+    char label[128];
+    std::snprintf(label, sizeof(label), "%s, %u readers", name, readers);
+    std::printf("%-48s %10.2f Mreads/s\n", label, static_cast<double>(totalReads.load()) / seconds / 1e6);
+}
+
+int main(int argc, char **argv)
+{
+    size_t count = bench::Arg(argc, argv, 1, 1'000'000);
+    unsigned maxReaders = static_cast<unsigned>(bench::Arg(argc, argv, 2, std::thread::hardware_concurrency()));
+    double seconds = 1.0;
+    size_t readsPerWrite = 100'000;
+
+    std::printf("%zu keys, one writer at ~1 write per %zu reads, read throughput summed over readers\n", count,
+                readsPerWrite);
+
+    auto keys = bench::RandomKeys(count);
+
+    for (unsigned readers = 1; readers <= maxReaders; readers *= 2)
+    {
+        SharedLockTable locked;
+        icb::ConcurrentHashTable<uint64_t, uint64_t> sharded;
+        icb::ReadMostlyHashTable<uint64_t, uint64_t> readMostly;
+        for (size_t i = 0; i < count; ++i)
+        {
+            locked.InsertOrAssign(keys[i], i);
+            sharded.Insert(keys[i], i);
+            readMostly.Insert(keys[i], i);
+        }
+
+        run("HashTable + shared_mutex", locked, keys, readers, seconds, readsPerWrite);
+        run("ConcurrentHashTable", sharded, keys, readers, seconds, readsPerWrite);
+        run("ReadMostlyHashTable", readMostly, keys, readers, seconds, readsPerWrite);
+    }
+
+    return 0;
+}
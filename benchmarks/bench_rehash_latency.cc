@@ -0,0 +1,41 @@
+#include <algorithm>
+
+#include "icb/hash_table.h"
+
+#include "bench_common.h"
+
+// per-insert latency while a table grows from empty, with and without incremental rehashing
+static void run(const char *name, const std::vector<uint64_t> &keys, bool incremental)
+{
+    icb::HashTable<uint64_t, uint64_t> table;
+    table.IncrementalRehash(incremental);
+
+    std::vector<double> latencies(keys.size());
+    double total = bench::TimeNs([&] {
+        for (size_t i = 0; i < keys.size(); ++i)
+        {
+            auto start = bench::Clock::now();
+            table.Insert(keys[i], i);
+            latencies[i] = std::chrono::duration<double, std::nano>(bench::Clock::now() - start).count();
+        }
+    });
+
+    std::sort(latencies.begin(), latencies.end());
+    auto percentile = [&](double p) { return latencies[static_cast<size_t>(p * static_cast<double>(keys.size() - 1))]; };
+
+    bench::Report(name, keys.size(), total);
+    std::printf("    p50 %.0f ns, p99 %.0f ns, p99.9 %.0f ns, p99.99 %.0f ns, max %.0f ns\n", percentile(0.5),
+                percentile(0.99), percentile(0.999), percentile(0.9999), latencies.back());
+}
+
+int main(int argc, char **argv)
+{
+    size_t count = bench::Arg(argc, argv, 1, 4'000'000);
+    std::printf("HashTable insert latency while growing to %zu keys\n", count);
+
+    auto keys = bench::RandomKeys(count);
+    run("HashTable insert (stop-the-world rehash)", keys, false);
+    run("HashTable insert (incremental rehash)", keys, true);
+
+    return 0;
+}
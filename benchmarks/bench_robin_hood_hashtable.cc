@@ -0,0 +1,113 @@
+#include "icb/flat_hash_table.h"
+#include "icb/hash_table.h"
+#include "icb/robin_hood_hash_table.h"
+
+#include <bit>
+
+#include "bench_common.h"
+
+using RobinHood = icb::RobinHoodHashTable<uint64_t, uint64_t>;
+
+// lookups in a table held at exactly the given load
+void highLoad(size_t capacity, float load)
+{
+    size_t count = static_cast<size_t>(static_cast<float>(capacity) * load);
+    auto keys = bench::RandomKeys(count);
+    auto misses = bench::RandomKeys(count, 1ULL << 40);
+
+    RobinHood table;
+    table.MaxLoadFactor(0.97f);
+    table.Rehash(capacity);
+    for (size_t i = 0; i < keys.size(); ++i)
+        table.Insert(keys[i], i);
+
+    char label[64];
+    std::snprintf(label, sizeof(label), "load %.2f, max PSL %zu", static_cast<double>(table.LoadFactor()),
+                  table.MaxProbeLength());
+    std::printf("%s\n", label);
+
+    double ns = bench::TimeNs([&] {
+        uint64_t sum = 0;
+        for (uint64_t key : keys)
+            sum += *table.FindPtr(key);
+        bench::Consume(sum);
+    });
+    bench::Report("    RobinHoodHashTable find hit", keys.size(), ns);
+
+    ns = bench::TimeNs([&] {
+        uint64_t found = 0;
+        for (uint64_t key : misses)
+            found += table.Contains(key);
+        bench::Consume(found);
+    });
+    bench::Report("    RobinHoodHashTable find miss", misses.size(), ns);
+}
+
+/*
+ * Steady state churn: every op erases the oldest key and inserts a new one, so the size stays put while the keys
+ * keep changing. Tombstone-based tables slowly fill up with deleted slots, which the miss lookups afterwards show.
+ */
+template <typename Table> void churn(const char *name, Table &table, size_t count, size_t ops)
+{
+    std::string label(name);
+    auto keys = bench::RandomKeys(count + ops);
+    auto misses = bench::RandomKeys(count, 1ULL << 40);
+
+    for (size_t i = 0; i < count; ++i)
+        table.Insert(keys[i], i);
+
+    double ns = bench::TimeNs([&] {
+        for (size_t i = 0; i < ops; ++i)
+        {
+            table.Erase(keys[i]);
+            table.Insert(keys[count + i], i);
+        }
+    });
+    bench::Report((label + " erase+insert").c_str(), ops, ns);
+
+    ns = bench::TimeNs([&] {
+        uint64_t found = 0;
+        for (size_t i = ops; i < count + ops; ++i)
+            found += table.Contains(keys[i]);
+        bench::Consume(found);
+    });
+    bench::Report((label + " find hit after churn").c_str(), count, ns);
+
+    ns = bench::TimeNs([&] {
+        uint64_t found = 0;
+        for (uint64_t key : misses)
+            found += table.Contains(key);
+        bench::Consume(found);
+    });
+    bench::Report((label + " find miss after churn").c_str(), misses.size(), ns);
+}
+
+int main(int argc, char **argv)
+{
+    size_t capacity = std::bit_ceil(bench::Arg(argc, argv, 1, 1 << 20));
+    size_t ops = bench::Arg(argc, argv, 2, 4'000'000);
+
+    std::printf("RobinHoodHashTable at high load, %zu slots\n", capacity);
+    for (float load : {0.5f, 0.75f, 0.9f, 0.95f})
+        highLoad(capacity, load);
+
+    // 0.85 of the slots, just below FlatHashTable's 7/8 so neither open addressing table grows
+    size_t count = capacity * 85 / 100;
+    std::printf("\nErase-heavy churn, %zu keys, %zu erase+insert pairs\n", count, ops);
+    {
+        RobinHood table;
+        table.MaxLoadFactor(0.95f);
+        table.Rehash(capacity);
+        churn("RobinHoodHashTable", table, count, ops);
+    }
+    {
+        icb::FlatHashTable<uint64_t, uint64_t> table(capacity);
+        churn("FlatHashTable", table, count, ops);
+    }
+    {
+        icb::HashTable<uint64_t, uint64_t> table(capacity);
+        churn("HashTable", table, count, ops);
+    }
+
+    return 0;
+}
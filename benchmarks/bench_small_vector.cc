@@ -0,0 +1,113 @@
+#include <vector>
+
+#include "icb/small_vector.h"
+#include "icb/vector.h"
+
+#include "bench_common.h"
+
+// lowercase adapters, so std::vector, icb::Vector and icb::SmallVector go through the same loops
+template <typename Base> struct Adapter : Base
+{
+    void push_back(const typename Base::ValueType &value)
+    {
+        this->PushBack(value);
+    }
+    size_t size() const
+    {
+        return this->Size();
+    }
+    size_t capacity() const
+    {
+        return this->Capacity();
+    }
+};
+
+template <typename T> using IcbVector = Adapter<icb::Vector<T>>;
+template <typename T, size_t N> using IcbSmallVector = Adapter<icb::SmallVector<T, N>>;
+
+// mostly under 8 elements: 90% of the sizes in [0, 8), the rest in [8, 64]
+static std::vector<size_t> smallSizes(size_t count)
+{
+    std::vector<uint64_t> random = bench::RandomKeys(count, 7);
+    std::vector<size_t> sizes(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        sizes[i] = random[i] % 100 < 90 ? random[i] % 8 : 8 + (random[i] >> 8) % 57;
+    }
+    return sizes;
+}
+
+/*
+ * Builds a vector of each size and drops it. A buffer is allocated (or realloc'd) exactly when the capacity changes,
+ * which is how the allocator calls are counted: Vector grows trivially copyable types with realloc, which an
+ * operator new counter wouldn't see.
+ */
+template <typename Vec> static void buildAndDrop(const char *name, const std::vector<size_t> &sizes)
+{
+    size_t allocations = 0;
+    double ns = bench::TimeNs([&] {
+        for (size_t size : sizes)
+        {
+            Vec vector;
+            size_t capacity = vector.capacity();
+            for (size_t i = 0; i < size; ++i)
+            {
+                vector.push_back(static_cast<uint32_t>(i));
+                if (vector.capacity() != capacity)
+                {
+                    capacity = vector.capacity();
+                    ++allocations;
+                }
+            }
+            bench::Consume(vector.size());
+        }
+    });
+    bench::Report(name, sizes.size(), ns);
+    std::printf("    %.3f allocations per vector\n",
+                static_cast<double>(allocations) / static_cast<double>(sizes.size()));
+}
+
+// many vectors kept alive side by side, then read back; the inline buffers make a SmallVector bigger to scan past
+template <typename Vec> static void keepAndSum(const char *name, const std::vector<size_t> &sizes)
+{
+    std::vector<Vec> vectors(sizes.size());
+    for (size_t v = 0; v < sizes.size(); ++v)
+    {
+        for (size_t i = 0; i < sizes[v]; ++i)
+        {
+            vectors[v].push_back(static_cast<uint32_t>(v + i));
+        }
+    }
+
+    uint64_t sum = 0;
+    double ns = bench::TimeNs([&] {
+        for (const Vec &vector : vectors)
+        {
+            for (uint32_t value : vector)
+            {
+                sum += value;
+            }
+        }
+    });
+    bench::Consume(sum);
+    bench::Report(name, sizes.size(), ns);
+}
+
+int main(int argc, char **argv)
+{
+    size_t count = bench::Arg(argc, argv, 1, 1'000'000);
+    const std::vector<size_t> sizes = smallSizes(count);
+
+    std::printf("%zu vectors of uint32_t, 90%% under 8 elements, build and drop\n", count);
+    buildAndDrop<std::vector<uint32_t>>("std::vector", sizes);
+    buildAndDrop<IcbVector<uint32_t>>("Vector", sizes);
+    buildAndDrop<IcbSmallVector<uint32_t, 8>>("SmallVector<8>", sizes);
+    buildAndDrop<IcbSmallVector<uint32_t, 16>>("SmallVector<16>", sizes);
+
+    std::printf("\nkept alive, then summed\n");
+    keepAndSum<std::vector<uint32_t>>("std::vector", sizes);
+    keepAndSum<IcbVector<uint32_t>>("Vector", sizes);
+    keepAndSum<IcbSmallVector<uint32_t, 8>>("SmallVector<8>", sizes);
+
+    return 0;
+}
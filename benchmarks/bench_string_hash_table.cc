@@ -0,0 +1,112 @@
+#include "icb/hash_table.h"
+#include "icb/string_hash_table.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+#include <random>
+
+#include "bench_common.h"
+
+// counts heap allocations and live bytes, every block carries its size in front of it
+namespace
+{
+size_t g_allocations = 0;
+size_t g_liveBytes = 0;
+constexpr size_t HEADER = alignof(std::max_align_t);
+} // namespace
+
+void *operator new(size_t size)
+{
+    void *block = std::malloc(size + HEADER);
+    if (!block)
+        throw std::bad_alloc();
+    *static_cast<size_t *>(block) = size;
+    ++g_allocations;
+    g_liveBytes += size;
+    return static_cast<char *>(block) + HEADER;
+}
+
+void operator delete(void *ptr) noexcept
+{
+    if (!ptr)
+        return;
+    void *block = reinterpret_cast<void *>(reinterpret_cast<uintptr_t>(ptr) - HEADER);
+    g_liveBytes -= *static_cast<size_t *>(block);
+    std::free(block);
+}
+
+void operator delete(void *ptr, size_t) noexcept
+{
+    operator delete(ptr);
+}
+
+// nothing measured here needs more alignment than the header gives
+void *operator new(size_t size, std::align_val_t alignment)
+{
+    if (static_cast<size_t>(alignment) > HEADER)
+        std::abort();
+    return operator new(size);
+}
+
+void operator delete(void *ptr, std::align_val_t) noexcept
+{
+    operator delete(ptr);
+}
+
+void operator delete(void *ptr, size_t, std::align_val_t) noexcept
+{
+    operator delete(ptr);
+}
+
+template <typename Table> void measure(const char *name, const std::vector<std::string> &keys)
+{
+    std::string label(name);
+    std::vector<std::string> lookupKeys = keys;
+    std::shuffle(lookupKeys.begin(), lookupKeys.end(), std::mt19937_64(7));
+
+    const size_t allocationsBefore = g_allocations;
+    const size_t bytesBefore = g_liveBytes;
+    {
+        Table table;
+        double ns = bench::TimeNs([&] {
+            for (size_t i = 0; i < keys.size(); ++i)
+                table.Insert(keys[i], i);
+        });
+        bench::Report((label + " insert").c_str(), keys.size(), ns);
+        // requested bytes only, the allocator adds its own overhead to every block on top
+        std::printf("    %.3f allocations per insert, %.1f bytes per element\n",
+                    static_cast<double>(g_allocations - allocationsBefore) / static_cast<double>(keys.size()),
+                    static_cast<double>(g_liveBytes - bytesBefore) / static_cast<double>(keys.size()));
+
+        ns = bench::TimeNs([&] {
+            size_t sum = 0;
+            for (const std::string &key : lookupKeys)
+                sum += *table.FindPtr(key);
+            bench::Consume(sum);
+        });
+        bench::Report((label + " find hit").c_str(), keys.size(), ns);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    size_t count = bench::Arg(argc, argv, 1, 1'000'000);
+    std::printf("StringHashTable, %zu keys\n", count);
+
+    // short keys that fit std::string's small buffer, then ones that don't
+    std::vector<std::string> shortKeys;
+    for (uint64_t key : bench::RandomKeys(count))
+        shortKeys.push_back("k" + std::to_string(key % 100'000'000'000ULL));
+    auto longKeys = bench::StringKeys(count);
+
+    std::printf("\n%zu byte keys\n", shortKeys[0].size());
+    measure<icb::HashTable<std::string, uint64_t>>("HashTable<std::string>", shortKeys);
+    measure<icb::StringHashTable<uint64_t>>("StringHashTable", shortKeys);
+
+    std::printf("\n%zu byte keys\n", longKeys[0].size());
+    measure<icb::HashTable<std::string, uint64_t>>("HashTable<std::string>", longKeys);
+    measure<icb::StringHashTable<uint64_t>>("StringHashTable", longKeys);
+
+    return 0;
+}
@@ -0,0 +1,77 @@
+#include <iterator>
+
+#include "icb/linkedlist.h"
+#include "icb/unrolled_list.h"
+
+#include "bench_common.h"
+
+// a list built with PushBack, walked ten times
+template <typename List> static void traverse(const char *name, size_t count)
+{
+    List list;
+    for (size_t i = 0; i < count; ++i)
+        list.PushBack(static_cast<int>(i));
+
+    uint64_t sum = 0;
+    double ns = bench::TimeNs([&] {
+        for (int round = 0; round < 10; ++round)
+            for (int value : list)
+                sum += static_cast<uint64_t>(value);
+    });
+    bench::Consume(sum);
+    bench::Report(name, 10 * count, ns);
+}
+
+// every insert walks to a pseudo-random position first, so the walk is part of the cost, as it usually is
+template <typename List> static void insertRandom(const char *name, size_t count)
+{
+    List list;
+    uint64_t state = 1;
+
+    double ns = bench::TimeNs([&] {
+        for (size_t i = 0; i < count; ++i)
+        {
+            state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+            const auto position = static_cast<std::ptrdiff_t>((state >> 33) % (list.Size() + 1));
+            list.Insert(std::next(list.begin(), position), static_cast<int>(i));
+        }
+    });
+    bench::Consume(list.Size());
+    bench::Report(name, count, ns);
+}
+
+// inserts at an iterator the caller already holds, in the middle of a large list
+template <typename List> static void insertAtIterator(const char *name, size_t count)
+{
+    List list;
+    for (size_t i = 0; i < count; ++i)
+        list.PushBack(static_cast<int>(i));
+
+    auto it = std::next(list.begin(), static_cast<std::ptrdiff_t>(count / 2));
+    double ns = bench::TimeNs([&] {
+        for (size_t i = 0; i < count; ++i)
+            it = list.Insert(it, static_cast<int>(i));
+    });
+    bench::Consume(list.Size());
+    bench::Report(name, count, ns);
+}
+
+int main(int argc, char **argv)
+{
+    size_t count = bench::Arg(argc, argv, 1, 1'000'000);
+    size_t randomCount = bench::Arg(argc, argv, 2, 20'000);
+
+    std::printf("walking %zu ints, %zu per UnrolledList node\n", count, icb::UnrolledList<int>::NODE_CAPACITY);
+    traverse<icb::LinkedList<int>>("LinkedList traversal", count);
+    traverse<icb::UnrolledList<int>>("UnrolledList traversal", count);
+
+    std::printf("\n%zu inserts at random positions, walking to each\n", randomCount);
+    insertRandom<icb::LinkedList<int>>("LinkedList insert at random position", randomCount);
+    insertRandom<icb::UnrolledList<int>>("UnrolledList insert at random position", randomCount);
+
+    std::printf("\n%zu inserts at a held iterator in the middle\n", count);
+    insertAtIterator<icb::LinkedList<int>>("LinkedList insert at iterator", count);
+    insertAtIterator<icb::UnrolledList<int>>("UnrolledList insert at iterator", count);
+
+    return 0;
+}
@@ -0,0 +1,143 @@
+#include <string>
+#include <vector>
+
+#include "icb/vector.h"
+
+#include "bench_common.h"
+
+// a POD payload, trivially copyable, so Vector grows it with realloc and shifts it with memmove
+struct Payload
+{
+    uint64_t id;
+    uint64_t values[3];
+};
+
+// lowercase adapters, so std::vector and icb::Vector go through the same loops
+template <typename T> struct IcbVector : icb::Vector<T>
+{
+    void push_back(const T &value)
+    {
+        this->PushBack(value);
+    }
+    void insert(typename icb::Vector<T>::ConstIterator position, const T &value)
+    {
+        this->Insert(position, value);
+    }
+    void erase(typename icb::Vector<T>::ConstIterator position)
+    {
+        this->Erase(position);
+    }
+    size_t size() const
+    {
+        return this->Size();
+    }
+    const T &operator[](size_t index) const
+    {
+        return this->Data()[index];
+    }
+};
+
+template <typename T> static T make(uint64_t i)
+{
+    if constexpr (std::is_same_v<T, Payload>)
+        return Payload{i, {i, i, i}};
+    else if constexpr (std::is_same_v<T, std::string>)
+        return std::to_string(i) + std::string(24, 'x');
+    else
+        return static_cast<T>(i);
+}
+
+template <typename T> static uint64_t fold(const T &value)
+{
+    if constexpr (std::is_same_v<T, Payload>)
+        return value.id;
+    else if constexpr (std::is_same_v<T, std::string>)
+        return value.size();
+    else
+        return static_cast<uint64_t>(value);
+}
+
+// fills fresh vectors without reserving, growth is the whole cost
+template <typename Vec> static void growth(const char *name, size_t count, size_t rounds)
+{
+    using T = std::remove_cvref_t<decltype(std::declval<Vec &>()[0])>;
+    double ns = bench::TimeNs([&] {
+        for (size_t round = 0; round < rounds; ++round)
+        {
+            Vec vector;
+            for (size_t i = 0; i < count; ++i)
+                vector.push_back(make<T>(i));
+            bench::Consume(fold(vector[count - 1]));
+        }
+    });
+    bench::Report(name, count * rounds, ns);
+}
+
+// inserts at and erases from the middle, every op shifts half of the elements
+template <typename Vec> static void shifting(const char *name, size_t count, size_t ops)
+{
+    using T = std::remove_cvref_t<decltype(std::declval<Vec &>()[0])>;
+    Vec vector;
+    for (size_t i = 0; i < count; ++i)
+        vector.push_back(make<T>(i));
+
+    double ns = bench::TimeNs([&] {
+        for (size_t i = 0; i < ops; ++i)
+        {
+            vector.insert(vector.begin() + static_cast<std::ptrdiff_t>(vector.size() / 2), make<T>(i));
+            vector.erase(vector.begin() + static_cast<std::ptrdiff_t>(vector.size() / 3));
+        }
+    });
+    bench::Consume(fold(vector[0]));
+    bench::Report(name, 2 * ops, ns);
+}
+
+template <typename Vec> static void copying(const char *name, size_t count, size_t rounds)
+{
+    using T = std::remove_cvref_t<decltype(std::declval<Vec &>()[0])>;
+    Vec vector;
+    for (size_t i = 0; i < count; ++i)
+        vector.push_back(make<T>(i));
+
+    double ns = bench::TimeNs([&] {
+        for (size_t round = 0; round < rounds; ++round)
+        {
+            Vec copy(vector);
+            bench::Consume(fold(copy[count / 2]));
+        }
+    });
+    bench::Report(name, count * rounds, ns);
+}
+
+template <typename T> static void all(const char *type, size_t count)
+{
+    const size_t rounds = std::max<size_t>(1, 10'000'000 / count);
+    char name[64];
+
+    std::printf("\n%s, %zu elements\n", type, count);
+    std::snprintf(name, sizeof(name), "std::vector push_back");
+    growth<std::vector<T>>(name, count, rounds);
+    std::snprintf(name, sizeof(name), "Vector PushBack");
+    growth<IcbVector<T>>(name, count, rounds);
+
+    std::snprintf(name, sizeof(name), "std::vector insert/erase middle");
+    shifting<std::vector<T>>(name, 10'000, 20'000);
+    std::snprintf(name, sizeof(name), "Vector Insert/Erase middle");
+    shifting<IcbVector<T>>(name, 10'000, 20'000);
+
+    std::snprintf(name, sizeof(name), "std::vector copy");
+    copying<std::vector<T>>(name, count, rounds);
+    std::snprintf(name, sizeof(name), "Vector copy");
+    copying<IcbVector<T>>(name, count, rounds);
+}
+
+int main(int argc, char **argv)
+{
+    size_t count = bench::Arg(argc, argv, 1, 1'000'000);
+
+    all<uint32_t>("uint32_t", count);
+    all<Payload>("32-byte POD", count);
+    all<std::string>("std::string", count);
+
+    return 0;
+}
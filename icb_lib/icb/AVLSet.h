@@ -14,6 +14,8 @@
 #include <functional>
 #include <iomanip>
 #include <iostream>
+#include <memory>
+#include <memory_resource>
 #include <type_traits>
 
 namespace icb
@@ -26,11 +28,13 @@ concept Comparable = requires(A a, B b) {
     { a != b } -> std::convertible_to<bool>;
 };
 
-template <typename T> class AVLSet
+// the nodes come from Allocator, rebound to the node type, and assignment keeps the set's own allocator
+template <typename T, typename Allocator = std::allocator<T>> class AVLSet
 {
   public:
     using SizeType = size_t;
     using ValueType = T;
+    using AllocatorType = Allocator;
 
   private:
     using HeightType = int32_t;
@@ -56,6 +60,9 @@ template <typename T> class AVLSet
         }
     };
 
+    using NodeAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+    using NodeTraits = std::allocator_traits<NodeAllocator>;
+
   public:
     enum TraversalOrder
     {
@@ -71,8 +78,13 @@ template <typename T> class AVLSet
         deleteSubtree(m_root);
     }
 
+    explicit AVLSet(const Allocator &allocator) : m_allocator(allocator)
+    {
+    }
+
     // copy ctor
-    explicit AVLSet(const AVLSet<T> &other) noexcept
+    explicit AVLSet(const AVLSet &other)
+        : m_allocator(NodeTraits::select_on_container_copy_construction(other.m_allocator))
     {
         if (other.m_root == nullptr)
         {
@@ -83,22 +95,23 @@ template <typename T> class AVLSet
     }
 
     // move ctor
-    explicit AVLSet(AVLSet<T> &&other) noexcept : m_root(other.m_root)
+    explicit AVLSet(AVLSet &&other) noexcept : m_root(other.m_root), m_allocator(other.m_allocator)
     {
         other.m_root = nullptr;
     }
 
     // copy assignment
-    AVLSet &operator=(const AVLSet<T> &other) noexcept
+    AVLSet &operator=(const AVLSet &other)
     {
-        if (other.m_root == nullptr)
+        if (this == &other)
         {
-            m_root = nullptr;
             return *this;
         }
 
-        if (this == &other)
+        if (other.m_root == nullptr)
         {
+            deleteSubtree(m_root);
+            m_root = nullptr;
             return *this;
         }
 
@@ -109,20 +122,35 @@ template <typename T> class AVLSet
         return *this;
     }
 
-    // move assignment
-    AVLSet &operator=(AVLSet &&other) noexcept
+    // move assignment, nodes from a different allocator are copied and then freed by it
+    AVLSet &operator=(AVLSet &&other) noexcept(NodeTraits::is_always_equal::value)
     {
         if (this == &other)
         {
             return *this;
         }
 
-        m_root = other.m_root;
+        deleteSubtree(m_root);
+        if (NodeTraits::is_always_equal::value || m_allocator == other.m_allocator)
+        {
+            m_root = other.m_root;
+        }
+        else
+        {
+            m_root = nullptr;
+            m_root = copySubtree(other.m_root);
+            other.deleteSubtree(other.m_root);
+        }
         other.m_root = nullptr;
 
         return *this;
     }
 
+    Allocator GetAllocator() const noexcept
+    {
+        return Allocator(m_allocator);
+    }
+
   public:
     // copy
     void Insert(const ValueType &data)
@@ -217,7 +245,7 @@ template <typename T> class AVLSet
 
         if (node == nullptr)
         {
-            return new Node(std::forward<InsertType>(data));
+            return createNode(std::forward<InsertType>(data));
         }
 
         if (data < node->data)
@@ -289,7 +317,8 @@ template <typename T> class AVLSet
 
         deleteSubtree(node->left);
         deleteSubtree(node->right);
-        delete node;
+        node->~Node();
+        NodeTraits::deallocate(m_allocator, node, 1);
     }
 
     Node *copySubtree(const Node *node)
@@ -299,7 +328,21 @@ template <typename T> class AVLSet
             return nullptr;
         }
 
-        return new Node(node->data, copySubtree(node->left), copySubtree(node->right));
+        return createNode(node->data, copySubtree(node->left), copySubtree(node->right));
+    }
+
+    template <typename... Args> Node *createNode(Args &&...args)
+    {
+        Node *node = NodeTraits::allocate(m_allocator, 1);
+        try
+        {
+            return new (node) Node(std::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+            NodeTraits::deallocate(m_allocator, node, 1);
+            throw;
+        }
     }
 
     [[nodiscard]] Node *rotateRight(Node *node)
@@ -356,6 +399,12 @@ template <typename T> class AVLSet
 
   private:
     Node *m_root = nullptr;
+    [[no_unique_address]] NodeAllocator m_allocator;
 };
 
+namespace pmr
+{
+// an AVLSet whose nodes come from a std::pmr::memory_resource
+template <typename T> using AVLSet = icb::AVLSet<T, std::pmr::polymorphic_allocator<T>>;
+} // namespace pmr
 } // namespace icb
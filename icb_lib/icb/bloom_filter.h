@@ -0,0 +1,238 @@
+/**
+ * @file bloom_filter.h
+ * @author Dovydas Ciomenas (icouldbreathe@icloud.com)
+ * @brief Blocked Bloom filter, a set membership test that answers every query within one cache line
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+
+#include "hash.h"
+
+#define BF_INIT_CAPACITY 16
+#define BF_BITS_PER_KEY 12 // about 0.5% false positives when filled to capacity
+
+namespace icb
+{
+/**
+ * @brief Probabilistic set: MayContain is false for keys never inserted, except for a small false positive rate
+ *
+ * The bits are split into 64-byte blocks. A key's hash picks one block and sets one bit in each of its eight
+ * words, so an insert or a query touches a single cache line and the eight tests don't depend on each other.
+ * That costs a slightly higher false positive rate than a classic Bloom filter with the same number of bits.
+ *
+ * Keys can't be removed. The filter is sized for an expected number of keys, inserting more keeps it correct but
+ * raises the false positive rate.
+ */
+template <typename Key> class BloomFilter
+{
+  public:
+    using SizeType = size_t;
+
+  private:
+    template <typename K> static constexpr bool isHeterogeneous = detail::IsHeterogeneous<Key, K>;
+
+    static constexpr SizeType BLOCK_WORDS = 8;
+    static constexpr SizeType BLOCK_BITS = BLOCK_WORDS * 64;
+
+    struct alignas(64) Block
+    {
+        uint64_t words[BLOCK_WORDS];
+    };
+
+  public:
+    BloomFilter(const SizeType &capacity = BF_INIT_CAPACITY, const SizeType &bitsPerKey = BF_BITS_PER_KEY)
+        : m_blockCount(blockCountFor(capacity, bitsPerKey)), m_blocks(new Block[m_blockCount]()),
+          m_capacity(capacity)
+    {
+    }
+
+    // copy ctor
+    BloomFilter(const BloomFilter &other)
+        : m_blockCount(other.m_blockCount), m_blocks(new Block[other.m_blockCount]),
+          m_capacity(other.m_capacity), m_size(other.m_size)
+    {
+        std::copy(other.m_blocks, other.m_blocks + m_blockCount, m_blocks);
+    }
+
+    // move ctor, leaves other without blocks: it rejects every key until assigned to
+    BloomFilter(BloomFilter &&other) noexcept
+    {
+        swap(other);
+    }
+
+    ~BloomFilter()
+    {
+        delete[] m_blocks;
+    }
+
+    // copy assignment
+    BloomFilter &operator=(const BloomFilter &other)
+    {
+        if (this != &other)
+        {
+            BloomFilter copy(other);
+            swap(copy);
+        }
+        return *this;
+    }
+
+    // move assignment
+    BloomFilter &operator=(BloomFilter &&other) noexcept
+    {
+        if (this != &other)
+        {
+            BloomFilter moved(std::move(other));
+            swap(moved);
+        }
+        return *this;
+    }
+
+    void Insert(const Key &key)
+    {
+        InsertHash(detail::HashKey<Key>(key));
+    }
+
+    template <typename K>
+        requires isHeterogeneous<K>
+    void Insert(const K &key)
+    {
+        InsertHash(detail::HashKey<Key>(key));
+    }
+
+    bool MayContain(const Key &key) const
+    {
+        return MayContainHash(detail::HashKey<Key>(key));
+    }
+
+    template <typename K>
+        requires isHeterogeneous<K>
+    bool MayContain(const K &key) const
+    {
+        return MayContainHash(detail::HashKey<Key>(key));
+    }
+
+    /**
+     * @brief Insert and query by a hash already computed with detail::HashKey<Key>, as the hash tables do
+     *
+     * Lets a container that hashes the key anyway share that work with its filter.
+     */
+    void InsertHash(SizeType h)
+    {
+        if (!m_blockCount)
+        {
+            return;
+        }
+
+        Block &block = m_blocks[blockIndex(h)];
+        const uint32_t bits = bitSeed(h);
+
+        for (SizeType i = 0; i < BLOCK_WORDS; ++i)
+        {
+            block.words[i] |= bitOf(bits, i);
+        }
+        ++m_size;
+    }
+
+    bool MayContainHash(SizeType h) const
+    {
+        if (!m_blockCount)
+        {
+            return false;
+        }
+
+        const Block &block = m_blocks[blockIndex(h)];
+        const uint32_t bits = bitSeed(h);
+
+        // no early exit, the eight tests are independent and cheaper than a mispredicted branch
+        bool all = true;
+        for (SizeType i = 0; i < BLOCK_WORDS; ++i)
+        {
+            all &= (block.words[i] & bitOf(bits, i)) != 0;
+        }
+        return all;
+    }
+
+    void Clear()
+    {
+        std::fill(m_blocks, m_blocks + m_blockCount, Block{});
+        m_size = 0;
+    }
+
+    // number of inserts since the last Clear, keys inserted twice count twice
+    SizeType Size() const
+    {
+        return m_size;
+    }
+
+    bool Empty() const
+    {
+        return m_size == 0;
+    }
+
+    // number of keys the filter was sized for
+    SizeType Capacity() const
+    {
+        return m_capacity;
+    }
+
+    SizeType BlockCount() const
+    {
+        return m_blockCount;
+    }
+
+    SizeType SizeInBytes() const
+    {
+        return m_blockCount * sizeof(Block);
+    }
+
+  private:
+    static SizeType blockCountFor(SizeType capacity, SizeType bitsPerKey)
+    {
+        const SizeType bits = std::max(capacity, SizeType(1)) * std::max(bitsPerKey, SizeType(1));
+        return (bits + BLOCK_BITS - 1) / BLOCK_BITS;
+    }
+
+    // the block comes from the low half of the hash, the bits within it from the high half
+    SizeType blockIndex(SizeType h) const noexcept
+    {
+        return static_cast<SizeType>((static_cast<uint64_t>(static_cast<uint32_t>(h)) * m_blockCount) >> 32);
+    }
+
+    static uint32_t bitSeed(SizeType h) noexcept
+    {
+        return static_cast<uint32_t>(static_cast<uint64_t>(h) >> 32);
+    }
+
+    // one bit per word, from the top bits of the seed times an odd constant per word
+    static uint64_t bitOf(uint32_t seed, SizeType word) noexcept
+    {
+        static constexpr uint32_t SALT[BLOCK_WORDS] = {0x47b6137bu, 0x44974d91u, 0x8824ad5bu, 0xa2b7289du,
+                                                       0x705495c7u, 0x2df1424bu, 0x9efc4947u, 0x5c6bfb31u};
+        return uint64_t(1) << ((seed * SALT[word]) >> 26);
+    }
+
+    void swap(BloomFilter &other) noexcept
+    {
+        std::swap(m_blockCount, other.m_blockCount);
+        std::swap(m_blocks, other.m_blocks);
+        std::swap(m_capacity, other.m_capacity);
+        std::swap(m_size, other.m_size);
+    }
+
+  private:
+    SizeType m_blockCount = 0;
+    Block *m_blocks = nullptr;
+    SizeType m_capacity = 0;
+    SizeType m_size = 0;
+};
+
+} // namespace icb
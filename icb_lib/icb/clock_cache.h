@@ -0,0 +1,288 @@
+/**
+ * @file clock_cache.h
+ * @author Dovydas Ciomenas (icouldbreathe@icloud.com)
+ * @brief Thread-safe bounded cache, sharded, evicting with the CLOCK approximation of LRU
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#pragma once
+
+#include <assert.h>
+#include <atomic>
+#include <bit>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <utility>
+#include <vector>
+
+#include "concurrent_hash_table.h" // ICB_CACHE_LINE_SIZE
+#include "hash.h"
+#include "hash_table.h"
+
+#define CC_SHARD_COUNT 64
+
+namespace icb
+{
+/**
+ * @brief Bounded cache for many threads: shards like ConcurrentHashTable, evicts like CLOCK
+ *
+ * LRU has to move an entry on every hit, so even lookups need an exclusive lock. CLOCK gives every entry a reference
+ * bit instead: a hit only sets it, which Get does under the shard's shared lock, and only when it isn't set yet, so
+ * hot entries don't keep writing to their cache line. A Put into a full shard sweeps a hand over the entries,
+ * clearing set bits and evicting the first entry whose bit is already clear, one that wasn't used since the hand
+ * last passed it.
+ *
+ * The capacity is split evenly over the shards and every shard evicts on its own, so the cache as a whole only
+ * approximates its capacity and its eviction order. Lookups return copies (Get) or run a callback under the shard
+ * lock (Visit), as in ConcurrentHashTable.
+ */
+template <typename Key, typename Value> class ConcurrentClockCache
+{
+  public:
+    using SizeType = size_t;
+    using Entry = std::pair<Key, Value>;
+
+  private:
+    // entries sit in slots [0, size), the hand walks over them; the index maps a key to its slot
+    struct alignas(ICB_CACHE_LINE_SIZE) Shard
+    {
+        mutable std::shared_mutex mutex;
+        HashTable<Key, SizeType> index;
+        std::vector<Entry> entries;
+        std::unique_ptr<std::atomic<bool>[]> referenced;
+        SizeType capacity;
+        SizeType hand = 0;
+
+        Shard(SizeType capacity) : index(capacity), referenced(new std::atomic<bool>[capacity]()), capacity(capacity)
+        {
+            entries.reserve(capacity);
+        }
+    };
+
+  public:
+    /**
+     * @param capacity Split evenly over the shards, rounded up
+     * @param shardCount Rounded up to the next power of two
+     */
+    explicit ConcurrentClockCache(SizeType capacity, SizeType shardCount = CC_SHARD_COUNT)
+        : m_shardCount(std::bit_ceil(shardCount ? shardCount : SizeType(1))),
+          m_shardShift(static_cast<SizeType>(std::numeric_limits<SizeType>::digits - std::countr_zero(m_shardCount)))
+    {
+        assert(capacity > 0 && "ConcurrentClockCache capacity has to be positive");
+
+        const SizeType perShard = (capacity + m_shardCount - 1) / m_shardCount;
+        m_shards = static_cast<Shard *>(
+            ::operator new(m_shardCount * sizeof(Shard), std::align_val_t(alignof(Shard))));
+        for (SizeType i = 0; i < m_shardCount; ++i)
+        {
+            new (&m_shards[i]) Shard(perShard);
+        }
+    }
+
+    ~ConcurrentClockCache()
+    {
+        for (SizeType i = 0; i < m_shardCount; ++i)
+        {
+            m_shards[i].~Shard();
+        }
+        ::operator delete(m_shards, m_shardCount * sizeof(Shard), std::align_val_t(alignof(Shard)));
+    }
+
+    ConcurrentClockCache(const ConcurrentClockCache &) = delete;
+    ConcurrentClockCache &operator=(const ConcurrentClockCache &) = delete;
+
+    // returns a copy and marks the entry as used
+    std::optional<Value> Get(const Key &key) const
+    {
+        std::optional<Value> result;
+        Visit(key, [&](const Value &value) { result = value; });
+        return result;
+    }
+
+    /**
+     * @brief Calls fn(const Value &) under the shard's shared lock and marks the entry as used
+     *
+     * @return Whether the key was found
+     */
+    template <typename Fn> bool Visit(const Key &key, Fn &&fn) const
+    {
+        const Shard &shard = shardFor(key);
+        std::shared_lock lock(shard.mutex);
+
+        const SizeType *slot = shard.index.FindPtr(key);
+        if (!slot)
+        {
+            return false;
+        }
+
+        std::atomic<bool> &referenced = shard.referenced[*slot];
+        if (!referenced.load(std::memory_order_relaxed))
+        {
+            referenced.store(true, std::memory_order_relaxed);
+        }
+
+        fn(shard.entries[*slot].second);
+        return true;
+    }
+
+    // doesn't mark the entry as used
+    bool Contains(const Key &key) const
+    {
+        const Shard &shard = shardFor(key);
+        std::shared_lock lock(shard.mutex);
+        return shard.index.Contains(key);
+    }
+
+    /**
+     * @brief Inserts or assigns the value, evicting an entry of the key's shard if it is full
+     *
+     * @return Whether the key was inserted rather than assigned
+     */
+    template <typename K, typename V> bool Put(K &&key, V &&value)
+    {
+        Shard &shard = shardFor(key);
+        std::unique_lock lock(shard.mutex);
+
+        if (SizeType *slot = shard.index.FindPtr(key))
+        {
+            shard.entries[*slot].second = std::forward<V>(value);
+            shard.referenced[*slot].store(true, std::memory_order_relaxed);
+            return false;
+        }
+
+        SizeType slot;
+        if (shard.entries.size() < shard.capacity)
+        {
+            slot = shard.entries.size();
+            shard.entries.emplace_back(std::forward<K>(key), std::forward<V>(value));
+        }
+        else
+        {
+            slot = evict(shard);
+            shard.entries[slot].first = std::forward<K>(key);
+            shard.entries[slot].second = std::forward<V>(value);
+        }
+
+        // starts unreferenced, it survives until the hand comes around, a hit before then protects it once more
+        shard.referenced[slot].store(false, std::memory_order_relaxed);
+        shard.index.Insert(shard.entries[slot].first, slot);
+        return true;
+    }
+
+    void Erase(const Key &key)
+    {
+        Shard &shard = shardFor(key);
+        std::unique_lock lock(shard.mutex);
+
+        const SizeType *found = shard.index.FindPtr(key);
+        if (!found)
+        {
+            return;
+        }
+
+        // the last entry fills the hole, so the slots stay dense
+        const SizeType slot = *found;
+        const SizeType last = shard.entries.size() - 1;
+        shard.index.Erase(key);
+
+        if (slot != last)
+        {
+            shard.entries[slot] = std::move(shard.entries[last]);
+            shard.referenced[slot].store(shard.referenced[last].load(std::memory_order_relaxed),
+                                         std::memory_order_relaxed);
+            *shard.index.FindPtr(shard.entries[slot].first) = slot;
+        }
+        shard.entries.pop_back();
+
+        if (shard.hand >= shard.entries.size())
+        {
+            shard.hand = 0;
+        }
+    }
+
+    // locks one shard at a time, so it isn't atomic with respect to concurrent puts
+    void Clear()
+    {
+        for (SizeType i = 0; i < m_shardCount; ++i)
+        {
+            std::unique_lock lock(m_shards[i].mutex);
+            m_shards[i].index.Clear();
+            m_shards[i].entries.clear();
+            m_shards[i].hand = 0;
+        }
+    }
+
+    // a snapshot, concurrent writers may change it while the shards are summed up
+    SizeType Size() const
+    {
+        SizeType size = 0;
+        for (SizeType i = 0; i < m_shardCount; ++i)
+        {
+            std::shared_lock lock(m_shards[i].mutex);
+            size += m_shards[i].entries.size();
+        }
+        return size;
+    }
+
+    bool Empty() const
+    {
+        return Size() == 0;
+    }
+
+    // the shard capacity times the shard count, which can be a little more than asked for
+    SizeType Capacity() const noexcept
+    {
+        return m_shards[0].capacity * m_shardCount;
+    }
+
+    SizeType ShardCount() const noexcept
+    {
+        return m_shardCount;
+    }
+
+    SizeType ShardIndex(const Key &key) const noexcept
+    {
+        // shifting by the full width would be undefined for a single shard
+        return m_shardCount == 1 ? 0 : detail::HashKey<Key>(key) >> m_shardShift;
+    }
+
+  private:
+    // advances the hand to the first unreferenced entry, clearing the bits it passes, and drops that entry's key
+    static SizeType evict(Shard &shard)
+    {
+        while (shard.referenced[shard.hand].load(std::memory_order_relaxed))
+        {
+            shard.referenced[shard.hand].store(false, std::memory_order_relaxed);
+            shard.hand = shard.hand + 1 == shard.entries.size() ? 0 : shard.hand + 1;
+        }
+
+        const SizeType victim = shard.hand;
+        shard.hand = shard.hand + 1 == shard.entries.size() ? 0 : shard.hand + 1;
+        shard.index.Erase(shard.entries[victim].first);
+        return victim;
+    }
+
+    Shard &shardFor(const Key &key) noexcept
+    {
+        return m_shards[ShardIndex(key)];
+    }
+
+    const Shard &shardFor(const Key &key) const noexcept
+    {
+        return m_shards[ShardIndex(key)];
+    }
+
+  private:
+    SizeType m_shardCount;
+    SizeType m_shardShift;
+    Shard *m_shards = nullptr;
+};
+
+} // namespace icb
@@ -0,0 +1,264 @@
+/**
+ * @file concurrent_hash_table.h
+ * @author Dovydas Ciomenas (icouldbreathe@icloud.com)
+ * @brief Thread-safe hash table (map) sharded over independently locked HashTables
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#pragma once
+
+#include <assert.h>
+#include <bit>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+
+#include "hash.h"
+#include "hash_table.h"
+
+#define CHT_SHARD_COUNT 64
+#define ICB_CACHE_LINE_SIZE 64
+
+namespace icb
+{
+/**
+ * @brief Splits the key space over a power-of-two number of HashTable shards, each behind its own reader/writer lock
+ *
+ * Readers of the same shard don't block each other, and operations on different shards don't touch shared cache
+ * lines. The shard is picked from the high bits of the key's hash, while the shard's own buckets use the low bits,
+ * so the two choices stay independent.
+ *
+ * Lookups return copies (Find) or run a callback under the shard lock (Visit, Update): handing out pointers into
+ * a shard would outlive the lock.
+ */
+template <typename Key, typename Value> class ConcurrentHashTable
+{
+  public:
+    using SizeType = size_t;
+    using Table = icb::HashTable<Key, Value>;
+
+  private:
+    template <typename K> static constexpr bool isHeterogeneous = detail::IsHeterogeneous<Key, K>;
+
+    // one per cache line, so locking a shard doesn't invalidate its neighbours
+    struct alignas(ICB_CACHE_LINE_SIZE) Shard
+    {
+        mutable std::shared_mutex mutex;
+        Table table;
+
+        Shard(SizeType capacity) : table(capacity)
+        {
+        }
+    };
+
+  public:
+    /**
+     * @param shardCount Rounded up to the next power of two, a few times the thread count is a good start
+     * @param capacityPerShard Initial bucket count of every shard
+     */
+    ConcurrentHashTable(SizeType shardCount = CHT_SHARD_COUNT, SizeType capacityPerShard = HT_INIT_CAPACITY)
+        : m_shardCount(std::bit_ceil(shardCount ? shardCount : SizeType(1))),
+          m_shardShift(static_cast<SizeType>(std::numeric_limits<SizeType>::digits - std::countr_zero(m_shardCount)))
+    {
+        m_shards = static_cast<Shard *>(
+            ::operator new(m_shardCount * sizeof(Shard), std::align_val_t(alignof(Shard))));
+        for (SizeType i = 0; i < m_shardCount; ++i)
+        {
+            new (&m_shards[i]) Shard(capacityPerShard);
+        }
+    }
+
+    ~ConcurrentHashTable()
+    {
+        for (SizeType i = 0; i < m_shardCount; ++i)
+        {
+            m_shards[i].~Shard();
+        }
+        ::operator delete(m_shards, m_shardCount * sizeof(Shard), std::align_val_t(alignof(Shard)));
+    }
+
+    ConcurrentHashTable(const ConcurrentHashTable &) = delete;
+    ConcurrentHashTable &operator=(const ConcurrentHashTable &) = delete;
+
+    // copy
+    void Insert(const Key &key, const Value &value)
+    {
+        Shard &shard = shardFor(key);
+        std::unique_lock lock(shard.mutex);
+        shard.table.Insert(key, value);
+    }
+
+    // move
+    void Insert(Key &&key, Value &&value)
+    {
+        Shard &shard = shardFor(key);
+        std::unique_lock lock(shard.mutex);
+        shard.table.Insert(std::move(key), std::move(value));
+    }
+
+    // returns whether the value was inserted
+    template <typename K, typename... Args> bool TryEmplace(K &&key, Args &&...args)
+    {
+        Shard &shard = shardFor(key);
+        std::unique_lock lock(shard.mutex);
+        return shard.table.TryEmplace(std::forward<K>(key), std::forward<Args>(args)...).second;
+    }
+
+    // returns whether the value was inserted rather than assigned
+    template <typename K, typename V> bool InsertOrAssign(K &&key, V &&value)
+    {
+        Shard &shard = shardFor(key);
+        std::unique_lock lock(shard.mutex);
+        return shard.table.InsertOrAssign(std::forward<K>(key), std::forward<V>(value)).second;
+    }
+
+    std::optional<Value> Find(const Key &key) const
+    {
+        const Shard &shard = shardFor(key);
+        std::shared_lock lock(shard.mutex);
+        return shard.table.Find(key);
+    }
+
+    template <typename K>
+        requires isHeterogeneous<K>
+    std::optional<Value> Find(const K &key) const
+    {
+        const Shard &shard = shardFor(key);
+        std::shared_lock lock(shard.mutex);
+        return shard.table.Find(key);
+    }
+
+    template <typename K> bool Contains(const K &key) const
+    {
+        const Shard &shard = shardFor(key);
+        std::shared_lock lock(shard.mutex);
+        return shard.table.Contains(key);
+    }
+
+    /**
+     * @brief Calls fn(const Value &) under the shard's shared lock, avoiding the copy Find makes
+     *
+     * @return Whether the key was found
+     */
+    template <typename K, typename Fn> bool Visit(const K &key, Fn &&fn) const
+    {
+        const Shard &shard = shardFor(key);
+        std::shared_lock lock(shard.mutex);
+
+        const Value *value = shard.table.FindPtr(key);
+        if (value)
+        {
+            fn(*value);
+        }
+        return value != nullptr;
+    }
+
+    /**
+     * @brief Calls fn(Value &) under the shard's exclusive lock, for read-modify-write updates
+     *
+     * @return Whether the key was found
+     */
+    template <typename K, typename Fn> bool Update(const K &key, Fn &&fn)
+    {
+        Shard &shard = shardFor(key);
+        std::unique_lock lock(shard.mutex);
+
+        Value *value = shard.table.FindPtr(key);
+        if (value)
+        {
+            fn(*value);
+        }
+        return value != nullptr;
+    }
+
+    template <typename K> void Erase(const K &key)
+    {
+        Shard &shard = shardFor(key);
+        std::unique_lock lock(shard.mutex);
+        shard.table.Erase(key);
+    }
+
+    // locks one shard at a time, so it isn't atomic with respect to concurrent inserts
+    void Clear()
+    {
+        for (SizeType i = 0; i < m_shardCount; ++i)
+        {
+            std::unique_lock lock(m_shards[i].mutex);
+            m_shards[i].table.Clear();
+        }
+    }
+
+    /**
+     * @brief Rehashes every shard to an equal share of totalCapacity, one shard at a time
+     *
+     * Only the shard being rehashed is locked, the others keep serving requests.
+     */
+    void Rehash(SizeType totalCapacity)
+    {
+        SizeType perShard = totalCapacity / m_shardCount;
+        for (SizeType i = 0; i < m_shardCount; ++i)
+        {
+            RehashShard(i, perShard ? perShard : 1);
+        }
+    }
+
+    void RehashShard(SizeType shardIndex, SizeType capacity)
+    {
+        assert(shardIndex < m_shardCount && "ConcurrentHashTable::RehashShard shard index out of range");
+
+        std::unique_lock lock(m_shards[shardIndex].mutex);
+        m_shards[shardIndex].table.Rehash(capacity);
+    }
+
+    // a snapshot, concurrent writers may change it while the shards are summed up
+    SizeType Size() const
+    {
+        SizeType size = 0;
+        for (SizeType i = 0; i < m_shardCount; ++i)
+        {
+            std::shared_lock lock(m_shards[i].mutex);
+            size += m_shards[i].table.Size();
+        }
+        return size;
+    }
+
+    bool Empty() const
+    {
+        return Size() == 0;
+    }
+
+    SizeType ShardCount() const noexcept
+    {
+        return m_shardCount;
+    }
+
+    template <typename K> SizeType ShardIndex(const K &key) const noexcept
+    {
+        // shifting by the full width would be undefined for a single shard
+        return m_shardCount == 1 ? 0 : detail::HashKey<Key>(key) >> m_shardShift;
+    }
+
+  private:
+    template <typename K> Shard &shardFor(const K &key) noexcept
+    {
+        return m_shards[ShardIndex(key)];
+    }
+
+    template <typename K> const Shard &shardFor(const K &key) const noexcept
+    {
+        return m_shards[ShardIndex(key)];
+    }
+
+  private:
+    SizeType m_shardCount;
+    SizeType m_shardShift;
+    Shard *m_shards = nullptr;
+};
+
+} // namespace icb
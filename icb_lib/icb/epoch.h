@@ -0,0 +1,250 @@
+/**
+ * @file epoch.h
+ * @author Dovydas Ciomenas (icouldbreathe@icloud.com)
+ * @brief Epoch-based memory reclamation for lock-free readers
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#pragma once
+
+#include <assert.h>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <stdexcept>
+
+#include "vector.h"
+
+#define ICB_EPOCH_MAX_THREADS 256
+#define ICB_EPOCH_RECLAIM_THRESHOLD 64 // retired objects that trigger a reclaim attempt
+
+namespace icb
+{
+/**
+ * @brief Process-wide epoch manager
+ *
+ * Readers Pin() the manager around every access to shared nodes; pinning is a plain store to the thread's own slot
+ * and a fence, no locks or read-modify-write operations. Writers unlink nodes first and then Retire() them, and a
+ * retired node is freed once every reader that was pinned when it got retired has unpinned.
+ *
+ * Each thread that pins takes one of ICB_EPOCH_MAX_THREADS slots, released again when the thread exits.
+ */
+class EpochManager
+{
+  private:
+    struct Retired
+    {
+        void *ptr;
+        void (*deleter)(void *);
+        uint64_t epoch;
+    };
+
+    // one per cache line, every reader only ever writes its own
+    struct alignas(64) Slot
+    {
+        std::atomic<uint64_t> epoch{0}; // 0 while not pinned
+        std::atomic<bool> inUse{false};
+    };
+
+    struct ThreadRecord
+    {
+        Slot *slot = nullptr;
+        uint32_t depth = 0;
+
+        ~ThreadRecord()
+        {
+            if (slot)
+            {
+                slot->epoch.store(0, std::memory_order_release);
+                slot->inUse.store(false, std::memory_order_release);
+            }
+        }
+    };
+
+  public:
+    class Guard
+    {
+      public:
+        explicit Guard(EpochManager &manager) : m_manager(manager)
+        {
+            m_manager.enter();
+        }
+
+        ~Guard()
+        {
+            m_manager.exit();
+        }
+
+        Guard(const Guard &) = delete;
+        Guard &operator=(const Guard &) = delete;
+
+      private:
+        EpochManager &m_manager;
+    };
+
+  public:
+    static EpochManager &Get()
+    {
+        static EpochManager instance;
+        return instance;
+    }
+
+    ~EpochManager()
+    {
+        // no readers are left at static destruction time
+        for (SizeType i = 0; i < m_retired.Size(); ++i)
+        {
+            m_retired[i].deleter(m_retired[i].ptr);
+        }
+    }
+
+    EpochManager(const EpochManager &) = delete;
+    EpochManager &operator=(const EpochManager &) = delete;
+
+    /**
+     * @brief Protects everything reachable from shared pointers loaded until the guard is destroyed
+     *
+     * Guards nest, only the outermost one publishes an epoch.
+     */
+    [[nodiscard]] Guard Pin()
+    {
+        return Guard(*this);
+    }
+
+    /**
+     * @brief Frees ptr with deleter once no reader can still hold it
+     *
+     * ptr must already be unreachable for readers that pin from now on.
+     */
+    void Retire(void *ptr, void (*deleter)(void *))
+    {
+        std::lock_guard lock(m_retireMutex);
+
+        // readers that pin after this increment can't reach ptr anymore
+        uint64_t epoch = m_globalEpoch.fetch_add(1, std::memory_order_acq_rel);
+        m_retired.PushBack(Retired{ptr, deleter, epoch});
+
+        if (m_retired.Size() >= m_reclaimAt)
+        {
+            reclaimLocked();
+
+            // don't rescan on every retire while readers hold an old epoch
+            m_reclaimAt = m_retired.Size() + ICB_EPOCH_RECLAIM_THRESHOLD;
+        }
+    }
+
+    // frees whatever no pinned reader can reach anymore
+    void Reclaim()
+    {
+        std::lock_guard lock(m_retireMutex);
+        reclaimLocked();
+        m_reclaimAt = m_retired.Size() + ICB_EPOCH_RECLAIM_THRESHOLD;
+    }
+
+    // retired objects that haven't been freed yet
+    size_t Pending()
+    {
+        std::lock_guard lock(m_retireMutex);
+        return m_retired.Size();
+    }
+
+  private:
+    using SizeType = size_t;
+
+    EpochManager() = default;
+
+    void enter()
+    {
+        ThreadRecord &record = threadRecord();
+        if (record.depth++ == 0)
+        {
+            record.slot->epoch.store(m_globalEpoch.load(std::memory_order_acquire), std::memory_order_relaxed);
+
+            /*
+             * Pairs with the fence in reclaimLocked(): either the writer sees this slot as pinned,
+             * or this reader sees the writer's unlink and can't reach the retired node.
+             */
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+        }
+    }
+
+    void exit()
+    {
+        ThreadRecord &record = threadRecord();
+        assert(record.depth > 0 && "EpochManager::exit without a matching enter");
+        if (--record.depth == 0)
+        {
+            record.slot->epoch.store(0, std::memory_order_release);
+        }
+    }
+
+    ThreadRecord &threadRecord()
+    {
+        static thread_local ThreadRecord record;
+
+        if (!record.slot)
+        {
+            record.slot = claimSlot();
+        }
+        return record;
+    }
+
+    Slot *claimSlot()
+    {
+        for (SizeType i = 0; i < ICB_EPOCH_MAX_THREADS; ++i)
+        {
+            bool expected = false;
+            if (!m_slots[i].inUse.load(std::memory_order_relaxed) &&
+                m_slots[i].inUse.compare_exchange_strong(expected, true, std::memory_order_acq_rel))
+            {
+                return &m_slots[i];
+            }
+        }
+        throw std::runtime_error("EpochManager: more than ICB_EPOCH_MAX_THREADS threads pinned at once");
+    }
+
+    void reclaimLocked()
+    {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        // the oldest epoch some reader is still pinned at
+        uint64_t oldest = UINT64_MAX;
+        for (SizeType i = 0; i < ICB_EPOCH_MAX_THREADS; ++i)
+        {
+            uint64_t epoch = m_slots[i].epoch.load(std::memory_order_acquire);
+            if (epoch && epoch < oldest)
+            {
+                oldest = epoch;
+            }
+        }
+
+        // a reader pinned at epoch e may hold anything retired at epoch >= e
+        SizeType kept = 0;
+        for (SizeType i = 0; i < m_retired.Size(); ++i)
+        {
+            if (m_retired[i].epoch < oldest)
+            {
+                m_retired[i].deleter(m_retired[i].ptr);
+            }
+            else
+            {
+                m_retired[kept++] = m_retired[i];
+            }
+        }
+        m_retired.Resize(kept);
+    }
+
+  private:
+    Slot m_slots[ICB_EPOCH_MAX_THREADS];
+    alignas(64) std::atomic<uint64_t> m_globalEpoch{1};
+
+    std::mutex m_retireMutex;
+    icb::Vector<Retired> m_retired;
+    SizeType m_reclaimAt = ICB_EPOCH_RECLAIM_THRESHOLD;
+};
+
+} // namespace icb
@@ -0,0 +1,263 @@
+/**
+ * @file filtered_hash_table.h
+ * @author Dovydas Ciomenas (icouldbreathe@icloud.com)
+ * @brief HashTable behind a BloomFilter, for workloads where most lookups miss
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <initializer_list>
+#include <optional>
+#include <utility>
+
+#include "bloom_filter.h"
+#include "hash.h"
+#include "hash_table.h"
+
+namespace icb
+{
+/**
+ * @brief HashTable whose lookups first ask a BloomFilter, so most misses end after one cache line
+ *
+ * Every key inserted into the table goes into the filter too. The table hashes with icb::Hash, the same hash the
+ * filter takes, so inserts and lookups compute it once and hand it to both. A miss the filter rules out never
+ * reaches the bucket array or walks a chain.
+ *
+ * The filter can't forget keys: an erased key keeps its bits and only costs false positives. Stale keys count
+ * against the filter's capacity like live ones, and once live plus stale keys outgrow it, the filter is rebuilt
+ * from the table, sized for twice the live keys. Growth and erasures are paid for by the same amortized rebuild.
+ *
+ * Only worth it when nearly all lookups miss. A hit pays for the filter on top of the table, and once hits are
+ * common the filter's answer is a branch the CPU can't predict, which stops it from overlapping the cache misses of
+ * consecutive lookups (bench_bloom_filter shows the break-even around a few percent hits).
+ */
+template <typename Key, typename Value> class FilteredHashTable
+{
+  public:
+    using SizeType = size_t;
+    using Pair = std::pair<Key, Value>;
+    using Table = HashTable<Key, Value>;
+    using Filter = BloomFilter<Key>;
+    using ConstIterator = typename Table::ConstIterator;
+
+  private:
+    template <typename K> static constexpr bool isHeterogeneous = detail::IsHeterogeneous<Key, K>;
+
+  public:
+    FilteredHashTable(const SizeType &capacity = HT_INIT_CAPACITY, const SizeType &bitsPerKey = BF_BITS_PER_KEY)
+        : m_table(capacity), m_filter(capacity, bitsPerKey), m_bitsPerKey(bitsPerKey)
+    {
+    }
+
+    FilteredHashTable(std::initializer_list<Pair> il, const SizeType &capacity = HT_INIT_CAPACITY)
+        : FilteredHashTable(std::max(capacity, il.size()))
+    {
+        for (const auto &[key, value] : il)
+        {
+            Insert(key, value);
+        }
+    }
+
+    // copy
+    void Insert(const Key &key, const Value &value)
+    {
+        TryEmplace(key, value);
+    }
+
+    // move
+    void Insert(Key &&key, Value &&value)
+    {
+        TryEmplace(std::move(key), std::move(value));
+    }
+
+    template <typename K, typename... Args> std::pair<Value *, bool> TryEmplace(K &&key, Args &&...args)
+    {
+        const SizeType h = detail::HashKey<Key>(key);
+        return added(h, m_table.tryEmplaceHashed(h, std::forward<K>(key), std::forward<Args>(args)...));
+    }
+
+    template <typename K, typename V> std::pair<Value *, bool> InsertOrAssign(K &&key, V &&value)
+    {
+        const SizeType h = detail::HashKey<Key>(key);
+        return added(h, m_table.insertOrAssignHashed(h, std::forward<K>(key), std::forward<V>(value)));
+    }
+
+    // default-constructs the value if the key is missing
+    Value &operator[](const Key &key)
+    {
+        return *TryEmplace(key).first;
+    }
+
+    Value &operator[](Key &&key)
+    {
+        return *TryEmplace(std::move(key)).first;
+    }
+
+    // returns a copy, use FindPtr to avoid it
+    std::optional<Value> Find(const Key &key) const
+    {
+        const Value *value = FindPtr(key);
+
+        if (value)
+        {
+            return *value;
+        }
+        return std::nullopt;
+    }
+
+    template <typename K>
+        requires isHeterogeneous<K>
+    std::optional<Value> Find(const K &key) const
+    {
+        const Value *value = FindPtr(key);
+
+        if (value)
+        {
+            return *value;
+        }
+        return std::nullopt;
+    }
+
+    Value *FindPtr(const Key &key)
+    {
+        return findPtr(m_table, m_filter, key);
+    }
+
+    const Value *FindPtr(const Key &key) const
+    {
+        return findPtr(m_table, m_filter, key);
+    }
+
+    template <typename K>
+        requires isHeterogeneous<K>
+    Value *FindPtr(const K &key)
+    {
+        return findPtr(m_table, m_filter, key);
+    }
+
+    template <typename K>
+        requires isHeterogeneous<K>
+    const Value *FindPtr(const K &key) const
+    {
+        return findPtr(m_table, m_filter, key);
+    }
+
+    bool Contains(const Key &key) const
+    {
+        return FindPtr(key) != nullptr;
+    }
+
+    template <typename K>
+        requires isHeterogeneous<K>
+    bool Contains(const K &key) const
+    {
+        return FindPtr(key) != nullptr;
+    }
+
+    // the key's bits stay set until the filter is rebuilt
+    void Erase(const Key &key)
+    {
+        m_table.Erase(key);
+    }
+
+    template <typename K>
+        requires isHeterogeneous<K>
+    void Erase(const K &key)
+    {
+        m_table.Erase(key);
+    }
+
+    void Clear()
+    {
+        m_table.Clear();
+        m_filter.Clear();
+    }
+
+    ConstIterator begin() const noexcept
+    {
+        return m_table.begin();
+    }
+
+    ConstIterator end() const noexcept
+    {
+        return m_table.end();
+    }
+
+    ConstIterator cbegin() const noexcept
+    {
+        return m_table.cbegin();
+    }
+
+    ConstIterator cend() const noexcept
+    {
+        return m_table.cend();
+    }
+
+    const Table &GetTable() const
+    {
+        return m_table;
+    }
+
+    const Filter &GetFilter() const
+    {
+        return m_filter;
+    }
+
+    bool Empty() const
+    {
+        return m_table.Empty();
+    }
+
+    SizeType Size() const
+    {
+        return m_table.Size();
+    }
+
+  private:
+    // shared by the const and non-const lookups, Self carries the constness
+    template <typename Self, typename K> static auto findPtr(Self &table, const Filter &filter, const K &key)
+    {
+        const SizeType h = detail::HashKey<Key>(key);
+        return filter.MayContainHash(h) ? table.findPtrHashed(key, h) : nullptr;
+    }
+
+    std::pair<Value *, bool> added(SizeType h, std::pair<Value *, bool> result)
+    {
+        if (result.second)
+        {
+            if (m_filter.Size() >= m_filter.Capacity())
+            {
+                rebuildFilter();
+            }
+            else
+            {
+                m_filter.InsertHash(h);
+            }
+        }
+        return result;
+    }
+
+    // the new key is already in the table, so the rebuild picks it up
+    void rebuildFilter()
+    {
+        Filter filter(std::max(m_table.Size() * 2, SizeType(HT_INIT_CAPACITY)), m_bitsPerKey);
+        for (auto it = m_table.cbegin(); it != m_table.cend(); ++it)
+        {
+            filter.Insert(it->first);
+        }
+        m_filter = std::move(filter);
+    }
+
+  private:
+    Table m_table;
+    Filter m_filter;
+    SizeType m_bitsPerKey;
+};
+
+} // namespace icb
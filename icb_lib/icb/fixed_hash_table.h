@@ -0,0 +1,433 @@
+/**
+ * @file fixed_hash_table.h
+ * @author Dovydas Ciomenas (icouldbreathe@icloud.com)
+ * @brief Fixed-capacity hash table (map) stored inside the object, never allocates
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#pragma once
+
+#include <assert.h>
+#include <bit>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <optional>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+
+#include <utility> // std::pair
+
+#include "hash.h"
+
+namespace icb
+{
+/**
+ * @brief Open addressing over a fixed array of slots inside the object, for at most N elements
+ *
+ * Robin Hood linear probing with backward-shift deletion, as in RobinHoodHashTable, over SLOT_COUNT slots: the next
+ * power of two above 1.5 N, so the load factor stays under 2/3 and probe sequences stay short. There is no rehash
+ * and no allocation, the cost of an operation only depends on how many elements share its probe sequence. Inserting
+ * a new key into a full table throws std::length_error.
+ *
+ * Every slot holds a Pair from the start, the empty ones default constructed, so Key and Value have to be default
+ * constructible. Erase assigns a default constructed Pair over the freed slot. When Key, Value, Hasher and KeyEqual
+ * are usable in constant expressions (integer keys with icb::Hash, for one), so is the whole table.
+ *
+ * Elements move on insert and erase: pointers from FindPtr and iterators are only valid until the next modification.
+ */
+template <typename Key, typename Value, size_t N, typename Hasher = Hash<Key>, typename KeyEqual = std::equal_to<>>
+class FixedHashTable
+{
+  public:
+    using SizeType = size_t;
+    using Pair = std::pair<Key, Value>;
+
+    static_assert(N > 0, "FixedHashTable needs room for at least one element");
+    static_assert(std::is_default_constructible_v<Pair>,
+                  "FixedHashTable keys and values have to be default constructible");
+
+    static constexpr SizeType SLOT_COUNT = std::bit_ceil(N + N / 2 + 1);
+
+  private:
+    // psl is the probe sequence length + 1, 0 for an empty slot
+    struct Slot
+    {
+        uint32_t psl = 0;
+        Pair pair{};
+    };
+
+    static constexpr SizeType NPOS = static_cast<SizeType>(-1);
+    static constexpr SizeType MASK = SLOT_COUNT - 1;
+
+    /**
+     * @brief Forward iterator over the elements, in slot order
+     *
+     * The key must not be modified through it.
+     */
+    template <typename AccessType = Pair> class BaseIterator
+    {
+      public:
+        using iterator_category = std::forward_iterator_tag;
+        using difference_type = std::ptrdiff_t;
+        using value_type = Pair;
+        using pointer = std::conditional_t<std::is_const_v<AccessType>, const Pair *, Pair *>;
+        using reference = std::conditional_t<std::is_const_v<AccessType>, const Pair &, Pair &>;
+        using self_type = BaseIterator<AccessType>;
+        using slot_ptr = std::conditional_t<std::is_const_v<AccessType>, const Slot *, Slot *>;
+
+      public:
+        BaseIterator() = default;
+
+        // implicit conversion from Iterator to ConstIterator
+        template <typename WasAccessType,
+                  class = std::enable_if_t<std::is_const_v<AccessType> && !std::is_const_v<WasAccessType>>>
+        constexpr BaseIterator(const BaseIterator<WasAccessType> &other) noexcept
+            : m_slot(other.m_slot), m_end(other.m_end)
+        {
+        }
+
+        // prefix ++
+        constexpr self_type &operator++() noexcept
+        {
+            ++m_slot;
+            skipEmpty();
+            return *this;
+        }
+
+        // postfix ++
+        constexpr self_type operator++(int) noexcept
+        {
+            self_type previous = *this;
+            ++*this;
+            return previous;
+        }
+
+        constexpr reference operator*() const
+        {
+            assert(m_slot != m_end && "FixedHashTable::Iterator::operator* end dereference");
+            return m_slot->pair;
+        }
+
+        constexpr pointer operator->() const
+        {
+            return &m_slot->pair;
+        }
+
+        friend constexpr bool operator==(const self_type &x, const self_type &y) noexcept
+        {
+            return x.m_slot == y.m_slot;
+        }
+
+        friend constexpr bool operator!=(const self_type &x, const self_type &y) noexcept
+        {
+            return x.m_slot != y.m_slot;
+        }
+
+        friend class FixedHashTable;
+        template <typename> friend class BaseIterator;
+
+      private:
+        constexpr BaseIterator(slot_ptr slot, slot_ptr end) noexcept : m_slot(slot), m_end(end)
+        {
+            skipEmpty();
+        }
+
+        constexpr void skipEmpty() noexcept
+        {
+            while (m_slot != m_end && !m_slot->psl)
+            {
+                ++m_slot;
+            }
+        }
+
+      private:
+        slot_ptr m_slot = nullptr;
+        slot_ptr m_end = nullptr;
+    };
+
+  public:
+    using Iterator = BaseIterator<Pair>;
+    using ConstIterator = BaseIterator<const Pair>;
+
+  public:
+    constexpr FixedHashTable(const Hasher &hasher = Hasher(), const KeyEqual &keyEqual = KeyEqual())
+        : m_hasher(hasher), m_keyEqual(keyEqual)
+    {
+    }
+
+    constexpr FixedHashTable(std::initializer_list<Pair> il) : FixedHashTable()
+    {
+        for (const auto &[key, value] : il)
+        {
+            Insert(key, value);
+        }
+    }
+
+    // copy
+    constexpr void Insert(const Key &key, const Value &value)
+    {
+        tryEmplace(key, value);
+    }
+
+    // move
+    constexpr void Insert(Key &&key, Value &&value)
+    {
+        tryEmplace(std::move(key), std::move(value));
+    }
+
+    /**
+     * @brief Constructs the value from args, unless the key is already present
+     *
+     * @return Pointer to the value stored under key and whether it was inserted
+     */
+    template <typename... Args> constexpr std::pair<Value *, bool> TryEmplace(const Key &key, Args &&...args)
+    {
+        return tryEmplace(key, std::forward<Args>(args)...);
+    }
+
+    template <typename... Args> constexpr std::pair<Value *, bool> TryEmplace(Key &&key, Args &&...args)
+    {
+        return tryEmplace(std::move(key), std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Inserts the value, or assigns it over the existing one
+     *
+     * @return Pointer to the value stored under key and whether it was inserted
+     */
+    template <typename V> constexpr std::pair<Value *, bool> InsertOrAssign(const Key &key, V &&value)
+    {
+        return insertOrAssign(key, std::forward<V>(value));
+    }
+
+    template <typename V> constexpr std::pair<Value *, bool> InsertOrAssign(Key &&key, V &&value)
+    {
+        return insertOrAssign(std::move(key), std::forward<V>(value));
+    }
+
+    // default-constructs the value if the key is missing
+    constexpr Value &operator[](const Key &key)
+    {
+        return *tryEmplace(key).first;
+    }
+
+    constexpr Value &operator[](Key &&key)
+    {
+        return *tryEmplace(std::move(key)).first;
+    }
+
+    constexpr std::optional<Value> Find(const Key &key) const
+    {
+        const SizeType index = findIndex(key);
+        if (index == NPOS)
+        {
+            return std::nullopt;
+        }
+        return m_slots[index].pair.second;
+    }
+
+    // nullptr when the key is missing, valid until the next modification
+    constexpr Value *FindPtr(const Key &key)
+    {
+        const SizeType index = findIndex(key);
+        return index == NPOS ? nullptr : &m_slots[index].pair.second;
+    }
+
+    constexpr const Value *FindPtr(const Key &key) const
+    {
+        const SizeType index = findIndex(key);
+        return index == NPOS ? nullptr : &m_slots[index].pair.second;
+    }
+
+    constexpr bool Contains(const Key &key) const
+    {
+        return findIndex(key) != NPOS;
+    }
+
+    // shifts the rest of the cluster back by one slot, no tombstones
+    constexpr void Erase(const Key &key)
+    {
+        SizeType index = findIndex(key);
+        if (index == NPOS)
+        {
+            return;
+        }
+
+        for (SizeType next = (index + 1) & MASK; m_slots[next].psl > 1; index = next, next = (next + 1) & MASK)
+        {
+            m_slots[index].pair = std::move(m_slots[next].pair);
+            m_slots[index].psl = m_slots[next].psl - 1;
+        }
+        m_slots[index].pair = Pair();
+        m_slots[index].psl = 0;
+        --m_size;
+    }
+
+    // visits every slot, O(SLOT_COUNT)
+    constexpr void Clear()
+    {
+        for (Slot &slot : m_slots)
+        {
+            if (slot.psl)
+            {
+                slot.pair = Pair();
+                slot.psl = 0;
+            }
+        }
+        m_size = 0;
+    }
+
+    constexpr Iterator begin() noexcept
+    {
+        return Iterator(m_slots, m_slots + SLOT_COUNT);
+    }
+
+    constexpr Iterator end() noexcept
+    {
+        return Iterator(m_slots + SLOT_COUNT, m_slots + SLOT_COUNT);
+    }
+
+    constexpr ConstIterator begin() const noexcept
+    {
+        return ConstIterator(m_slots, m_slots + SLOT_COUNT);
+    }
+
+    constexpr ConstIterator end() const noexcept
+    {
+        return ConstIterator(m_slots + SLOT_COUNT, m_slots + SLOT_COUNT);
+    }
+
+    constexpr ConstIterator cbegin() const noexcept
+    {
+        return begin();
+    }
+
+    constexpr ConstIterator cend() const noexcept
+    {
+        return end();
+    }
+
+    constexpr bool Empty() const
+    {
+        return !m_size;
+    }
+
+    constexpr bool Full() const
+    {
+        return m_size == N;
+    }
+
+    constexpr SizeType Size() const
+    {
+        return m_size;
+    }
+
+    // the most elements the table holds
+    constexpr SizeType Capacity() const
+    {
+        return N;
+    }
+
+    constexpr SizeType BucketCount() const
+    {
+        return SLOT_COUNT;
+    }
+
+    constexpr float LoadFactor() const
+    {
+        return static_cast<float>(m_size) / static_cast<float>(SLOT_COUNT);
+    }
+
+  private:
+    template <typename K, typename... Args> constexpr std::pair<Value *, bool> tryEmplace(K &&key, Args &&...args)
+    {
+        const SizeType index = findIndex(key);
+        if (index != NPOS)
+        {
+            return {&m_slots[index].pair.second, false};
+        }
+
+        return {&emplaceNew(Pair(std::piecewise_construct, std::forward_as_tuple(std::forward<K>(key)),
+                                 std::forward_as_tuple(std::forward<Args>(args)...))),
+                true};
+    }
+
+    template <typename K, typename V> constexpr std::pair<Value *, bool> insertOrAssign(K &&key, V &&value)
+    {
+        const SizeType index = findIndex(key);
+        if (index != NPOS)
+        {
+            m_slots[index].pair.second = std::forward<V>(value);
+            return {&m_slots[index].pair.second, false};
+        }
+
+        return {&emplaceNew(Pair(std::forward<K>(key), std::forward<V>(value))), true};
+    }
+
+    /*
+     * Walks from the home slot and takes the place of the first element that is closer to its own home than the new
+     * one would be there, which then continues the walk in its stead, until an empty slot ends it.
+     */
+    constexpr Value &emplaceNew(Pair &&pair)
+    {
+        if (Full())
+        {
+            throw std::length_error("FixedHashTable: capacity exceeded");
+        }
+
+        SizeType index = homeSlot(pair.first);
+        uint32_t psl = 1;
+        Value *placed = nullptr;
+        for (; m_slots[index].psl; index = (index + 1) & MASK, ++psl)
+        {
+            if (m_slots[index].psl < psl)
+            {
+                std::swap(pair, m_slots[index].pair);
+                std::swap(psl, m_slots[index].psl);
+                if (!placed)
+                {
+                    placed = &m_slots[index].pair.second;
+                }
+            }
+        }
+
+        m_slots[index].pair = std::move(pair);
+        m_slots[index].psl = psl;
+        ++m_size;
+        return placed ? *placed : m_slots[index].pair.second;
+    }
+
+    // stops at the first slot whose element is closer to its home than the key would be, it would have been there
+    constexpr SizeType findIndex(const Key &key) const
+    {
+        SizeType index = homeSlot(key);
+        for (uint32_t psl = 1; m_slots[index].psl >= psl; index = (index + 1) & MASK, ++psl)
+        {
+            if (m_keyEqual(m_slots[index].pair.first, key))
+            {
+                return index;
+            }
+        }
+        return NPOS;
+    }
+
+    constexpr SizeType homeSlot(const Key &key) const
+    {
+        return static_cast<SizeType>(m_hasher(key)) & MASK;
+    }
+
+  private:
+    Slot m_slots[SLOT_COUNT]{};
+    SizeType m_size = 0;
+    Hasher m_hasher;
+    KeyEqual m_keyEqual;
+};
+
+} // namespace icb
@@ -0,0 +1,582 @@
+/**
+ * @file flat_hash_table.h
+ * @author Dovydas Ciomenas (icouldbreathe@icloud.com)
+ * @brief Unordered hash table (map) with open addressing and SIMD probing ("Swiss table")
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#pragma once
+
+#include <assert.h>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <new>
+#include <optional>
+
+#include <utility> // std::pair
+
+#if !defined(ICB_NO_SIMD) && defined(__AVX2__)
+#include <immintrin.h>
+#define ICB_FHT_AVX2 1
+#elif !defined(ICB_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#include <emmintrin.h>
+#define ICB_FHT_SSE2 1
+#endif
+
+#include "hash.h"
+
+#define FHT_INIT_CAPACITY 16
+
+namespace icb
+{
+namespace detail
+{
+/*
+ * Every slot has one control byte:
+ *  - full slots store the low 7 bits of the hash (H2), so the sign bit is clear
+ *  - empty and deleted (tombstone) slots have the sign bit set
+ */
+using CtrlType = int8_t;
+
+enum : CtrlType
+{
+    CTRL_EMPTY = -128,  // 0b10000000
+    CTRL_DELETED = -2,  // 0b11111110
+};
+
+/**
+ * @brief Set of matching slots within a group, one bit (or one byte for the scalar group) per slot
+ *
+ * @tparam MaskType Integer type wide enough for the group
+ * @tparam Shift log2 of the bits used per slot
+ */
+template <typename MaskType, int Shift> class BitMask
+{
+  public:
+    explicit BitMask(MaskType mask) noexcept : m_mask(mask)
+    {
+    }
+
+    explicit operator bool() const noexcept
+    {
+        return m_mask != 0;
+    }
+
+    size_t LowestBit() const noexcept
+    {
+        return static_cast<size_t>(std::countr_zero(m_mask)) >> Shift;
+    }
+
+    void ClearLowest() noexcept
+    {
+        m_mask &= m_mask - 1;
+    }
+
+  private:
+    MaskType m_mask;
+};
+
+#if defined(ICB_FHT_AVX2)
+struct Group
+{
+    static constexpr size_t Width = 32;
+
+    explicit Group(const CtrlType *ctrl) noexcept
+        : m_ctrl(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(ctrl)))
+    {
+    }
+
+    BitMask<uint32_t, 0> Match(CtrlType h2) const noexcept
+    {
+        return BitMask<uint32_t, 0>(
+            static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_set1_epi8(h2), m_ctrl))));
+    }
+
+    BitMask<uint32_t, 0> MatchEmpty() const noexcept
+    {
+        return Match(CTRL_EMPTY);
+    }
+
+    // full slots are the only ones with a clear sign bit
+    BitMask<uint32_t, 0> MatchEmptyOrDeleted() const noexcept
+    {
+        return BitMask<uint32_t, 0>(static_cast<uint32_t>(_mm256_movemask_epi8(m_ctrl)));
+    }
+
+    __m256i m_ctrl;
+};
+#elif defined(ICB_FHT_SSE2)
+struct Group
+{
+    static constexpr size_t Width = 16;
+
+    explicit Group(const CtrlType *ctrl) noexcept : m_ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i *>(ctrl)))
+    {
+    }
+
+    BitMask<uint32_t, 0> Match(CtrlType h2) const noexcept
+    {
+        return BitMask<uint32_t, 0>(
+            static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), m_ctrl))));
+    }
+
+    BitMask<uint32_t, 0> MatchEmpty() const noexcept
+    {
+        return Match(CTRL_EMPTY);
+    }
+
+    // full slots are the only ones with a clear sign bit
+    BitMask<uint32_t, 0> MatchEmptyOrDeleted() const noexcept
+    {
+        return BitMask<uint32_t, 0>(static_cast<uint32_t>(_mm_movemask_epi8(m_ctrl)));
+    }
+
+    __m128i m_ctrl;
+};
+#else
+/*
+ * Portable fallback: 8 control bytes in a uint64_t, matched with SWAR bit tricks.
+ * Match() may report a false positive right after a true one, which is fine since keys are compared anyway.
+ */
+struct Group
+{
+    static constexpr size_t Width = 8;
+    static constexpr uint64_t LSBS = 0x0101010101010101ULL;
+    static constexpr uint64_t MSBS = 0x8080808080808080ULL;
+
+    explicit Group(const CtrlType *ctrl) noexcept : m_ctrl(0)
+    {
+        // assemble little-endian regardless of the host, the compiler turns this into a single load
+        for (size_t i = 0; i < Width; ++i)
+        {
+            m_ctrl |= static_cast<uint64_t>(static_cast<uint8_t>(ctrl[i])) << (i * 8);
+        }
+    }
+
+    BitMask<uint64_t, 3> Match(CtrlType h2) const noexcept
+    {
+        uint64_t x = m_ctrl ^ (LSBS * static_cast<uint8_t>(h2));
+        return BitMask<uint64_t, 3>((x - LSBS) & ~x & MSBS);
+    }
+
+    // empty is the only control byte with the sign bit set and bit 6 clear
+    BitMask<uint64_t, 3> MatchEmpty() const noexcept
+    {
+        return BitMask<uint64_t, 3>(m_ctrl & ~(m_ctrl << 1) & MSBS);
+    }
+
+    BitMask<uint64_t, 3> MatchEmptyOrDeleted() const noexcept
+    {
+        return BitMask<uint64_t, 3>(m_ctrl & MSBS);
+    }
+
+    uint64_t m_ctrl;
+};
+#endif
+} // namespace detail
+
+template <typename Key, typename Value> class FlatHashTable
+{
+  public:
+    using SizeType = size_t;
+    using Pair = std::pair<Key, Value>;
+
+  private:
+    using CtrlType = detail::CtrlType;
+    using Group = detail::Group;
+
+    static constexpr SizeType NPOS = static_cast<SizeType>(-1);
+
+  public:
+    FlatHashTable(const SizeType &capacity = FHT_INIT_CAPACITY)
+    {
+        allocate(normalizeCapacity(capacity));
+    }
+
+    FlatHashTable(std::initializer_list<Pair> il, const SizeType &capacity = FHT_INIT_CAPACITY)
+        : FlatHashTable(capacity)
+    {
+        for (const auto &[key, value] : il)
+        {
+            Insert(key, value);
+        }
+    }
+
+    ~FlatHashTable()
+    {
+        destroySlots();
+        deallocate();
+    }
+
+    // copy ctor
+    FlatHashTable(const FlatHashTable &other) : FlatHashTable(other.m_capacity)
+    {
+        // the ctrl bytes are set slot by slot, so a throwing copy leaves nothing half-built for the destructor
+        for (SizeType i = 0; i < other.m_capacity; ++i)
+        {
+            if (isFull(other.m_ctrl[i]))
+            {
+                new (&m_slots[i]) Pair(other.m_slots[i]);
+                setCtrl(i, other.m_ctrl[i]);
+                ++m_size;
+            }
+        }
+
+        // then the tombstones too, the probe sequences that run past them have to stay the same
+        if (other.m_capacity)
+        {
+            std::memcpy(m_ctrl, other.m_ctrl, ctrlBytes(m_capacity));
+            m_growthLeft = other.m_growthLeft;
+        }
+    }
+
+    // move ctor
+    FlatHashTable(FlatHashTable &&other) noexcept
+    {
+        swap(other);
+    }
+
+    // copy assignment
+    FlatHashTable &operator=(const FlatHashTable &other)
+    {
+        if (this != &other)
+        {
+            FlatHashTable copy(other);
+            swap(copy);
+        }
+        return *this;
+    }
+
+    // move assignment
+    FlatHashTable &operator=(FlatHashTable &&other) noexcept
+    {
+        if (this != &other)
+        {
+            FlatHashTable moved(std::move(other));
+            swap(moved);
+        }
+        return *this;
+    }
+
+    // copy
+    void Insert(const Key &key, const Value &value)
+    {
+        insertUnique(key, value);
+    }
+
+    // move
+    void Insert(Key &&key, Value &&value)
+    {
+        insertUnique(std::move(key), std::move(value));
+    }
+
+    std::optional<Value> Find(const Key &key) const
+    {
+        SizeType index = findIndex(key, hash(key));
+
+        if (index == NPOS)
+        {
+            return std::nullopt;
+        }
+        return m_slots[index].second;
+    }
+
+    bool Contains(const Key &key) const
+    {
+        return findIndex(key, hash(key)) != NPOS;
+    }
+
+    void Erase(const Key &key)
+    {
+        SizeType index = findIndex(key, hash(key));
+
+        if (index == NPOS)
+        {
+            return;
+        }
+
+        /*
+         * Always leave a tombstone: a probe sequence for another key may have passed over this slot while it was
+         * full, so turning it back into EMPTY could end that probe early. Tombstones are reused by Insert and
+         * dropped on the next Rehash.
+         */
+        m_slots[index].~Pair();
+        setCtrl(index, detail::CTRL_DELETED);
+        --m_size;
+    }
+
+    void Clear()
+    {
+        destroySlots();
+        resetCtrl();
+        m_size = 0;
+    }
+
+    /**
+     * @brief Rebuilds the table with at least newCapacity slots, dropping all tombstones
+     *
+     * The capacity is rounded up to a power of two and never made too small to hold the current elements.
+     */
+    void Rehash(const SizeType &newCapacity)
+    {
+        assert(newCapacity > 0 && "FlatHashTable::Rehash attempt to resize to <=0");
+
+        SizeType capacity = normalizeCapacity(newCapacity);
+        while (maxElements(capacity) < m_size)
+        {
+            capacity *= 2;
+        }
+
+        CtrlType *oldCtrl = m_ctrl;
+        Pair *oldSlots = m_slots;
+        SizeType oldCapacity = m_capacity;
+
+        allocate(capacity);
+
+        for (SizeType i = 0; i < oldCapacity; ++i)
+        {
+            if (isFull(oldCtrl[i]))
+            {
+                SizeType h = hash(oldSlots[i].first);
+                SizeType index = findFirstNonFull(h);
+                new (&m_slots[index]) Pair(std::move(oldSlots[i]));
+                oldSlots[i].~Pair();
+                setCtrl(index, h2(h));
+            }
+        }
+        m_growthLeft -= m_size;
+
+        ::operator delete(oldCtrl, ctrlBytes(oldCapacity));
+        ::operator delete(oldSlots, oldCapacity * sizeof(Pair), std::align_val_t(alignof(Pair)));
+    }
+
+    bool Empty() const
+    {
+        return !m_size;
+    }
+
+    SizeType Size() const
+    {
+        return m_size;
+    }
+
+    SizeType Capacity() const
+    {
+        return m_capacity;
+    }
+
+  private:
+    template <typename K, typename V> void insertUnique(K &&key, V &&value)
+    {
+        // moved-from tables have no storage
+        if (!m_capacity)
+        {
+            allocate(normalizeCapacity(FHT_INIT_CAPACITY));
+        }
+
+        SizeType h = hash(key);
+
+        if (findIndex(key, h) != NPOS)
+        {
+            return;
+        }
+
+        SizeType index = findFirstNonFull(h);
+
+        // reusing a tombstone doesn't eat into the growth budget, only empty slots do
+        if (m_ctrl[index] == detail::CTRL_EMPTY)
+        {
+            if (m_growthLeft == 0)
+            {
+                rehashForGrowth();
+                index = findFirstNonFull(h);
+            }
+            --m_growthLeft;
+        }
+
+        new (&m_slots[index]) Pair(std::forward<K>(key), std::forward<V>(value));
+        setCtrl(index, h2(h));
+        ++m_size;
+    }
+
+    SizeType findIndex(const Key &key, SizeType h) const
+    {
+        if (!m_capacity)
+        {
+            return NPOS;
+        }
+
+        const SizeType mask = m_capacity - 1;
+        SizeType pos = h1(h) & mask;
+        SizeType step = 0;
+
+        while (true)
+        {
+            Group group(m_ctrl + pos);
+
+            for (auto match = group.Match(h2(h)); match; match.ClearLowest())
+            {
+                SizeType index = (pos + match.LowestBit()) & mask;
+                if (m_slots[index].first == key)
+                {
+                    return index;
+                }
+            }
+
+            if (group.MatchEmpty())
+            {
+                return NPOS;
+            }
+
+            // triangular probing over whole groups visits every group once for power-of-two capacities
+            step += Group::Width;
+            pos = (pos + step) & mask;
+        }
+    }
+
+    SizeType findFirstNonFull(SizeType h) const
+    {
+        const SizeType mask = m_capacity - 1;
+        SizeType pos = h1(h) & mask;
+        SizeType step = 0;
+
+        while (true)
+        {
+            auto match = Group(m_ctrl + pos).MatchEmptyOrDeleted();
+            if (match)
+            {
+                return (pos + match.LowestBit()) & mask;
+            }
+
+            step += Group::Width;
+            pos = (pos + step) & mask;
+        }
+    }
+
+    void rehashForGrowth()
+    {
+        // mostly tombstones: cleaning them up in place is enough
+        if (m_size <= maxElements(m_capacity) / 2)
+        {
+            Rehash(m_capacity);
+        }
+        else
+        {
+            Rehash(m_capacity * 2);
+        }
+    }
+
+    /*
+     * The first Width - 1 control bytes are mirrored past the end of the array,
+     * so a group can be loaded from any position without wrapping around.
+     */
+    void setCtrl(SizeType index, CtrlType value) noexcept
+    {
+        m_ctrl[index] = value;
+        if (index < Group::Width - 1)
+        {
+            m_ctrl[m_capacity + index] = value;
+        }
+    }
+
+    void allocate(SizeType capacity)
+    {
+        m_capacity = capacity;
+        m_ctrl = static_cast<CtrlType *>(::operator new(ctrlBytes(capacity)));
+        m_slots = static_cast<Pair *>(::operator new(capacity * sizeof(Pair), std::align_val_t(alignof(Pair))));
+        resetCtrl();
+    }
+
+    void deallocate() noexcept
+    {
+        if (m_capacity)
+        {
+            ::operator delete(m_ctrl, ctrlBytes(m_capacity));
+            ::operator delete(m_slots, m_capacity * sizeof(Pair), std::align_val_t(alignof(Pair)));
+        }
+        m_ctrl = nullptr;
+        m_slots = nullptr;
+        m_capacity = 0;
+    }
+
+    void resetCtrl() noexcept
+    {
+        if (!m_capacity)
+        {
+            return;
+        }
+        std::memset(m_ctrl, static_cast<uint8_t>(detail::CTRL_EMPTY), ctrlBytes(m_capacity));
+        m_growthLeft = maxElements(m_capacity);
+    }
+
+    void destroySlots() noexcept
+    {
+        for (SizeType i = 0; i < m_capacity; ++i)
+        {
+            if (isFull(m_ctrl[i]))
+            {
+                m_slots[i].~Pair();
+            }
+        }
+    }
+
+    void swap(FlatHashTable &other) noexcept
+    {
+        std::swap(m_ctrl, other.m_ctrl);
+        std::swap(m_slots, other.m_slots);
+        std::swap(m_capacity, other.m_capacity);
+        std::swap(m_size, other.m_size);
+        std::swap(m_growthLeft, other.m_growthLeft);
+    }
+
+    static SizeType normalizeCapacity(SizeType capacity) noexcept
+    {
+        return std::bit_ceil(capacity < Group::Width ? Group::Width : capacity);
+    }
+
+    // max load factor of 7/8
+    static SizeType maxElements(SizeType capacity) noexcept
+    {
+        return capacity - capacity / 8;
+    }
+
+    static SizeType ctrlBytes(SizeType capacity) noexcept
+    {
+        return capacity + Group::Width - 1;
+    }
+
+    static bool isFull(CtrlType ctrl) noexcept
+    {
+        return ctrl >= 0;
+    }
+
+    static SizeType h1(SizeType h) noexcept
+    {
+        return h >> 7;
+    }
+
+    static CtrlType h2(SizeType h) noexcept
+    {
+        return static_cast<CtrlType>(h & 0x7F);
+    }
+
+    static SizeType hash(const Key &key) noexcept
+    {
+        return detail::HashKey<Key>(key);
+    }
+
+  private:
+    CtrlType *m_ctrl = nullptr;
+    Pair *m_slots = nullptr;
+    SizeType m_capacity = 0;
+    SizeType m_size = 0;
+    SizeType m_growthLeft = 0;
+};
+
+} // namespace icb
@@ -0,0 +1,464 @@
+/**
+ * @file frozen_hash_table.h
+ * @author Dovydas Ciomenas (icouldbreathe@icloud.com)
+ * @brief Immutable hash table (map) over a minimal perfect hash function
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <new>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+
+#include <utility> // std::pair
+
+#include "hash.h"
+
+#define FZHT_KEYS_PER_BUCKET 2           // average keys per displacement bucket, 4 bytes of bucket array each
+#define FZHT_MAX_SEED_ATTEMPTS (1u << 20) // seeds tried for one bucket before the build gives up
+
+namespace icb
+{
+/**
+ * @brief Read-only map built once from a set of keys, every lookup is a single probe
+ *
+ * Built with hash-and-displace (CHD): keys are split into buckets of about FZHT_KEYS_PER_BUCKET by their hash.
+ * Going from the largest bucket to the smallest, each bucket gets the first seed that sends all of its keys to
+ * still free slots. Buckets with a single key are placed last and store their slot directly, which fills the
+ * remaining holes and keeps the table minimal: n keys take exactly n slots, packed as one array of pairs.
+ *
+ * A lookup hashes the key, reads its bucket's seed, computes the slot and compares one key. Keys that weren't in
+ * the set land on some other key and miss on that comparison.
+ */
+template <typename Key, typename Value> class FrozenHashTable
+{
+  public:
+    using SizeType = size_t;
+    using Pair = std::pair<Key, Value>;
+    using ConstIterator = const Pair *;
+
+  private:
+    template <typename K> static constexpr bool isHeterogeneous = detail::IsHeterogeneous<Key, K>;
+
+    static constexpr uint32_t DIRECT = 0x80000000u; // bucket entry is a slot index, not a seed
+
+  public:
+    FrozenHashTable() = default;
+
+    /**
+     * @brief Builds the table from a range of distinct key-value pairs, which is walked twice
+     *
+     * @throws std::runtime_error when the keys can't be placed, which only happens for duplicate keys or keys whose
+     *         full hashes collide
+     */
+    template <std::forward_iterator ForwardIterator> FrozenHashTable(ForwardIterator first, ForwardIterator last)
+    {
+        build(first, last);
+    }
+
+    FrozenHashTable(std::initializer_list<Pair> il) : FrozenHashTable(il.begin(), il.end())
+    {
+    }
+
+    ~FrozenHashTable()
+    {
+        destroy();
+    }
+
+    // copy ctor
+    FrozenHashTable(const FrozenHashTable &other)
+        : m_size(other.m_size), m_bucketCount(other.m_bucketCount)
+    {
+        if (!other.m_buckets)
+        {
+            return;
+        }
+
+        std::unique_ptr<uint32_t[]> buckets(new uint32_t[m_bucketCount]);
+        std::memcpy(buckets.get(), other.m_buckets, m_bucketCount * sizeof(uint32_t));
+
+        m_entries = static_cast<Pair *>(::operator new(m_size * sizeof(Pair), std::align_val_t(alignof(Pair))));
+        SizeType constructed = 0;
+        try
+        {
+            for (; constructed < m_size; ++constructed)
+            {
+                new (&m_entries[constructed]) Pair(other.m_entries[constructed]);
+            }
+        }
+        catch (...)
+        {
+            for (SizeType i = 0; i < constructed; ++i)
+            {
+                m_entries[i].~Pair();
+            }
+            ::operator delete(m_entries, m_size * sizeof(Pair), std::align_val_t(alignof(Pair)));
+            throw;
+        }
+        m_buckets = buckets.release();
+    }
+
+    // move ctor
+    FrozenHashTable(FrozenHashTable &&other) noexcept
+    {
+        swap(other);
+    }
+
+    // copy assignment
+    FrozenHashTable &operator=(const FrozenHashTable &other)
+    {
+        if (this != &other)
+        {
+            FrozenHashTable copy(other);
+            swap(copy);
+        }
+        return *this;
+    }
+
+    // move assignment
+    FrozenHashTable &operator=(FrozenHashTable &&other) noexcept
+    {
+        if (this != &other)
+        {
+            FrozenHashTable moved(std::move(other));
+            swap(moved);
+        }
+        return *this;
+    }
+
+    // returns a copy, use FindPtr to avoid it
+    std::optional<Value> Find(const Key &key) const
+    {
+        const Value *value = FindPtr(key);
+
+        if (value)
+        {
+            return *value;
+        }
+        return std::nullopt;
+    }
+
+    template <typename K>
+        requires isHeterogeneous<K>
+    std::optional<Value> Find(const K &key) const
+    {
+        const Value *value = FindPtr(key);
+
+        if (value)
+        {
+            return *value;
+        }
+        return std::nullopt;
+    }
+
+    // zero-copy lookup, the pointer stays valid for the lifetime of the table
+    const Value *FindPtr(const Key &key) const
+    {
+        return findValue(key);
+    }
+
+    template <typename K>
+        requires isHeterogeneous<K>
+    const Value *FindPtr(const K &key) const
+    {
+        return findValue(key);
+    }
+
+    bool Contains(const Key &key) const
+    {
+        return findValue(key) != nullptr;
+    }
+
+    template <typename K>
+        requires isHeterogeneous<K>
+    bool Contains(const K &key) const
+    {
+        return findValue(key) != nullptr;
+    }
+
+    // the pairs in slot order
+    ConstIterator begin() const noexcept
+    {
+        return m_entries;
+    }
+
+    ConstIterator end() const noexcept
+    {
+        return m_entries + m_size;
+    }
+
+    ConstIterator cbegin() const noexcept
+    {
+        return begin();
+    }
+
+    ConstIterator cend() const noexcept
+    {
+        return end();
+    }
+
+    bool Empty() const
+    {
+        return !m_size;
+    }
+
+    SizeType Size() const
+    {
+        return m_size;
+    }
+
+    SizeType BucketCount() const
+    {
+        return m_bucketCount;
+    }
+
+  private:
+    template <typename K> const Value *findValue(const K &key) const
+    {
+        if (!m_size)
+        {
+            return nullptr;
+        }
+
+        const SizeType h = detail::HashKey<Key>(key);
+        const uint32_t bucket = m_buckets[bucketOf(h, m_bucketCount)];
+        const SizeType slot = (bucket & DIRECT) ? bucket & ~DIRECT : slotOf(h, bucket, m_size);
+
+        const Pair &entry = m_entries[slot];
+        return entry.first == key ? &entry.second : nullptr;
+    }
+
+    template <typename ForwardIterator> void build(ForwardIterator first, ForwardIterator last)
+    {
+        const SizeType n = static_cast<SizeType>(std::distance(first, last));
+        if (n >= DIRECT)
+        {
+            throw std::length_error("FrozenHashTable: more than 2^31 keys");
+        }
+        if (!n)
+        {
+            return;
+        }
+
+        const SizeType bucketCount = n / FZHT_KEYS_PER_BUCKET + 1;
+
+        std::unique_ptr<SizeType[]> hashes(new SizeType[n]);
+        SizeType i = 0;
+        for (auto it = first; it != last; ++it, ++i)
+        {
+            hashes[i] = detail::HashKey<Key>(it->first);
+        }
+
+        // counting sort of the keys by bucket: bucket b holds members[start[b], start[b + 1])
+        std::unique_ptr<SizeType[]> start(new SizeType[bucketCount + 1]());
+        for (i = 0; i < n; ++i)
+        {
+            ++start[bucketOf(hashes[i], bucketCount) + 1];
+        }
+
+        SizeType maxBucketSize = 0;
+        for (SizeType b = 0; b < bucketCount; ++b)
+        {
+            maxBucketSize = std::max(maxBucketSize, start[b + 1]);
+            start[b + 1] += start[b];
+        }
+
+        std::unique_ptr<uint32_t[]> members(new uint32_t[n]);
+        {
+            std::unique_ptr<SizeType[]> fill(new SizeType[bucketCount]);
+            std::memcpy(fill.get(), start.get(), bucketCount * sizeof(SizeType));
+            for (i = 0; i < n; ++i)
+            {
+                members[fill[bucketOf(hashes[i], bucketCount)]++] = static_cast<uint32_t>(i);
+            }
+        }
+
+        // counting sort of the buckets by size, largest first: they are the hardest to place
+        std::unique_ptr<uint32_t[]> order(new uint32_t[bucketCount]);
+        {
+            std::unique_ptr<SizeType[]> bySize(new SizeType[maxBucketSize + 2]());
+            for (SizeType b = 0; b < bucketCount; ++b)
+            {
+                ++bySize[maxBucketSize - (start[b + 1] - start[b]) + 1];
+            }
+            for (SizeType s = 0; s <= maxBucketSize; ++s)
+            {
+                bySize[s + 1] += bySize[s];
+            }
+            for (SizeType b = 0; b < bucketCount; ++b)
+            {
+                order[bySize[maxBucketSize - (start[b + 1] - start[b])]++] = static_cast<uint32_t>(b);
+            }
+        }
+
+        std::unique_ptr<uint32_t[]> buckets(new uint32_t[bucketCount]());
+        std::unique_ptr<uint64_t[]> taken(new uint64_t[(n + 63) / 64]());
+        std::unique_ptr<uint32_t[]> slots(new uint32_t[n]);
+        std::unique_ptr<SizeType[]> candidate(new SizeType[maxBucketSize]);
+
+        auto isTaken = [&](SizeType slot) { return (taken[slot / 64] >> (slot % 64)) & 1; };
+        auto take = [&](SizeType slot) { taken[slot / 64] |= uint64_t(1) << (slot % 64); };
+
+        SizeType next = 0; // position in order
+        for (; next < bucketCount; ++next)
+        {
+            const uint32_t b = order[next];
+            const SizeType size = start[b + 1] - start[b];
+            if (size < 2)
+            {
+                break;
+            }
+
+            const uint32_t *keys = &members[start[b]];
+            for (SizeType k = 1; k < size; ++k)
+            {
+                for (SizeType j = 0; j < k; ++j)
+                {
+                    if (hashes[keys[k]] == hashes[keys[j]])
+                    {
+                        throw std::runtime_error("FrozenHashTable: two keys with the same hash, duplicate keys?");
+                    }
+                }
+            }
+
+            uint32_t seed = 0;
+            for (;; ++seed)
+            {
+                if (seed == FZHT_MAX_SEED_ATTEMPTS)
+                {
+                    throw std::runtime_error("FrozenHashTable: no seed places all keys of a bucket");
+                }
+
+                bool placed = true;
+                for (SizeType k = 0; k < size && placed; ++k)
+                {
+                    candidate[k] = slotOf(hashes[keys[k]], seed, n);
+                    placed = !isTaken(candidate[k]);
+                    for (SizeType j = 0; j < k && placed; ++j)
+                    {
+                        placed = candidate[j] != candidate[k];
+                    }
+                }
+
+                if (placed)
+                {
+                    break;
+                }
+            }
+
+            buckets[b] = seed;
+            for (SizeType k = 0; k < size; ++k)
+            {
+                take(candidate[k]);
+                slots[keys[k]] = static_cast<uint32_t>(candidate[k]);
+            }
+        }
+
+        // single-key buckets fill the remaining slots in order, empty buckets keep seed 0
+        SizeType freeSlot = 0;
+        for (; next < bucketCount; ++next)
+        {
+            const uint32_t b = order[next];
+            if (start[b + 1] == start[b])
+            {
+                break;
+            }
+
+            while (isTaken(freeSlot))
+            {
+                ++freeSlot;
+            }
+            take(freeSlot);
+            buckets[b] = DIRECT | static_cast<uint32_t>(freeSlot);
+            slots[members[start[b]]] = static_cast<uint32_t>(freeSlot);
+        }
+
+        Pair *entries = static_cast<Pair *>(::operator new(n * sizeof(Pair), std::align_val_t(alignof(Pair))));
+        i = 0;
+        try
+        {
+            for (auto it = first; it != last; ++it, ++i)
+            {
+                new (&entries[slots[i]]) Pair(*it);
+            }
+        }
+        catch (...)
+        {
+            for (SizeType j = 0; j < i; ++j)
+            {
+                entries[slots[j]].~Pair();
+            }
+            ::operator delete(entries, n * sizeof(Pair), std::align_val_t(alignof(Pair)));
+            throw;
+        }
+
+        m_entries = entries;
+        m_buckets = buckets.release();
+        m_size = n;
+        m_bucketCount = bucketCount;
+    }
+
+    // maps x onto [0, range) with a multiply instead of a division
+    static SizeType reduce(uint32_t x, SizeType range) noexcept
+    {
+        return static_cast<SizeType>((static_cast<uint64_t>(x) * range) >> 32);
+    }
+
+    static SizeType bucketOf(SizeType h, SizeType bucketCount) noexcept
+    {
+        return reduce(static_cast<uint32_t>(h), bucketCount);
+    }
+
+    // the bucket used the low bits of h, the slot is taken from the high bits of a seeded remix
+    static SizeType slotOf(SizeType h, uint32_t seed, SizeType size) noexcept
+    {
+        const SizeType mixed = detail::Mix(h ^ static_cast<SizeType>(seed * 0x9e3779b97f4a7c15ULL));
+        return reduce(static_cast<uint32_t>(mixed >> (std::numeric_limits<SizeType>::digits - 32)), size);
+    }
+
+    void destroy() noexcept
+    {
+        if (m_buckets)
+        {
+            for (SizeType i = 0; i < m_size; ++i)
+            {
+                m_entries[i].~Pair();
+            }
+            ::operator delete(m_entries, m_size * sizeof(Pair), std::align_val_t(alignof(Pair)));
+            delete[] m_buckets;
+        }
+        m_entries = nullptr;
+        m_buckets = nullptr;
+        m_size = 0;
+        m_bucketCount = 0;
+    }
+
+    void swap(FrozenHashTable &other) noexcept
+    {
+        std::swap(m_entries, other.m_entries);
+        std::swap(m_buckets, other.m_buckets);
+        std::swap(m_size, other.m_size);
+        std::swap(m_bucketCount, other.m_bucketCount);
+    }
+
+  private:
+    Pair *m_entries = nullptr;
+    uint32_t *m_buckets = nullptr; // seed, or DIRECT | slot for single-key buckets
+    SizeType m_size = 0;
+    SizeType m_bucketCount = 0;
+};
+
+} // namespace icb
@@ -0,0 +1,254 @@
+/**
+ * @file hash.h
+ * @author Dovydas Ciomenas (icouldbreathe@icloud.com)
+ * @brief Hashing helpers shared by the hash tables
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h> // _umul128
+#endif
+
+namespace icb
+{
+namespace detail
+{
+/*
+ * std::hash is the identity for integers on the major implementations, and the tables only look at some of the
+ * bits (the low ones for bucket masks, the high ones for shards). Spread all bits around first (murmur3 finalizer).
+ */
+constexpr size_t Mix(size_t value) noexcept
+{
+    uint64_t h = static_cast<uint64_t>(value);
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return static_cast<size_t>(h);
+}
+
+// 64x64 -> 128 bit multiply folded back to 64 bits, every output bit depends on every input bit of both factors
+constexpr uint64_t MulFold(uint64_t a, uint64_t b) noexcept
+{
+#if defined(__SIZEOF_INT128__)
+    __extension__ typedef unsigned __int128 U128;
+    U128 product = static_cast<U128>(a) * b;
+    return static_cast<uint64_t>(product) ^ static_cast<uint64_t>(product >> 64);
+#else
+#if defined(_MSC_VER) && defined(_M_X64)
+    if (!std::is_constant_evaluated())
+    {
+        uint64_t high;
+        uint64_t low = _umul128(a, b, &high);
+        return low ^ high;
+    }
+#endif
+    const uint64_t aLow = a & 0xffffffffULL, aHigh = a >> 32;
+    const uint64_t bLow = b & 0xffffffffULL, bHigh = b >> 32;
+    const uint64_t ll = aLow * bLow, lh = aLow * bHigh, hl = aHigh * bLow, hh = aHigh * bHigh;
+    const uint64_t middle = (ll >> 32) + (lh & 0xffffffffULL) + (hl & 0xffffffffULL);
+    const uint64_t low = (ll & 0xffffffffULL) | (middle << 32);
+    const uint64_t high = hh + (lh >> 32) + (hl >> 32) + (middle >> 32);
+    return low ^ high;
+#endif
+}
+
+inline uint64_t Read64(const unsigned char *bytes) noexcept
+{
+    uint64_t word;
+    std::memcpy(&word, bytes, sizeof(word));
+    return word;
+}
+
+inline uint64_t Read32(const unsigned char *bytes) noexcept
+{
+    uint32_t word;
+    std::memcpy(&word, bytes, sizeof(word));
+    return word;
+}
+
+/**
+ * @brief Hash of raw bytes that only depends on the bytes, unlike std::hash it is the same for every process,
+ * compiler and standard library
+ *
+ * Built like wyhash: 16 bytes are consumed per multiply-fold, inputs up to 16 bytes are read with at most four
+ * overlapping loads and no loop, and longer ones run three independent lanes per 48 bytes.
+ *
+ * Also meant for hashes that are stored, e.g. in files. Words are read in host byte order, so it matches across
+ * little-endian hosts only.
+ */
+inline uint64_t HashBytes(const void *data, size_t size, uint64_t seed = 0) noexcept
+{
+    constexpr uint64_t P0 = 0xa0761d6478bd642fULL;
+    constexpr uint64_t P1 = 0xe7037ed1a0b428dbULL;
+    constexpr uint64_t P2 = 0x8ebc6af09c88c6e3ULL;
+    constexpr uint64_t P3 = 0x589965cc75374cc3ULL;
+
+    const unsigned char *bytes = static_cast<const unsigned char *>(data);
+    uint64_t a = 0;
+    uint64_t b = 0;
+
+    seed ^= MulFold(seed ^ P0, P1);
+
+    if (size <= 16)
+    {
+        if (size >= 4)
+        {
+            // two pairs of 4-byte loads from both ends, overlapping for sizes below 16
+            const size_t step = (size >> 3) << 2;
+            a = (Read32(bytes) << 32) | Read32(bytes + step);
+            b = (Read32(bytes + size - 4) << 32) | Read32(bytes + size - 4 - step);
+        }
+        else if (size > 0)
+        {
+            a = (uint64_t(bytes[0]) << 16) | (uint64_t(bytes[size >> 1]) << 8) | bytes[size - 1];
+        }
+    }
+    else
+    {
+        size_t remaining = size;
+
+        if (remaining > 48)
+        {
+            uint64_t lane1 = seed;
+            uint64_t lane2 = seed;
+            do
+            {
+                seed = MulFold(Read64(bytes) ^ P1, Read64(bytes + 8) ^ seed);
+                lane1 = MulFold(Read64(bytes + 16) ^ P2, Read64(bytes + 24) ^ lane1);
+                lane2 = MulFold(Read64(bytes + 32) ^ P3, Read64(bytes + 40) ^ lane2);
+                bytes += 48;
+                remaining -= 48;
+            } while (remaining > 48);
+            seed ^= lane1 ^ lane2;
+        }
+
+        while (remaining > 16)
+        {
+            seed = MulFold(Read64(bytes) ^ P1, Read64(bytes + 8) ^ seed);
+            bytes += 16;
+            remaining -= 16;
+        }
+
+        // the last 16 bytes, overlapping what was already consumed
+        a = Read64(bytes + remaining - 16);
+        b = Read64(bytes + remaining - 8);
+    }
+
+    return MulFold(P1 ^ static_cast<uint64_t>(size), MulFold(a ^ P1, b ^ seed));
+}
+
+template <typename T> struct StringViewOf
+{
+    using Type = void;
+};
+
+template <typename CharT, typename Traits, typename Allocator>
+struct StringViewOf<std::basic_string<CharT, Traits, Allocator>>
+{
+    using Type = std::basic_string_view<CharT, Traits>;
+};
+
+// lookup types other than Key that can be hashed and compared without converting to Key
+template <typename Key, typename K>
+constexpr bool IsHeterogeneous = !std::is_void_v<typename StringViewOf<Key>::Type> &&
+                                 !std::is_same_v<std::remove_cvref_t<K>, Key> &&
+                                 std::is_convertible_v<const K &, typename StringViewOf<Key>::Type>;
+
+// the hasher (or key equality) accepts any type that can stand in for the key
+template <typename T>
+constexpr bool IsTransparent = requires { typename T::is_transparent; };
+
+template <typename CharT, typename Traits> struct StringHash
+{
+    using is_transparent = void;
+
+    size_t operator()(std::basic_string_view<CharT, Traits> key) const noexcept
+    {
+        return static_cast<size_t>(HashBytes(key.data(), key.size() * sizeof(CharT)));
+    }
+};
+} // namespace detail
+
+/**
+ * @brief Default hasher of the hash tables, with every output bit well mixed
+ *
+ * Integers, enums and pointers go through a single multiply-fold, which unlike std::hash (the identity on the
+ * major implementations) spreads them over the low bits the bucket masks use. Strings and string views are hashed
+ * with detail::HashBytes, so std::string, std::string_view and const char * keys hash alike and the hasher is
+ * transparent. Anything else falls back to mixing std::hash.
+ *
+ * Specialize it for your own key types, or pass a different hasher to HashTable.
+ */
+template <typename T> struct Hash
+{
+    constexpr size_t operator()(const T &key) const noexcept
+    {
+        if constexpr (std::is_integral_v<T> || std::is_enum_v<T> || std::is_pointer_v<T>)
+        {
+            uint64_t bits;
+            if constexpr (std::is_pointer_v<T>)
+            {
+                bits = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(key));
+            }
+            else
+            {
+                bits = static_cast<uint64_t>(key);
+            }
+            // the xor keeps small keys from leaving the high half of the product (and so the low output bits) empty
+            return static_cast<size_t>(detail::MulFold(bits ^ 0xa0761d6478bd642fULL, 0xe7037ed1a0b428dbULL));
+        }
+        else
+        {
+            return detail::Mix(std::hash<T>{}(key));
+        }
+    }
+};
+
+template <typename CharT, typename Traits, typename Allocator>
+struct Hash<std::basic_string<CharT, Traits, Allocator>> : detail::StringHash<CharT, Traits>
+{
+};
+
+template <typename CharT, typename Traits>
+struct Hash<std::basic_string_view<CharT, Traits>> : detail::StringHash<CharT, Traits>
+{
+};
+
+namespace detail
+{
+/**
+ * @brief Hash of a Key with icb::Hash, or of a K that can stand in for it
+ *
+ * String keys are hashed through their string_view, which lets string_view and const char * lookups find
+ * std::string keys without building a temporary.
+ */
+template <typename Key, typename K> size_t HashKey(const K &key) noexcept
+{
+    using KeyView = typename StringViewOf<Key>::Type;
+
+    if constexpr (!std::is_void_v<KeyView>)
+    {
+        return Hash<Key>{}(KeyView(key));
+    }
+    else
+    {
+        return Hash<Key>{}(key);
+    }
+}
+} // namespace detail
+} // namespace icb
@@ -11,141 +11,764 @@
 
 #pragma once
 
+#include <algorithm>
+#include <assert.h>
+#include <bit>
+#include <cmath>
+#include <concepts>
+#include <cstdint>
 #include <functional>
 #include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
 #include <optional>
+#include <span>
+#include <tuple>
+#include <type_traits>
 
 #include <utility> // std::pair
+#include <vector>
 
-#include "linkedlist.h"
-#include "vector.h"
+#include "frozen_hash_table.h"
+#include "hash.h"
+#include "prefetch.h"
+#include "thread_pool.h"
 
-#define HT_INIT_CAPACITY 11
+#define HT_INIT_CAPACITY 16
+#define HT_MAX_LOAD_FACTOR 1.0f
+#define HT_REHASH_STEP 4 // old buckets migrated per operation in incremental rehash mode
+#define HT_BATCH_SIZE 16 // keys whose memory accesses FindBatch keeps in flight at once
+#define HT_PARALLEL_THRESHOLD (1 << 16) // elements below which BulkInsert and Rehash stay on the calling thread
+#define HT_PARALLEL_GRAIN 4096          // minimum elements or buckets per parallel task
 
 namespace icb
 {
-template <typename Key, typename Value> class HashTable
+template <typename Key, typename Value> class FilteredHashTable;
+
+/**
+ * @brief How evenly a HashTable spreads its keys, see HashTable::Stats
+ */
+struct HashTableStats
+{
+    size_t size = 0;
+    size_t bucketCount = 0;
+    float loadFactor = 0.0f;
+    size_t emptyBuckets = 0;
+    size_t maxChainLength = 0;
+    double averageProbeLength = 0.0; // nodes visited by a successful lookup, about 1 + loadFactor / 2 for a good hash
+    std::vector<size_t> chainLengthHistogram; // [i] is the number of buckets whose chain has i nodes
+};
+
+/**
+ * @brief Separate chaining over a flat array of head pointers
+ *
+ * Every bucket is a single pointer to a singly linked chain, so an empty bucket costs one word. Nodes keep the full
+ * hash of their key: lookups compare it before calling operator== on the key, and rehashing relinks the nodes
+ * without hashing any key again. Nodes never move, pointers to values stay valid until the element is erased.
+ *
+ * Keys are hashed with Hasher and compared with KeyEqual. When both are transparent (have an is_transparent member
+ * type, as the defaults for strings do), lookups also accept any type they can hash and compare, without building a
+ * Key. Buckets are picked from the low bits of the hash, so a Hasher has to mix well into them.
+ *
+ * The nodes and the bucket array come from Allocator, rebound to each; the elements don't get it. Copies and moves
+ * follow Vector: a copy asks select_on_container_copy_construction, a move takes the allocator along, and assignment
+ * keeps the table's own allocator. Allocators other than std::allocator are only ever called from the thread that
+ * calls into the table, also by the parallel BulkInsert.
+ */
+template <typename Key, typename Value, typename Hasher = Hash<Key>, typename KeyEqual = std::equal_to<>,
+          typename Allocator = std::allocator<std::pair<const Key, Value>>>
+class HashTable
 {
   public:
     using SizeType = size_t;
     using Pair = std::pair<Key, Value>;
-    using Chain = icb::LinkedList<Pair>;
-    using Table = icb::Vector<Chain>;
+    using ValueType = std::pair<const Key, Value>;
+    using AllocatorType = Allocator;
+
+  private:
+    template <typename K>
+    static constexpr bool isHeterogeneous = detail::IsTransparent<Hasher> && detail::IsTransparent<KeyEqual> &&
+                                            !std::is_same_v<std::remove_cvref_t<K>, Key>;
+
+    // by iterator_category rather than the concept, which std::move_iterator only satisfies as an input iterator
+    template <typename It>
+    static constexpr bool isRandomAccess =
+        std::derived_from<typename std::iterator_traits<It>::iterator_category, std::random_access_iterator_tag>;
+
+    struct Node
+    {
+        Node *next;
+        const SizeType hash;
+        ValueType value;
+
+        template <typename... Args>
+        Node(Node *next, SizeType hash, Args &&...args) : next(next), hash(hash), value(std::forward<Args>(args)...)
+        {
+        }
+    };
+
+    /**
+     * @brief Forward iterator over the elements, in bucket order
+     *
+     * During an incremental rehash the buckets that haven't been migrated yet are visited first. Any insertion or
+     * erase, and a non-const FindPtr, may migrate nodes and invalidates the iterators.
+     */
+    template <typename AccessType = ValueType> class BaseIterator
+    {
+      public:
+        using iterator_category = std::forward_iterator_tag;
+        using difference_type = std::ptrdiff_t;
+        using value_type = ValueType;
+        using pointer = std::conditional_t<std::is_const_v<AccessType>, const ValueType *, ValueType *>;
+        using reference = std::conditional_t<std::is_const_v<AccessType>, const ValueType &, ValueType &>;
+        using self_type = BaseIterator<AccessType>;
+
+      public:
+        BaseIterator() = default;
+
+        // implicit conversion from Iterator to ConstIterator
+        template <typename WasAccessType,
+                  class = std::enable_if_t<std::is_const_v<AccessType> && !std::is_const_v<WasAccessType>>>
+        BaseIterator(const BaseIterator<WasAccessType> &other) noexcept
+            : m_table(other.m_table), m_node(other.m_node), m_bucket(other.m_bucket), m_inOld(other.m_inOld)
+        {
+        }
+
+        // prefix ++
+        self_type &operator++() noexcept
+        {
+            m_node = m_node->next;
+            if (!m_node)
+            {
+                ++m_bucket;
+                m_node = m_table->firstNodeFrom(m_bucket, m_inOld);
+            }
+            return *this;
+        }
+
+        // postfix ++
+        self_type operator++(int) noexcept
+        {
+            self_type previous = *this;
+            ++*this;
+            return previous;
+        }
+
+        reference operator*() const
+        {
+            assert(m_node && "HashTable::Iterator::operator* end dereference");
+            return m_node->value;
+        }
+
+        pointer operator->() const
+        {
+            return &m_node->value;
+        }
+
+        friend bool operator==(const self_type &x, const self_type &y) noexcept
+        {
+            return x.m_node == y.m_node;
+        }
+
+        friend bool operator!=(const self_type &x, const self_type &y) noexcept
+        {
+            return x.m_node != y.m_node;
+        }
+
+        friend class HashTable;
+        template <typename> friend class BaseIterator;
+
+      private:
+        BaseIterator(const HashTable *table, SizeType bucket, bool inOld) noexcept
+            : m_table(table), m_bucket(bucket), m_inOld(inOld)
+        {
+            m_node = m_table->firstNodeFrom(m_bucket, m_inOld);
+        }
+
+      private:
+        const HashTable *m_table = nullptr;
+        Node *m_node = nullptr; // nullptr is end()
+        SizeType m_bucket = 0;
+        bool m_inOld = false;
+    };
+
+  public:
+    using Iterator = BaseIterator<ValueType>;
+    using ConstIterator = BaseIterator<const ValueType>;
+
+  private:
+    using NodeAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+    using NodeTraits = std::allocator_traits<NodeAllocator>;
+    using BucketAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Node *>;
+    using BucketTraits = std::allocator_traits<BucketAllocator>;
+
+    // std::allocator can be called from the BulkInsert tasks, any other allocator only from the calling thread
+    static constexpr bool concurrentAllocation = std::is_same_v<Allocator, std::allocator<ValueType>>;
+
+    // shares the key's hash with its BloomFilter through the hash-taking paths below
+    template <typename, typename> friend class FilteredHashTable;
 
   public:
-    HashTable(const SizeType &capacity = HT_INIT_CAPACITY) : m_capacity(capacity)
+    HashTable(const SizeType &capacity = HT_INIT_CAPACITY, const Hasher &hasher = Hasher(),
+              const KeyEqual &keyEqual = KeyEqual(), const Allocator &allocator = Allocator())
+        : m_allocator(allocator), m_buckets(allocateBuckets(normalizeCapacity(capacity))),
+          m_capacity(normalizeCapacity(capacity)), m_hasher(hasher), m_keyEqual(keyEqual)
+    {
+    }
+
+    explicit HashTable(const Allocator &allocator) : HashTable(HT_INIT_CAPACITY, Hasher(), KeyEqual(), allocator)
     {
-        m_table.Reserve(capacity);
-        m_table.Resize(capacity);
     }
 
     ~HashTable()
     {
         Clear();
+        freeBuckets(m_buckets, m_capacity);
     }
 
-    HashTable(std::initializer_list<Pair> il, const SizeType &capacity = HT_INIT_CAPACITY) : m_capacity(capacity)
+    HashTable(std::initializer_list<Pair> il, const SizeType &capacity = HT_INIT_CAPACITY,
+              const Allocator &allocator = Allocator())
+        : HashTable(capacity, Hasher(), KeyEqual(), allocator)
     {
-        m_table.Reserve(capacity);
-        m_table.Resize(capacity);
-
         for (const auto &[key, value] : il)
         {
             Insert(key, value);
         }
     }
 
-    // copy
-    void Insert(const Key &key, const Value &value)
+    // copy ctor, the copy has no rehash in progress
+    HashTable(const HashTable &other)
+        : HashTable(other, NodeTraits::select_on_container_copy_construction(other.m_allocator))
     {
-        SizeType index = hash(key);
+    }
 
-        if (!Find(key).has_value())
+    // copy ctor into memory from the given allocator
+    HashTable(const HashTable &other, const Allocator &allocator)
+        : HashTable(other.m_capacity ? other.m_capacity : SizeType(HT_INIT_CAPACITY), other.m_hasher, other.m_keyEqual,
+                    allocator)
+    {
+        cloneNodes(other);
+    }
+
+    // move ctor, other is left empty without buckets and allocates them again on its next insert
+    HashTable(HashTable &&other) noexcept : m_allocator(other.m_allocator)
+    {
+        swap(other);
+    }
+
+    // copy assignment, keeps this table's allocator
+    HashTable &operator=(const HashTable &other)
+    {
+        if (this != &other)
         {
-            m_table[index].EmplaceBack(key, value);
-            ++m_elements;
+            HashTable copy(other, Allocator(m_allocator));
+            swap(copy);
         }
+        return *this;
+    }
+
+    // move assignment, keeps this table's allocator: nodes from a different one are moved element by element
+    HashTable &operator=(HashTable &&other) noexcept(NodeTraits::is_always_equal::value)
+    {
+        if (this == &other)
+        {
+            return *this;
+        }
+
+        if (NodeTraits::is_always_equal::value || m_allocator == other.m_allocator)
+        {
+            HashTable moved(std::move(other));
+            swap(moved);
+        }
+        else
+        {
+            HashTable moved(other.m_capacity ? other.m_capacity : SizeType(HT_INIT_CAPACITY), other.m_hasher,
+                            other.m_keyEqual, Allocator(m_allocator));
+            moved.cloneNodes(std::move(other));
+            other.Clear();
+            swap(moved);
+        }
+        return *this;
+    }
+
+    Allocator GetAllocator() const noexcept
+    {
+        return Allocator(m_allocator);
+    }
+
+    // copy
+    void Insert(const Key &key, const Value &value)
+    {
+        tryEmplace(key, value);
     }
 
     // move
     void Insert(Key &&key, Value &&value)
     {
-        SizeType index = hash(key);
+        tryEmplace(std::move(key), std::move(value));
+    }
+
+    /**
+     * @brief Constructs the value in place from args, unless the key is already present
+     *
+     * @return Pointer to the value stored under key and whether it was inserted
+     */
+    template <typename... Args> std::pair<Value *, bool> TryEmplace(const Key &key, Args &&...args)
+    {
+        return tryEmplace(key, std::forward<Args>(args)...);
+    }
+
+    template <typename... Args> std::pair<Value *, bool> TryEmplace(Key &&key, Args &&...args)
+    {
+        return tryEmplace(std::move(key), std::forward<Args>(args)...);
+    }
+
+    // the Key is only built from K when it actually gets inserted
+    template <typename K, typename... Args>
+        requires isHeterogeneous<K>
+    std::pair<Value *, bool> TryEmplace(const K &key, Args &&...args)
+    {
+        return tryEmplace(key, std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Inserts the value, or assigns it over the existing one
+     *
+     * @return Pointer to the value stored under key and whether it was inserted
+     */
+    template <typename V> std::pair<Value *, bool> InsertOrAssign(const Key &key, V &&value)
+    {
+        return insertOrAssign(key, std::forward<V>(value));
+    }
+
+    template <typename V> std::pair<Value *, bool> InsertOrAssign(Key &&key, V &&value)
+    {
+        return insertOrAssign(std::move(key), std::forward<V>(value));
+    }
+
+    // default-constructs the value if the key is missing
+    Value &operator[](const Key &key)
+    {
+        return *tryEmplace(key).first;
+    }
 
-        if (!Find(key).has_value())
+    Value &operator[](Key &&key)
+    {
+        return *tryEmplace(std::move(key)).first;
+    }
+
+    // returns a copy, use FindPtr to avoid it
+    std::optional<Value> Find(const Key &key) const
+    {
+        const Value *value = FindPtr(key);
+
+        if (value)
         {
-            m_table[index].EmplaceBack(std::move(key), std::move(value));
-            ++m_elements;
+            return *value;
         }
+        return std::nullopt;
     }
 
-    std::optional<Value> Find(const Key &key)
+    template <typename K>
+        requires isHeterogeneous<K>
+    std::optional<Value> Find(const K &key) const
     {
-        SizeType index = hash(key);
+        const Value *value = FindPtr(key);
 
-        for (auto &[existingKey, value] : m_table[index])
+        if (value)
         {
-            if (key == existingKey)
-            {
-                return value;
-            }
+            return *value;
         }
         return std::nullopt;
     }
 
+    /**
+     * @brief Zero-copy lookup
+     *
+     * @return Pointer to the stored value or nullptr, valid until the element is erased
+     */
+    Value *FindPtr(const Key &key)
+    {
+        migrationStep();
+        return findValue(*this, key, hashOf(key));
+    }
+
+    const Value *FindPtr(const Key &key) const
+    {
+        return findValue(*this, key, hashOf(key));
+    }
+
+    template <typename K>
+        requires isHeterogeneous<K>
+    Value *FindPtr(const K &key)
+    {
+        migrationStep();
+        return findValue(*this, key, hashOf(key));
+    }
+
+    template <typename K>
+        requires isHeterogeneous<K>
+    const Value *FindPtr(const K &key) const
+    {
+        return findValue(*this, key, hashOf(key));
+    }
+
+    bool Contains(const Key &key) const
+    {
+        return FindPtr(key) != nullptr;
+    }
+
+    template <typename K>
+        requires isHeterogeneous<K>
+    bool Contains(const K &key) const
+    {
+        return FindPtr(key) != nullptr;
+    }
+
+    /**
+     * @brief Looks up a batch of keys, overlapping their cache misses
+     *
+     * Keys are processed HT_BATCH_SIZE at a time: all of them are hashed and their buckets prefetched, then the first
+     * node of every non-empty chain is prefetched, and only then are the chains walked. For tables much larger than
+     * the last level cache this keeps many memory accesses in flight instead of stalling on one at a time.
+     *
+     * @param out Receives a pointer to each key's value, or nullptr, at the key's position
+     */
+    void FindBatch(std::span<const Key> keys, std::span<Value *> out)
+    {
+        assert(out.size() >= keys.size() && "HashTable::FindBatch output is smaller than the batch");
+        findBatch(*this, keys, [&](SizeType i, Value *value) { out[i] = value; });
+    }
+
+    void FindBatch(std::span<const Key> keys, std::span<const Value *> out) const
+    {
+        assert(out.size() >= keys.size() && "HashTable::FindBatch output is smaller than the batch");
+        findBatch(*this, keys, [&](SizeType i, const Value *value) { out[i] = value; });
+    }
+
+    void ContainsBatch(std::span<const Key> keys, std::span<bool> out) const
+    {
+        assert(out.size() >= keys.size() && "HashTable::ContainsBatch output is smaller than the batch");
+        findBatch(*this, keys, [&](SizeType i, const Value *value) { out[i] = value != nullptr; });
+    }
+
     void Erase(const Key &key)
     {
-        SizeType index = hash(key);
+        erase(key);
+    }
+
+    template <typename K>
+        requires isHeterogeneous<K>
+    void Erase(const K &key)
+    {
+        erase(key);
+    }
+
+    // keeps the bucket array
+    void Clear()
+    {
+        freeChains(m_buckets, 0, m_capacity);
+        endMigration();
+        m_elements = 0;
+    }
+
+    /**
+     * @brief Redistributes the elements over requestedCapacity buckets
+     *
+     * Nodes are relinked using their stored hash, nothing is copied or hashed again.
+     *
+     * @param requestedCapacity Rounded up to the next power of two, and to what the max load factor needs
+     */
+    void Rehash(const SizeType &requestedCapacity)
+    {
+        assert(requestedCapacity > 0 && "HashTable::Rehash attempt to resize to <=0");
+
+        const SizeType newCapacity = rehashCapacity(requestedCapacity);
+        finishMigration();
 
-        Chain &chain = m_table[index];
+        Node **newBuckets = allocateBuckets(newCapacity);
+        relinkBuckets(newBuckets, newCapacity, 0, std::min(m_capacity, newCapacity));
 
-        for (auto it = chain.begin(); it != chain.end(); ++it)
+        freeBuckets(m_buckets, m_capacity);
+        m_buckets = newBuckets;
+        m_capacity = newCapacity;
+    }
+
+    /**
+     * @brief Rehash that splits the relinking over pool
+     *
+     * With power-of-two capacities every new bucket is fed by old buckets that no other new bucket reads from: when
+     * growing, new bucket j only takes nodes from old bucket j mod old capacity, when shrinking, new bucket j takes
+     * old buckets j, j + new capacity, ... So each task owns a range of buckets on both sides and needs no locks,
+     * and visits its old buckets in the serial order: the result is exactly what Rehash(requestedCapacity) gives.
+     *
+     * Tables under HT_PARALLEL_THRESHOLD elements are rehashed on the calling thread.
+     */
+    void Rehash(const SizeType &requestedCapacity, ThreadPool &pool)
+    {
+        assert(requestedCapacity > 0 && "HashTable::Rehash attempt to resize to <=0");
+
+        const SizeType newCapacity = rehashCapacity(requestedCapacity);
+        const SizeType span = std::min(m_capacity, newCapacity);
+        const SizeType tasks = parallelTasks(pool, m_elements, span);
+
+        if (tasks < 2)
         {
-            auto [existingKey, value] = *it;
-            if (existingKey == key)
-            {
-                chain.Erase(it);
-                --m_elements;
-                return;
-            }
+            Rehash(requestedCapacity);
+            return;
         }
+
+        finishMigration();
+
+        Node **newBuckets = allocateBuckets(newCapacity);
+        pool.Run(tasks, [&](SizeType task) {
+            auto [first, last] = taskRange(task, tasks, span);
+            relinkBuckets(newBuckets, newCapacity, first, last);
+        });
+
+        freeBuckets(m_buckets, m_capacity);
+        m_buckets = newBuckets;
+        m_capacity = newCapacity;
     }
 
-    void Clear()
+    /**
+     * @brief Inserts every element of [first, last), large batches in parallel on ThreadPool::Get()
+     *
+     * Same result as calling Insert on each element in order: the first occurrence of a key wins, keys already in
+     * the table keep their value, and the chains come out in the same order whatever the number of threads.
+     */
+    template <typename It>
+        requires isRandomAccess<It>
+    void BulkInsert(It first, It last)
     {
-        for (auto &chain : m_table)
+        if (static_cast<SizeType>(last - first) < HT_PARALLEL_THRESHOLD)
         {
-            chain.Clear();
+            bulkInsertSerial(first, last);
+        }
+        else
+        {
+            BulkInsert(first, last, ThreadPool::Get());
         }
-
-        m_table.Clear();
     }
 
-    void Rehash(const SizeType &newCapacity)
+    /**
+     * @brief BulkInsert on the given pool
+     *
+     * The table grows once for all the elements, then:
+     * 1. each task allocates the nodes of a slice of the input and hashes their keys, counting how many land in
+     *    each partition, a contiguous range of buckets,
+     * 2. the node pointers are scattered into one array grouped by partition, keeping the input order within each,
+     * 3. each task links the nodes of its partitions, which no other task touches, dropping keys already present.
+     *
+     * With an allocator other than std::allocator the node memory is allocated up front and the dropped nodes freed
+     * at the end, both on the calling thread. Hasher and KeyEqual are called from several threads at once. Duplicates
+     * in the input still count when sizing
+     * the table. If constructing an element or hashing it throws, the table is left as it was (apart from having
+     * grown) and the exception is rethrown.
+     */
+    template <typename It>
+        requires isRandomAccess<It>
+    void BulkInsert(It first, It last, ThreadPool &pool)
     {
-        assert(newCapacity > 0 && "HashTable::Resize attempt to resize to <=0");
+        const SizeType count = static_cast<SizeType>(last - first);
+        const SizeType chunks = parallelTasks(pool, count, count);
 
-        Table newTable;
-        newTable.Reserve(newCapacity);
-        newTable.Resize(newCapacity);
+        if (chunks < 2)
+        {
+            bulkInsertSerial(first, last);
+            return;
+        }
+
+        reserveFor(m_elements + count, &pool);
+
+        const SizeType partitions = std::min(m_capacity, std::bit_ceil(pool.ThreadCount() * 4));
+        const int shift = std::countr_zero(m_capacity) - std::countr_zero(partitions);
+
+        // all allocated up front, so nothing but the element and key operations can throw once nodes exist
+        std::vector<Node *> nodes(count, nullptr);
+        std::vector<SizeType> offsets(chunks * partitions, 0); // counts per [chunk][partition], then start offsets
+        std::vector<SizeType> partitionStart(partitions + 1, 0);
+        std::vector<Node *> grouped(count);
+        std::vector<SizeType> inserted(partitions, 0);
 
-        for (SizeType i = 0; i < m_capacity; ++i)
+        std::vector<Node *> memory; // the allocator's part of phase 1, when it can't be called from the tasks
+        if constexpr (!concurrentAllocation)
         {
-            Chain &current = m_table[i];
-            for (auto it = current.begin(); it != current.end(); ++it)
+            memory.reserve(count);
+            try
             {
-                const auto &[existingKey, value] = *it;
+                for (SizeType i = 0; i < count; ++i)
+                {
+                    memory.push_back(NodeTraits::allocate(m_allocator, 1));
+                }
+            }
+            catch (...)
+            {
+                deallocateNodes(memory);
+                throw;
+            }
+        }
 
-                SizeType newIndex = hash(existingKey, newCapacity);
-                Chain &newChain = newTable[newIndex];
-                typename Chain::Iterator tempIt = it;
-                --it;
-                newChain.Splice(newChain.end(), current, tempIt);
+        try
+        {
+            pool.Run(chunks, [&](SizeType chunk) {
+                auto [begin, end] = taskRange(chunk, chunks, count);
+                SizeType *counts = &offsets[chunk * partitions];
+
+                for (SizeType i = begin; i < end; ++i)
+                {
+                    const SizeType h = hashOf((*(first + i)).first);
+                    if constexpr (concurrentAllocation)
+                    {
+                        nodes[i] = createNode(nullptr, h, *(first + i));
+                    }
+                    else
+                    {
+                        nodes[i] = new (memory[i]) Node(nullptr, h, *(first + i));
+                    }
+                    ++counts[bucketIndex(h, m_capacity) >> shift];
+                }
+            });
+        }
+        catch (...)
+        {
+            for (Node *node : nodes)
+            {
+                if (!node)
+                {
+                    continue;
+                }
+
+                if constexpr (concurrentAllocation)
+                {
+                    destroyNode(node);
+                }
+                else
+                {
+                    node->~Node();
+                }
             }
+            deallocateNodes(memory);
+            throw;
         }
 
-        m_table = std::move(newTable);
-        m_capacity = newCapacity;
+        // partition-major, so a partition's nodes are contiguous and its chunks follow in input order
+        SizeType offset = 0;
+        for (SizeType partition = 0; partition < partitions; ++partition)
+        {
+            partitionStart[partition] = offset;
+            for (SizeType chunk = 0; chunk < chunks; ++chunk)
+            {
+                const SizeType chunkCount = offsets[chunk * partitions + partition];
+                offsets[chunk * partitions + partition] = offset;
+                offset += chunkCount;
+            }
+        }
+        partitionStart[partitions] = offset;
+
+        pool.Run(chunks, [&](SizeType chunk) {
+            auto [begin, end] = taskRange(chunk, chunks, count);
+            SizeType *cursors = &offsets[chunk * partitions];
+
+            for (SizeType i = begin; i < end; ++i)
+            {
+                grouped[cursors[bucketIndex(nodes[i]->hash, m_capacity) >> shift]++] = nodes[i];
+            }
+        });
+
+        // a node leaves grouped once it is linked (or destroyed as a duplicate), what is left still has to be freed
+        auto linked = [&] {
+            for (SizeType partitionInserted : inserted)
+            {
+                m_elements += partitionInserted;
+            }
+            for (Node *node : grouped)
+            {
+                if (node)
+                {
+                    destroyNode(node);
+                }
+            }
+        };
+
+        try
+        {
+            pool.Run(partitions, [&](SizeType partition) {
+                for (SizeType i = partitionStart[partition]; i < partitionStart[partition + 1]; ++i)
+                {
+                    Node *node = grouped[i];
+                    Node *&head = m_buckets[bucketIndex(node->hash, m_capacity)];
+
+                    if (findInChain(head, node->value.first, node->hash))
+                    {
+                        if constexpr (concurrentAllocation)
+                        {
+                            destroyNode(node);
+                            grouped[i] = nullptr;
+                        }
+                    }
+                    else
+                    {
+                        node->next = head;
+                        head = node;
+                        grouped[i] = nullptr;
+                        ++inserted[partition];
+                    }
+                }
+            });
+        }
+        catch (...)
+        {
+            // the nodes linked before the throw stay in the table
+            linked();
+            throw;
+        }
+
+        // only the dropped duplicates are left
+        linked();
+    }
+
+    Iterator begin() noexcept
+    {
+        return Iterator(this, m_migrated, Rehashing());
+    }
+
+    Iterator end() noexcept
+    {
+        return Iterator();
+    }
+
+    ConstIterator begin() const noexcept
+    {
+        return ConstIterator(this, m_migrated, Rehashing());
+    }
+
+    ConstIterator end() const noexcept
+    {
+        return ConstIterator();
+    }
+
+    ConstIterator cbegin() const noexcept
+    {
+        return begin();
+    }
+
+    ConstIterator cend() const noexcept
+    {
+        return end();
+    }
+
+    /**
+     * @brief Builds an immutable single-probe copy of the table for read-only phases
+     *
+     * The copy hashes and compares keys with icb::Hash and operator==, not with this table's Hasher and KeyEqual.
+     *
+     * @throws std::runtime_error in the unlikely case two keys have the same full hash
+     */
+    FrozenHashTable<Key, Value> Freeze() const
+    {
+        return FrozenHashTable<Key, Value>(begin(), end());
     }
 
     bool Empty() const
@@ -158,23 +781,616 @@ template <typename Key, typename Value> class HashTable
         return m_elements;
     }
 
+    SizeType BucketCount() const
+    {
+        return m_capacity;
+    }
+
+    Hasher HashFunction() const
+    {
+        return m_hasher;
+    }
+
+    KeyEqual KeyEq() const
+    {
+        return m_keyEqual;
+    }
+
+    float LoadFactor() const
+    {
+        return m_capacity ? static_cast<float>(m_elements) / static_cast<float>(m_capacity) : 0.0f;
+    }
+
+    /**
+     * @brief Walks every chain and reports how the keys are spread over the buckets, O(size + bucket count)
+     *
+     * Meant to catch a poor hash or an unlucky key distribution before it shows up as latency: a max chain length
+     * or average probe length well above what the load factor predicts means many keys share buckets.
+     * During an incremental rehash the old buckets that still hold keys are counted too, lookups walk them as well.
+     */
+    HashTableStats Stats() const
+    {
+        HashTableStats stats;
+        stats.size = m_elements;
+        stats.bucketCount = m_capacity;
+        stats.loadFactor = LoadFactor();
+
+        SizeType probes = 0;
+        auto countChains = [&](Node *const *buckets, SizeType first, SizeType last) {
+            for (SizeType i = first; i < last; ++i)
+            {
+                SizeType length = 0;
+                for (const Node *node = buckets[i]; node; node = node->next)
+                {
+                    ++length;
+                }
+
+                if (length >= stats.chainLengthHistogram.size())
+                {
+                    stats.chainLengthHistogram.resize(length + 1);
+                }
+                ++stats.chainLengthHistogram[length];
+                stats.maxChainLength = std::max(stats.maxChainLength, length);
+                probes += length * (length + 1) / 2;
+            }
+        };
+
+        countChains(m_buckets, 0, m_capacity);
+        if (Rehashing())
+        {
+            countChains(m_oldBuckets, m_migrated, m_oldCapacity);
+        }
+
+        stats.emptyBuckets = stats.chainLengthHistogram.empty() ? 0 : stats.chainLengthHistogram[0];
+        stats.averageProbeLength = m_elements ? static_cast<double>(probes) / static_cast<double>(m_elements) : 0.0;
+        return stats;
+    }
+
+    float MaxLoadFactor() const
+    {
+        return m_maxLoadFactor;
+    }
+
+    bool IncrementalRehash() const
+    {
+        return m_incrementalRehash;
+    }
+
+    /**
+     * @brief Spreads the rehash triggered by growth over the following operations
+     *
+     * When enabled, growing keeps the old bucket array next to the new one, and every Insert, Erase, TryEmplace,
+     * InsertOrAssign, operator[] and non-const FindPtr moves HT_REHASH_STEP old buckets over, so no single operation
+     * pays for moving the whole table. Lookups check both arrays until the migration is done.
+     * Const lookups never migrate, so they stay safe to call concurrently.
+     * An explicit Rehash() still completes in one go.
+     */
+    void IncrementalRehash(bool enable)
+    {
+        m_incrementalRehash = enable;
+        if (!enable)
+        {
+            finishMigration();
+        }
+    }
+
+    // an incremental rehash is in progress
+    bool Rehashing() const
+    {
+        return m_oldCapacity != 0;
+    }
+
+    /**
+     * @brief Sets the average chain length at which Insert grows the table, rehashing right away if it is exceeded
+     */
+    void MaxLoadFactor(float maxLoadFactor)
+    {
+        assert(maxLoadFactor > 0.0f && "HashTable::MaxLoadFactor has to be positive");
+
+        m_maxLoadFactor = maxLoadFactor;
+
+        if (static_cast<float>(m_elements) > static_cast<float>(m_capacity) * m_maxLoadFactor)
+        {
+            Rehash(m_capacity);
+        }
+    }
+
   private:
-    SizeType hash(const Key &key) noexcept
+    template <typename K, typename... Args> std::pair<Value *, bool> tryEmplace(K &&key, Args &&...args)
+    {
+        // hash once, the bucket index is recomputed from it if the table has to grow
+        const SizeType h = hashOf(key);
+        return tryEmplaceHashed(h, std::forward<K>(key), std::forward<Args>(args)...);
+    }
+
+    // h is the key's hash under m_hasher, computed by the caller
+    template <typename K, typename... Args>
+    std::pair<Value *, bool> tryEmplaceHashed(SizeType h, K &&key, Args &&...args)
+    {
+        migrationStep();
+        if (Value *existing = findValue(*this, key, h))
+        {
+            return {existing, false};
+        }
+
+        growIfNeeded();
+        return {&linkNew(h, std::piecewise_construct, std::forward_as_tuple(std::forward<K>(key)),
+                         std::forward_as_tuple(std::forward<Args>(args)...)),
+                true};
+    }
+
+    template <typename K, typename V> std::pair<Value *, bool> insertOrAssign(K &&key, V &&value)
     {
-        std::hash<Key> hasher;
-        return hasher(key) % m_capacity;
+        const SizeType h = hashOf(key);
+        return insertOrAssignHashed(h, std::forward<K>(key), std::forward<V>(value));
     }
 
-    SizeType hash(const Key &key, const SizeType &capacity) noexcept
+    template <typename K, typename V> std::pair<Value *, bool> insertOrAssignHashed(SizeType h, K &&key, V &&value)
     {
-        std::hash<Key> hasher;
-        return hasher(key) % capacity;
+        migrationStep();
+        if (Value *existing = findValue(*this, key, h))
+        {
+            *existing = std::forward<V>(value);
+            return {existing, false};
+        }
+
+        growIfNeeded();
+        return {&linkNew(h, std::forward<K>(key), std::forward<V>(value)), true};
+    }
+
+    template <typename K> Value *findPtrHashed(const K &key, SizeType h)
+    {
+        migrationStep();
+        return findValue(*this, key, h);
+    }
+
+    template <typename K> const Value *findPtrHashed(const K &key, SizeType h) const
+    {
+        return findValue(*this, key, h);
+    }
+
+    // new nodes go to the head of their chain
+    template <typename... Args> Value &linkNew(SizeType h, Args &&...args)
+    {
+        Node *&head = m_buckets[bucketIndex(h, m_capacity)];
+        head = createNode(head, h, std::forward<Args>(args)...);
+        ++m_elements;
+        return head->value.second;
+    }
+
+    template <typename K> void erase(const K &key)
+    {
+        // also keeps a moved-from table without buckets from indexing them
+        if (!m_elements)
+        {
+            return;
+        }
+
+        const SizeType h = hashOf(key);
+
+        migrationStep();
+        if (!eraseFromChain(m_buckets[bucketIndex(h, m_capacity)], key, h) && Rehashing())
+        {
+            SizeType oldIndex = bucketIndex(h, m_oldCapacity);
+            if (oldIndex >= m_migrated)
+            {
+                eraseFromChain(m_oldBuckets[oldIndex], key, h);
+            }
+        }
+    }
+
+    template <typename K> bool eraseFromChain(Node *&head, const K &key, SizeType h)
+    {
+        for (Node **link = &head; *link; link = &(*link)->next)
+        {
+            Node *node = *link;
+            if (node->hash == h && m_keyEqual(node->value.first, key))
+            {
+                *link = node->next;
+                destroyNode(node);
+                --m_elements;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // shared by the const and non-const lookups, Self carries the constness
+    template <typename Self, typename K> static auto findValue(Self &self, const K &key, SizeType h)
+    {
+        using ValuePointer = std::conditional_t<std::is_const_v<Self>, const Value *, Value *>;
+
+        if (!self.m_elements)
+        {
+            return static_cast<ValuePointer>(nullptr);
+        }
+
+        Node *node = self.findInChain(self.m_buckets[bucketIndex(h, self.m_capacity)], key, h);
+
+        // buckets below m_migrated have already been moved to the new array
+        if (!node && self.Rehashing())
+        {
+            SizeType oldIndex = bucketIndex(h, self.m_oldCapacity);
+            if (oldIndex >= self.m_migrated)
+            {
+                node = self.findInChain(self.m_oldBuckets[oldIndex], key, h);
+            }
+        }
+        return node ? static_cast<ValuePointer>(&node->value.second) : static_cast<ValuePointer>(nullptr);
+    }
+
+    template <typename Self, typename Fn> static void findBatch(Self &self, std::span<const Key> keys, Fn &&emit)
+    {
+        if (!self.m_elements)
+        {
+            for (SizeType i = 0; i < keys.size(); ++i)
+            {
+                emit(i, nullptr);
+            }
+            return;
+        }
+
+        SizeType hashes[HT_BATCH_SIZE];
+
+        for (SizeType first = 0; first < keys.size(); first += HT_BATCH_SIZE)
+        {
+            const SizeType count = std::min<SizeType>(HT_BATCH_SIZE, keys.size() - first);
+
+            for (SizeType i = 0; i < count; ++i)
+            {
+                hashes[i] = self.hashOf(keys[first + i]);
+                detail::Prefetch(&self.m_buckets[bucketIndex(hashes[i], self.m_capacity)]);
+            }
+
+            // the bucket lines are (hopefully) in by now, so reading the head pointers doesn't stall for long
+            for (SizeType i = 0; i < count; ++i)
+            {
+                if (const Node *head = self.m_buckets[bucketIndex(hashes[i], self.m_capacity)])
+                {
+                    detail::Prefetch(head);
+                }
+            }
+
+            for (SizeType i = 0; i < count; ++i)
+            {
+                emit(first + i, findValue(self, keys[first + i], hashes[i]));
+            }
+        }
+    }
+
+    // the stored hash filters out nearly every mismatch before the keys are compared
+    template <typename K> Node *findInChain(Node *node, const K &key, SizeType h) const
+    {
+        for (; node; node = node->next)
+        {
+            if (node->hash == h && m_keyEqual(node->value.first, key))
+            {
+                return node;
+            }
+        }
+        return nullptr;
+    }
+
+    // first node in bucket or after it, the unmigrated old buckets come before the new ones
+    Node *firstNodeFrom(SizeType &bucket, bool &inOld) const noexcept
+    {
+        if (inOld)
+        {
+            for (; bucket < m_oldCapacity; ++bucket)
+            {
+                if (m_oldBuckets[bucket])
+                {
+                    return m_oldBuckets[bucket];
+                }
+            }
+            inOld = false;
+            bucket = 0;
+        }
+
+        for (; bucket < m_capacity; ++bucket)
+        {
+            if (m_buckets[bucket])
+            {
+                return m_buckets[bucket];
+            }
+        }
+        return nullptr;
+    }
+
+    // grows once up front, so the loop below links exactly as the parallel path does
+    template <typename It> void bulkInsertSerial(It first, It last)
+    {
+        reserveFor(m_elements + static_cast<SizeType>(last - first), nullptr);
+
+        for (; first != last; ++first)
+        {
+            tryEmplace((*first).first, (*first).second);
+        }
+    }
+
+    // finishes any migration and grows to hold elements without passing the max load factor
+    void reserveFor(SizeType elements, ThreadPool *pool)
+    {
+        finishMigration();
+
+        if (static_cast<float>(elements) > static_cast<float>(m_capacity) * m_maxLoadFactor)
+        {
+            const auto needed = static_cast<SizeType>(std::ceil(static_cast<float>(elements) / m_maxLoadFactor));
+            if (pool)
+            {
+                Rehash(std::max(needed, SizeType(HT_INIT_CAPACITY)), *pool);
+            }
+            else
+            {
+                Rehash(std::max(needed, SizeType(HT_INIT_CAPACITY)));
+            }
+        }
+    }
+
+    // number of tasks to split work over, 1 (stay serial) for small tables or a single thread
+    static SizeType parallelTasks(const ThreadPool &pool, SizeType elements, SizeType work) noexcept
+    {
+        if (pool.ThreadCount() < 2 || elements < HT_PARALLEL_THRESHOLD)
+        {
+            return 1;
+        }
+        return std::clamp(work / HT_PARALLEL_GRAIN, SizeType(1), pool.ThreadCount() * 4);
+    }
+
+    // [first, last) of the task-th of tasks even slices of count
+    static std::pair<SizeType, SizeType> taskRange(SizeType task, SizeType tasks, SizeType count) noexcept
+    {
+        return {count * task / tasks, count * (task + 1) / tasks};
+    }
+
+    SizeType rehashCapacity(SizeType requestedCapacity) const noexcept
+    {
+        SizeType newCapacity = normalizeCapacity(requestedCapacity);
+        while (static_cast<float>(m_elements) > static_cast<float>(newCapacity) * m_maxLoadFactor)
+        {
+            newCapacity *= 2;
+        }
+        return newCapacity;
+    }
+
+    /*
+     * Relinks the old buckets feeding new buckets [first, last) mod the smaller of the two capacities. Every new
+     * bucket still receives its old buckets in increasing order, as a plain loop over the old array would do.
+     */
+    void relinkBuckets(Node **newBuckets, SizeType newCapacity, SizeType first, SizeType last) noexcept
+    {
+        const SizeType span = std::min(m_capacity, newCapacity);
+
+        for (SizeType base = 0; base < m_capacity; base += span)
+        {
+            for (SizeType i = first; i < last; ++i)
+            {
+                relinkChain(m_buckets[base + i], newBuckets, newCapacity);
+            }
+        }
+    }
+
+    // doubles the bucket count when one more element would exceed the max load factor
+    void growIfNeeded()
+    {
+        if (static_cast<float>(m_elements + 1) > static_cast<float>(m_capacity) * m_maxLoadFactor)
+        {
+            if (!m_capacity)
+            {
+                Rehash(HT_INIT_CAPACITY);
+            }
+            else if (m_incrementalRehash)
+            {
+                startMigration(m_capacity * 2);
+            }
+            else
+            {
+                Rehash(m_capacity * 2);
+            }
+        }
+    }
+
+    /*
+     * The new bucket array is still allocated and zeroed up front, which is O(buckets) but only a memset of head
+     * pointers. Moving the nodes, the expensive part, is left to migrationStep().
+     */
+    void startMigration(SizeType newCapacity)
+    {
+        // only happens if growth outpaces the migration, e.g. with a very low max load factor
+        finishMigration();
+
+        m_oldBuckets = m_buckets;
+        m_oldCapacity = m_capacity;
+        m_migrated = 0;
+
+        m_buckets = allocateBuckets(newCapacity);
+        m_capacity = newCapacity;
+    }
+
+    void migrationStep()
+    {
+        for (SizeType step = 0; step < HT_REHASH_STEP && Rehashing(); ++step)
+        {
+            migrateBucket();
+        }
+    }
+
+    void finishMigration()
+    {
+        while (Rehashing())
+        {
+            migrateBucket();
+        }
+    }
+
+    void migrateBucket()
+    {
+        relinkChain(m_oldBuckets[m_migrated], m_buckets, m_capacity);
+
+        if (++m_migrated == m_oldCapacity)
+        {
+            endMigration();
+        }
+    }
+
+    void endMigration()
+    {
+        freeChains(m_oldBuckets, m_migrated, m_oldCapacity);
+        freeBuckets(m_oldBuckets, m_oldCapacity);
+
+        m_oldBuckets = nullptr;
+        m_oldCapacity = 0;
+        m_migrated = 0;
+    }
+
+    // moves every node of the chain to the head of its chain in buckets, leaving head empty
+    static void relinkChain(Node *&head, Node **buckets, SizeType capacity) noexcept
+    {
+        Node *node = head;
+        while (node)
+        {
+            Node *next = node->next;
+            Node *&newHead = buckets[bucketIndex(node->hash, capacity)];
+            node->next = newHead;
+            newHead = node;
+            node = next;
+        }
+        head = nullptr;
+    }
+
+    void freeChains(Node **buckets, SizeType first, SizeType last) noexcept
+    {
+        for (SizeType i = first; i < last; ++i)
+        {
+            Node *node = buckets[i];
+            while (node)
+            {
+                Node *next = node->next;
+                destroyNode(node);
+                node = next;
+            }
+            buckets[i] = nullptr;
+        }
+    }
+
+    // copies, or moves when other is an rvalue, every element of other into this empty table
+    template <typename Other> void cloneNodes(Other &&other)
+    {
+        m_maxLoadFactor = other.m_maxLoadFactor;
+        m_incrementalRehash = other.m_incrementalRehash;
+
+        for (auto it = other.begin(); it != other.end(); ++it)
+        {
+            Node *&head = m_buckets[bucketIndex(it.m_node->hash, m_capacity)];
+            if constexpr (std::is_rvalue_reference_v<Other &&>)
+            {
+                head = createNode(head, it.m_node->hash, it->first, std::move(it->second));
+            }
+            else
+            {
+                head = createNode(head, it.m_node->hash, *it);
+            }
+            ++m_elements;
+        }
+    }
+
+    template <typename... Args> Node *createNode(Args &&...args)
+    {
+        Node *node = NodeTraits::allocate(m_allocator, 1);
+        try
+        {
+            return new (node) Node(std::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+            NodeTraits::deallocate(m_allocator, node, 1);
+            throw;
+        }
+    }
+
+    void destroyNode(Node *node) noexcept
+    {
+        node->~Node();
+        NodeTraits::deallocate(m_allocator, node, 1);
+    }
+
+    void deallocateNodes(const std::vector<Node *> &memory) noexcept
+    {
+        for (Node *node : memory)
+        {
+            NodeTraits::deallocate(m_allocator, node, 1);
+        }
+    }
+
+    Node **allocateBuckets(SizeType capacity)
+    {
+        BucketAllocator allocator(m_allocator);
+        Node **buckets = BucketTraits::allocate(allocator, capacity);
+        std::fill_n(buckets, capacity, nullptr);
+        return buckets;
+    }
+
+    void freeBuckets(Node **buckets, SizeType capacity) noexcept
+    {
+        if (buckets)
+        {
+            BucketAllocator allocator(m_allocator);
+            BucketTraits::deallocate(allocator, buckets, capacity);
+        }
+    }
+
+    void swap(HashTable &other) noexcept
+    {
+        std::swap(m_buckets, other.m_buckets);
+        std::swap(m_capacity, other.m_capacity);
+        std::swap(m_elements, other.m_elements);
+        std::swap(m_maxLoadFactor, other.m_maxLoadFactor);
+        std::swap(m_oldBuckets, other.m_oldBuckets);
+        std::swap(m_oldCapacity, other.m_oldCapacity);
+        std::swap(m_migrated, other.m_migrated);
+        std::swap(m_incrementalRehash, other.m_incrementalRehash);
+        std::swap(m_hasher, other.m_hasher);
+        std::swap(m_keyEqual, other.m_keyEqual);
+    }
+
+    // capacity is always a power of two, so the bucket index is a mask instead of a division
+    static SizeType bucketIndex(SizeType h, SizeType capacity) noexcept
+    {
+        return h & (capacity - 1);
+    }
+
+    template <typename K> SizeType hashOf(const K &key) const
+    {
+        return static_cast<SizeType>(m_hasher(key));
+    }
+
+    static SizeType normalizeCapacity(SizeType capacity) noexcept
+    {
+        return std::bit_ceil(capacity ? capacity : SizeType(1));
     }
 
   private:
-    Table m_table;
+    [[no_unique_address]] NodeAllocator m_allocator;
+    Node **m_buckets = nullptr;
     SizeType m_capacity = 0;
     SizeType m_elements = 0;
+    float m_maxLoadFactor = HT_MAX_LOAD_FACTOR;
+
+    // incremental rehash: m_oldBuckets [m_migrated, m_oldCapacity) still hold elements
+    Node **m_oldBuckets = nullptr;
+    SizeType m_oldCapacity = 0;
+    SizeType m_migrated = 0;
+    bool m_incrementalRehash = false;
+
+    Hasher m_hasher;
+    KeyEqual m_keyEqual;
 };
 
-} // namespace icb
\ No newline at end of file
+namespace pmr
+{
+// a HashTable whose nodes and buckets come from a std::pmr::memory_resource
+template <typename Key, typename Value, typename Hasher = Hash<Key>, typename KeyEqual = std::equal_to<>>
+using HashTable =
+    icb::HashTable<Key, Value, Hasher, KeyEqual, std::pmr::polymorphic_allocator<std::pair<const Key, Value>>>;
+} // namespace pmr
+} // namespace icb
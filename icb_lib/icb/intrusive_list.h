@@ -0,0 +1,443 @@
+/**
+ * @file intrusive_list.h
+ * @author Dovydas Ciomenas (icouldbreathe@icloud.com)
+ * @brief Doubly linked list threaded through hooks embedded in the elements
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#pragma once
+
+#include <assert.h>
+#include <iterator>
+#include <type_traits>
+
+namespace icb
+{
+namespace detail
+{
+struct ListLink
+{
+    ListLink *prev = nullptr;
+    ListLink *next = nullptr;
+
+    void linkBefore(ListLink *position) noexcept
+    {
+        prev = position->prev;
+        next = position;
+        position->prev->next = this;
+        position->prev = this;
+    }
+
+    void unlink() noexcept
+    {
+        prev->next = next;
+        next->prev = prev;
+        prev = next = nullptr;
+    }
+};
+} // namespace detail
+
+// tag of the hook an IntrusiveList uses when it isn't given one
+struct DefaultListTag;
+
+/**
+ * @brief Base class that lets a T sit in an IntrusiveList<T, Tag>
+ *
+ * Derive from one hook per list the object has to be in at the same time, each with its own Tag. A hook holds two
+ * pointers and is either in one list or in none.
+ *
+ * A plain hook asserts that its object isn't destroyed while still in a list. With AutoUnlink (see
+ * AutoUnlinkListHook) the destructor takes the object out of its list instead, and Unlink can be called directly;
+ * lists of such objects can't know their size without counting it.
+ *
+ * Copying an object doesn't copy its list membership: a copied hook starts unlinked, assigning leaves it as it was.
+ */
+template <typename Tag = DefaultListTag, bool AutoUnlink = false> class ListHook : private detail::ListLink
+{
+  public:
+    ListHook() = default;
+
+    ListHook(const ListHook &) noexcept
+    {
+    }
+
+    ListHook &operator=(const ListHook &) noexcept
+    {
+        return *this;
+    }
+
+    ~ListHook()
+    {
+        if constexpr (AutoUnlink)
+        {
+            Unlink();
+        }
+        else
+        {
+            assert(!IsLinked() && "ListHook destroyed while still in an IntrusiveList");
+        }
+    }
+
+    bool IsLinked() const noexcept
+    {
+        return next != nullptr;
+    }
+
+    // takes the object out of its list, if any
+    void Unlink() noexcept
+        requires AutoUnlink
+    {
+        if (IsLinked())
+        {
+            unlink();
+        }
+    }
+
+    template <typename, typename> friend class IntrusiveList;
+};
+
+template <typename Tag = DefaultListTag> using AutoUnlinkListHook = ListHook<Tag, true>;
+
+/**
+ * @brief Doubly linked list of objects owned elsewhere, linked through their ListHook<Tag> base
+ *
+ * The list never allocates, copies or destroys an element: inserting links the object's hook, erasing unlinks it.
+ * Insert, Erase, Remove and Splice are O(1), and an object can be erased given only a reference to it. Objects have
+ * to stay alive (and in place) while they are in the list, Clear and the destructor unlink whatever is left.
+ *
+ * Size is O(1), except for objects with an AutoUnlinkListHook, which can leave the list on their own: then it counts.
+ */
+template <typename T, typename Tag = DefaultListTag> class IntrusiveList
+{
+  public:
+    using ValueType = T;
+    using SizeType = size_t;
+    using Reference = T &;
+    using Pointer = T *;
+
+  private:
+    static constexpr bool autoUnlink = std::is_base_of_v<ListHook<Tag, true>, T>;
+    using Hook = ListHook<Tag, autoUnlink>;
+    using Link = detail::ListLink;
+
+    static_assert(std::is_base_of_v<Hook, T>, "IntrusiveList element has to derive from ListHook<Tag>");
+
+    template <typename AccessType = T> class BaseIterator
+    {
+      public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using difference_type = std::ptrdiff_t;
+        using value_type = T;
+        using pointer = std::conditional_t<std::is_const_v<AccessType>, const T *, T *>;
+        using reference = std::conditional_t<std::is_const_v<AccessType>, const T &, T &>;
+        using self_type = BaseIterator<AccessType>;
+
+      public:
+        BaseIterator() = default;
+
+        // implicit conversion from Iterator to ConstIterator
+        template <typename WasAccessType,
+                  class = std::enable_if_t<std::is_const_v<AccessType> && !std::is_const_v<WasAccessType>>>
+        BaseIterator(const BaseIterator<WasAccessType> &other) noexcept : m_link(other.m_link)
+        {
+        }
+
+        // prefix ++
+        self_type &operator++() noexcept
+        {
+            m_link = m_link->next;
+            return *this;
+        }
+
+        // postfix ++
+        self_type operator++(int) noexcept
+        {
+            self_type previous = *this;
+            m_link = m_link->next;
+            return previous;
+        }
+
+        // prefix --
+        self_type &operator--() noexcept
+        {
+            m_link = m_link->prev;
+            return *this;
+        }
+
+        // postfix --
+        self_type operator--(int) noexcept
+        {
+            self_type previous = *this;
+            m_link = m_link->prev;
+            return previous;
+        }
+
+        reference operator*() const
+        {
+            assert(m_link && "IntrusiveList::Iterator::operator* nullptr dereference");
+            return *asElement(m_link);
+        }
+
+        pointer operator->() const
+        {
+            return asElement(m_link);
+        }
+
+        friend bool operator==(const self_type &x, const self_type &y) noexcept
+        {
+            return x.m_link == y.m_link;
+        }
+
+        friend bool operator!=(const self_type &x, const self_type &y) noexcept
+        {
+            return x.m_link != y.m_link;
+        }
+
+        friend class IntrusiveList;
+        template <typename> friend class BaseIterator;
+
+      private:
+        explicit BaseIterator(Link *link) noexcept : m_link(link)
+        {
+        }
+
+      private:
+        Link *m_link = nullptr;
+    };
+
+  public:
+    using Iterator = BaseIterator<T>;
+    using ConstIterator = BaseIterator<const T>;
+
+  public:
+    IntrusiveList() = default;
+
+    ~IntrusiveList()
+    {
+        Clear();
+    }
+
+    // an object can only be in one list per hook
+    IntrusiveList(const IntrusiveList &) = delete;
+    IntrusiveList &operator=(const IntrusiveList &) = delete;
+
+    // move ctor, takes over the elements
+    IntrusiveList(IntrusiveList &&other) noexcept
+    {
+        Splice(end(), other);
+    }
+
+    // move assignment, unlinks this list's elements first
+    IntrusiveList &operator=(IntrusiveList &&other) noexcept
+    {
+        if (this != &other)
+        {
+            Clear();
+            Splice(end(), other);
+        }
+        return *this;
+    }
+
+    void PushBack(T &value) noexcept
+    {
+        Insert(end(), value);
+    }
+
+    void PushFront(T &value) noexcept
+    {
+        Insert(begin(), value);
+    }
+
+    // links value before position, value mustn't be in a list through this hook already
+    Iterator Insert(ConstIterator position, T &value) noexcept
+    {
+        Link *link = asLink(value);
+        assert(!link->next && "IntrusiveList::Insert element is already in a list");
+
+        link->linkBefore(position.m_link);
+        ++m_size;
+        return Iterator(link);
+    }
+
+    // unlinks the element at position, returns the one after it
+    Iterator Erase(ConstIterator position) noexcept
+    {
+        assert(position.m_link != &m_end && "IntrusiveList::Erase end iterator");
+
+        Link *next = position.m_link->next;
+        position.m_link->unlink();
+        --m_size;
+        return Iterator(next);
+    }
+
+    // unlinks value, which has to be in this list
+    void Remove(T &value) noexcept
+    {
+        Erase(IteratorTo(value));
+    }
+
+    void PopFront() noexcept
+    {
+        assert(!Empty() && "IntrusiveList::PopFront empty list");
+        Erase(begin());
+    }
+
+    void PopBack() noexcept
+    {
+        assert(!Empty() && "IntrusiveList::PopBack empty list");
+        Erase(Iterator(m_end.prev));
+    }
+
+    // moves the element at it from other to before position
+    void Splice(ConstIterator position, IntrusiveList &other, ConstIterator it) noexcept
+    {
+        assert(it.m_link != &other.m_end && "IntrusiveList::Splice splicing the end node is undefined behavior");
+
+        if (position == it)
+        {
+            return;
+        }
+
+        it.m_link->unlink();
+        it.m_link->linkBefore(position.m_link);
+        --other.m_size;
+        ++m_size;
+    }
+
+    // moves all of other's elements before position
+    void Splice(ConstIterator position, IntrusiveList &other) noexcept
+    {
+        assert(&other != this && "IntrusiveList::Splice a list into itself");
+
+        if (other.m_end.next == &other.m_end)
+        {
+            return;
+        }
+
+        Link *first = other.m_end.next;
+        Link *last = other.m_end.prev;
+        Link *next = position.m_link;
+
+        first->prev = next->prev;
+        next->prev->next = first;
+        last->next = next;
+        next->prev = last;
+
+        m_size += other.m_size;
+        other.m_end.next = other.m_end.prev = &other.m_end;
+        other.m_size = 0;
+    }
+
+    // unlinks every element, none of them is destroyed
+    void Clear() noexcept
+    {
+        Link *link = m_end.next;
+        while (link != &m_end)
+        {
+            Link *next = link->next;
+            link->prev = link->next = nullptr;
+            link = next;
+        }
+
+        m_end.next = m_end.prev = &m_end;
+        m_size = 0;
+    }
+
+    // iterator to an element known to be in this list
+    Iterator IteratorTo(T &value) noexcept
+    {
+        assert(asLink(value)->next && "IntrusiveList::IteratorTo element isn't in a list");
+        return Iterator(asLink(value));
+    }
+
+    ConstIterator IteratorTo(const T &value) const noexcept
+    {
+        return ConstIterator(asLink(const_cast<T &>(value)));
+    }
+
+    Reference Front() const noexcept
+    {
+        assert(!Empty() && "IntrusiveList::Front empty list");
+        return *asElement(m_end.next);
+    }
+
+    Reference Back() const noexcept
+    {
+        assert(!Empty() && "IntrusiveList::Back empty list");
+        return *asElement(m_end.prev);
+    }
+
+    // O(n) for auto-unlink elements, they may have left without telling the list
+    SizeType Size() const noexcept
+    {
+        if constexpr (autoUnlink)
+        {
+            SizeType size = 0;
+            for (const Link *link = m_end.next; link != &m_end; link = link->next)
+            {
+                ++size;
+            }
+            return size;
+        }
+        else
+        {
+            return m_size;
+        }
+    }
+
+    bool Empty() const noexcept
+    {
+        return m_end.next == &m_end;
+    }
+
+    Iterator begin() noexcept
+    {
+        return Iterator(m_end.next);
+    }
+
+    Iterator end() noexcept
+    {
+        return Iterator(&m_end);
+    }
+
+    ConstIterator begin() const noexcept
+    {
+        return ConstIterator(m_end.next);
+    }
+
+    ConstIterator end() const noexcept
+    {
+        return ConstIterator(const_cast<Link *>(&m_end));
+    }
+
+    ConstIterator cbegin() const noexcept
+    {
+        return begin();
+    }
+
+    ConstIterator cend() const noexcept
+    {
+        return end();
+    }
+
+  private:
+    static Link *asLink(T &value) noexcept
+    {
+        return static_cast<Link *>(static_cast<Hook *>(&value));
+    }
+
+    static T *asElement(Link *link) noexcept
+    {
+        return static_cast<T *>(static_cast<Hook *>(link));
+    }
+
+  private:
+    Link m_end{&m_end, &m_end};
+    SizeType m_size = 0; // not kept up to date for auto-unlink elements
+};
+
+} // namespace icb
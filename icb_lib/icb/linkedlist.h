@@ -12,19 +12,40 @@
 #pragma once
 
 #include <assert.h>
+#include <functional>
 #include <iterator>
+#include <limits>
+#include <memory>
+#include <memory_resource>
 #include <new>
 #include <type_traits>
+#include <utility>
+
+#include "node_pool.h"
 
 namespace icb
 {
-template <typename T> class LinkedList
+/**
+ * @brief Doubly linked list around a sentry node
+ *
+ * Nodes come from a Pool when the list is given one, a block allocator shared with other lists of the same T. Without
+ * one every node is its own heap allocation, but nodes that are popped or erased are kept on a free list and reused by
+ * the next insertion, so a list with steady churn stops allocating once it has reached its peak size. ShrinkToFit
+ * frees them. Without a pool the nodes come from Allocator, rebound to the node type; it only provides the memory, the
+ * elements don't get it. Splicing between two lists needs both to use the same pool, or both none and equal
+ * allocators.
+ *
+ * Splice, Merge and Sort relink the nodes they are given and never allocate or copy an element, so iterators to the
+ * moved elements stay valid and now point into the receiving list.
+ */
+template <typename T, typename Allocator = std::allocator<T>> class LinkedList
 {
   public:
     using ValueType = T;
     using SizeType = size_t;
     using Reference = T &;
     using Pointer = T *;
+    using AllocatorType = Allocator;
 
   private:
     struct NodeLink
@@ -50,6 +71,13 @@ template <typename T> class LinkedList
         }
     };
 
+    // a chain of nodes outside of the list while Sort or Merge works on it, last->next is nullptr
+    struct Run
+    {
+        NodeLink *first = nullptr;
+        NodeLink *last = nullptr;
+    };
+
   private:
     template <typename AccessType = T> class BaseIterator
     {
@@ -143,53 +171,62 @@ template <typename T> class LinkedList
     using Iterator = BaseIterator<T>;
     using ConstIterator = BaseIterator<const T>;
 
+    // block allocator for the nodes, can be shared by any number of LinkedList<T>
+    using Pool = NodePool<sizeof(Node), alignof(Node)>;
+
+  private:
+    using NodeAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+    using NodeTraits = std::allocator_traits<NodeAllocator>;
+
   public:
     LinkedList() = default;
+
+    // the pool has to outlive the list
+    explicit LinkedList(Pool &pool) : m_pool(&pool)
+    {
+    }
+
+    explicit LinkedList(const Allocator &allocator) : m_allocator(allocator)
+    {
+    }
+
     ~LinkedList()
     {
-        while (m_end.next != &m_end)
-        {
-            Node *tmp = asNode(m_end.next);
-            m_end.next = m_end.next->next;
-            asNode(tmp)->value.~ValueType();
-            ::operator delete(asNode(tmp), sizeof(Node));
-        }
+        Clear();
+        ShrinkToFit();
     }
 
-    template <typename InputIterator> LinkedList(InputIterator first, InputIterator last)
+    template <typename InputIterator>
+    LinkedList(InputIterator first, InputIterator last, const Allocator &allocator = Allocator())
+        : m_allocator(allocator)
     {
         for (; first != last; ++first)
             PushBack(*first);
     }
 
-    LinkedList(std::initializer_list<ValueType> init) : LinkedList(init.begin(), init.end())
+    LinkedList(std::initializer_list<ValueType> init, const Allocator &allocator = Allocator())
+        : LinkedList(init.begin(), init.end(), allocator)
     {
     }
 
-    // copy ctor
-    LinkedList(const LinkedList &other) : LinkedList(other.cbegin(), other.cend())
+    // copy ctor, the copy allocates from the same pool
+    LinkedList(const LinkedList &other)
+        : m_pool(other.m_pool), m_allocator(NodeTraits::select_on_container_copy_construction(other.m_allocator))
     {
+        for (auto it = other.cbegin(); it != other.cend(); ++it)
+        {
+            PushBack(*it);
+        }
     }
 
-    // move ctor
-    LinkedList(LinkedList &&other) noexcept
+    // move ctor, takes over the nodes, the pool, the allocator and the free nodes
+    LinkedList(LinkedList &&other) noexcept : m_pool(other.m_pool), m_allocator(other.m_allocator)
     {
-        if (this != &other)
-        {
-            m_end = other.m_end;
-            m_size = other.m_size;
-
-            m_end.next->prev = &m_end;
-            m_end.prev->next = &m_end;
-
-            other.m_end.prev = &other.m_end;
-            other.m_end.next = &other.m_end;
-
-            other.m_size = 0;
-        }
+        takeNodes(other);
+        std::swap(m_free, other.m_free);
     }
 
-    // copy assignment
+    // copy assignment, keeps this list's pool and allocator
     LinkedList &operator=(const LinkedList &other)
     {
         if (this != &other)
@@ -203,21 +240,24 @@ template <typename T> class LinkedList
         return *this;
     }
 
-    // move assignment
-    LinkedList &operator=(LinkedList &&other) noexcept
+    // move assignment, keeps this list's pool and allocator: nodes from elsewhere are moved element by element
+    LinkedList &operator=(LinkedList &&other)
     {
         if (this != &other)
         {
             Clear();
-            m_end = other.m_end;
-            m_size = other.m_size;
-
-            m_end.next->prev = &m_end;
-            m_end.prev->next = &m_end;
-
-            other.m_end.next = &other.m_end;
-            other.m_end.prev = &other.m_end;
-            other.m_size = 0;
+            if (sharesNodes(other))
+            {
+                takeNodes(other);
+            }
+            else
+            {
+                for (auto it = other.begin(); it != other.end(); ++it)
+                {
+                    EmplaceBack(std::move(*it));
+                }
+                other.Clear();
+            }
         }
         return *this;
     }
@@ -225,146 +265,284 @@ template <typename T> class LinkedList
     // copy
     void PushBack(const ValueType &value)
     {
-        Node *newNode = new Node();
-        newNode->value = value;
-        newNode->next = &m_end;
-        if (m_size)
-        {
-            newNode->prev = m_end.prev;
-            m_end.prev->next = newNode;
-        }
-        else
-        {
-            newNode->prev = &m_end;
-            m_end.next = newNode;
-        }
-        m_end.prev = newNode;
-        ++m_size;
+        EmplaceBack(value);
     }
 
     // move
     void PushBack(ValueType &&value)
     {
-        Node *newNode = new Node();
-        newNode->value = std::move(value);
-        newNode->next = &m_end;
-        if (m_size)
-        {
-            newNode->prev = m_end.prev;
-            m_end.prev->next = newNode;
-        }
-        else
-        {
-            newNode->prev = &m_end;
-            m_end.next = newNode;
-        }
-        m_end.prev = newNode;
-        ++m_size;
+        EmplaceBack(std::move(value));
     }
 
     template <typename... Args> void EmplaceBack(Args &&...args)
     {
-        Node *newNode = new Node();
-        new (&newNode->value) ValueType(std::forward<Args>(args)...);
-        newNode->next = &m_end;
-        if (m_size)
-        {
-            newNode->prev = m_end.prev;
-            m_end.prev->next = newNode;
-        }
-        else
-        {
-            newNode->prev = &m_end;
-            m_end.next = newNode;
-        }
-        m_end.prev = newNode;
-        ++m_size;
+        linkBefore(&m_end, createNode(std::forward<Args>(args)...));
     }
 
     // copy
     void PushFront(const ValueType &value)
     {
-        Node *newNode = new Node();
-        newNode->value = value;
-        newNode->next = m_end.next;
-        newNode->prev = &m_end;
-        if (m_size)
-        {
-            m_end.next->prev = newNode;
-        }
-        else
+        EmplaceFront(value);
+    }
+
+    // move
+    void PushFront(ValueType &&value)
+    {
+        EmplaceFront(std::move(value));
+    }
+
+    template <typename... Args> void EmplaceFront(Args &&...args)
+    {
+        linkBefore(m_end.next, createNode(std::forward<Args>(args)...));
+    }
+
+    // copy
+    Iterator Insert(Iterator position, const ValueType &value)
+    {
+        return Emplace(position, value);
+    }
+
+    // move
+    Iterator Insert(Iterator position, ValueType &&value)
+    {
+        return Emplace(position, std::move(value));
+    }
+
+    /**
+     * @brief Constructs an element before position
+     *
+     * @return Iterator to the new element
+     */
+    template <typename... Args> Iterator Emplace(Iterator position, Args &&...args)
+    {
+        Node *node = createNode(std::forward<Args>(args)...);
+        linkBefore(getNodeLink(position), node);
+        return Iterator(node);
+    }
+
+    // moves the element at it from other to before position
+    void Splice(Iterator position, LinkedList &other, Iterator it)
+    {
+        assert(getNodeLink(position) && getNodeLink(it) && "LinkedList::Splice invalid iterators");
+        assert(!other.Empty() && "LinkedList::Splice attempt to splice an empty list");
+        assert(it != other.end() && "LinkedList::Splice splicing the end node is undefined behavior");
+        assert(sharesNodes(other) && "LinkedList::Splice lists allocate from different pools or allocators");
+
+        NodeLink *node = getNodeLink(it);
+        if (getNodeLink(position) == node || getNodeLink(position) == node->next)
         {
-            m_end.prev = newNode;
+            return;
         }
-        m_end.next = newNode;
+
+        relink(getNodeLink(position), node, node->next);
+        --other.m_size;
         ++m_size;
     }
 
-    // move
-    void PushFront(ValueType &&value)
+    // moves all of other's elements to before position, O(1)
+    void Splice(Iterator position, LinkedList &other)
     {
-        Node *newNode = new Node();
-        newNode->value = std::move(value);
-        newNode->next = m_end.next;
-        newNode->prev = &m_end;
-        if (m_size)
+        assert(&other != this && "LinkedList::Splice a list into itself");
+        assert(sharesNodes(other) && "LinkedList::Splice lists allocate from different pools or allocators");
+
+        if (other.Empty())
         {
-            m_end.next->prev = newNode;
+            return;
         }
-        else
+
+        relink(getNodeLink(position), other.m_end.next, &other.m_end);
+        m_size += other.m_size;
+        other.m_size = 0;
+    }
+
+    /**
+     * @brief Moves [first, last) from other to before position, position mustn't be inside the range
+     *
+     * O(1) within one list, otherwise the range is walked once to keep both sizes right. Use the overload taking the
+     * count when it is known.
+     */
+    void Splice(Iterator position, LinkedList &other, Iterator first, Iterator last)
+    {
+        if (&other == this)
         {
-            m_end.prev = newNode;
+            relink(getNodeLink(position), getNodeLink(first), getNodeLink(last));
+            return;
         }
-        m_end.next = newNode;
-        ++m_size;
+
+        Splice(position, other, first, last, static_cast<SizeType>(std::distance(first, last)));
     }
 
-    template <typename... Args> void EmplaceFront(Args &&...args)
+    // O(1), count has to be the distance from first to last
+    void Splice(Iterator position, LinkedList &other, Iterator first, Iterator last, SizeType count)
     {
-        Node *newNode = new Node();
-        new (&newNode->value) ValueType(std::forward<Args>(args)...);
-        newNode->next = m_end.next;
-        newNode->prev = &m_end;
-        if (m_size)
+        assert(sharesNodes(other) && "LinkedList::Splice lists allocate from different pools or allocators");
+
+        relink(getNodeLink(position), getNodeLink(first), getNodeLink(last));
+        other.m_size -= count;
+        m_size += count;
+    }
+
+    /**
+     * @brief Merges the sorted other into this sorted list, leaving other empty
+     *
+     * Stable: of equivalent elements, the ones from this list come first. Relinks the nodes, O(Size() + other.Size()).
+     * If comp throws, all of the elements are left in this list in an unspecified order, and other is empty.
+     */
+    template <typename Compare = std::less<>> void Merge(LinkedList &other, Compare comp = Compare())
+    {
+        assert(sharesNodes(other) && "LinkedList::Merge lists allocate from different pools or allocators");
+
+        if (&other == this || other.Empty())
         {
-            m_end.next->prev = newNode;
+            return;
         }
-        else
+
+        Run incoming = other.detachRun();
+        const SizeType incomingSize = std::exchange(other.m_size, 0);
+        if (Empty())
         {
-            m_end.prev = newNode;
+            m_size = incomingSize;
+            attachRun(incoming);
+            return;
         }
-        m_end.next = newNode;
-        ++m_size;
+
+        Run merged = detachRun();
+        m_size += incomingSize;
+        try
+        {
+            mergeRuns(merged, incoming, comp);
+        }
+        catch (...)
+        {
+            attachRun(merged);
+            throw;
+        }
+        attachRun(merged);
     }
 
-    void Splice(Iterator position, LinkedList &other, Iterator it)
+    /**
+     * @brief Stable sort by relinking the nodes, no element is copied or moved and nothing is allocated
+     *
+     * Bottom-up merge sort: single nodes are merged into runs of doubling length kept in bins, as in binary counting,
+     * and the bins are merged at the end. O(n log n) comparisons, O(1) extra memory. The prev links are kept up to
+     * date while merging, when the nodes are in cache anyway, rather than in a pass over the sorted list.
+     *
+     * If comp throws, the list keeps all of its elements in an unspecified order.
+     */
+    template <typename Compare = std::less<>> void Sort(Compare comp = Compare())
     {
-        assert(getNodeLink(position) && getNodeLink(it) && "LinkedList::Splice invalid iterators");
-        assert(!other.Empty() && "LinkedList::Splice attempt to splice an empty list");
-        assert(it != other.end() && "LinkedList::Splice splicing the end node is undefined behavior");
+        if (m_size < 2)
+        {
+            return;
+        }
 
-        NodeLink *prev = getNodeLink(std::prev(position));
-        NodeLink *next = getNodeLink(position);
+        // bins[i] holds a sorted run of 2^i nodes or nothing, higher bins hold earlier elements
+        Run bins[std::numeric_limits<SizeType>::digits] = {};
+        SizeType used = 0;
 
-        prev->next = getNodeLink(it);
-        next->prev = getNodeLink(it);
+        // every node is either in rest or in a bin, also when mergeRuns throws
+        Run rest = detachRun();
+        try
+        {
+            while (rest.first)
+            {
+                Run run{rest.first, rest.first};
+                rest.first = rest.first->next;
+                run.last->next = nullptr;
+
+                SizeType i = 0;
+                for (; i < used && bins[i].first; ++i)
+                {
+                    mergeRuns(bins[i], run, comp);
+                    run = std::exchange(bins[i], Run{});
+                }
+                if (i == used)
+                {
+                    ++used;
+                }
+                bins[i] = run;
+            }
 
-        getNodeLink(std::prev(it))->next = getNodeLink(it)->next;
-        getNodeLink(std::next(it))->prev = getNodeLink(it)->prev;
+            Run sorted{};
+            for (SizeType i = 0; i < used; ++i)
+            {
+                if (bins[i].first)
+                {
+                    if (sorted.first)
+                    {
+                        mergeRuns(bins[i], sorted, comp);
+                    }
+                    sorted = std::exchange(bins[i], Run{});
+                }
+            }
+            attachRun(sorted);
+        }
+        catch (...)
+        {
+            Run all = rest.first ? rest : Run{};
+            for (SizeType i = 0; i < used; ++i)
+            {
+                all = concatRuns(all, bins[i]);
+            }
+            attachRun(all);
+            throw;
+        }
+    }
 
-        getNodeLink(it)->prev = prev;
-        getNodeLink(it)->next = next;
+    /**
+     * @brief Erases every element but the first of each run of consecutive equal elements
+     *
+     * @return The number of elements erased
+     */
+    template <typename BinaryPredicate = std::equal_to<>> SizeType Unique(BinaryPredicate equal = BinaryPredicate())
+    {
+        const SizeType before = m_size;
+        if (m_size < 2)
+        {
+            return 0;
+        }
 
-        --other.m_size;
-        ++m_size;
+        for (Iterator kept = begin(), it = std::next(kept); it != end();)
+        {
+            if (equal(*kept, *it))
+            {
+                it = Erase(it);
+            }
+            else
+            {
+                kept = it++;
+            }
+        }
+        return before - m_size;
+    }
+
+    /**
+     * @brief Erases every element for which pred returns true
+     *
+     * @return The number of elements erased
+     */
+    template <typename Predicate> SizeType RemoveIf(Predicate pred)
+    {
+        const SizeType before = m_size;
+        for (Iterator it = begin(); it != end();)
+        {
+            if (pred(*it))
+            {
+                it = Erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+        return before - m_size;
     }
 
     void PopFront()
     {
         assert(!Empty() && "LinkedList::PopFront empty list");
         Node *second = asNode(m_end.next->next);
-        asNode(m_end.next)->value.~ValueType();
-        ::operator delete(asNode(m_end.next), sizeof(Node));
+        destroyNode(asNode(m_end.next));
         m_end.next = second;
         m_end.next->prev = &m_end;
         --m_size;
@@ -375,12 +553,12 @@ template <typename T> class LinkedList
         assert(!Empty() && "LinkedList::PopBack empty list");
         Node *previous = asNode(m_end.prev->prev);
         previous->next = &m_end;
-        asNode(m_end.prev)->value.~ValueType();
-        ::operator delete(asNode(m_end.prev), sizeof(Node));
+        destroyNode(asNode(m_end.prev));
         m_end.prev = previous;
         --m_size;
     }
 
+    // the nodes are kept for reuse, see ShrinkToFit
     void Clear()
     {
         if (Empty())
@@ -389,8 +567,7 @@ template <typename T> class LinkedList
         {
             Node *tmp = asNode(m_end.next);
             m_end.next = m_end.next->next;
-            asNode(tmp)->value.~ValueType();
-            ::operator delete(asNode(tmp), sizeof(Node));
+            destroyNode(tmp);
         }
 
         m_end.prev = &m_end;
@@ -398,6 +575,29 @@ template <typename T> class LinkedList
         m_size = 0;
     }
 
+    // frees the nodes kept for reuse, with a pool they already went back to it
+    void ShrinkToFit() noexcept
+    {
+        while (m_free)
+        {
+            NodeLink *next = m_free->next;
+            NodeTraits::deallocate(m_allocator, asNode(m_free), 1);
+            m_free = next;
+        }
+    }
+
+    // nullptr when the nodes are allocated one at a time
+    Pool *GetPool() const noexcept
+    {
+        return m_pool;
+    }
+
+    // where the nodes come from when there is no pool
+    Allocator GetAllocator() const noexcept
+    {
+        return Allocator(m_allocator);
+    }
+
     Iterator Erase(Iterator position)
     {
         assert(getNodeLink(position) && "LinkedList::Erase invalid iterator");
@@ -413,7 +613,7 @@ template <typename T> class LinkedList
         getNodeLink(std::prev(position))->next = next;
         next->prev = getNodeLink(position)->prev;
 
-        delete asNode(getNodeLink(position));
+        destroyNode(asNode(getNodeLink(position)));
 
         --m_size;
 
@@ -452,6 +652,16 @@ template <typename T> class LinkedList
         return Iterator(&m_end);
     }
 
+    ConstIterator begin() const noexcept
+    {
+        return ConstIterator(m_end.next);
+    }
+
+    ConstIterator end() const noexcept
+    {
+        return ConstIterator(&m_end);
+    }
+
     ConstIterator cbegin() const noexcept
     {
         return ConstIterator(m_end.next);
@@ -463,6 +673,198 @@ template <typename T> class LinkedList
     }
 
   private:
+    // raw storage, so the value is constructed exactly once and doesn't need to be default constructible
+    template <typename... Args> Node *createNode(Args &&...args)
+    {
+        void *memory;
+        if (m_pool)
+        {
+            memory = m_pool->Allocate();
+        }
+        else if (m_free)
+        {
+            memory = asNode(m_free);
+            m_free = m_free->next;
+        }
+        else
+        {
+            memory = NodeTraits::allocate(m_allocator, 1);
+        }
+
+        Node *node = static_cast<Node *>(memory);
+        try
+        {
+            new (&node->value) ValueType(std::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+            releaseNode(node);
+            throw;
+        }
+        return node;
+    }
+
+    void destroyNode(Node *node) noexcept
+    {
+        node->value.~ValueType();
+        releaseNode(node);
+    }
+
+    void releaseNode(Node *node) noexcept
+    {
+        if (m_pool)
+        {
+            m_pool->Deallocate(node);
+        }
+        else
+        {
+            node->next = m_free;
+            m_free = node;
+        }
+    }
+
+    void linkBefore(NodeLink *position, Node *node) noexcept
+    {
+        node->prev = position->prev;
+        node->next = position;
+        position->prev->next = node;
+        position->prev = node;
+        ++m_size;
+    }
+
+    // unlinks [first, last) and links it before position, the sizes are up to the caller
+    static void relink(NodeLink *position, NodeLink *first, NodeLink *last) noexcept
+    {
+        if (first == last)
+        {
+            return;
+        }
+
+        NodeLink *tail = last->prev;
+        first->prev->next = last;
+        last->prev = first->prev;
+
+        first->prev = position->prev;
+        tail->next = position;
+        position->prev->next = first;
+        position->prev = tail;
+    }
+
+    /**
+     * @brief Merges the sorted, non-empty run b into the sorted, non-empty run a, a wins ties
+     *
+     * The runs are doubly linked chains whose last node links to nullptr, so is the result. The first node's prev is
+     * left for the caller to set. If comp throws, a is left holding all of the nodes of both, merged up to that point.
+     */
+    template <typename Compare> static void mergeRuns(Run &a, Run b, Compare &comp)
+    {
+        NodeLink head;
+        NodeLink *tail = &head;
+        NodeLink *x = a.first;
+        NodeLink *y = b.first;
+        try
+        {
+            while (true)
+            {
+                if (comp(asNode(y)->value, asNode(x)->value))
+                {
+                    tail->next = y;
+                    y->prev = tail;
+                    tail = y;
+                    if (!(y = y->next))
+                    {
+                        tail->next = x;
+                        x->prev = tail;
+                        a = Run{head.next, a.last};
+                        return;
+                    }
+                }
+                else
+                {
+                    tail->next = x;
+                    x->prev = tail;
+                    tail = x;
+                    if (!(x = x->next))
+                    {
+                        tail->next = y;
+                        y->prev = tail;
+                        a = Run{head.next, b.last};
+                        return;
+                    }
+                }
+            }
+        }
+        catch (...)
+        {
+            // the merged part, then what is left of a, then what is left of b
+            tail->next = x;
+            x->prev = tail;
+            a.last->next = y;
+            y->prev = a.last;
+            a = Run{head.next, b.last};
+            throw;
+        }
+    }
+
+    // a followed by b, either may be empty
+    static Run concatRuns(Run a, Run b) noexcept
+    {
+        if (!a.first)
+        {
+            return b;
+        }
+        if (!b.first)
+        {
+            return a;
+        }
+        a.last->next = b.first;
+        b.first->prev = a.last;
+        return Run{a.first, b.last};
+    }
+
+    // unhooks the nodes from the sentry as a run, the list has to be non-empty and its size is left as it was
+    Run detachRun() noexcept
+    {
+        Run run{m_end.next, m_end.prev};
+        run.last->next = nullptr;
+        m_end.next = m_end.prev = &m_end;
+        return run;
+    }
+
+    // hooks a run onto the sentry of this list, which has to be empty
+    void attachRun(Run run) noexcept
+    {
+        m_end.next = run.first;
+        m_end.prev = run.last;
+        run.first->prev = &m_end;
+        run.last->next = &m_end;
+    }
+
+    // whether the nodes of one list can be freed by the other
+    bool sharesNodes(const LinkedList &other) const noexcept
+    {
+        return m_pool == other.m_pool && (m_pool || m_allocator == other.m_allocator);
+    }
+
+    // other's nodes become this list's, this list has to be empty
+    void takeNodes(LinkedList &other) noexcept
+    {
+        if (other.Empty())
+        {
+            return;
+        }
+
+        m_end.next = other.m_end.next;
+        m_end.prev = other.m_end.prev;
+        m_end.next->prev = &m_end;
+        m_end.prev->next = &m_end;
+        m_size = other.m_size;
+
+        other.m_end.next = &other.m_end;
+        other.m_end.prev = &other.m_end;
+        other.m_size = 0;
+    }
+
     static inline Node *asNode(NodeLink *node) noexcept
     {
         return static_cast<Node *>(node);
@@ -496,6 +898,14 @@ template <typename T> class LinkedList
   private:
     NodeLink m_end{&m_end, &m_end};
     SizeType m_size = 0;
+    Pool *m_pool = nullptr;
+    NodeLink *m_free = nullptr; // released nodes kept for reuse when there is no pool, linked through next
+    [[no_unique_address]] NodeAllocator m_allocator;
 };
 
+namespace pmr
+{
+// a LinkedList whose nodes come from a std::pmr::memory_resource
+template <typename T> using LinkedList = icb::LinkedList<T, std::pmr::polymorphic_allocator<T>>;
+} // namespace pmr
 } // namespace icb
@@ -0,0 +1,190 @@
+/**
+ * @file lru_cache.h
+ * @author Dovydas Ciomenas (icouldbreathe@icloud.com)
+ * @brief Bounded cache evicting the least recently used entry, a HashTable over a LinkedList
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#pragma once
+
+#include <assert.h>
+#include <iterator>
+#include <utility>
+
+#include "hash_table.h"
+#include "linkedlist.h"
+
+namespace icb
+{
+/**
+ * @brief Holds at most Capacity() entries, a Put beyond that evicts the entry that was used the longest time ago
+ *
+ * The entries live in a LinkedList ordered from most to least recently used, and a HashTable maps each key to its
+ * list node. A hit splices the node to the front of the list, so Get, Put and eviction are O(1) and a hit never
+ * allocates. An eviction reuses the evicted entry's list node for the new one. The index is sized for the capacity
+ * up front and never rehashes.
+ *
+ * Not thread-safe, even Get reorders the list. See ConcurrentClockCache for use from several threads.
+ */
+template <typename Key, typename Value> class LRUCache
+{
+  public:
+    using SizeType = size_t;
+    using Entry = std::pair<Key, Value>;
+    using List = LinkedList<Entry>;
+    using ConstIterator = typename List::ConstIterator;
+
+  private:
+    using Index = HashTable<Key, typename List::Iterator>;
+
+  public:
+    explicit LRUCache(const SizeType &capacity) : m_index(capacity), m_capacity(capacity)
+    {
+        assert(capacity > 0 && "LRUCache capacity has to be positive");
+    }
+
+    // the index stores list iterators, which a copied list doesn't share
+    LRUCache(const LRUCache &) = delete;
+    LRUCache &operator=(const LRUCache &) = delete;
+
+    /**
+     * @brief Looks the key up and marks it as the most recently used
+     *
+     * @return Pointer to the cached value or nullptr, valid until the entry is evicted or erased
+     */
+    Value *Get(const Key &key)
+    {
+        typename List::Iterator *node = m_index.FindPtr(key);
+        if (!node)
+        {
+            return nullptr;
+        }
+
+        touch(*node);
+        return &(**node).second;
+    }
+
+    // lookup that leaves the recency order alone
+    const Value *Peek(const Key &key) const
+    {
+        const typename List::Iterator *node = m_index.FindPtr(key);
+        return node ? &(**node).second : nullptr;
+    }
+
+    bool Contains(const Key &key) const
+    {
+        return m_index.Contains(key);
+    }
+
+    /**
+     * @brief Inserts or assigns the value and marks it as the most recently used, evicting if the cache is full
+     *
+     * @return Pointer to the cached value and whether the key was inserted
+     */
+    template <typename K, typename V> std::pair<Value *, bool> Put(K &&key, V &&value)
+    {
+        if (typename List::Iterator *node = m_index.FindPtr(key))
+        {
+            (**node).second = std::forward<V>(value);
+            touch(*node);
+            return {&(**node).second, false};
+        }
+
+        if (m_order.Size() == m_capacity)
+        {
+            // reuse the least recently used node, then move it to the front
+            typename List::Iterator last = std::prev(m_order.end());
+            m_index.Erase((*last).first);
+
+            (*last).first = std::forward<K>(key);
+            (*last).second = std::forward<V>(value);
+            touch(last);
+            m_index.Insert((*m_order.begin()).first, m_order.begin());
+        }
+        else
+        {
+            m_order.EmplaceFront(std::forward<K>(key), std::forward<V>(value));
+            m_index.Insert((*m_order.begin()).first, m_order.begin());
+        }
+        return {&(*m_order.begin()).second, true};
+    }
+
+    void Erase(const Key &key)
+    {
+        if (typename List::Iterator *node = m_index.FindPtr(key))
+        {
+            typename List::Iterator position = *node;
+            m_index.Erase(key);
+            m_order.Erase(position);
+        }
+    }
+
+    void Clear()
+    {
+        m_index.Clear();
+        m_order.Clear();
+    }
+
+    // the least recently used entry, the next one Put evicts when full
+    const Entry &Oldest() const
+    {
+        assert(!Empty() && "LRUCache::Oldest empty cache");
+        return m_order.Back();
+    }
+
+    // from the most to the least recently used entry
+    ConstIterator begin() const noexcept
+    {
+        return m_order.cbegin();
+    }
+
+    ConstIterator end() const noexcept
+    {
+        return m_order.cend();
+    }
+
+    ConstIterator cbegin() const noexcept
+    {
+        return m_order.cbegin();
+    }
+
+    ConstIterator cend() const noexcept
+    {
+        return m_order.cend();
+    }
+
+    SizeType Size() const
+    {
+        return m_order.Size();
+    }
+
+    SizeType Capacity() const
+    {
+        return m_capacity;
+    }
+
+    bool Empty() const
+    {
+        return m_order.Empty();
+    }
+
+  private:
+    void touch(typename List::Iterator node)
+    {
+        if (node != m_order.begin())
+        {
+            m_order.Splice(m_order.begin(), m_order, node);
+        }
+    }
+
+  private:
+    List m_order;
+    Index m_index;
+    SizeType m_capacity;
+};
+
+} // namespace icb
@@ -0,0 +1,651 @@
+/**
+ * @file mapped_hash_table.h
+ * @author Dovydas Ciomenas (icouldbreathe@icloud.com)
+ * @brief Read-only hash table (map) answered straight from a memory-mapped file
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <io.h> // _commit, _fileno
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "hash.h"
+#include "hash_table.h"
+
+#define MHT_FORMAT_VERSION 2
+#define MHT_SECTION_ALIGNMENT 64
+
+namespace icb
+{
+namespace detail
+{
+/**
+ * @brief Read-only mapping of a whole file, shared with every other process mapping it
+ */
+class FileMapping
+{
+  public:
+    FileMapping() = default;
+
+    // throws std::runtime_error if the file can't be opened or mapped
+    explicit FileMapping(const std::string &path)
+    {
+#if defined(_WIN32)
+        HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                  FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+        {
+            throw std::runtime_error("FileMapping: can't open " + path);
+        }
+
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(file, &size) || size.QuadPart == 0)
+        {
+            CloseHandle(file);
+            throw std::runtime_error("FileMapping: can't map empty or unreadable " + path);
+        }
+
+        // the view keeps the mapping object alive, both handles can go right away
+        HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        CloseHandle(file);
+        if (!mapping)
+        {
+            throw std::runtime_error("FileMapping: can't map " + path);
+        }
+
+        void *data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        CloseHandle(mapping);
+        if (!data)
+        {
+            throw std::runtime_error("FileMapping: can't map " + path);
+        }
+
+        m_data = static_cast<const unsigned char *>(data);
+        m_size = static_cast<size_t>(size.QuadPart);
+#else
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+        {
+            throw std::runtime_error("FileMapping: can't open " + path);
+        }
+
+        struct stat info;
+        if (::fstat(fd, &info) != 0 || info.st_size == 0)
+        {
+            ::close(fd);
+            throw std::runtime_error("FileMapping: can't map empty or unreadable " + path);
+        }
+
+        // the mapping stays valid after the descriptor is closed
+        void *data = ::mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (data == MAP_FAILED)
+        {
+            throw std::runtime_error("FileMapping: can't map " + path);
+        }
+
+        m_data = static_cast<const unsigned char *>(data);
+        m_size = static_cast<size_t>(info.st_size);
+#endif
+    }
+
+    ~FileMapping()
+    {
+        unmap();
+    }
+
+    FileMapping(const FileMapping &) = delete;
+    FileMapping &operator=(const FileMapping &) = delete;
+
+    FileMapping(FileMapping &&other) noexcept
+    {
+        std::swap(m_data, other.m_data);
+        std::swap(m_size, other.m_size);
+    }
+
+    FileMapping &operator=(FileMapping &&other) noexcept
+    {
+        if (this != &other)
+        {
+            unmap();
+            std::swap(m_data, other.m_data);
+            std::swap(m_size, other.m_size);
+        }
+        return *this;
+    }
+
+    const unsigned char *Data() const noexcept
+    {
+        return m_data;
+    }
+
+    size_t Size() const noexcept
+    {
+        return m_size;
+    }
+
+  private:
+    void unmap() noexcept
+    {
+        if (m_data)
+        {
+#if defined(_WIN32)
+            UnmapViewOfFile(m_data);
+#else
+            ::munmap(const_cast<unsigned char *>(m_data), m_size);
+#endif
+        }
+        m_data = nullptr;
+        m_size = 0;
+    }
+
+  private:
+    const unsigned char *m_data = nullptr;
+    size_t m_size = 0;
+};
+
+/**
+ * @brief File written under a temporary name next to path, which Commit() syncs and renames over path
+ *
+ * The rename replaces the directory entry only: processes that have the old file mapped keep its inode and never see
+ * a truncated or half-written file. Destroyed without Commit(), it removes the temporary file.
+ */
+class ReplacingFile
+{
+  public:
+    // throws std::runtime_error if the temporary file can't be created
+    explicit ReplacingFile(const std::string &path) : m_path(path), m_temporaryPath(temporaryPathFor(path))
+    {
+        m_file = std::fopen(m_temporaryPath.c_str(), "wb");
+        if (!m_file)
+        {
+            throw std::runtime_error("ReplacingFile: can't create " + m_temporaryPath);
+        }
+    }
+
+    ~ReplacingFile()
+    {
+        if (m_file)
+        {
+            std::fclose(m_file);
+            std::remove(m_temporaryPath.c_str());
+        }
+    }
+
+    ReplacingFile(const ReplacingFile &) = delete;
+    ReplacingFile &operator=(const ReplacingFile &) = delete;
+
+    std::FILE *Get() const noexcept
+    {
+        return m_file;
+    }
+
+    // throws std::runtime_error if the data can't be flushed to disk or the file can't be renamed over path
+    void Commit()
+    {
+        bool synced = std::fflush(m_file) == 0;
+#if defined(_WIN32)
+        synced = synced && _commit(_fileno(m_file)) == 0;
+#else
+        synced = synced && ::fsync(::fileno(m_file)) == 0;
+#endif
+        const bool closed = std::fclose(m_file) == 0;
+        m_file = nullptr;
+
+#if defined(_WIN32)
+        const bool renamed = synced && closed &&
+                             MoveFileExA(m_temporaryPath.c_str(), m_path.c_str(),
+                                         MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH);
+#else
+        const bool renamed = synced && closed && std::rename(m_temporaryPath.c_str(), m_path.c_str()) == 0;
+#endif
+        if (!renamed)
+        {
+            std::remove(m_temporaryPath.c_str());
+            throw std::runtime_error("ReplacingFile: can't write " + m_path);
+        }
+    }
+
+  private:
+    // unique per process and call, so concurrent writers of the same path don't share a temporary file
+    static std::string temporaryPathFor(const std::string &path)
+    {
+        static std::atomic<uint64_t> sequence{0};
+#if defined(_WIN32)
+        const uint64_t pid = GetCurrentProcessId();
+#else
+        const uint64_t pid = static_cast<uint64_t>(::getpid());
+#endif
+        return path + ".tmp." + std::to_string(pid) + "." + std::to_string(sequence.fetch_add(1));
+    }
+
+  private:
+    std::string m_path;
+    std::string m_temporaryPath;
+    std::FILE *m_file = nullptr;
+};
+
+// a std::string stored in the file's string section
+struct StringRef
+{
+    uint64_t offset;
+    uint64_t length;
+};
+
+/*
+ * How a key or value type is laid out in the file: strings go to the string section, anything else is stored as
+ * its bytes. Keys are hashed and compared by their bytes, so they can't have padding.
+ */
+template <typename T> struct MappedField
+{
+    static constexpr bool IsString = false;
+    static constexpr bool IsValidKey = std::is_trivially_copyable_v<T> && std::has_unique_object_representations_v<T>;
+    static constexpr bool IsValidValue = std::is_trivially_copyable_v<T>;
+
+    using Stored = T;
+    using View = T;
+};
+
+template <> struct MappedField<std::string>
+{
+    static constexpr bool IsString = true;
+    static constexpr bool IsValidKey = true;
+    static constexpr bool IsValidValue = true;
+
+    using Stored = StringRef;
+    using View = std::string_view;
+};
+} // namespace detail
+
+/**
+ * @brief HashTable contents written once to a file and read by mapping it, with no deserialization
+ *
+ * Write() lays the pairs out position-independently: a header, a bucket offset array, the entries sorted by bucket
+ * (each with its hash), and a section with the bytes of string keys and values that entries point into by offset.
+ * Opening a file only maps it; lookups hash the key, read the bucket's range and compare entries in place, so
+ * startup costs only the page faults of the pages actually touched, and processes mapping the same file share its
+ * physical pages.
+ *
+ * Keys are either std::string or trivially copyable without padding, values either std::string or trivially
+ * copyable. Hashes are computed with detail::HashBytes, which is stable across runs and builds. The format records
+ * the host's byte order and type sizes, and files are rejected when they don't match.
+ */
+template <typename Key, typename Value> class MappedHashTable
+{
+    using KeyField = detail::MappedField<Key>;
+    using ValueField = detail::MappedField<Value>;
+
+    static_assert(KeyField::IsValidKey, "MappedHashTable keys must be std::string or trivially copyable without padding");
+    static_assert(ValueField::IsValidValue, "MappedHashTable values must be std::string or trivially copyable");
+
+  public:
+    using SizeType = size_t;
+    using ValueView = typename ValueField::View; // std::string_view for string values, Value otherwise
+
+  private:
+    template <typename K> static constexpr bool isHeterogeneous = detail::IsHeterogeneous<Key, K>;
+
+    struct Header
+    {
+        char magic[8];
+        uint32_t version;
+        uint32_t byteOrder;
+        uint64_t entrySize;
+        uint64_t keySize;
+        uint64_t valueSize;
+        uint64_t count;
+        uint64_t bucketCount;
+        uint64_t bucketsOffset; // uint64_t[bucketCount + 1], bucket b holds entries [buckets[b], buckets[b + 1])
+        uint64_t entriesOffset; // Entry[count]
+        uint64_t stringsOffset;
+        uint64_t stringsSize;
+    };
+
+    struct Entry
+    {
+        uint64_t hash;
+        typename KeyField::Stored key;
+        typename ValueField::Stored value;
+    };
+
+    static constexpr char MAGIC[8] = {'I', 'C', 'B', 'M', 'H', 'T', '\0', '\0'};
+    static constexpr uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+  public:
+    // maps the file written by Write(), throws std::runtime_error if it can't be mapped or doesn't match the types
+    explicit MappedHashTable(const std::string &path) : m_file(path)
+    {
+        if (m_file.Size() < sizeof(Header))
+        {
+            throw std::runtime_error("MappedHashTable: " + path + " is too small");
+        }
+
+        std::memcpy(&m_header, m_file.Data(), sizeof(Header));
+        const Header &header = m_header;
+
+        if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != MHT_FORMAT_VERSION)
+        {
+            throw std::runtime_error("MappedHashTable: " + path + " is not a table file of this version");
+        }
+        if (header.byteOrder != BYTE_ORDER_MARK || header.entrySize != sizeof(Entry) ||
+            header.keySize != sizeof(typename KeyField::Stored) ||
+            header.valueSize != sizeof(typename ValueField::Stored))
+        {
+            throw std::runtime_error("MappedHashTable: " + path + " was written for different types or byte order");
+        }
+        if (!std::has_single_bit(header.bucketCount) || header.bucketCount + 1 == 0 ||
+            !fits(header.bucketsOffset, header.bucketCount + 1, sizeof(uint64_t), alignof(uint64_t)) ||
+            !fits(header.entriesOffset, header.count, sizeof(Entry), alignof(Entry)) ||
+            !fits(header.stringsOffset, header.stringsSize, 1, 1))
+        {
+            throw std::runtime_error("MappedHashTable: " + path + " is truncated or corrupt");
+        }
+
+        m_buckets = reinterpret_cast<const uint64_t *>(m_file.Data() + header.bucketsOffset);
+        m_entries = reinterpret_cast<const Entry *>(m_file.Data() + header.entriesOffset);
+        m_strings = reinterpret_cast<const char *>(m_file.Data() + header.stringsOffset);
+    }
+
+    MappedHashTable(const MappedHashTable &) = delete;
+    MappedHashTable &operator=(const MappedHashTable &) = delete;
+
+    // the source is left empty, its lookups find nothing
+    MappedHashTable(MappedHashTable &&other) noexcept
+        : m_file(std::move(other.m_file)), m_header(std::exchange(other.m_header, Header{})),
+          m_buckets(std::exchange(other.m_buckets, nullptr)), m_entries(std::exchange(other.m_entries, nullptr)),
+          m_strings(std::exchange(other.m_strings, nullptr))
+    {
+    }
+
+    MappedHashTable &operator=(MappedHashTable &&other) noexcept
+    {
+        if (this != &other)
+        {
+            m_file = std::move(other.m_file);
+            m_header = std::exchange(other.m_header, Header{});
+            m_buckets = std::exchange(other.m_buckets, nullptr);
+            m_entries = std::exchange(other.m_entries, nullptr);
+            m_strings = std::exchange(other.m_strings, nullptr);
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Writes the pairs of a range to path, replacing the file
+     *
+     * The table is written to a temporary file next to path, synced, and renamed over it. Tables already mapping
+     * path keep reading the old file, which goes away once the last of them is closed. Windows won't replace a
+     * mapped file, so there Write throws while any table maps path.
+     *
+     * @throws std::runtime_error if the file can't be written
+     */
+    template <std::forward_iterator ForwardIterator>
+    static void Write(ForwardIterator first, ForwardIterator last, const std::string &path)
+    {
+        const SizeType count = static_cast<SizeType>(std::distance(first, last));
+        const SizeType bucketCount = std::bit_ceil(count ? count : SizeType(1));
+
+        // zero-initialized, so padding inside the entries is written as zeros
+        std::unique_ptr<Entry[]> unsorted(new Entry[count]());
+        std::unique_ptr<uint64_t[]> buckets(new uint64_t[bucketCount + 1]());
+        std::string strings;
+
+        SizeType i = 0;
+        for (auto it = first; it != last; ++it, ++i)
+        {
+            unsorted[i].hash = hashOf(it->first);
+            unsorted[i].key = store<KeyField>(it->first, strings);
+            unsorted[i].value = store<ValueField>(it->second, strings);
+            ++buckets[(unsorted[i].hash & (bucketCount - 1)) + 1];
+        }
+
+        for (SizeType b = 0; b < bucketCount; ++b)
+        {
+            buckets[b + 1] += buckets[b];
+        }
+
+        std::unique_ptr<Entry[]> entries(new Entry[count]());
+        {
+            std::unique_ptr<uint64_t[]> fill(new uint64_t[bucketCount]);
+            std::memcpy(fill.get(), buckets.get(), bucketCount * sizeof(uint64_t));
+            for (i = 0; i < count; ++i)
+            {
+                std::memcpy(&entries[fill[unsorted[i].hash & (bucketCount - 1)]++], &unsorted[i], sizeof(Entry));
+            }
+        }
+        unsorted.reset();
+
+        Header header{};
+        std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+        header.version = MHT_FORMAT_VERSION;
+        header.byteOrder = BYTE_ORDER_MARK;
+        header.entrySize = sizeof(Entry);
+        header.keySize = sizeof(typename KeyField::Stored);
+        header.valueSize = sizeof(typename ValueField::Stored);
+        header.count = count;
+        header.bucketCount = bucketCount;
+        header.bucketsOffset = alignUp(sizeof(Header));
+        header.entriesOffset = alignUp(header.bucketsOffset + (bucketCount + 1) * sizeof(uint64_t));
+        header.stringsOffset = alignUp(header.entriesOffset + count * sizeof(Entry));
+        header.stringsSize = strings.size();
+
+        detail::ReplacingFile file(path);
+
+        uint64_t written = 0;
+        auto section = [&](uint64_t offset, const void *data, uint64_t size) {
+            static constexpr unsigned char zeros[MHT_SECTION_ALIGNMENT] = {};
+            if (std::fwrite(zeros, 1, offset - written, file.Get()) != offset - written ||
+                (size && std::fwrite(data, 1, size, file.Get()) != size))
+            {
+                throw std::runtime_error("MappedHashTable: can't write " + path);
+            }
+            written = offset + size;
+        };
+
+        section(0, &header, sizeof(Header));
+        section(header.bucketsOffset, buckets.get(), (bucketCount + 1) * sizeof(uint64_t));
+        section(header.entriesOffset, entries.get(), count * sizeof(Entry));
+        section(header.stringsOffset, strings.data(), strings.size());
+
+        file.Commit();
+    }
+
+    template <typename Hasher, typename KeyEqual, typename Allocator>
+    static void Write(const HashTable<Key, Value, Hasher, KeyEqual, Allocator> &table, const std::string &path)
+    {
+        Write(table.begin(), table.end(), path);
+    }
+
+    // string values are returned as views into the mapped file, valid as long as the table
+    std::optional<ValueView> Find(const Key &key) const
+    {
+        return find(key);
+    }
+
+    template <typename K>
+        requires isHeterogeneous<K>
+    std::optional<ValueView> Find(const K &key) const
+    {
+        return find(key);
+    }
+
+    // zero-copy lookup into the mapped pages, only for non-string values
+    const Value *FindPtr(const Key &key) const
+        requires(!ValueField::IsString)
+    {
+        const Entry *entry = findEntry(key);
+        return entry ? &entry->value : nullptr;
+    }
+
+    bool Contains(const Key &key) const
+    {
+        return findEntry(key) != nullptr;
+    }
+
+    template <typename K>
+        requires isHeterogeneous<K>
+    bool Contains(const K &key) const
+    {
+        return findEntry(key) != nullptr;
+    }
+
+    bool Empty() const
+    {
+        return !m_header.count;
+    }
+
+    SizeType Size() const
+    {
+        return static_cast<SizeType>(m_header.count);
+    }
+
+    SizeType BucketCount() const
+    {
+        return static_cast<SizeType>(m_header.bucketCount);
+    }
+
+  private:
+    template <typename K> std::optional<ValueView> find(const K &key) const
+    {
+        const Entry *entry = findEntry(key);
+
+        if (!entry)
+        {
+            return std::nullopt;
+        }
+        if constexpr (ValueField::IsString)
+        {
+            return view(entry->value);
+        }
+        else
+        {
+            return entry->value;
+        }
+    }
+
+    template <typename K> const Entry *findEntry(const K &key) const
+    {
+        if (!m_header.count)
+        {
+            return nullptr;
+        }
+
+        const uint64_t h = hashOf(key);
+        const uint64_t b = h & (m_header.bucketCount - 1);
+
+        // clamped, so a corrupt offset can't send the lookup outside the mapping
+        const uint64_t last = std::min(m_buckets[b + 1], m_header.count);
+        for (uint64_t i = m_buckets[b]; i < last; ++i)
+        {
+            const Entry &entry = m_entries[i];
+            if (entry.hash == h && keyEquals(entry.key, key))
+            {
+                return &entry;
+            }
+        }
+        return nullptr;
+    }
+
+    template <typename K> bool keyEquals(const typename KeyField::Stored &stored, const K &key) const
+    {
+        if constexpr (KeyField::IsString)
+        {
+            return view(stored) == std::string_view(key);
+        }
+        else
+        {
+            return stored == key;
+        }
+    }
+
+    std::string_view view(const detail::StringRef &ref) const noexcept
+    {
+        if (ref.offset > m_header.stringsSize || ref.length > m_header.stringsSize - ref.offset)
+        {
+            return {};
+        }
+        return std::string_view(m_strings + ref.offset, static_cast<size_t>(ref.length));
+    }
+
+    template <typename K> static uint64_t hashOf(const K &key) noexcept
+    {
+        if constexpr (KeyField::IsString)
+        {
+            std::string_view bytes(key);
+            return detail::HashBytes(bytes.data(), bytes.size());
+        }
+        else
+        {
+            return detail::HashBytes(&key, sizeof(Key));
+        }
+    }
+
+    template <typename Field, typename T>
+    static typename Field::Stored store(const T &field, std::string &strings)
+    {
+        if constexpr (Field::IsString)
+        {
+            detail::StringRef ref{strings.size(), field.size()};
+            strings.append(field);
+            return ref;
+        }
+        else
+        {
+            return field;
+        }
+    }
+
+    // count elements of elementSize bytes at offset are inside the file, divided rather than multiplied so a corrupt
+    // count can't overflow past the check
+    bool fits(uint64_t offset, uint64_t count, uint64_t elementSize, uint64_t alignment) const noexcept
+    {
+        return offset % alignment == 0 && offset <= m_file.Size() && count <= (m_file.Size() - offset) / elementSize;
+    }
+
+    static uint64_t alignUp(uint64_t offset) noexcept
+    {
+        return (offset + MHT_SECTION_ALIGNMENT - 1) / MHT_SECTION_ALIGNMENT * MHT_SECTION_ALIGNMENT;
+    }
+
+  private:
+    detail::FileMapping m_file;
+    Header m_header{};
+    const uint64_t *m_buckets = nullptr;
+    const Entry *m_entries = nullptr;
+    const char *m_strings = nullptr;
+};
+
+} // namespace icb
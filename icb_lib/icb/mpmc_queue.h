@@ -0,0 +1,201 @@
+/**
+ * @file mpmc_queue.h
+ * @author Dovydas Ciomenas (icouldbreathe@icloud.com)
+ * @brief Bounded lock-free queue for any number of producer and consumer threads
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <assert.h>
+#include <atomic>
+#include <bit>
+#include <new>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+#include "concurrent_hash_table.h" // ICB_CACHE_LINE_SIZE
+
+namespace icb
+{
+/**
+ * @brief Fixed-capacity FIFO that any number of threads push to and pop from, after Dmitry Vyukov's bounded queue
+ *
+ * Every slot of the ring carries a sequence number telling whose turn it is. A producer claims the slot at the
+ * enqueue position with one compare-and-swap once the slot's sequence says it is free for that lap, writes the
+ * element and bumps the sequence to hand it to consumers; consumers claim slots the same way from the dequeue
+ * position. The two positions sit on their own cache lines, and threads only contend on the position they advance.
+ *
+ * No locks and no allocation after construction. A thread stalled between claiming and releasing a slot holds up
+ * the other side at that slot, so the queue isn't lock-free in the strict sense, but no other thread ever waits on a
+ * lock. Elements have to be nothrow move constructible: they are built outside the ring and moved in, so a claimed
+ * slot is always released.
+ */
+template <typename T> class MPMCQueue
+{
+  public:
+    using ValueType = T;
+    using SizeType = size_t;
+
+    static_assert(std::is_nothrow_move_constructible_v<T>, "MPMCQueue elements have to be nothrow move constructible");
+
+  private:
+    // sequence == position: free for the producer at position, == position + 1: holds the element pushed there
+    struct Slot
+    {
+        std::atomic<SizeType> sequence;
+        alignas(T) unsigned char storage[sizeof(T)];
+
+        T *value() noexcept
+        {
+            return std::launder(reinterpret_cast<T *>(storage));
+        }
+    };
+
+    struct alignas(ICB_CACHE_LINE_SIZE) Position
+    {
+        std::atomic<SizeType> value{0};
+    };
+
+  public:
+    // capacity is rounded up to a power of two, at least 2
+    explicit MPMCQueue(SizeType capacity)
+        : m_capacity(std::bit_ceil(std::max(capacity, SizeType(2)))), m_mask(m_capacity - 1),
+          m_slots(static_cast<Slot *>(::operator new(m_capacity * sizeof(Slot), std::align_val_t(alignof(Slot)))))
+    {
+        assert(capacity > 0 && "MPMCQueue capacity has to be positive");
+
+        for (SizeType i = 0; i < m_capacity; ++i)
+        {
+            new (&m_slots[i]) Slot();
+            m_slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    ~MPMCQueue()
+    {
+        const SizeType tail = m_enqueue.value.load(std::memory_order_relaxed);
+        for (SizeType i = m_dequeue.value.load(std::memory_order_relaxed); i != tail; ++i)
+        {
+            m_slots[i & m_mask].value()->~T();
+        }
+        ::operator delete(m_slots, m_capacity * sizeof(Slot), std::align_val_t(alignof(Slot)));
+    }
+
+    MPMCQueue(const MPMCQueue &) = delete;
+    MPMCQueue &operator=(const MPMCQueue &) = delete;
+
+    // copy
+    bool TryPush(const T &value)
+    {
+        return TryPush(T(value));
+    }
+
+    // move, returns false when the queue is full
+    bool TryPush(T &&value) noexcept
+    {
+        SizeType position = m_enqueue.value.load(std::memory_order_relaxed);
+        Slot *slot;
+        while (true)
+        {
+            slot = &m_slots[position & m_mask];
+            const SizeType sequence = slot->sequence.load(std::memory_order_acquire);
+            const auto lap = static_cast<std::ptrdiff_t>(sequence - position);
+
+            if (lap == 0)
+            {
+                if (m_enqueue.value.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if (lap < 0)
+            {
+                // the slot still holds the element pushed a lap ago
+                return false;
+            }
+            else
+            {
+                position = m_enqueue.value.load(std::memory_order_relaxed);
+            }
+        }
+
+        new (slot->storage) T(std::move(value));
+        slot->sequence.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    template <typename... Args> bool TryEmplace(Args &&...args)
+    {
+        return TryPush(T(std::forward<Args>(args)...));
+    }
+
+    // empty when the queue is
+    std::optional<T> TryPop() noexcept
+    {
+        SizeType position = m_dequeue.value.load(std::memory_order_relaxed);
+        Slot *slot;
+        while (true)
+        {
+            slot = &m_slots[position & m_mask];
+            const SizeType sequence = slot->sequence.load(std::memory_order_acquire);
+            const auto lap = static_cast<std::ptrdiff_t>(sequence - (position + 1));
+
+            if (lap == 0)
+            {
+                if (m_dequeue.value.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if (lap < 0)
+            {
+                // nothing pushed at this position yet
+                return std::nullopt;
+            }
+            else
+            {
+                position = m_dequeue.value.load(std::memory_order_relaxed);
+            }
+        }
+
+        std::optional<T> value(std::move(*slot->value()));
+        slot->value()->~T();
+        slot->sequence.store(position + m_capacity, std::memory_order_release);
+        return value;
+    }
+
+    // a snapshot, concurrent pushes and pops may change it at any time
+    SizeType Size() const noexcept
+    {
+        const SizeType head = m_dequeue.value.load(std::memory_order_acquire);
+        const SizeType tail = m_enqueue.value.load(std::memory_order_acquire);
+        // claimed positions can briefly run ahead on either side
+        return tail > head ? std::min(tail - head, m_capacity) : 0;
+    }
+
+    bool Empty() const noexcept
+    {
+        return Size() == 0;
+    }
+
+    SizeType Capacity() const noexcept
+    {
+        return m_capacity;
+    }
+
+  private:
+    const SizeType m_capacity;
+    const SizeType m_mask;
+    Slot *const m_slots;
+    Position m_enqueue;
+    Position m_dequeue;
+};
+
+} // namespace icb
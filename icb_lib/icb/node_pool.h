@@ -0,0 +1,167 @@
+/**
+ * @file node_pool.h
+ * @author Dovydas Ciomenas (icouldbreathe@icloud.com)
+ * @brief Fixed-size node allocator carving nodes out of large blocks
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <assert.h>
+#include <cstddef>
+#include <new>
+
+#define NP_FIRST_BLOCK_NODES 32
+#define NP_MAX_BLOCK_NODES 4096
+
+namespace icb
+{
+/**
+ * @brief Hands out NodeSize-byte slots from blocks of many slots, and recycles freed ones through a free list
+ *
+ * Allocate pops the free list if it has a slot, otherwise takes the next unused slot of the newest block, and only
+ * calls operator new when that block is used up. Blocks start at NP_FIRST_BLOCK_NODES slots and double up to
+ * NP_MAX_BLOCK_NODES, so a container that fills up gets its nodes next to each other, in the order it made them.
+ *
+ * Memory goes back to the system only when the pool is destroyed or Release is called, never one slot at a time.
+ * Not thread-safe: containers sharing a pool have to be used from one thread at a time.
+ */
+template <size_t NodeSize, size_t NodeAlign> class NodePool
+{
+  public:
+    using SizeType = size_t;
+
+  private:
+    // a free slot holds the link to the next one
+    struct FreeSlot
+    {
+        FreeSlot *next;
+    };
+
+    // blocks are chained through a header at their start, the slots follow it
+    struct Block
+    {
+        Block *next;
+        SizeType slots;
+    };
+
+    static constexpr SizeType SLOT_ALIGN = std::max(NodeAlign, alignof(FreeSlot));
+    static constexpr SizeType SLOT_SIZE =
+        (std::max(NodeSize, sizeof(FreeSlot)) + SLOT_ALIGN - 1) / SLOT_ALIGN * SLOT_ALIGN;
+    static constexpr SizeType BLOCK_ALIGN = std::max(SLOT_ALIGN, alignof(Block));
+    static constexpr SizeType HEADER_SIZE = (sizeof(Block) + SLOT_ALIGN - 1) / SLOT_ALIGN * SLOT_ALIGN;
+
+  public:
+    NodePool() = default;
+
+    ~NodePool()
+    {
+        assert(!m_inUse && "NodePool destroyed while nodes are still allocated from it");
+        Release();
+    }
+
+    // containers keep pointers to their pool
+    NodePool(const NodePool &) = delete;
+    NodePool &operator=(const NodePool &) = delete;
+
+    void *Allocate()
+    {
+        ++m_inUse;
+
+        if (m_free)
+        {
+            FreeSlot *slot = m_free;
+            m_free = slot->next;
+            return slot;
+        }
+
+        if (m_cursor == m_blockEnd)
+        {
+            addBlock();
+        }
+
+        void *slot = m_cursor;
+        m_cursor += SLOT_SIZE;
+        return slot;
+    }
+
+    void Deallocate(void *node) noexcept
+    {
+        assert(m_inUse && "NodePool::Deallocate more nodes than were allocated");
+        --m_inUse;
+
+        m_free = new (node) FreeSlot{m_free};
+    }
+
+    // gives every block back, only valid once none of the nodes are in use
+    void Release() noexcept
+    {
+        assert(!m_inUse && "NodePool::Release while nodes are still allocated from it");
+
+        while (m_blocks)
+        {
+            Block *next = m_blocks->next;
+            ::operator delete(m_blocks, HEADER_SIZE + m_blocks->slots * SLOT_SIZE, std::align_val_t(BLOCK_ALIGN));
+            m_blocks = next;
+        }
+
+        m_free = nullptr;
+        m_cursor = m_blockEnd = nullptr;
+        m_slotCount = 0;
+        m_blockCount = 0;
+    }
+
+    // nodes currently allocated
+    SizeType InUse() const noexcept
+    {
+        return m_inUse;
+    }
+
+    // slots in all blocks, used or not
+    SizeType SlotCount() const noexcept
+    {
+        return m_slotCount;
+    }
+
+    SizeType BlockCount() const noexcept
+    {
+        return m_blockCount;
+    }
+
+    static constexpr SizeType SlotSize() noexcept
+    {
+        return SLOT_SIZE;
+    }
+
+  private:
+    void addBlock()
+    {
+        const SizeType slots =
+            m_blocks ? std::min(m_blocks->slots * 2, SizeType(NP_MAX_BLOCK_NODES)) : SizeType(NP_FIRST_BLOCK_NODES);
+
+        char *memory =
+            static_cast<char *>(::operator new(HEADER_SIZE + slots * SLOT_SIZE, std::align_val_t(BLOCK_ALIGN)));
+        m_blocks = new (memory) Block{m_blocks, slots};
+
+        m_cursor = memory + HEADER_SIZE;
+        m_blockEnd = m_cursor + slots * SLOT_SIZE;
+        m_slotCount += slots;
+        ++m_blockCount;
+    }
+
+  private:
+    FreeSlot *m_free = nullptr;
+    char *m_cursor = nullptr; // next never-used slot of the newest block
+    char *m_blockEnd = nullptr;
+    Block *m_blocks = nullptr;
+    SizeType m_inUse = 0;
+    SizeType m_slotCount = 0;
+    SizeType m_blockCount = 0;
+};
+
+} // namespace icb
@@ -0,0 +1,34 @@
+/**
+ * @file prefetch.h
+ * @author Dovydas Ciomenas (icouldbreathe@icloud.com)
+ * @brief Portable software prefetch hint
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#pragma once
+
+#if !defined(__GNUC__) && !defined(__clang__) && (defined(_M_X64) || defined(_M_IX86))
+#include <xmmintrin.h>
+#endif
+
+namespace icb
+{
+namespace detail
+{
+// asks for the cache line holding address to be loaded, never faults
+inline void Prefetch(const void *address) noexcept
+{
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(address);
+#elif defined(_M_X64) || defined(_M_IX86)
+    _mm_prefetch(static_cast<const char *>(address), _MM_HINT_T0);
+#else
+    (void)address;
+#endif
+}
+} // namespace detail
+} // namespace icb
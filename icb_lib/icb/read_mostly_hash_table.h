@@ -0,0 +1,334 @@
+/**
+ * @file read_mostly_hash_table.h
+ * @author Dovydas Ciomenas (icouldbreathe@icloud.com)
+ * @brief Hash table (map) with lock-free lookups and serialized writers, for read-mostly data
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#pragma once
+
+#include <assert.h>
+#include <atomic>
+#include <bit>
+#include <initializer_list>
+#include <mutex>
+#include <optional>
+
+#include <utility> // std::pair
+
+#include "epoch.h"
+#include "hash.h"
+
+#define RMHT_INIT_CAPACITY 16
+#define RMHT_MAX_LOAD_FACTOR 1.0f
+
+namespace icb
+{
+/**
+ * @brief Separate chaining like HashTable, but readers never lock
+ *
+ * Lookups only pin the EpochManager and follow atomic pointers. Writers take a mutex among themselves and publish
+ * every change with a single pointer store:
+ *  - Insert links a fully built node at the head of its chain
+ *  - InsertOrAssign replaces the node with an updated copy, so readers never see a half-written value
+ *  - Erase unlinks the node
+ *  - growing builds a complete new bucket array with copies of the nodes and swaps it in
+ *
+ * Whatever got unlinked is retired to the EpochManager and freed once no reader can hold it anymore.
+ * Values are returned by copy (Find) or visited while pinned (Visit), since a pointer could outlive the node.
+ */
+template <typename Key, typename Value> class ReadMostlyHashTable
+{
+  public:
+    using SizeType = size_t;
+    using Pair = std::pair<Key, Value>;
+
+  private:
+    template <typename K> static constexpr bool isHeterogeneous = detail::IsHeterogeneous<Key, K>;
+
+    struct Node
+    {
+        std::atomic<Node *> next;
+        const SizeType hash;
+        const Pair value;
+
+        template <typename K, typename V>
+        Node(Node *next, SizeType hash, K &&key, V &&value)
+            : next(next), hash(hash), value(std::forward<K>(key), std::forward<V>(value))
+        {
+        }
+    };
+
+    struct Table
+    {
+        SizeType capacity;
+        std::atomic<Node *> *buckets;
+
+        explicit Table(SizeType capacity) : capacity(capacity), buckets(new std::atomic<Node *>[capacity])
+        {
+            for (SizeType i = 0; i < capacity; ++i)
+            {
+                buckets[i].store(nullptr, std::memory_order_relaxed);
+            }
+        }
+
+        // frees the nodes as well, only once no reader can reach them
+        ~Table()
+        {
+            for (SizeType i = 0; i < capacity; ++i)
+            {
+                Node *node = buckets[i].load(std::memory_order_relaxed);
+                while (node)
+                {
+                    Node *next = node->next.load(std::memory_order_relaxed);
+                    delete node;
+                    node = next;
+                }
+            }
+            delete[] buckets;
+        }
+
+        std::atomic<Node *> &bucket(SizeType h) const noexcept
+        {
+            return buckets[h & (capacity - 1)];
+        }
+    };
+
+  public:
+    ReadMostlyHashTable(const SizeType &capacity = RMHT_INIT_CAPACITY)
+        : m_table(new Table(std::bit_ceil(capacity ? capacity : SizeType(1))))
+    {
+    }
+
+    ReadMostlyHashTable(std::initializer_list<Pair> il, const SizeType &capacity = RMHT_INIT_CAPACITY)
+        : ReadMostlyHashTable(capacity)
+    {
+        for (const auto &[key, value] : il)
+        {
+            Insert(key, value);
+        }
+    }
+
+    // no reader may still be using the table
+    ~ReadMostlyHashTable()
+    {
+        delete m_table.load(std::memory_order_relaxed);
+    }
+
+    ReadMostlyHashTable(const ReadMostlyHashTable &) = delete;
+    ReadMostlyHashTable &operator=(const ReadMostlyHashTable &) = delete;
+
+    // copy
+    void Insert(const Key &key, const Value &value)
+    {
+        insert(key, value, false);
+    }
+
+    // move
+    void Insert(Key &&key, Value &&value)
+    {
+        insert(std::move(key), std::move(value), false);
+    }
+
+    // returns whether the value was inserted rather than assigned
+    template <typename K, typename V> bool InsertOrAssign(K &&key, V &&value)
+    {
+        return insert(std::forward<K>(key), std::forward<V>(value), true);
+    }
+
+    void Erase(const Key &key)
+    {
+        erase(key);
+    }
+
+    template <typename K>
+        requires isHeterogeneous<K>
+    void Erase(const K &key)
+    {
+        erase(key);
+    }
+
+    std::optional<Value> Find(const Key &key) const
+    {
+        std::optional<Value> result;
+        Visit(key, [&](const Value &value) { result = value; });
+        return result;
+    }
+
+    template <typename K>
+        requires isHeterogeneous<K>
+    std::optional<Value> Find(const K &key) const
+    {
+        std::optional<Value> result;
+        Visit(key, [&](const Value &value) { result = value; });
+        return result;
+    }
+
+    template <typename K> bool Contains(const K &key) const
+    {
+        return Visit(key, [](const Value &) {});
+    }
+
+    /**
+     * @brief Lock-free lookup, calls fn(const Value &) while the node is protected
+     *
+     * @return Whether the key was found
+     */
+    template <typename K, typename Fn> bool Visit(const K &key, Fn &&fn) const
+    {
+        const SizeType h = detail::HashKey<Key>(key);
+        auto guard = EpochManager::Get().Pin();
+
+        const Table *table = m_table.load(std::memory_order_acquire);
+        for (Node *node = table->bucket(h).load(std::memory_order_acquire); node;
+             node = node->next.load(std::memory_order_acquire))
+        {
+            if (node->hash == h && node->value.first == key)
+            {
+                fn(node->value.second);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void Clear()
+    {
+        std::lock_guard lock(m_writeMutex);
+
+        Table *old = m_table.load(std::memory_order_relaxed);
+        m_table.store(new Table(old->capacity), std::memory_order_release);
+        m_size.store(0, std::memory_order_relaxed);
+        retire(old);
+    }
+
+    void Rehash(const SizeType &requestedCapacity)
+    {
+        assert(requestedCapacity > 0 && "ReadMostlyHashTable::Rehash attempt to resize to <=0");
+
+        std::lock_guard lock(m_writeMutex);
+        rehashLocked(std::bit_ceil(requestedCapacity));
+    }
+
+    bool Empty() const
+    {
+        return Size() == 0;
+    }
+
+    SizeType Size() const
+    {
+        return m_size.load(std::memory_order_relaxed);
+    }
+
+    SizeType BucketCount() const
+    {
+        return m_table.load(std::memory_order_acquire)->capacity;
+    }
+
+  private:
+    template <typename K, typename V> bool insert(K &&key, V &&value, bool assign)
+    {
+        const SizeType h = detail::HashKey<Key>(key);
+        std::lock_guard lock(m_writeMutex);
+
+        Table *table = m_table.load(std::memory_order_relaxed);
+        std::atomic<Node *> *link = &table->bucket(h);
+
+        for (Node *node = link->load(std::memory_order_relaxed); node; node = node->next.load(std::memory_order_relaxed))
+        {
+            if (node->hash == h && node->value.first == key)
+            {
+                if (assign)
+                {
+                    // copy-on-write: readers see either the old node or the complete new one
+                    Node *updated = new Node(node->next.load(std::memory_order_relaxed), h, std::forward<K>(key),
+                                             std::forward<V>(value));
+                    link->store(updated, std::memory_order_release);
+                    retire(node);
+                }
+                return false;
+            }
+            link = &node->next;
+        }
+
+        std::atomic<Node *> &head = table->bucket(h);
+        head.store(new Node(head.load(std::memory_order_relaxed), h, std::forward<K>(key), std::forward<V>(value)),
+                   std::memory_order_release);
+
+        SizeType size = m_size.load(std::memory_order_relaxed) + 1;
+        m_size.store(size, std::memory_order_relaxed);
+
+        if (static_cast<float>(size) > static_cast<float>(table->capacity) * RMHT_MAX_LOAD_FACTOR)
+        {
+            rehashLocked(table->capacity * 2);
+        }
+        return true;
+    }
+
+    template <typename K> void erase(const K &key)
+    {
+        const SizeType h = detail::HashKey<Key>(key);
+        std::lock_guard lock(m_writeMutex);
+
+        std::atomic<Node *> *link = &m_table.load(std::memory_order_relaxed)->bucket(h);
+        for (Node *node = link->load(std::memory_order_relaxed); node; node = node->next.load(std::memory_order_relaxed))
+        {
+            if (node->hash == h && node->value.first == key)
+            {
+                // readers standing on the node can still follow its next pointer
+                link->store(node->next.load(std::memory_order_relaxed), std::memory_order_release);
+                m_size.store(m_size.load(std::memory_order_relaxed) - 1, std::memory_order_relaxed);
+                retire(node);
+                return;
+            }
+            link = &node->next;
+        }
+    }
+
+    /*
+     * Nodes can't be relinked in place, a reader walking a chain would be moved into another one and miss keys.
+     * The new array gets copies instead, and the old array is retired together with its nodes.
+     */
+    void rehashLocked(SizeType capacity)
+    {
+        Table *old = m_table.load(std::memory_order_relaxed);
+        Table *table = new Table(capacity);
+
+        for (SizeType i = 0; i < old->capacity; ++i)
+        {
+            for (Node *node = old->buckets[i].load(std::memory_order_relaxed); node;
+                 node = node->next.load(std::memory_order_relaxed))
+            {
+                std::atomic<Node *> &head = table->bucket(node->hash);
+                head.store(new Node(head.load(std::memory_order_relaxed), node->hash, node->value.first,
+                                    node->value.second),
+                           std::memory_order_relaxed);
+            }
+        }
+
+        m_table.store(table, std::memory_order_release);
+        retire(old);
+    }
+
+    // the node keeps its next pointer, a reader standing on it may still need it
+    static void retire(Node *node)
+    {
+        EpochManager::Get().Retire(node, [](void *ptr) { delete static_cast<Node *>(ptr); });
+    }
+
+    static void retire(Table *table)
+    {
+        EpochManager::Get().Retire(table, [](void *ptr) { delete static_cast<Table *>(ptr); });
+    }
+
+  private:
+    std::atomic<Table *> m_table;
+    std::atomic<SizeType> m_size{0};
+    std::mutex m_writeMutex;
+};
+
+} // namespace icb
@@ -0,0 +1,718 @@
+/**
+ * @file robin_hood_hash_table.h
+ * @author Dovydas Ciomenas (icouldbreathe@icloud.com)
+ * @brief Unordered hash table (map) with Robin Hood open addressing and backward-shift deletion
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <assert.h>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <new>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+
+#include <utility> // std::pair
+
+#include "hash.h"
+
+#define RHHT_INIT_CAPACITY 16
+#define RHHT_MAX_LOAD_FACTOR 0.9f
+
+namespace icb
+{
+/**
+ * @brief Linear probing that keeps every probe sequence short by letting the "poorest" element win
+ *
+ * Each slot records its element's probe sequence length (PSL), the distance from the slot the hash points to.
+ * Inserting never leaves an element further from home than the one it would pass over, which keeps the elements of
+ * a cluster ordered by home slot and the PSL variance low even above 90% load. That order gives two more things:
+ *  - a lookup stops as soon as it reaches a slot whose PSL is shorter than its own, the key would have been there
+ *  - Erase shifts the rest of the cluster back by one slot instead of leaving a tombstone, so heavy insert/erase
+ *    churn doesn't degrade the table
+ *
+ * Slots also keep the top 32 bits of the hash, which both filter key comparisons and give the home slot, so
+ * rehashing never hashes a key again. Elements move on insert and erase: pointers from FindPtr and iterators are
+ * only valid until the next modification.
+ */
+template <typename Key, typename Value> class RobinHoodHashTable
+{
+  public:
+    using SizeType = size_t;
+    using Pair = std::pair<Key, Value>;
+
+  private:
+    template <typename K> static constexpr bool isHeterogeneous = detail::IsHeterogeneous<Key, K>;
+
+    struct Meta
+    {
+        uint32_t psl;  // probe sequence length + 1, 0 for an empty slot
+        uint32_t hash; // top bits of the hash, the top log2(capacity) of them are the home slot
+    };
+
+    // the meta sits next to its element, a lookup usually touches a single cache line
+    struct Slot
+    {
+        Meta meta;
+        alignas(Pair) unsigned char storage[sizeof(Pair)];
+
+        Pair &pair() noexcept
+        {
+            return *std::launder(reinterpret_cast<Pair *>(storage));
+        }
+
+        const Pair &pair() const noexcept
+        {
+            return *std::launder(reinterpret_cast<const Pair *>(storage));
+        }
+    };
+
+    static constexpr SizeType NPOS = static_cast<SizeType>(-1);
+    static constexpr SizeType MIN_CAPACITY = 8;
+
+    /**
+     * @brief Forward iterator over the elements, in slot order
+     *
+     * The key must not be modified through it.
+     */
+    template <typename AccessType = Pair> class BaseIterator
+    {
+      public:
+        using iterator_category = std::forward_iterator_tag;
+        using difference_type = std::ptrdiff_t;
+        using value_type = Pair;
+        using pointer = std::conditional_t<std::is_const_v<AccessType>, const Pair *, Pair *>;
+        using reference = std::conditional_t<std::is_const_v<AccessType>, const Pair &, Pair &>;
+        using self_type = BaseIterator<AccessType>;
+        using slot_ptr = std::conditional_t<std::is_const_v<AccessType>, const Slot *, Slot *>;
+
+      public:
+        BaseIterator() = default;
+
+        // implicit conversion from Iterator to ConstIterator
+        template <typename WasAccessType,
+                  class = std::enable_if_t<std::is_const_v<AccessType> && !std::is_const_v<WasAccessType>>>
+        BaseIterator(const BaseIterator<WasAccessType> &other) noexcept : m_slot(other.m_slot), m_end(other.m_end)
+        {
+        }
+
+        // prefix ++
+        self_type &operator++() noexcept
+        {
+            ++m_slot;
+            skipEmpty();
+            return *this;
+        }
+
+        // postfix ++
+        self_type operator++(int) noexcept
+        {
+            self_type previous = *this;
+            ++*this;
+            return previous;
+        }
+
+        reference operator*() const
+        {
+            assert(m_slot != m_end && "RobinHoodHashTable::Iterator::operator* end dereference");
+            return m_slot->pair();
+        }
+
+        pointer operator->() const
+        {
+            return &m_slot->pair();
+        }
+
+        friend bool operator==(const self_type &x, const self_type &y) noexcept
+        {
+            return x.m_slot == y.m_slot;
+        }
+
+        friend bool operator!=(const self_type &x, const self_type &y) noexcept
+        {
+            return x.m_slot != y.m_slot;
+        }
+
+        friend class RobinHoodHashTable;
+        template <typename> friend class BaseIterator;
+
+      private:
+        BaseIterator(slot_ptr slot, slot_ptr end) noexcept : m_slot(slot), m_end(end)
+        {
+            skipEmpty();
+        }
+
+        void skipEmpty() noexcept
+        {
+            while (m_slot != m_end && !m_slot->meta.psl)
+            {
+                ++m_slot;
+            }
+        }
+
+      private:
+        slot_ptr m_slot = nullptr;
+        slot_ptr m_end = nullptr;
+    };
+
+  public:
+    using Iterator = BaseIterator<Pair>;
+    using ConstIterator = BaseIterator<const Pair>;
+
+  public:
+    RobinHoodHashTable(const SizeType &capacity = RHHT_INIT_CAPACITY)
+    {
+        allocate(normalizeCapacity(capacity));
+    }
+
+    RobinHoodHashTable(std::initializer_list<Pair> il, const SizeType &capacity = RHHT_INIT_CAPACITY)
+        : RobinHoodHashTable(capacity)
+    {
+        for (const auto &[key, value] : il)
+        {
+            Insert(key, value);
+        }
+    }
+
+    ~RobinHoodHashTable()
+    {
+        destroySlots();
+        deallocate();
+    }
+
+    // copy ctor
+    RobinHoodHashTable(const RobinHoodHashTable &other) : RobinHoodHashTable(other.m_capacity)
+    {
+        m_maxLoadFactor = other.m_maxLoadFactor;
+
+        // the meta is filled in slot by slot, so a throwing copy leaves nothing half-built for the destructor
+        for (SizeType i = 0; i < other.m_capacity; ++i)
+        {
+            if (other.m_slots[i].meta.psl)
+            {
+                new (m_slots[i].storage) Pair(other.m_slots[i].pair());
+                m_slots[i].meta = other.m_slots[i].meta;
+                ++m_size;
+            }
+        }
+    }
+
+    // move ctor, other is left without storage and allocates again on its next insert
+    RobinHoodHashTable(RobinHoodHashTable &&other) noexcept
+    {
+        swap(other);
+    }
+
+    // copy assignment
+    RobinHoodHashTable &operator=(const RobinHoodHashTable &other)
+    {
+        if (this != &other)
+        {
+            RobinHoodHashTable copy(other);
+            swap(copy);
+        }
+        return *this;
+    }
+
+    // move assignment
+    RobinHoodHashTable &operator=(RobinHoodHashTable &&other) noexcept
+    {
+        if (this != &other)
+        {
+            RobinHoodHashTable moved(std::move(other));
+            swap(moved);
+        }
+        return *this;
+    }
+
+    // copy
+    void Insert(const Key &key, const Value &value)
+    {
+        tryEmplace(key, value);
+    }
+
+    // move
+    void Insert(Key &&key, Value &&value)
+    {
+        tryEmplace(std::move(key), std::move(value));
+    }
+
+    /**
+     * @brief Constructs the value from args, unless the key is already present
+     *
+     * @return Pointer to the value stored under key and whether it was inserted
+     */
+    template <typename... Args> std::pair<Value *, bool> TryEmplace(const Key &key, Args &&...args)
+    {
+        return tryEmplace(key, std::forward<Args>(args)...);
+    }
+
+    template <typename... Args> std::pair<Value *, bool> TryEmplace(Key &&key, Args &&...args)
+    {
+        return tryEmplace(std::move(key), std::forward<Args>(args)...);
+    }
+
+    // the Key is only built from K when it actually gets inserted
+    template <typename K, typename... Args>
+        requires isHeterogeneous<K>
+    std::pair<Value *, bool> TryEmplace(const K &key, Args &&...args)
+    {
+        return tryEmplace(key, std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Inserts the value, or assigns it over the existing one
+     *
+     * @return Pointer to the value stored under key and whether it was inserted
+     */
+    template <typename V> std::pair<Value *, bool> InsertOrAssign(const Key &key, V &&value)
+    {
+        return insertOrAssign(key, std::forward<V>(value));
+    }
+
+    template <typename V> std::pair<Value *, bool> InsertOrAssign(Key &&key, V &&value)
+    {
+        return insertOrAssign(std::move(key), std::forward<V>(value));
+    }
+
+    // default-constructs the value if the key is missing
+    Value &operator[](const Key &key)
+    {
+        return *tryEmplace(key).first;
+    }
+
+    Value &operator[](Key &&key)
+    {
+        return *tryEmplace(std::move(key)).first;
+    }
+
+    // returns a copy, use FindPtr to avoid it
+    std::optional<Value> Find(const Key &key) const
+    {
+        const Value *value = FindPtr(key);
+
+        if (value)
+        {
+            return *value;
+        }
+        return std::nullopt;
+    }
+
+    template <typename K>
+        requires isHeterogeneous<K>
+    std::optional<Value> Find(const K &key) const
+    {
+        const Value *value = FindPtr(key);
+
+        if (value)
+        {
+            return *value;
+        }
+        return std::nullopt;
+    }
+
+    /**
+     * @brief Zero-copy lookup
+     *
+     * @return Pointer to the stored value or nullptr, valid until the next insertion or erase
+     */
+    Value *FindPtr(const Key &key)
+    {
+        SizeType index = findIndex(key, hashOf(key));
+        return index == NPOS ? nullptr : &m_slots[index].pair().second;
+    }
+
+    const Value *FindPtr(const Key &key) const
+    {
+        SizeType index = findIndex(key, hashOf(key));
+        return index == NPOS ? nullptr : &m_slots[index].pair().second;
+    }
+
+    template <typename K>
+        requires isHeterogeneous<K>
+    Value *FindPtr(const K &key)
+    {
+        SizeType index = findIndex(key, hashOf(key));
+        return index == NPOS ? nullptr : &m_slots[index].pair().second;
+    }
+
+    template <typename K>
+        requires isHeterogeneous<K>
+    const Value *FindPtr(const K &key) const
+    {
+        SizeType index = findIndex(key, hashOf(key));
+        return index == NPOS ? nullptr : &m_slots[index].pair().second;
+    }
+
+    bool Contains(const Key &key) const
+    {
+        return findIndex(key, hashOf(key)) != NPOS;
+    }
+
+    template <typename K>
+        requires isHeterogeneous<K>
+    bool Contains(const K &key) const
+    {
+        return findIndex(key, hashOf(key)) != NPOS;
+    }
+
+    void Erase(const Key &key)
+    {
+        erase(key);
+    }
+
+    template <typename K>
+        requires isHeterogeneous<K>
+    void Erase(const K &key)
+    {
+        erase(key);
+    }
+
+    // keeps the slots
+    void Clear()
+    {
+        destroySlots();
+        if (m_capacity)
+        {
+            std::memset(static_cast<void *>(m_slots), 0, m_capacity * sizeof(Slot));
+        }
+        m_size = 0;
+    }
+
+    /**
+     * @brief Redistributes the elements over requestedCapacity slots
+     *
+     * @param requestedCapacity Rounded up to the next power of two, and to what the max load factor needs
+     */
+    void Rehash(const SizeType &requestedCapacity)
+    {
+        assert(requestedCapacity > 0 && "RobinHoodHashTable::Rehash attempt to resize to <=0");
+
+        SizeType newCapacity = normalizeCapacity(requestedCapacity);
+        while (static_cast<float>(m_size) > static_cast<float>(newCapacity) * m_maxLoadFactor)
+        {
+            newCapacity *= 2;
+        }
+
+        Slot *oldSlots = m_slots;
+        SizeType oldCapacity = m_capacity;
+
+        allocate(newCapacity);
+
+        for (SizeType i = 0; i < oldCapacity; ++i)
+        {
+            if (oldSlots[i].meta.psl)
+            {
+                auto [index, psl] = insertionPoint(oldSlots[i].meta.hash);
+                emplaceAt(index, psl, oldSlots[i].meta.hash, std::move(oldSlots[i].pair()));
+                oldSlots[i].pair().~Pair();
+            }
+        }
+
+        if (oldCapacity)
+        {
+            ::operator delete(oldSlots, oldCapacity * sizeof(Slot), std::align_val_t(alignof(Slot)));
+        }
+    }
+
+    Iterator begin() noexcept
+    {
+        return Iterator(m_slots, m_slots + m_capacity);
+    }
+
+    Iterator end() noexcept
+    {
+        return Iterator(m_slots + m_capacity, m_slots + m_capacity);
+    }
+
+    ConstIterator begin() const noexcept
+    {
+        return ConstIterator(m_slots, m_slots + m_capacity);
+    }
+
+    ConstIterator end() const noexcept
+    {
+        return ConstIterator(m_slots + m_capacity, m_slots + m_capacity);
+    }
+
+    ConstIterator cbegin() const noexcept
+    {
+        return begin();
+    }
+
+    ConstIterator cend() const noexcept
+    {
+        return end();
+    }
+
+    bool Empty() const
+    {
+        return !m_size;
+    }
+
+    SizeType Size() const
+    {
+        return m_size;
+    }
+
+    SizeType BucketCount() const
+    {
+        return m_capacity;
+    }
+
+    float LoadFactor() const
+    {
+        return m_capacity ? static_cast<float>(m_size) / static_cast<float>(m_capacity) : 0.0f;
+    }
+
+    float MaxLoadFactor() const
+    {
+        return m_maxLoadFactor;
+    }
+
+    /**
+     * @brief Sets the load at which Insert grows the table, rehashing right away if it is exceeded
+     *
+     * Robin Hood probing stays usable up to about 0.95, at least one slot is always kept empty.
+     */
+    void MaxLoadFactor(float maxLoadFactor)
+    {
+        assert(maxLoadFactor > 0.0f && maxLoadFactor < 1.0f &&
+               "RobinHoodHashTable::MaxLoadFactor has to be between 0 and 1");
+
+        m_maxLoadFactor = maxLoadFactor;
+
+        if (static_cast<float>(m_size) > static_cast<float>(m_capacity) * m_maxLoadFactor)
+        {
+            Rehash(m_capacity);
+        }
+    }
+
+    // longest probe sequence of any element, 0 when empty
+    SizeType MaxProbeLength() const
+    {
+        uint32_t longest = 0;
+        for (SizeType i = 0; i < m_capacity; ++i)
+        {
+            longest = std::max(longest, m_slots[i].meta.psl);
+        }
+        return longest ? longest - 1 : 0;
+    }
+
+  private:
+    template <typename K, typename... Args> std::pair<Value *, bool> tryEmplace(K &&key, Args &&...args)
+    {
+        const uint32_t h = hashOf(key);
+
+        SizeType index = findIndex(key, h);
+        if (index != NPOS)
+        {
+            return {&m_slots[index].pair().second, false};
+        }
+
+        return {emplaceNew(h, std::piecewise_construct, std::forward_as_tuple(std::forward<K>(key)),
+                           std::forward_as_tuple(std::forward<Args>(args)...)),
+                true};
+    }
+
+    template <typename K, typename V> std::pair<Value *, bool> insertOrAssign(K &&key, V &&value)
+    {
+        const uint32_t h = hashOf(key);
+
+        SizeType index = findIndex(key, h);
+        if (index != NPOS)
+        {
+            m_slots[index].pair().second = std::forward<V>(value);
+            return {&m_slots[index].pair().second, false};
+        }
+
+        return {emplaceNew(h, std::forward<K>(key), std::forward<V>(value)), true};
+    }
+
+    template <typename... Args> Value *emplaceNew(uint32_t h, Args &&...args)
+    {
+        // build the element before anything is shifted, so a throwing constructor leaves the table intact
+        Pair pair(std::forward<Args>(args)...);
+
+        if (static_cast<float>(m_size + 1) > static_cast<float>(m_capacity) * m_maxLoadFactor)
+        {
+            Rehash(m_capacity ? m_capacity * 2 : RHHT_INIT_CAPACITY);
+        }
+
+        auto [index, psl] = insertionPoint(h);
+        emplaceAt(index, psl, h, std::move(pair));
+        return &m_slots[index].pair().second;
+    }
+
+    template <typename K> void erase(const K &key)
+    {
+        SizeType index = findIndex(key, hashOf(key));
+        if (index == NPOS)
+        {
+            return;
+        }
+
+        m_slots[index].pair().~Pair();
+        --m_size;
+
+        // backward shift: pull the rest of the cluster one slot closer to home, up to an empty or home slot
+        const SizeType mask = m_capacity - 1;
+        for (SizeType next = (index + 1) & mask; m_slots[next].meta.psl > 1; next = (next + 1) & mask)
+        {
+            new (m_slots[index].storage) Pair(std::move(m_slots[next].pair()));
+            m_slots[next].pair().~Pair();
+            m_slots[index].meta = Meta{m_slots[next].meta.psl - 1, m_slots[next].meta.hash};
+            index = next;
+        }
+        m_slots[index].meta.psl = 0;
+    }
+
+    template <typename K> SizeType findIndex(const K &key, uint32_t h) const
+    {
+        // also keeps a moved-from table without storage from indexing it
+        if (!m_size)
+        {
+            return NPOS;
+        }
+
+        const SizeType mask = m_capacity - 1;
+        SizeType index = homeSlot(h);
+
+        for (uint32_t psl = 1;; ++psl, index = (index + 1) & mask)
+        {
+            const Meta &meta = m_slots[index].meta;
+
+            // an empty slot, or one that is closer to home than the key would be: had it been inserted, it'd be here
+            if (meta.psl < psl)
+            {
+                return NPOS;
+            }
+
+            // equal hash bits mean an equal home slot, so the PSL matches as well
+            if (meta.hash == h && m_slots[index].pair().first == key)
+            {
+                return index;
+            }
+        }
+    }
+
+    // where an element with hash h goes: the first slot that is empty or closer to its own home
+    std::pair<SizeType, uint32_t> insertionPoint(uint32_t h) const noexcept
+    {
+        const SizeType mask = m_capacity - 1;
+        SizeType index = homeSlot(h);
+        uint32_t psl = 1;
+
+        while (m_slots[index].meta.psl >= psl)
+        {
+            index = (index + 1) & mask;
+            ++psl;
+        }
+        return {index, psl};
+    }
+
+    // shifts the cluster from index on one slot further, up to the next empty slot, and puts pair at index
+    void emplaceAt(SizeType index, uint32_t psl, uint32_t h, Pair &&pair)
+    {
+        const SizeType mask = m_capacity - 1;
+
+        SizeType empty = index;
+        while (m_slots[empty].meta.psl)
+        {
+            empty = (empty + 1) & mask;
+        }
+
+        while (empty != index)
+        {
+            SizeType previous = (empty - 1) & mask;
+            new (m_slots[empty].storage) Pair(std::move(m_slots[previous].pair()));
+            m_slots[previous].pair().~Pair();
+            m_slots[empty].meta = Meta{m_slots[previous].meta.psl + 1, m_slots[previous].meta.hash};
+            empty = previous;
+        }
+
+        new (m_slots[index].storage) Pair(std::move(pair));
+        m_slots[index].meta = Meta{psl, h};
+        ++m_size;
+    }
+
+    SizeType homeSlot(uint32_t h) const noexcept
+    {
+        return static_cast<SizeType>(h >> m_shift);
+    }
+
+    void allocate(SizeType capacity)
+    {
+        assert(capacity <= (SizeType(1) << 31) && "RobinHoodHashTable capacity is limited to 2^31 slots");
+
+        m_slots = static_cast<Slot *>(::operator new(capacity * sizeof(Slot), std::align_val_t(alignof(Slot))));
+        std::memset(static_cast<void *>(m_slots), 0, capacity * sizeof(Slot));
+
+        m_capacity = capacity;
+        m_shift = static_cast<uint32_t>(32 - std::countr_zero(capacity));
+        m_size = 0;
+    }
+
+    void deallocate() noexcept
+    {
+        if (m_capacity)
+        {
+            ::operator delete(m_slots, m_capacity * sizeof(Slot), std::align_val_t(alignof(Slot)));
+        }
+        m_slots = nullptr;
+        m_capacity = 0;
+    }
+
+    void destroySlots() noexcept
+    {
+        for (SizeType i = 0; i < m_capacity; ++i)
+        {
+            if (m_slots[i].meta.psl)
+            {
+                m_slots[i].pair().~Pair();
+            }
+        }
+    }
+
+    void swap(RobinHoodHashTable &other) noexcept
+    {
+        std::swap(m_slots, other.m_slots);
+        std::swap(m_capacity, other.m_capacity);
+        std::swap(m_size, other.m_size);
+        std::swap(m_shift, other.m_shift);
+        std::swap(m_maxLoadFactor, other.m_maxLoadFactor);
+    }
+
+    static SizeType normalizeCapacity(SizeType capacity) noexcept
+    {
+        return std::bit_ceil(capacity < MIN_CAPACITY ? MIN_CAPACITY : capacity);
+    }
+
+    // the top 32 bits, the bucket masks of the chained tables use the low ones
+    template <typename K> static uint32_t hashOf(const K &key) noexcept
+    {
+        return static_cast<uint32_t>(static_cast<uint64_t>(detail::HashKey<Key>(key)) >>
+                                     (std::numeric_limits<SizeType>::digits - 32));
+    }
+
+  private:
+    Slot *m_slots = nullptr;
+    SizeType m_capacity = 0;
+    SizeType m_size = 0;
+    uint32_t m_shift = 32;
+    float m_maxLoadFactor = RHHT_MAX_LOAD_FACTOR;
+};
+
+} // namespace icb
@@ -0,0 +1,491 @@
+/**
+ * @file small_vector.h
+ * @author Dovydas Ciomenas (icouldbreathe@icloud.com)
+ * @brief Dynamic array that keeps its first N elements inline
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <assert.h>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "vector.h"
+
+namespace icb
+{
+/**
+ * @brief Vector with room for N elements inside the object, the heap is only touched past them
+ *
+ * Up to N elements live in an inline buffer, so a SmallVector that stays small never allocates. The first element
+ * past N moves all of them to a heap buffer, which then grows like Vector's; Clear keeps it, the elements don't come
+ * back inline. Same API and iterators as Vector, and trivially relocatable types (see IsTriviallyRelocatable) are
+ * moved around with memcpy/memmove as there.
+ *
+ * Moving a SmallVector steals a heap buffer, but has to move inline elements one by one, and leaves other empty
+ * either way. Iterators and pointers to elements are invalidated by anything that may grow the vector, and by
+ * moving it while it is inline.
+ */
+template <typename T, size_t N> class SmallVector
+{
+  public:
+    using SizeType = size_t;
+    using ValueType = T;
+    using Iterator = typename Vector<T>::Iterator;
+    using ConstIterator = typename Vector<T>::ConstIterator;
+
+    static_assert(N > 0, "SmallVector needs room for at least one inline element");
+
+    static constexpr SizeType INLINE_CAPACITY = N;
+
+  public:
+    SmallVector() noexcept = default;
+
+    template <typename InputIterator> SmallVector(InputIterator first, InputIterator last)
+    {
+        if constexpr (std::is_base_of_v<std::forward_iterator_tag,
+                                        typename std::iterator_traits<InputIterator>::iterator_category>)
+        {
+            Reserve(static_cast<SizeType>(std::distance(first, last)));
+        }
+        for (; first != last; ++first)
+            PushBack(*first);
+    }
+
+    SmallVector(std::initializer_list<ValueType> il) : SmallVector(il.begin(), il.end())
+    {
+    }
+
+    // copy ctor
+    SmallVector(const SmallVector &other)
+    {
+        Reserve(other.m_size);
+        try
+        {
+            appendCopies(other.m_data, other.m_size);
+        }
+        catch (...)
+        {
+            Clear();
+            deallocate();
+            throw;
+        }
+    }
+
+    // move ctor, steals a heap buffer, moves inline elements
+    SmallVector(SmallVector &&other) noexcept(std::is_nothrow_move_constructible_v<ValueType>)
+    {
+        takeElements(other);
+    }
+
+    // copy assignment, reuses the buffer when it is big enough
+    SmallVector &operator=(const SmallVector &other)
+    {
+        if (this != &other)
+        {
+            Clear();
+            Reserve(other.m_size);
+            appendCopies(other.m_data, other.m_size);
+        }
+        return *this;
+    }
+
+    // move assignment
+    SmallVector &operator=(SmallVector &&other) noexcept(std::is_nothrow_move_constructible_v<ValueType>)
+    {
+        if (this != &other)
+        {
+            Clear();
+            if (!other.IsInline())
+            {
+                deallocate();
+                m_data = inlineData();
+                m_capacity = N;
+            }
+            takeElements(other);
+        }
+        return *this;
+    }
+
+    ~SmallVector()
+    {
+        Clear();
+        deallocate();
+    }
+
+    SizeType Size() const noexcept
+    {
+        return m_size;
+    }
+    SizeType Capacity() const noexcept
+    {
+        return m_capacity;
+    }
+
+    // whether the elements are still in the inline buffer
+    bool IsInline() const noexcept
+    {
+        return m_data == inlineData();
+    }
+
+    ValueType &operator[](SizeType index) noexcept
+    {
+        assert(index < m_size);
+        return m_data[index];
+    }
+    const ValueType &operator[](SizeType index) const noexcept
+    {
+        assert(index < m_size);
+        return m_data[index];
+    }
+
+    ValueType *Data()
+    {
+        return m_data;
+    }
+    const ValueType *Data() const
+    {
+        return m_data;
+    }
+
+    void Reserve(SizeType newCapacity)
+    {
+        if (newCapacity > m_capacity)
+        {
+            reallocate(newCapacity);
+        }
+    }
+
+    void Resize(SizeType newSize)
+    {
+        if (newSize > m_size)
+        {
+            if (newSize > m_capacity)
+            {
+                reallocate(newSize + (newSize + 2) / 2);
+            }
+
+            for (; m_size < newSize; ++m_size)
+            {
+                new (&m_data[m_size]) ValueType();
+            }
+        }
+        else
+        {
+            destroy(newSize, m_size);
+            m_size = newSize;
+        }
+    }
+
+    void Resize(SizeType newSize, const ValueType &value)
+    {
+        if (newSize > m_size)
+        {
+            // value may be one of the elements, which reallocating would move away
+            const ValueType copy(value);
+            if (newSize > m_capacity)
+            {
+                reallocate(newSize + (newSize + 2) / 2);
+            }
+
+            for (; m_size < newSize; ++m_size)
+            {
+                new (&m_data[m_size]) ValueType(copy);
+            }
+        }
+        else
+        {
+            destroy(newSize, m_size);
+            m_size = newSize;
+        }
+    }
+
+    // copy
+    Iterator Insert(ConstIterator position, const ValueType &value)
+    {
+        return Emplace(position, value);
+    }
+
+    // move
+    Iterator Insert(ConstIterator position, ValueType &&value)
+    {
+        return Emplace(position, std::move(value));
+    }
+
+    /**
+     * @brief Inserts copies of [first, last) before position
+     *
+     * The range mustn't point into this vector.
+     *
+     * @return Iterator to the first inserted element, or position if the range is empty
+     */
+    template <typename InputIterator> Iterator Insert(ConstIterator position, InputIterator first, InputIterator last)
+    {
+        const SizeType index = indexOf(position);
+
+        if constexpr (std::is_trivially_copyable_v<ValueType> &&
+                      std::is_base_of_v<std::forward_iterator_tag,
+                                        typename std::iterator_traits<InputIterator>::iterator_category>)
+        {
+            const SizeType count = static_cast<SizeType>(std::distance(first, last));
+            if (m_size + count > m_capacity)
+            {
+                reallocate(std::max(m_size + count, detail::GrownCapacity(m_capacity)));
+            }
+            detail::InsertCopies(m_data, m_size, index, first, count);
+        }
+        else
+        {
+            const SizeType oldSize = m_size;
+            for (; first != last; ++first)
+            {
+                EmplaceBack(*first);
+            }
+            std::rotate(m_data + index, m_data + oldSize, m_data + m_size);
+        }
+
+        return begin() + index;
+    }
+
+    /**
+     * @brief Constructs an element before position, shifting the tail up by one
+     *
+     * @return Iterator to the new element
+     */
+    template <typename... Args> Iterator Emplace(ConstIterator position, Args &&...args)
+    {
+        const SizeType index = indexOf(position);
+        if (index == m_size)
+        {
+            EmplaceBack(std::forward<Args>(args)...);
+            return begin() + index;
+        }
+
+        ValueType value(std::forward<Args>(args)...);
+        if (m_size == m_capacity)
+        {
+            reallocate(detail::GrownCapacity(m_capacity));
+        }
+        detail::InsertShifting(m_data, m_size, index, std::move(value));
+
+        return begin() + index;
+    }
+
+    Iterator Erase(ConstIterator position)
+    {
+        return Erase(position, position + 1);
+    }
+
+    /**
+     * @brief Erases [first, last), moving the tail down over the gap
+     *
+     * @return Iterator to the element after the erased ones
+     */
+    Iterator Erase(ConstIterator first, ConstIterator last)
+    {
+        const SizeType index = indexOf(first);
+        const SizeType count = static_cast<SizeType>(last - first);
+        assert(index + count <= m_size && "SmallVector::Erase range out of bounds");
+
+        detail::CloseGap(m_data, m_size, index, count);
+        return begin() + index;
+    }
+
+    // keeps a heap buffer
+    void Clear()
+    {
+        destroy(0, m_size);
+        m_size = 0;
+    }
+
+    // copy
+    void PushBack(const ValueType &value)
+    {
+        EmplaceBack(value);
+    }
+
+    // move
+    void PushBack(ValueType &&value)
+    {
+        EmplaceBack(std::move(value));
+    }
+
+    template <typename... Args> ValueType &EmplaceBack(Args &&...args)
+    {
+        if (m_size == m_capacity)
+            return growAndEmplaceBack(std::forward<Args>(args)...);
+
+        new (&m_data[m_size]) ValueType(std::forward<Args>(args)...);
+        return m_data[m_size++];
+    }
+
+    void PopBack()
+    {
+        if (m_size > 0)
+        {
+            --m_size;
+            m_data[m_size].~ValueType();
+        }
+    }
+
+    ValueType &At(SizeType index)
+    {
+        if (index >= m_size)
+        {
+            throw std::out_of_range("SmallVector::at: index out of range");
+        }
+        return m_data[index];
+    }
+
+    const ValueType &At(SizeType index) const
+    {
+        if (index >= m_size)
+        {
+            throw std::out_of_range("SmallVector::at: index out of range");
+        }
+        return m_data[index];
+    }
+
+    Iterator begin()
+    {
+        return Iterator(m_data);
+    }
+
+    Iterator end()
+    {
+        return Iterator(m_data + m_size);
+    }
+
+    ConstIterator begin() const
+    {
+        return ConstIterator(m_data);
+    }
+
+    ConstIterator end() const
+    {
+        return ConstIterator(m_data + m_size);
+    }
+
+    ConstIterator cbegin() const
+    {
+        return ConstIterator(m_data);
+    }
+
+    ConstIterator cend() const
+    {
+        return ConstIterator(m_data + m_size);
+    }
+
+  private:
+    ValueType *inlineData() noexcept
+    {
+        return reinterpret_cast<ValueType *>(m_inline);
+    }
+
+    const ValueType *inlineData() const noexcept
+    {
+        return reinterpret_cast<const ValueType *>(m_inline);
+    }
+
+    // frees a heap buffer, the elements have to be gone already
+    void deallocate() noexcept
+    {
+        if (!IsInline())
+        {
+            std::allocator<ValueType>().deallocate(m_data, m_capacity);
+        }
+    }
+
+    // only grows, the elements move to a new heap buffer
+    void reallocate(SizeType newCapacity)
+    {
+        ValueType *newData = std::allocator<ValueType>().allocate(newCapacity);
+        try
+        {
+            detail::RelocateElements(m_data, m_size, newData);
+        }
+        catch (...)
+        {
+            std::allocator<ValueType>().deallocate(newData, newCapacity);
+            throw;
+        }
+        deallocate();
+        m_data = newData;
+        m_capacity = newCapacity;
+    }
+
+    // the new element is built in the new buffer before the old ones leave, the arguments may refer to one of them
+    template <typename... Args> ValueType &growAndEmplaceBack(Args &&...args)
+    {
+        const SizeType newCapacity = detail::GrownCapacity(m_capacity);
+        ValueType *newData = std::allocator<ValueType>().allocate(newCapacity);
+        try
+        {
+            detail::EmplaceAndRelocate(m_data, m_size, newData, std::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+            std::allocator<ValueType>().deallocate(newData, newCapacity);
+            throw;
+        }
+        deallocate();
+        m_data = newData;
+        m_capacity = newCapacity;
+
+        return m_data[m_size++];
+    }
+
+    // other's elements become this vector's, which has to be empty and inline
+    void takeElements(SmallVector &other)
+    {
+        if (!other.IsInline())
+        {
+            m_data = other.m_data;
+            m_capacity = other.m_capacity;
+            m_size = other.m_size;
+            other.m_data = other.inlineData();
+            other.m_capacity = N;
+            other.m_size = 0;
+            return;
+        }
+
+        detail::RelocateElements(other.m_data, other.m_size, m_data);
+        m_size = other.m_size;
+        other.m_size = 0;
+    }
+
+    // copy constructs count elements after the last one, the capacity has to be there
+    void appendCopies(const ValueType *source, SizeType count)
+    {
+        detail::AppendCopies(m_data, m_size, source, count);
+    }
+
+    void destroy(SizeType from, SizeType to) noexcept
+    {
+        detail::DestroyElements(m_data + from, m_data + to);
+    }
+
+    SizeType indexOf(ConstIterator position) const
+    {
+        return detail::IndexOf(position, cbegin(), m_size);
+    }
+
+  private:
+    ValueType *m_data = inlineData();
+    SizeType m_size = 0;
+    SizeType m_capacity = N;
+    alignas(ValueType) unsigned char m_inline[N * sizeof(ValueType)];
+};
+} // namespace icb
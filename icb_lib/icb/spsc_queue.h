@@ -0,0 +1,231 @@
+/**
+ * @file spsc_queue.h
+ * @author Dovydas Ciomenas (icouldbreathe@icloud.com)
+ * @brief Bounded lock-free ring queue for one producer and one consumer thread
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <assert.h>
+#include <atomic>
+#include <bit>
+#include <new>
+#include <optional>
+#include <utility>
+
+#include "concurrent_hash_table.h" // ICB_CACHE_LINE_SIZE
+
+namespace icb
+{
+/**
+ * @brief Fixed-capacity FIFO between exactly one producer thread and one consumer thread
+ *
+ * Elements live in a ring of Capacity() slots allocated once, so pushing and popping never allocate. The producer
+ * owns the tail index and the consumer the head index, each on its own cache line, and each side keeps a cached copy
+ * of the other's index: it only reads the other side's cache line when the cached copy shows too little room (or
+ * too few elements). PushBatch and PopBatch move many elements for a single index update, the other side sees the
+ * whole batch at once.
+ *
+ * Push and pop calls may each come from one thread at a time only; use MPMCQueue for more.
+ */
+template <typename T> class SPSCQueue
+{
+  public:
+    using ValueType = T;
+    using SizeType = size_t;
+
+  private:
+    // written by the producer; cachedHead is its last look at the consumer's head
+    struct alignas(ICB_CACHE_LINE_SIZE) ProducerSide
+    {
+        std::atomic<SizeType> tail{0};
+        SizeType cachedHead = 0;
+    };
+
+    // written by the consumer; cachedTail is its last look at the producer's tail
+    struct alignas(ICB_CACHE_LINE_SIZE) ConsumerSide
+    {
+        std::atomic<SizeType> head{0};
+        SizeType cachedTail = 0;
+    };
+
+  public:
+    // capacity is rounded up to a power of two
+    explicit SPSCQueue(SizeType capacity)
+        : m_capacity(std::bit_ceil(std::max(capacity, SizeType(1)))), m_mask(m_capacity - 1),
+          m_slots(static_cast<T *>(::operator new(m_capacity * sizeof(T), std::align_val_t(alignof(T)))))
+    {
+        assert(capacity > 0 && "SPSCQueue capacity has to be positive");
+    }
+
+    ~SPSCQueue()
+    {
+        const SizeType tail = m_producer.tail.load(std::memory_order_relaxed);
+        for (SizeType i = m_consumer.head.load(std::memory_order_relaxed); i != tail; ++i)
+        {
+            m_slots[i & m_mask].~T();
+        }
+        ::operator delete(m_slots, m_capacity * sizeof(T), std::align_val_t(alignof(T)));
+    }
+
+    SPSCQueue(const SPSCQueue &) = delete;
+    SPSCQueue &operator=(const SPSCQueue &) = delete;
+
+    // copy
+    bool TryPush(const T &value)
+    {
+        return TryEmplace(value);
+    }
+
+    // move
+    bool TryPush(T &&value)
+    {
+        return TryEmplace(std::move(value));
+    }
+
+    // producer only, returns false when the queue is full
+    template <typename... Args> bool TryEmplace(Args &&...args)
+    {
+        const SizeType tail = m_producer.tail.load(std::memory_order_relaxed);
+        if (freeSlots(tail) == 0)
+        {
+            return false;
+        }
+
+        new (&m_slots[tail & m_mask]) T(std::forward<Args>(args)...);
+        m_producer.tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Producer only, copies (or moves, given move iterators) as many elements of [first, last) as fit
+     *
+     * The consumer sees them all at once, with one update of the tail.
+     *
+     * @return The number of elements pushed
+     */
+    template <typename InputIterator> SizeType PushBatch(InputIterator first, InputIterator last)
+    {
+        const SizeType tail = m_producer.tail.load(std::memory_order_relaxed);
+        const SizeType room = freeSlots(tail, m_capacity);
+
+        SizeType count = 0;
+        try
+        {
+            for (; count < room && first != last; ++count, ++first)
+            {
+                new (&m_slots[(tail + count) & m_mask]) T(*first);
+            }
+        }
+        catch (...)
+        {
+            // the elements built so far are published rather than rolled back
+            m_producer.tail.store(tail + count, std::memory_order_release);
+            throw;
+        }
+
+        m_producer.tail.store(tail + count, std::memory_order_release);
+        return count;
+    }
+
+    // consumer only, empty when the queue is
+    std::optional<T> TryPop()
+    {
+        const SizeType head = m_consumer.head.load(std::memory_order_relaxed);
+        if (usedSlots(head) == 0)
+        {
+            return std::nullopt;
+        }
+
+        T &slot = m_slots[head & m_mask];
+        std::optional<T> value(std::move(slot));
+        slot.~T();
+        m_consumer.head.store(head + 1, std::memory_order_release);
+        return value;
+    }
+
+    /**
+     * @brief Consumer only, moves up to maxCount elements to out, freeing their slots with one update of the head
+     *
+     * @return The number of elements popped
+     */
+    template <typename OutputIterator> SizeType PopBatch(OutputIterator out, SizeType maxCount)
+    {
+        const SizeType head = m_consumer.head.load(std::memory_order_relaxed);
+        const SizeType count = std::min(usedSlots(head, maxCount), maxCount);
+
+        SizeType popped = 0;
+        try
+        {
+            for (; popped < count; ++popped)
+            {
+                T &slot = m_slots[(head + popped) & m_mask];
+                *out = std::move(slot);
+                ++out;
+                slot.~T();
+            }
+        }
+        catch (...)
+        {
+            m_consumer.head.store(head + popped, std::memory_order_release);
+            throw;
+        }
+
+        m_consumer.head.store(head + count, std::memory_order_release);
+        return count;
+    }
+
+    // a snapshot, exact only from a thread that is the producer or the consumer while the other one is idle
+    SizeType Size() const noexcept
+    {
+        const SizeType head = m_consumer.head.load(std::memory_order_acquire);
+        const SizeType tail = m_producer.tail.load(std::memory_order_acquire);
+        return tail - head;
+    }
+
+    bool Empty() const noexcept
+    {
+        return Size() == 0;
+    }
+
+    SizeType Capacity() const noexcept
+    {
+        return m_capacity;
+    }
+
+  private:
+    // the producer's view, refreshes the cached head only when it shows fewer than wanted free slots
+    SizeType freeSlots(SizeType tail, SizeType wanted = 1) noexcept
+    {
+        if (m_capacity - (tail - m_producer.cachedHead) < wanted)
+        {
+            m_producer.cachedHead = m_consumer.head.load(std::memory_order_acquire);
+        }
+        return m_capacity - (tail - m_producer.cachedHead);
+    }
+
+    // the consumer's view, refreshes the cached tail only when it shows fewer than wanted elements
+    SizeType usedSlots(SizeType head, SizeType wanted = 1) noexcept
+    {
+        if (m_consumer.cachedTail - head < wanted)
+        {
+            m_consumer.cachedTail = m_producer.tail.load(std::memory_order_acquire);
+        }
+        return m_consumer.cachedTail - head;
+    }
+
+  private:
+    const SizeType m_capacity;
+    const SizeType m_mask;
+    T *const m_slots;
+    ProducerSide m_producer;
+    ConsumerSide m_consumer;
+};
+
+} // namespace icb
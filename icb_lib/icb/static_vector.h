@@ -0,0 +1,439 @@
+/**
+ * @file static_vector.h
+ * @author Dovydas Ciomenas (icouldbreathe@icloud.com)
+ * @brief Fixed-capacity dynamic array that never allocates
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <assert.h>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "vector.h"
+
+namespace icb
+{
+namespace detail
+{
+/*
+ * Room for N elements inside the object. A type that is trivial to create and destroy gets a plain array, which
+ * works in constant expressions; anything else gets raw bytes, so no element is constructed before it is added.
+ */
+template <typename T, size_t N,
+          bool = std::is_trivially_default_constructible_v<T> && std::is_trivially_destructible_v<T>>
+struct StaticStorage
+{
+    T elements[N];
+
+    constexpr StaticStorage() noexcept
+    {
+        // a constant expression can't leave anything uninitialized
+        if (std::is_constant_evaluated())
+        {
+            std::fill_n(elements, N, T());
+        }
+    }
+
+    constexpr T *Data() noexcept
+    {
+        return elements;
+    }
+
+    constexpr const T *Data() const noexcept
+    {
+        return elements;
+    }
+};
+
+template <typename T, size_t N> struct StaticStorage<T, N, false>
+{
+    alignas(T) unsigned char bytes[N * sizeof(T)];
+
+    T *Data() noexcept
+    {
+        return std::launder(reinterpret_cast<T *>(bytes));
+    }
+
+    const T *Data() const noexcept
+    {
+        return std::launder(reinterpret_cast<const T *>(bytes));
+    }
+};
+} // namespace detail
+
+/**
+ * @brief Vector with a hard capacity of N elements, all of them stored inside the object
+ *
+ * Never allocates, so it can be used where the heap is off limits, and no operation costs more than moving the
+ * elements it shifts. Adding past N throws std::length_error, and TryEmplaceBack reports it instead. Same API and
+ * iterators as Vector otherwise; Reserve and Resize only check against N.
+ *
+ * When T is trivially default constructible and trivially destructible (integers, PODs), every operation is
+ * constexpr and a StaticVector can be built in a constant expression.
+ */
+template <typename T, size_t N> class StaticVector
+{
+  public:
+    using SizeType = size_t;
+    using ValueType = T;
+    using Iterator = typename Vector<T>::Iterator;
+    using ConstIterator = typename Vector<T>::ConstIterator;
+
+    static_assert(N > 0, "StaticVector needs room for at least one element");
+
+  public:
+    constexpr StaticVector() noexcept = default;
+
+    template <typename InputIterator> constexpr StaticVector(InputIterator first, InputIterator last)
+    {
+        for (; first != last; ++first)
+            PushBack(*first);
+    }
+
+    constexpr StaticVector(std::initializer_list<ValueType> il) : StaticVector(il.begin(), il.end())
+    {
+    }
+
+    // copy ctor
+    constexpr StaticVector(const StaticVector &other)
+    {
+        detail::AppendCopies(Data(), m_size, other.Data(), other.m_size);
+    }
+
+    // move ctor, moves the elements one by one, other keeps its (moved-from) elements
+    constexpr StaticVector(StaticVector &&other) noexcept(std::is_nothrow_move_constructible_v<ValueType>)
+    {
+        for (; m_size < other.m_size; ++m_size)
+        {
+            std::construct_at(Data() + m_size, std::move(other[m_size]));
+        }
+    }
+
+    // copy assignment
+    constexpr StaticVector &operator=(const StaticVector &other)
+    {
+        if (this != &other)
+        {
+            assignFrom(other.Data(), other.m_size);
+        }
+        return *this;
+    }
+
+    // move assignment
+    constexpr StaticVector &operator=(StaticVector &&other) noexcept(std::is_nothrow_move_assignable_v<ValueType> &&
+                                                                     std::is_nothrow_move_constructible_v<ValueType>)
+    {
+        if (this != &other)
+        {
+            assignFrom(std::make_move_iterator(other.Data()), other.m_size);
+        }
+        return *this;
+    }
+
+    constexpr ~StaticVector()
+    {
+        Clear();
+    }
+
+    constexpr SizeType Size() const noexcept
+    {
+        return m_size;
+    }
+    constexpr SizeType Capacity() const noexcept
+    {
+        return N;
+    }
+
+    constexpr bool Full() const noexcept
+    {
+        return m_size == N;
+    }
+
+    constexpr ValueType &operator[](SizeType index) noexcept
+    {
+        assert(index < m_size);
+        return Data()[index];
+    }
+    constexpr const ValueType &operator[](SizeType index) const noexcept
+    {
+        assert(index < m_size);
+        return Data()[index];
+    }
+
+    constexpr ValueType *Data()
+    {
+        return m_storage.Data();
+    }
+    constexpr const ValueType *Data() const
+    {
+        return m_storage.Data();
+    }
+
+    // nothing to allocate, only checks newCapacity against N
+    constexpr void Reserve(SizeType newCapacity)
+    {
+        if (newCapacity > N)
+        {
+            throw std::length_error("StaticVector::Reserve: capacity exceeded");
+        }
+    }
+
+    constexpr void Resize(SizeType newSize)
+    {
+        Reserve(newSize);
+        for (; m_size < newSize; ++m_size)
+        {
+            std::construct_at(Data() + m_size);
+        }
+        destroy(newSize, m_size);
+        m_size = std::min(m_size, newSize);
+    }
+
+    constexpr void Resize(SizeType newSize, const ValueType &value)
+    {
+        Reserve(newSize);
+        for (; m_size < newSize; ++m_size)
+        {
+            std::construct_at(Data() + m_size, value);
+        }
+        destroy(newSize, m_size);
+        m_size = std::min(m_size, newSize);
+    }
+
+    // copy
+    constexpr Iterator Insert(ConstIterator position, const ValueType &value)
+    {
+        return Emplace(position, value);
+    }
+
+    // move
+    constexpr Iterator Insert(ConstIterator position, ValueType &&value)
+    {
+        return Emplace(position, std::move(value));
+    }
+
+    /**
+     * @brief Inserts copies of [first, last) before position
+     *
+     * The range mustn't point into this vector. Throws std::length_error if it doesn't fit: a forward range is
+     * measured first and leaves the vector as it was, any other leaves the elements that did fit appended at the end
+     * instead of inserted.
+     *
+     * @return Iterator to the first inserted element, or position if the range is empty
+     */
+    template <typename InputIterator>
+    constexpr Iterator Insert(ConstIterator position, InputIterator first, InputIterator last)
+    {
+        const SizeType index = indexOf(position);
+
+        if constexpr (std::is_base_of_v<std::forward_iterator_tag,
+                                        typename std::iterator_traits<InputIterator>::iterator_category>)
+        {
+            const SizeType count = static_cast<SizeType>(std::distance(first, last));
+            if (count > N - m_size)
+            {
+                throw std::length_error("StaticVector: capacity exceeded");
+            }
+
+            if constexpr (std::is_trivially_copyable_v<ValueType>)
+            {
+                detail::InsertCopies(Data(), m_size, index, first, count);
+                return begin() + index;
+            }
+        }
+
+        const SizeType oldSize = m_size;
+        for (; first != last; ++first)
+        {
+            EmplaceBack(*first);
+        }
+        std::rotate(Data() + index, Data() + oldSize, Data() + m_size);
+
+        return begin() + index;
+    }
+
+    /**
+     * @brief Constructs an element before position, shifting the tail up by one
+     *
+     * @return Iterator to the new element
+     */
+    template <typename... Args> constexpr Iterator Emplace(ConstIterator position, Args &&...args)
+    {
+        const SizeType index = indexOf(position);
+        if (index == m_size)
+        {
+            EmplaceBack(std::forward<Args>(args)...);
+            return begin() + index;
+        }
+
+        checkRoom();
+        ValueType value(std::forward<Args>(args)...);
+        detail::InsertShifting(Data(), m_size, index, std::move(value));
+
+        return begin() + index;
+    }
+
+    constexpr Iterator Erase(ConstIterator position)
+    {
+        return Erase(position, position + 1);
+    }
+
+    /**
+     * @brief Erases [first, last), moving the tail down over the gap
+     *
+     * @return Iterator to the element after the erased ones
+     */
+    constexpr Iterator Erase(ConstIterator first, ConstIterator last)
+    {
+        const SizeType index = indexOf(first);
+        const SizeType count = static_cast<SizeType>(last - first);
+        assert(index + count <= m_size && "StaticVector::Erase range out of bounds");
+
+        detail::CloseGap(Data(), m_size, index, count);
+        return begin() + index;
+    }
+
+    constexpr void Clear()
+    {
+        destroy(0, m_size);
+        m_size = 0;
+    }
+
+    // copy
+    constexpr void PushBack(const ValueType &value)
+    {
+        EmplaceBack(value);
+    }
+
+    // move
+    constexpr void PushBack(ValueType &&value)
+    {
+        EmplaceBack(std::move(value));
+    }
+
+    template <typename... Args> constexpr ValueType &EmplaceBack(Args &&...args)
+    {
+        checkRoom();
+        return *TryEmplaceBack(std::forward<Args>(args)...);
+    }
+
+    // nullptr instead of an exception when the vector is full
+    template <typename... Args> constexpr ValueType *TryEmplaceBack(Args &&...args)
+    {
+        if (Full())
+        {
+            return nullptr;
+        }
+
+        ValueType *added = std::construct_at(Data() + m_size, std::forward<Args>(args)...);
+        ++m_size;
+        return added;
+    }
+
+    constexpr void PopBack()
+    {
+        if (m_size > 0)
+        {
+            --m_size;
+            std::destroy_at(Data() + m_size);
+        }
+    }
+
+    constexpr ValueType &At(SizeType index)
+    {
+        if (index >= m_size)
+        {
+            throw std::out_of_range("StaticVector::at: index out of range");
+        }
+        return Data()[index];
+    }
+
+    constexpr const ValueType &At(SizeType index) const
+    {
+        if (index >= m_size)
+        {
+            throw std::out_of_range("StaticVector::at: index out of range");
+        }
+        return Data()[index];
+    }
+
+    constexpr Iterator begin()
+    {
+        return Iterator(Data());
+    }
+
+    constexpr Iterator end()
+    {
+        return Iterator(Data() + m_size);
+    }
+
+    constexpr ConstIterator begin() const
+    {
+        return ConstIterator(Data());
+    }
+
+    constexpr ConstIterator end() const
+    {
+        return ConstIterator(Data() + m_size);
+    }
+
+    constexpr ConstIterator cbegin() const
+    {
+        return ConstIterator(Data());
+    }
+
+    constexpr ConstIterator cend() const
+    {
+        return ConstIterator(Data() + m_size);
+    }
+
+  private:
+    constexpr void checkRoom() const
+    {
+        if (Full())
+        {
+            throw std::length_error("StaticVector: capacity exceeded");
+        }
+    }
+
+    // assigns over the elements both have, then constructs or destroys the rest
+    template <typename SourceIterator> constexpr void assignFrom(SourceIterator source, SizeType count)
+    {
+        const SizeType common = std::min(m_size, count);
+        std::copy_n(source, common, Data());
+        for (SizeType i = common; i < count; ++i, ++m_size)
+        {
+            std::construct_at(Data() + i, *(source + i));
+        }
+        destroy(count, m_size);
+        m_size = count;
+    }
+
+    constexpr void destroy(SizeType from, SizeType to) noexcept
+    {
+        detail::DestroyElements(Data() + from, Data() + to);
+    }
+
+    constexpr SizeType indexOf(ConstIterator position) const
+    {
+        return detail::IndexOf(position, cbegin(), m_size);
+    }
+
+  private:
+    SizeType m_size = 0;
+    detail::StaticStorage<ValueType, N> m_storage;
+};
+} // namespace icb
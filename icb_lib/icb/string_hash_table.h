@@ -0,0 +1,721 @@
+/**
+ * @file string_hash_table.h
+ * @author Dovydas Ciomenas (icouldbreathe@icloud.com)
+ * @brief Hash table (map) with string keys interned in a bump-allocated arena
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <assert.h>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <new>
+#include <optional>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+
+#include <utility> // std::pair
+
+#include "hash.h"
+
+#define SHT_INIT_CAPACITY 16
+#define SHT_MAX_LOAD_FACTOR 1.0f
+#define SHT_MIN_COMPACT_BYTES 4096 // erased key bytes below this are never worth compacting the arena for
+
+namespace icb
+{
+/**
+ * @brief Separate chaining for string keys without a heap allocation per key or per element
+ *
+ * Key bytes are appended to one arena buffer, and the elements live in a dense array where each keeps a handle to
+ * its key (offset and length) plus half of the key's hash. Chains link elements by 32-bit index, the buckets are an
+ * array of indices. Inserting only allocates when the arena, the element array or the bucket array has to grow, all
+ * of which double, so the allocations per insert are amortized to nearly zero.
+ *
+ * Lookups compare the cached hash and the length before touching key bytes. Erase moves the last element into the
+ * hole to keep the array dense, and leaves the key's bytes in the arena; the arena is compacted once more than half
+ * of it is erased keys. Values move on insert and erase: pointers from FindPtr and iterators are only valid until
+ * the next modification.
+ */
+template <typename Value> class StringHashTable
+{
+  public:
+    using SizeType = size_t;
+
+  private:
+    using Index = uint32_t;
+    static constexpr Index NONE = std::numeric_limits<Index>::max();
+
+    static constexpr unsigned LENGTH_BITS = 24;
+    static constexpr uint64_t MAX_KEY_LENGTH = (uint64_t(1) << LENGTH_BITS) - 1;
+    static constexpr uint64_t MAX_ARENA_SIZE = uint64_t(1) << (64 - LENGTH_BITS);
+
+    // 16 bytes besides the value
+    struct Entry
+    {
+        uint64_t key;  // handle of the key bytes: arena offset in the high 40 bits, length in the low 24
+        uint32_t hash; // low half of the key's hash, all a bucket index ever needs
+        Index next;    // next element of the chain, or NONE
+        Value value;
+
+        template <typename... Args>
+        Entry(SizeType offset, SizeType length, uint32_t hash, Index next, Args &&...args)
+            : key((uint64_t(offset) << LENGTH_BITS) | length), hash(hash), next(next),
+              value(std::forward<Args>(args)...)
+        {
+        }
+
+        SizeType offset() const noexcept
+        {
+            return static_cast<SizeType>(key >> LENGTH_BITS);
+        }
+
+        SizeType length() const noexcept
+        {
+            return static_cast<SizeType>(key & MAX_KEY_LENGTH);
+        }
+
+        void moveKey(SizeType offset) noexcept
+        {
+            key = (uint64_t(offset) << LENGTH_BITS) | (key & MAX_KEY_LENGTH);
+        }
+    };
+
+    /**
+     * @brief Forward iterator over the elements, in insertion order unless elements were erased
+     *
+     * Dereferencing gives a (key, value reference) pair by value, e.g. for (auto [key, value] : table).
+     */
+    template <typename AccessType = Value> class BaseIterator
+    {
+      public:
+        using iterator_category = std::input_iterator_tag; // the reference is a proxy
+        using iterator_concept = std::forward_iterator_tag;
+        using difference_type = std::ptrdiff_t;
+        using value_type = std::pair<std::string_view, AccessType &>;
+        using reference = value_type;
+        using self_type = BaseIterator<AccessType>;
+        using table_ptr = std::conditional_t<std::is_const_v<AccessType>, const StringHashTable *, StringHashTable *>;
+
+      public:
+        BaseIterator() = default;
+
+        // implicit conversion from Iterator to ConstIterator
+        template <typename WasAccessType,
+                  class = std::enable_if_t<std::is_const_v<AccessType> && !std::is_const_v<WasAccessType>>>
+        BaseIterator(const BaseIterator<WasAccessType> &other) noexcept
+            : m_table(other.m_table), m_index(other.m_index)
+        {
+        }
+
+        // prefix ++
+        self_type &operator++() noexcept
+        {
+            ++m_index;
+            return *this;
+        }
+
+        // postfix ++
+        self_type operator++(int) noexcept
+        {
+            self_type previous = *this;
+            ++*this;
+            return previous;
+        }
+
+        reference operator*() const
+        {
+            assert(m_index < m_table->m_size && "StringHashTable::Iterator::operator* end dereference");
+            auto &entry = m_table->m_entries[m_index];
+            return reference(m_table->keyOf(entry), entry.value);
+        }
+
+        friend bool operator==(const self_type &x, const self_type &y) noexcept
+        {
+            return x.m_index == y.m_index;
+        }
+
+        friend bool operator!=(const self_type &x, const self_type &y) noexcept
+        {
+            return x.m_index != y.m_index;
+        }
+
+        friend class StringHashTable;
+        template <typename> friend class BaseIterator;
+
+      private:
+        BaseIterator(table_ptr table, SizeType index) noexcept : m_table(table), m_index(index)
+        {
+        }
+
+      private:
+        table_ptr m_table = nullptr;
+        SizeType m_index = 0;
+    };
+
+  public:
+    using Iterator = BaseIterator<Value>;
+    using ConstIterator = BaseIterator<const Value>;
+
+  public:
+    StringHashTable(const SizeType &capacity = SHT_INIT_CAPACITY)
+    {
+        allocateBuckets(normalizeCapacity(capacity));
+    }
+
+    StringHashTable(std::initializer_list<std::pair<std::string_view, Value>> il,
+                    const SizeType &capacity = SHT_INIT_CAPACITY)
+        : StringHashTable(std::max(capacity, il.size()))
+    {
+        for (const auto &[key, value] : il)
+        {
+            Insert(key, value);
+        }
+    }
+
+    ~StringHashTable()
+    {
+        destroy();
+    }
+
+    // copy ctor, the copy's arena holds only the live keys
+    StringHashTable(const StringHashTable &other) : StringHashTable(other.m_bucketCount)
+    {
+        m_maxLoadFactor = other.m_maxLoadFactor;
+        reserveEntries(other.m_size);
+        reserveArena(other.m_arenaSize - other.m_garbage);
+
+        for (SizeType i = 0; i < other.m_size; ++i)
+        {
+            const Entry &entry = other.m_entries[i];
+            emplaceNew(other.keyOf(entry), entry.hash, entry.value);
+        }
+    }
+
+    // move ctor, other is left empty without buckets and allocates them again on its next insert
+    StringHashTable(StringHashTable &&other) noexcept
+    {
+        swap(other);
+    }
+
+    // copy assignment
+    StringHashTable &operator=(const StringHashTable &other)
+    {
+        if (this != &other)
+        {
+            StringHashTable copy(other);
+            swap(copy);
+        }
+        return *this;
+    }
+
+    // move assignment
+    StringHashTable &operator=(StringHashTable &&other) noexcept
+    {
+        if (this != &other)
+        {
+            StringHashTable moved(std::move(other));
+            swap(moved);
+        }
+        return *this;
+    }
+
+    // copy
+    void Insert(std::string_view key, const Value &value)
+    {
+        tryEmplace(key, value);
+    }
+
+    // move
+    void Insert(std::string_view key, Value &&value)
+    {
+        tryEmplace(key, std::move(value));
+    }
+
+    /**
+     * @brief Constructs the value in place from args, unless the key is already present
+     *
+     * @return Pointer to the value stored under key and whether it was inserted
+     */
+    template <typename... Args> std::pair<Value *, bool> TryEmplace(std::string_view key, Args &&...args)
+    {
+        return tryEmplace(key, std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Inserts the value, or assigns it over the existing one
+     *
+     * @return Pointer to the value stored under key and whether it was inserted
+     */
+    template <typename V> std::pair<Value *, bool> InsertOrAssign(std::string_view key, V &&value)
+    {
+        const SizeType h = hashOf(key);
+
+        if (Index i = find(key, h); i != NONE)
+        {
+            m_entries[i].value = std::forward<V>(value);
+            return {&m_entries[i].value, false};
+        }
+        return {&emplaceNew(key, h, std::forward<V>(value)), true};
+    }
+
+    // default-constructs the value if the key is missing
+    Value &operator[](std::string_view key)
+    {
+        return *tryEmplace(key).first;
+    }
+
+    // returns a copy, use FindPtr to avoid it
+    std::optional<Value> Find(std::string_view key) const
+    {
+        const Value *value = FindPtr(key);
+
+        if (value)
+        {
+            return *value;
+        }
+        return std::nullopt;
+    }
+
+    /**
+     * @brief Zero-copy lookup
+     *
+     * @return Pointer to the stored value or nullptr, valid until the next modification
+     */
+    Value *FindPtr(std::string_view key)
+    {
+        Index i = find(key, hashOf(key));
+        return i != NONE ? &m_entries[i].value : nullptr;
+    }
+
+    const Value *FindPtr(std::string_view key) const
+    {
+        Index i = find(key, hashOf(key));
+        return i != NONE ? &m_entries[i].value : nullptr;
+    }
+
+    bool Contains(std::string_view key) const
+    {
+        return find(key, hashOf(key)) != NONE;
+    }
+
+    void Erase(std::string_view key)
+    {
+        if (!m_size)
+        {
+            return;
+        }
+
+        const SizeType h = hashOf(key);
+        Index *link = &m_buckets[bucketIndex(h)];
+
+        for (; *link != NONE; link = &m_entries[*link].next)
+        {
+            if (matches(m_entries[*link], key, h))
+            {
+                break;
+            }
+        }
+        if (*link == NONE)
+        {
+            return;
+        }
+
+        const Index erased = *link;
+        *link = m_entries[erased].next;
+        m_garbage += m_entries[erased].length();
+        m_entries[erased].~Entry();
+
+        // keep the array dense: the last element takes the hole, whoever linked to it links to the hole now
+        const Index last = static_cast<Index>(m_size - 1);
+        if (erased != last)
+        {
+            Index *lastLink = &m_buckets[bucketIndex(m_entries[last].hash)];
+            while (*lastLink != last)
+            {
+                lastLink = &m_entries[*lastLink].next;
+            }
+            *lastLink = erased;
+
+            new (&m_entries[erased]) Entry(std::move(m_entries[last]));
+            m_entries[last].~Entry();
+        }
+        --m_size;
+
+        if (m_garbage >= SHT_MIN_COMPACT_BYTES && m_garbage * 2 > m_arenaSize)
+        {
+            compactArena();
+        }
+    }
+
+    // keeps the bucket, element and arena capacity
+    void Clear()
+    {
+        destroyEntries();
+        std::fill(m_buckets, m_buckets + m_bucketCount, NONE);
+        m_arenaSize = 0;
+        m_garbage = 0;
+    }
+
+    /**
+     * @brief Redistributes the elements over requestedCapacity buckets, using their cached hashes
+     *
+     * @param requestedCapacity Rounded up to the next power of two, and to what the max load factor needs
+     */
+    void Rehash(const SizeType &requestedCapacity)
+    {
+        assert(requestedCapacity > 0 && "StringHashTable::Rehash attempt to resize to <=0");
+
+        SizeType newCapacity = normalizeCapacity(requestedCapacity);
+        while (static_cast<float>(m_size) > static_cast<float>(newCapacity) * m_maxLoadFactor)
+        {
+            newCapacity *= 2;
+        }
+
+        Index *oldBuckets = m_buckets;
+        const SizeType oldCount = m_bucketCount;
+        allocateBuckets(newCapacity);
+        if (oldBuckets)
+        {
+            ::operator delete(oldBuckets, oldCount * sizeof(Index));
+        }
+
+        for (SizeType i = 0; i < m_size; ++i)
+        {
+            Index &head = m_buckets[bucketIndex(m_entries[i].hash)];
+            m_entries[i].next = head;
+            head = static_cast<Index>(i);
+        }
+    }
+
+    // makes room for count elements without growing any of the arrays
+    void Reserve(const SizeType &count)
+    {
+        reserveEntries(count);
+        if (static_cast<float>(count) > static_cast<float>(m_bucketCount) * m_maxLoadFactor)
+        {
+            Rehash(count);
+        }
+    }
+
+    Iterator begin() noexcept
+    {
+        return Iterator(this, 0);
+    }
+
+    Iterator end() noexcept
+    {
+        return Iterator(this, m_size);
+    }
+
+    ConstIterator begin() const noexcept
+    {
+        return ConstIterator(this, 0);
+    }
+
+    ConstIterator end() const noexcept
+    {
+        return ConstIterator(this, m_size);
+    }
+
+    ConstIterator cbegin() const noexcept
+    {
+        return begin();
+    }
+
+    ConstIterator cend() const noexcept
+    {
+        return end();
+    }
+
+    bool Empty() const
+    {
+        return !m_size;
+    }
+
+    SizeType Size() const
+    {
+        return m_size;
+    }
+
+    SizeType BucketCount() const
+    {
+        return m_bucketCount;
+    }
+
+    float LoadFactor() const
+    {
+        return m_bucketCount ? static_cast<float>(m_size) / static_cast<float>(m_bucketCount) : 0.0f;
+    }
+
+    float MaxLoadFactor() const
+    {
+        return m_maxLoadFactor;
+    }
+
+    void MaxLoadFactor(float maxLoadFactor)
+    {
+        assert(maxLoadFactor > 0.0f && "StringHashTable::MaxLoadFactor has to be positive");
+
+        m_maxLoadFactor = maxLoadFactor;
+        if (static_cast<float>(m_size) > static_cast<float>(m_bucketCount) * m_maxLoadFactor)
+        {
+            Rehash(m_bucketCount);
+        }
+    }
+
+    // arena bytes in use, including erased keys that haven't been compacted away yet
+    SizeType ArenaSize() const
+    {
+        return m_arenaSize;
+    }
+
+    // heap memory held by the table: elements, buckets and arena, counting unused capacity
+    SizeType SizeInBytes() const
+    {
+        return m_entryCapacity * sizeof(Entry) + m_bucketCount * sizeof(Index) + m_arenaCapacity;
+    }
+
+  private:
+    template <typename... Args> std::pair<Value *, bool> tryEmplace(std::string_view key, Args &&...args)
+    {
+        const SizeType h = hashOf(key);
+
+        if (Index i = find(key, h); i != NONE)
+        {
+            return {&m_entries[i].value, false};
+        }
+        return {&emplaceNew(key, h, std::forward<Args>(args)...), true};
+    }
+
+    // key isn't in the table yet
+    template <typename... Args> Value &emplaceNew(std::string_view key, SizeType h, Args &&...args)
+    {
+        if (key.size() > MAX_KEY_LENGTH || m_arenaSize + key.size() > MAX_ARENA_SIZE || m_size >= NONE)
+        {
+            throw std::length_error("StringHashTable: key, key bytes or element count too large");
+        }
+
+        if (m_size == m_entryCapacity)
+        {
+            reserveEntries(std::max(m_entryCapacity * 2, SizeType(SHT_INIT_CAPACITY)));
+        }
+        if (static_cast<float>(m_size + 1) > static_cast<float>(m_bucketCount) * m_maxLoadFactor)
+        {
+            Rehash(m_bucketCount ? m_bucketCount * 2 : SizeType(SHT_INIT_CAPACITY));
+        }
+
+        // the key may point into the arena itself, e.g. one taken from an iterator, which growing frees
+        const SizeType offset = m_arenaSize;
+        if (m_arenaSize + key.size() > m_arenaCapacity)
+        {
+            reserveArena(std::max(m_arenaCapacity * 2, m_arenaSize + key.size()), key);
+        }
+        else
+        {
+            std::memmove(m_arena + offset, key.data(), key.size());
+        }
+
+        Index &head = m_buckets[bucketIndex(h)];
+        Entry *entry = new (&m_entries[m_size])
+            Entry(offset, key.size(), static_cast<uint32_t>(h), head, std::forward<Args>(args)...);
+
+        // nothing changed until the value was built, a throwing constructor leaves the bytes unreferenced
+        m_arenaSize += key.size();
+        head = static_cast<Index>(m_size++);
+        return entry->value;
+    }
+
+    Index find(std::string_view key, SizeType h) const noexcept
+    {
+        if (!m_size)
+        {
+            return NONE;
+        }
+
+        for (Index i = m_buckets[bucketIndex(h)]; i != NONE; i = m_entries[i].next)
+        {
+            if (matches(m_entries[i], key, h))
+            {
+                return i;
+            }
+        }
+        return NONE;
+    }
+
+    // the key bytes are only read when hash and length already agree
+    bool matches(const Entry &entry, std::string_view key, SizeType h) const noexcept
+    {
+        return entry.hash == static_cast<uint32_t>(h) && entry.length() == key.size() &&
+               std::memcmp(m_arena + entry.offset(), key.data(), key.size()) == 0;
+    }
+
+    std::string_view keyOf(const Entry &entry) const noexcept
+    {
+        return std::string_view(m_arena + entry.offset(), entry.length());
+    }
+
+    void reserveEntries(SizeType capacity)
+    {
+        if (capacity <= m_entryCapacity)
+        {
+            return;
+        }
+
+        Entry *entries = static_cast<Entry *>(::operator new(capacity * sizeof(Entry), std::align_val_t(alignof(Entry))));
+        for (SizeType i = 0; i < m_size; ++i)
+        {
+            new (&entries[i]) Entry(std::move_if_noexcept(m_entries[i]));
+            m_entries[i].~Entry();
+        }
+
+        freeEntries();
+        m_entries = entries;
+        m_entryCapacity = capacity;
+    }
+
+    // pending is appended at m_arenaSize after the old bytes are copied, it may point into the old arena
+    void reserveArena(SizeType capacity, std::string_view pending = {})
+    {
+        if (capacity <= m_arenaCapacity && pending.empty())
+        {
+            return;
+        }
+
+        char *arena = static_cast<char *>(::operator new(capacity));
+        if (m_arenaSize)
+        {
+            std::memcpy(arena, m_arena, m_arenaSize);
+        }
+        if (!pending.empty())
+        {
+            std::memcpy(arena + m_arenaSize, pending.data(), pending.size());
+        }
+
+        ::operator delete(m_arena, m_arenaCapacity);
+        m_arena = arena;
+        m_arenaCapacity = capacity;
+    }
+
+    // copies the live keys into a right-sized arena, in element order
+    void compactArena()
+    {
+        const SizeType live = m_arenaSize - m_garbage;
+        const SizeType capacity = std::max(live * 2, SizeType(SHT_MIN_COMPACT_BYTES));
+        char *arena = static_cast<char *>(::operator new(capacity));
+
+        SizeType offset = 0;
+        for (SizeType i = 0; i < m_size; ++i)
+        {
+            Entry &entry = m_entries[i];
+            std::memcpy(arena + offset, m_arena + entry.offset(), entry.length());
+            entry.moveKey(offset);
+            offset += entry.length();
+        }
+
+        ::operator delete(m_arena, m_arenaCapacity);
+        m_arena = arena;
+        m_arenaCapacity = capacity;
+        m_arenaSize = offset;
+        m_garbage = 0;
+    }
+
+    void allocateBuckets(SizeType count)
+    {
+        m_buckets = static_cast<Index *>(::operator new(count * sizeof(Index)));
+        m_bucketCount = count;
+        std::fill(m_buckets, m_buckets + count, NONE);
+    }
+
+    void destroyEntries() noexcept
+    {
+        if constexpr (!std::is_trivially_destructible_v<Value>)
+        {
+            for (SizeType i = 0; i < m_size; ++i)
+            {
+                m_entries[i].~Entry();
+            }
+        }
+        m_size = 0;
+    }
+
+    void freeEntries() noexcept
+    {
+        if (m_entries)
+        {
+            ::operator delete(m_entries, m_entryCapacity * sizeof(Entry), std::align_val_t(alignof(Entry)));
+        }
+    }
+
+    void destroy() noexcept
+    {
+        destroyEntries();
+        freeEntries();
+        if (m_buckets)
+        {
+            ::operator delete(m_buckets, m_bucketCount * sizeof(Index));
+        }
+        if (m_arena)
+        {
+            ::operator delete(m_arena, m_arenaCapacity);
+        }
+    }
+
+    void swap(StringHashTable &other) noexcept
+    {
+        std::swap(m_entries, other.m_entries);
+        std::swap(m_size, other.m_size);
+        std::swap(m_entryCapacity, other.m_entryCapacity);
+        std::swap(m_buckets, other.m_buckets);
+        std::swap(m_bucketCount, other.m_bucketCount);
+        std::swap(m_arena, other.m_arena);
+        std::swap(m_arenaSize, other.m_arenaSize);
+        std::swap(m_arenaCapacity, other.m_arenaCapacity);
+        std::swap(m_garbage, other.m_garbage);
+        std::swap(m_maxLoadFactor, other.m_maxLoadFactor);
+    }
+
+    // bucket count is always a power of two
+    SizeType bucketIndex(SizeType h) const noexcept
+    {
+        return h & (m_bucketCount - 1);
+    }
+
+    static SizeType hashOf(std::string_view key) noexcept
+    {
+        return Hash<std::string_view>{}(key);
+    }
+
+    static SizeType normalizeCapacity(SizeType capacity) noexcept
+    {
+        return std::bit_ceil(capacity ? capacity : SizeType(1));
+    }
+
+  private:
+    Entry *m_entries = nullptr;
+    SizeType m_size = 0;
+    SizeType m_entryCapacity = 0;
+
+    Index *m_buckets = nullptr;
+    SizeType m_bucketCount = 0;
+
+    char *m_arena = nullptr;
+    SizeType m_arenaSize = 0;
+    SizeType m_arenaCapacity = 0;
+    SizeType m_garbage = 0; // arena bytes of erased keys
+
+    float m_maxLoadFactor = SHT_MAX_LOAD_FACTOR;
+};
+
+} // namespace icb
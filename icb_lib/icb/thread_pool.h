@@ -0,0 +1,192 @@
+/**
+ * @file thread_pool.h
+ * @author Dovydas Ciomenas (icouldbreathe@icloud.com)
+ * @brief Fixed-size thread pool for splitting one operation into parallel tasks
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace icb
+{
+/**
+ * @brief Runs batches of numbered tasks on a fixed set of threads, the calling thread included
+ *
+ * Run(taskCount, fn) calls fn(task) once for every task in [0, taskCount) and returns when all of them are done.
+ * Tasks are handed out one at a time from a shared counter, so uneven tasks still balance. The first exception a
+ * task throws is rethrown from Run once the remaining tasks have finished.
+ *
+ * Batches from different threads run one after another. A task must not call Run on its own pool.
+ */
+class ThreadPool
+{
+  public:
+    using SizeType = size_t;
+
+  private:
+    struct Batch
+    {
+        void (*invoke)(void *fn, SizeType task);
+        void *fn;
+        SizeType taskCount;
+        std::atomic<SizeType> next{0};
+        std::mutex errorMutex;
+        std::exception_ptr error;
+    };
+
+  public:
+    // threadCount counts the thread calling Run, a pool of 1 runs everything on the caller
+    explicit ThreadPool(SizeType threadCount = std::thread::hardware_concurrency())
+    {
+        threadCount = std::max(threadCount, SizeType(1));
+        m_workers.reserve(threadCount - 1);
+        for (SizeType i = 1; i < threadCount; ++i)
+        {
+            m_workers.emplace_back([this] { workerLoop(); });
+        }
+    }
+
+    ~ThreadPool()
+    {
+        {
+            std::lock_guard lock(m_mutex);
+            m_stop = true;
+        }
+        m_wake.notify_all();
+
+        for (std::thread &worker : m_workers)
+        {
+            worker.join();
+        }
+    }
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    // process-wide pool with a thread per hardware thread, started on first use
+    static ThreadPool &Get()
+    {
+        static ThreadPool instance;
+        return instance;
+    }
+
+    SizeType ThreadCount() const
+    {
+        return m_workers.size() + 1;
+    }
+
+    template <typename Fn> void Run(SizeType taskCount, Fn &&fn)
+    {
+        if (!taskCount)
+        {
+            return;
+        }
+
+        std::lock_guard run(m_runMutex);
+
+        Batch batch;
+        batch.invoke = [](void *callable, SizeType task) {
+            (*static_cast<std::remove_reference_t<Fn> *>(callable))(task);
+        };
+        batch.fn = const_cast<void *>(static_cast<const void *>(&fn));
+        batch.taskCount = taskCount;
+
+        {
+            std::lock_guard lock(m_mutex);
+            m_batch = &batch;
+            ++m_generation;
+        }
+        m_wake.notify_all();
+
+        work(batch);
+
+        // every task is taken, wait for the workers still running one; later wakers find no batch
+        {
+            std::unique_lock lock(m_mutex);
+            m_done.wait(lock, [&] { return m_active == 0; });
+            m_batch = nullptr;
+        }
+
+        if (batch.error)
+        {
+            std::rethrow_exception(batch.error);
+        }
+    }
+
+  private:
+    void workerLoop()
+    {
+        uint64_t seen = 0;
+        std::unique_lock lock(m_mutex);
+
+        while (true)
+        {
+            m_wake.wait(lock, [&] { return m_stop || (m_batch && m_generation != seen); });
+            if (m_stop)
+            {
+                return;
+            }
+
+            seen = m_generation;
+            Batch *batch = m_batch;
+            ++m_active;
+
+            lock.unlock();
+            work(*batch);
+            lock.lock();
+
+            if (--m_active == 0)
+            {
+                m_done.notify_all();
+            }
+        }
+    }
+
+    static void work(Batch &batch) noexcept
+    {
+        for (SizeType task = batch.next.fetch_add(1, std::memory_order_relaxed); task < batch.taskCount;
+             task = batch.next.fetch_add(1, std::memory_order_relaxed))
+        {
+            try
+            {
+                batch.invoke(batch.fn, task);
+            }
+            catch (...)
+            {
+                std::lock_guard lock(batch.errorMutex);
+                if (!batch.error)
+                {
+                    batch.error = std::current_exception();
+                }
+            }
+        }
+    }
+
+  private:
+    std::vector<std::thread> m_workers;
+
+    std::mutex m_runMutex; // one batch at a time
+    std::mutex m_mutex;    // guards everything below
+    std::condition_variable m_wake;
+    std::condition_variable m_done;
+    Batch *m_batch = nullptr;
+    uint64_t m_generation = 0;
+    SizeType m_active = 0; // workers inside the current batch
+    bool m_stop = false;
+};
+
+} // namespace icb
@@ -0,0 +1,667 @@
+/**
+ * @file unrolled_list.h
+ * @author Dovydas Ciomenas (icouldbreathe@icloud.com)
+ * @brief Doubly linked list of small arrays, several elements per node
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <assert.h>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#define UL_NODE_BYTES 256 // target node size, a few cache lines
+
+namespace icb
+{
+/**
+ * @brief Sequence with the interface of LinkedList that stores up to NODE_CAPACITY elements per node
+ *
+ * Each node holds its elements in an array, so walking the list reads whole cache lines of elements and follows a
+ * pointer only once per node, instead of once per element. Inserting into a full node splits it in two halves,
+ * erasing from a node that drops below a quarter full merges it with a neighbour when they fit together in three
+ * quarters of a node. Appending at either end starts a new node instead of splitting, so a list built with PushBack
+ * or PushFront has full nodes.
+ *
+ * Unlike LinkedList, elements move: Insert, Emplace, Erase and Splice shift the elements after the position within
+ * its node and may split or merge nodes, which invalidates iterators into the nodes involved. The iterators they
+ * return are valid. PushBack and EmplaceBack keep all iterators valid.
+ */
+template <typename T> class UnrolledList
+{
+  public:
+    using ValueType = T;
+    using SizeType = size_t;
+    using Reference = T &;
+    using Pointer = T *;
+
+  private:
+    struct NodeLink
+    {
+        NodeLink *prev;
+        NodeLink *next;
+    };
+
+    // the element array follows the header in the same allocation
+    struct Node : NodeLink
+    {
+        SizeType count;
+
+        T *data() noexcept
+        {
+            return std::launder(reinterpret_cast<T *>(reinterpret_cast<unsigned char *>(this) + STORAGE_OFFSET));
+        }
+    };
+
+    static constexpr SizeType STORAGE_OFFSET = (sizeof(Node) + alignof(T) - 1) / alignof(T) * alignof(T);
+    static constexpr SizeType NODE_ALIGN = std::max(alignof(Node), alignof(T));
+
+  public:
+    static constexpr SizeType NODE_CAPACITY =
+        std::max(SizeType(4), (UL_NODE_BYTES - STORAGE_OFFSET) / sizeof(T));
+
+  private:
+    static constexpr SizeType NODE_BYTES = STORAGE_OFFSET + NODE_CAPACITY * sizeof(T);
+
+    template <typename AccessType = T> class BaseIterator
+    {
+      public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using difference_type = std::ptrdiff_t;
+        using value_type = T;
+        using pointer = std::conditional_t<std::is_const_v<AccessType>, const T *, T *>;
+        using reference = std::conditional_t<std::is_const_v<AccessType>, const T &, T &>;
+        using self_type = BaseIterator<AccessType>;
+
+      public:
+        BaseIterator() = default;
+
+        // implicit conversion from Iterator to ConstIterator
+        template <typename WasAccessType,
+                  class = std::enable_if_t<std::is_const_v<AccessType> && !std::is_const_v<WasAccessType>>>
+        BaseIterator(const BaseIterator<WasAccessType> &other) noexcept
+            : m_node(other.m_node), m_index(other.m_index)
+        {
+        }
+
+        // prefix ++
+        self_type &operator++() noexcept
+        {
+            if (++m_index == asNode(m_node)->count)
+            {
+                m_node = m_node->next;
+                m_index = 0;
+            }
+            return *this;
+        }
+
+        // postfix ++
+        self_type operator++(int) noexcept
+        {
+            self_type previous = *this;
+            ++*this;
+            return previous;
+        }
+
+        // prefix --
+        self_type &operator--() noexcept
+        {
+            if (m_index == 0)
+            {
+                m_node = m_node->prev;
+                m_index = asNode(m_node)->count;
+            }
+            --m_index;
+            return *this;
+        }
+
+        // postfix --
+        self_type operator--(int) noexcept
+        {
+            self_type previous = *this;
+            --*this;
+            return previous;
+        }
+
+        reference operator*() const
+        {
+            assert(m_node && "UnrolledList::Iterator::operator* nullptr dereference");
+            return asNode(m_node)->data()[m_index];
+        }
+
+        pointer operator->() const
+        {
+            return &asNode(m_node)->data()[m_index];
+        }
+
+        friend bool operator==(const self_type &x, const self_type &y) noexcept
+        {
+            return x.m_node == y.m_node && x.m_index == y.m_index;
+        }
+
+        friend bool operator!=(const self_type &x, const self_type &y) noexcept
+        {
+            return !(x == y);
+        }
+
+        friend class UnrolledList;
+        template <typename> friend class BaseIterator;
+
+      private:
+        BaseIterator(NodeLink *node, SizeType index) noexcept : m_node(node), m_index(index)
+        {
+        }
+
+      private:
+        NodeLink *m_node = nullptr;
+        SizeType m_index = 0;
+    };
+
+  public:
+    using Iterator = BaseIterator<T>;
+    using ConstIterator = BaseIterator<const T>;
+
+  public:
+    UnrolledList() = default;
+
+    ~UnrolledList()
+    {
+        Clear();
+    }
+
+    template <typename InputIterator> UnrolledList(InputIterator first, InputIterator last)
+    {
+        for (; first != last; ++first)
+            PushBack(*first);
+    }
+
+    UnrolledList(std::initializer_list<ValueType> init) : UnrolledList(init.begin(), init.end())
+    {
+    }
+
+    // copy ctor, the copy has full nodes
+    UnrolledList(const UnrolledList &other) : UnrolledList(other.cbegin(), other.cend())
+    {
+    }
+
+    // move ctor
+    UnrolledList(UnrolledList &&other) noexcept
+    {
+        takeNodes(other);
+    }
+
+    // copy assignment
+    UnrolledList &operator=(const UnrolledList &other)
+    {
+        if (this != &other)
+        {
+            UnrolledList copy(other);
+            Clear();
+            takeNodes(copy);
+        }
+        return *this;
+    }
+
+    // move assignment
+    UnrolledList &operator=(UnrolledList &&other) noexcept
+    {
+        if (this != &other)
+        {
+            Clear();
+            takeNodes(other);
+        }
+        return *this;
+    }
+
+    // copy
+    void PushBack(const ValueType &value)
+    {
+        EmplaceBack(value);
+    }
+
+    // move
+    void PushBack(ValueType &&value)
+    {
+        EmplaceBack(std::move(value));
+    }
+
+    template <typename... Args> void EmplaceBack(Args &&...args)
+    {
+        Node *last = m_end.prev != &m_end ? asNode(m_end.prev) : nullptr;
+        if (!last || last->count == NODE_CAPACITY)
+        {
+            last = createNode(&m_end);
+        }
+        constructAt(last, last->count, std::forward<Args>(args)...);
+    }
+
+    // copy
+    void PushFront(const ValueType &value)
+    {
+        EmplaceFront(value);
+    }
+
+    // move
+    void PushFront(ValueType &&value)
+    {
+        EmplaceFront(std::move(value));
+    }
+
+    template <typename... Args> void EmplaceFront(Args &&...args)
+    {
+        Node *first = m_end.next != &m_end ? asNode(m_end.next) : nullptr;
+        if (!first || first->count == NODE_CAPACITY)
+        {
+            first = createNode(m_end.next);
+        }
+        constructAt(first, 0, std::forward<Args>(args)...);
+    }
+
+    // copy
+    Iterator Insert(ConstIterator position, const ValueType &value)
+    {
+        return Emplace(position, value);
+    }
+
+    // move
+    Iterator Insert(ConstIterator position, ValueType &&value)
+    {
+        return Emplace(position, std::move(value));
+    }
+
+    /**
+     * @brief Constructs an element before position
+     *
+     * @return Iterator to the new element
+     */
+    template <typename... Args> Iterator Emplace(ConstIterator position, Args &&...args)
+    {
+        auto [node, index] = makeRoom(position.m_node, position.m_index);
+        constructAt(node, index, std::forward<Args>(args)...);
+        return Iterator(node, index);
+    }
+
+    /**
+     * @brief Erases the element at position
+     *
+     * @return Iterator to the element that followed it
+     */
+    Iterator Erase(ConstIterator position)
+    {
+        assert(position.m_node != &m_end && "UnrolledList::Erase end iterator");
+
+        Node *node = asNode(position.m_node);
+        SizeType index = position.m_index;
+
+        destroyAt(node, index);
+        NodeLink *link = rebalance(node, index);
+        if (link != &m_end && index == asNode(link)->count)
+        {
+            link = link->next;
+            index = 0;
+        }
+        return Iterator(link, index);
+    }
+
+    /**
+     * @brief Moves the element at it from other to before position, O(NODE_CAPACITY)
+     *
+     * The element is moved, not relinked, so pointers to it don't follow it. other can be this list. If moving the
+     * element throws, both lists stay valid; the element stays in other, unless other is this list and its node holds
+     * more than that element, then it is lost.
+     */
+    void Splice(ConstIterator position, UnrolledList &other, ConstIterator it)
+    {
+        assert(it.m_node != &other.m_end && "UnrolledList::Splice splicing the end node is undefined behavior");
+
+        if (&other == this && position == it)
+        {
+            return;
+        }
+
+        Node *from = asNode(it.m_node);
+        SizeType index = it.m_index;
+
+        // constructed at position before it is erased: nothing in other moves, and a lone element's node is at most
+        // appended to, never split or shifted
+        if (&other != this || from->count == 1)
+        {
+            Emplace(position, std::move(from->data()[index]));
+            other.destroyAt(from, index);
+            other.rebalance(from, index);
+            return;
+        }
+
+        ValueType value = std::move(from->data()[index]);
+
+        // erased without rebalancing, so no node disappears before the insert; from keeps at least one element
+        other.destroyAt(from, index);
+        if (position.m_node == from && position.m_index > index)
+        {
+            --position.m_index;
+        }
+
+        index = 0;
+        try
+        {
+            Emplace(position, std::move(value));
+        }
+        catch (...)
+        {
+            rebalance(from, index);
+            throw;
+        }
+        rebalance(from, index);
+    }
+
+    /**
+     * @brief Moves all of other's elements before position, relinking its nodes, O(NODE_CAPACITY)
+     *
+     * Only the node at position may be split in two, other's elements stay in their nodes.
+     */
+    void Splice(ConstIterator position, UnrolledList &other)
+    {
+        assert(&other != this && "UnrolledList::Splice a list into itself");
+
+        if (other.Empty())
+        {
+            return;
+        }
+
+        NodeLink *next = position.m_node;
+        if (next != &m_end && position.m_index > 0)
+        {
+            next = splitAt(asNode(next), position.m_index);
+        }
+
+        NodeLink *first = other.m_end.next;
+        NodeLink *last = other.m_end.prev;
+        NodeLink *prev = next->prev;
+
+        prev->next = first;
+        first->prev = prev;
+        last->next = next;
+        next->prev = last;
+
+        m_size += other.m_size;
+        m_nodeCount += other.m_nodeCount;
+        other.m_end.next = other.m_end.prev = &other.m_end;
+        other.m_size = 0;
+        other.m_nodeCount = 0;
+    }
+
+    void PopFront()
+    {
+        assert(!Empty() && "UnrolledList::PopFront empty list");
+        Erase(begin());
+    }
+
+    void PopBack()
+    {
+        assert(!Empty() && "UnrolledList::PopBack empty list");
+        Erase(std::prev(end()));
+    }
+
+    void Clear()
+    {
+        NodeLink *link = m_end.next;
+        while (link != &m_end)
+        {
+            NodeLink *next = link->next;
+            Node *node = asNode(link);
+            std::destroy_n(node->data(), node->count);
+            ::operator delete(node, NODE_BYTES, std::align_val_t(NODE_ALIGN));
+            link = next;
+        }
+
+        m_end.next = m_end.prev = &m_end;
+        m_size = 0;
+        m_nodeCount = 0;
+    }
+
+    Reference Front() const noexcept
+    {
+        assert(!Empty() && "UnrolledList::Front empty list");
+        return asNode(m_end.next)->data()[0];
+    }
+
+    Reference Back() const noexcept
+    {
+        assert(!Empty() && "UnrolledList::Back empty list");
+        Node *last = asNode(m_end.prev);
+        return last->data()[last->count - 1];
+    }
+
+    SizeType Size() const noexcept
+    {
+        return m_size;
+    }
+
+    bool Empty() const noexcept
+    {
+        return !m_size;
+    }
+
+    SizeType NodeCount() const noexcept
+    {
+        return m_nodeCount;
+    }
+
+    Iterator begin() noexcept
+    {
+        return Iterator(m_end.next, 0);
+    }
+
+    Iterator end() noexcept
+    {
+        return Iterator(&m_end, 0);
+    }
+
+    ConstIterator begin() const noexcept
+    {
+        return ConstIterator(const_cast<NodeLink *>(m_end.next), 0);
+    }
+
+    ConstIterator end() const noexcept
+    {
+        return ConstIterator(const_cast<NodeLink *>(&m_end), 0);
+    }
+
+    ConstIterator cbegin() const noexcept
+    {
+        return begin();
+    }
+
+    ConstIterator cend() const noexcept
+    {
+        return end();
+    }
+
+  private:
+    // a new empty node linked before next
+    Node *createNode(NodeLink *next)
+    {
+        Node *node = static_cast<Node *>(::operator new(NODE_BYTES, std::align_val_t(NODE_ALIGN)));
+        node->count = 0;
+        node->next = next;
+        node->prev = next->prev;
+        next->prev->next = node;
+        next->prev = node;
+        ++m_nodeCount;
+        return node;
+    }
+
+    void freeNode(Node *node) noexcept
+    {
+        node->prev->next = node->next;
+        node->next->prev = node->prev;
+        ::operator delete(node, NODE_BYTES, std::align_val_t(NODE_ALIGN));
+        --m_nodeCount;
+    }
+
+    // constructs the element at index of a node with room, shifting the ones from index up by one
+    template <typename... Args> void constructAt(Node *node, SizeType index, Args &&...args)
+    {
+        T *data = node->data();
+        if (index == node->count)
+        {
+            try
+            {
+                new (data + index) T(std::forward<Args>(args)...);
+            }
+            catch (...)
+            {
+                // a node created for this element mustn't stay behind empty
+                if (!node->count)
+                {
+                    freeNode(node);
+                }
+                throw;
+            }
+        }
+        else
+        {
+            // built first, args may refer to an element that is about to move
+            T value(std::forward<Args>(args)...);
+            new (data + node->count) T(std::move(data[node->count - 1]));
+            std::move_backward(data + index, data + node->count - 1, data + node->count);
+            data[index] = std::move(value);
+        }
+        ++node->count;
+        ++m_size;
+    }
+
+    // destroys the element at index, shifting the ones after it down, the node may be left empty
+    void destroyAt(Node *node, SizeType index) noexcept
+    {
+        T *data = node->data();
+        std::move(data + index + 1, data + node->count, data + index);
+        data[node->count - 1].~T();
+        --node->count;
+        --m_size;
+    }
+
+    // moves the elements [index, count) of from to the end of to
+    static void moveTail(Node *from, SizeType index, Node *to) noexcept
+    {
+        std::uninitialized_move(from->data() + index, from->data() + from->count, to->data() + to->count);
+        std::destroy(from->data() + index, from->data() + from->count);
+        to->count += from->count - index;
+        from->count = index;
+    }
+
+    // moves [index, count) into a new node after node, returns the new node
+    Node *splitAt(Node *node, SizeType index)
+    {
+        Node *tail = createNode(node->next);
+        moveTail(node, index, tail);
+        return tail;
+    }
+
+    // a node and index with room for one more element, where an element inserted before link/index has to go
+    std::pair<Node *, SizeType> makeRoom(NodeLink *link, SizeType index)
+    {
+        // end, or the start of a node: append to the previous node if it has room
+        if (index == 0 && link->prev != &m_end && asNode(link->prev)->count < NODE_CAPACITY)
+        {
+            Node *prev = asNode(link->prev);
+            return {prev, prev->count};
+        }
+
+        // starting a node of its own beats splitting a full one in front of its first element
+        if (link == &m_end || index == 0)
+        {
+            return {createNode(link), 0};
+        }
+
+        Node *node = asNode(link);
+        if (node->count < NODE_CAPACITY)
+        {
+            return {node, index};
+        }
+
+        const SizeType half = NODE_CAPACITY / 2;
+        Node *tail = splitAt(node, half);
+        return index > half ? std::pair{tail, index - half} : std::pair{node, index};
+    }
+
+    /*
+     * After an erase from node: frees it if empty, or merges it with a neighbour when it fell below a quarter full
+     * and both fit in three quarters of a node. index (a position in node) is carried over to where the merge put
+     * it. Returns the node holding that position, or the next node when node was freed (index is then 0).
+     */
+    NodeLink *rebalance(Node *node, SizeType &index) noexcept
+    {
+        if (node->count == 0)
+        {
+            NodeLink *next = node->next;
+            freeNode(node);
+            index = 0;
+            return next;
+        }
+
+        if (node->count >= NODE_CAPACITY / 4)
+        {
+            return node;
+        }
+
+        constexpr SizeType MERGED = NODE_CAPACITY * 3 / 4;
+        if (node->next != &m_end && node->count + asNode(node->next)->count <= MERGED)
+        {
+            Node *next = asNode(node->next);
+            moveTail(next, 0, node);
+            freeNode(next);
+        }
+        else if (node->prev != &m_end && asNode(node->prev)->count + node->count <= MERGED)
+        {
+            Node *prev = asNode(node->prev);
+            index += prev->count;
+            moveTail(node, 0, prev);
+            freeNode(node);
+            return prev;
+        }
+        return node;
+    }
+
+    // other's nodes become this list's, this list has to be empty
+    void takeNodes(UnrolledList &other) noexcept
+    {
+        if (other.Empty())
+        {
+            return;
+        }
+
+        m_end.next = other.m_end.next;
+        m_end.prev = other.m_end.prev;
+        m_end.next->prev = &m_end;
+        m_end.prev->next = &m_end;
+        m_size = other.m_size;
+        m_nodeCount = other.m_nodeCount;
+
+        other.m_end.next = other.m_end.prev = &other.m_end;
+        other.m_size = 0;
+        other.m_nodeCount = 0;
+    }
+
+    static Node *asNode(NodeLink *link) noexcept
+    {
+        return static_cast<Node *>(link);
+    }
+
+  private:
+    NodeLink m_end{&m_end, &m_end};
+    SizeType m_size = 0;
+    SizeType m_nodeCount = 0;
+};
+
+} // namespace icb
@@ -11,20 +11,241 @@
 
 #pragma once
 
+#include <algorithm>
 #include <assert.h>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
 #include <initializer_list>
 #include <iostream>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
 #include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
 
 #include <vector>
 
 namespace icb
 {
-template <typename T> class Vector
+/**
+ * @brief Whether a T can be moved to another address by copying its bytes and forgetting the old ones
+ *
+ * True for trivially copyable types. Most types that only point elsewhere qualify too (std::unique_ptr, std::vector),
+ * unlike ones that point into themselves, so it can be specialized to std::true_type for them. Vector grows, inserts
+ * and erases such types with memcpy/memmove and grows their buffer with realloc.
+ */
+template <typename T> struct IsTriviallyRelocatable : std::is_trivially_copyable<T>
+{
+};
+
+template <typename T> inline constexpr bool isTriviallyRelocatable = IsTriviallyRelocatable<T>::value;
+
+namespace detail
+{
+/*
+ * Element operations on a raw buffer, shared by Vector, SmallVector and StaticVector: data holds size live elements
+ * followed by uninitialized room, and the callers make sure the room is there. Types that relocate by their bytes
+ * (see IsTriviallyRelocatable) are moved with memcpy/memmove, except in constant expressions, which can't.
+ */
+template <typename T>
+inline constexpr bool relocatableElements = isTriviallyRelocatable<T> && std::is_nothrow_move_constructible_v<T>;
+
+template <typename T> constexpr void DestroyElements(T *first, T *last) noexcept
+{
+    if constexpr (!std::is_trivially_destructible_v<T>)
+    {
+        std::destroy(first, last);
+    }
+}
+
+// next capacity of a growing buffer, 1.5 times the current one
+constexpr size_t GrownCapacity(size_t capacity) noexcept
+{
+    return capacity + (capacity + 2) / 2;
+}
+
+template <typename ConstIterator>
+constexpr size_t IndexOf(ConstIterator position, ConstIterator begin, [[maybe_unused]] size_t size)
+{
+    const auto index = position - begin;
+    assert(index >= 0 && static_cast<size_t>(index) <= size && "Vector iterator out of range");
+    return static_cast<size_t>(index);
+}
+
+/**
+ * @brief Moves the size elements of data to the front of newData, leaving data without live elements
+ *
+ * A relocatable type is copied by its bytes and the old bytes are simply forgotten: no move constructor, no
+ * destructor. Anything else is moved one by one, and copied instead when its move constructor could throw, so if
+ * it does, the elements in data are still intact and newData holds none.
+ */
+template <typename T> void RelocateElements(T *data, size_t size, T *newData)
+{
+    if constexpr (relocatableElements<T>)
+    {
+        if (size)
+            std::memcpy(static_cast<void *>(newData), data, size * sizeof(T));
+    }
+    else
+    {
+        size_t i = 0;
+        try
+        {
+            for (; i < size; ++i)
+            {
+                std::construct_at(newData + i, std::move_if_noexcept(data[i]));
+            }
+        }
+        catch (...)
+        {
+            DestroyElements(newData, newData + i);
+            throw;
+        }
+
+        DestroyElements(data, data + size);
+    }
+}
+
+// builds an element at newData[size], then relocates the elements of data in front of it; args may refer to them
+template <typename T, typename... Args> T &EmplaceAndRelocate(T *data, size_t size, T *newData, Args &&...args)
+{
+    T *added = std::construct_at(newData + size, std::forward<Args>(args)...);
+    try
+    {
+        RelocateElements(data, size, newData);
+    }
+    catch (...)
+    {
+        std::destroy_at(added);
+        throw;
+    }
+    return *added;
+}
+
+// copy constructs count elements from source at the end, size counts each one as soon as it is built
+template <typename T> constexpr void AppendCopies(T *data, size_t &size, const T *source, size_t count)
+{
+    if constexpr (std::is_trivially_copyable_v<T>)
+    {
+        if (!std::is_constant_evaluated())
+        {
+            if (count)
+                std::memcpy(static_cast<void *>(data + size), source, count * sizeof(T));
+            size += count;
+            return;
+        }
+    }
+
+    for (size_t i = 0; i < count; ++i, ++size)
+    {
+        std::construct_at(data + size, source[i]);
+    }
+}
+
+/**
+ * @brief Copies count elements from first into a gap opened at index, for trivially copyable types
+ *
+ * The tail is moved up once, by count, with memmove. Nothing can throw, so no element is ever left half-shifted.
+ */
+template <typename T, typename ForwardIterator>
+constexpr void InsertCopies(T *data, size_t &size, size_t index, ForwardIterator first, size_t count)
+{
+    static_assert(std::is_trivially_copyable_v<T>, "InsertCopies shifts the elements by their bytes");
+
+    if (std::is_constant_evaluated())
+    {
+        for (size_t i = size; i-- > index;)
+        {
+            std::construct_at(data + i + count, data[i]);
+        }
+    }
+    else if (size > index)
+    {
+        std::memmove(static_cast<void *>(data + index + count), data + index, (size - index) * sizeof(T));
+    }
+
+    for (size_t i = index; i < index + count; ++i, ++first)
+    {
+        std::construct_at(data + i, *first);
+    }
+    size += count;
+}
+
+/**
+ * @brief Moves value in at index < size, shifting [index, size) up by one
+ *
+ * value must not be one of the elements: callers build it first from their arguments, which may refer to elements
+ * that are about to move.
+ */
+template <typename T> constexpr void InsertShifting(T *data, size_t &size, size_t index, T &&value)
+{
+    if constexpr (relocatableElements<T>)
+    {
+        if (!std::is_constant_evaluated())
+        {
+            std::memmove(static_cast<void *>(data + index + 1), data + index, (size - index) * sizeof(T));
+            std::construct_at(data + index, std::move(value));
+            ++size;
+            return;
+        }
+    }
+
+    std::construct_at(data + size, std::move(data[size - 1]));
+    std::move_backward(data + index, data + size - 1, data + size);
+    data[index] = std::move(value);
+    ++size;
+}
+
+// erases [index, index + count), moving the tail down over the gap
+template <typename T> constexpr void CloseGap(T *data, size_t &size, size_t index, size_t count)
+{
+    if (count == 0)
+    {
+        return;
+    }
+
+    if constexpr (relocatableElements<T>)
+    {
+        if (!std::is_constant_evaluated())
+        {
+            // the erased elements are gone, the tail's bytes can be moved over them as they are
+            DestroyElements(data + index, data + index + count);
+            std::memmove(static_cast<void *>(data + index), data + index + count,
+                         (size - index - count) * sizeof(T));
+            size -= count;
+            return;
+        }
+    }
+
+    std::move(data + index + count, data + size, data + index);
+    DestroyElements(data + size - count, data + size);
+    size -= count;
+}
+} // namespace detail
+
+/**
+ * @brief Dynamic array
+ *
+ * The buffer comes from Allocator, which only provides the memory: elements are constructed in it as they are with
+ * std::allocator, the allocator isn't passed on to them. A copy asks the allocator through
+ * select_on_container_copy_construction, a move takes the other vector's allocator along with its buffer, and
+ * assignment keeps the allocator this vector was made with, so a vector stays with the memory it was given, such as a
+ * request-scoped arena (see icb::pmr::Vector).
+ */
+template <typename T, typename Allocator = std::allocator<T>> class Vector
 {
   public:
     using SizeType = size_t;
     using ValueType = T;
+    using AllocatorType = Allocator;
+
+  private:
+    using AllocatorTraits = std::allocator_traits<Allocator>;
+
+    static_assert(std::is_same_v<typename AllocatorTraits::value_type, T>, "Vector allocator has to allocate T");
 
   private:
     template <typename AccessType = T> class BaseIterator
@@ -40,7 +261,7 @@ template <typename T> class Vector
       public:
         BaseIterator() = default;
 
-        BaseIterator(pointer ptr) noexcept : m_ptr(ptr)
+        constexpr BaseIterator(pointer ptr) noexcept : m_ptr(ptr)
         {
         }
 
@@ -53,122 +274,122 @@ template <typename T> class Vector
          */
         template <typename WasAccessType,
                   class = std::enable_if_t<std::is_const_v<AccessType> && !std::is_const_v<WasAccessType>>>
-        BaseIterator(const BaseIterator<WasAccessType> &other) noexcept : m_ptr(other.m_ptr)
+        constexpr BaseIterator(const BaseIterator<WasAccessType> &other) noexcept : m_ptr(other.m_ptr)
         {
         }
 
         // Prefix operator++
-        self_type &operator++() noexcept
+        constexpr self_type &operator++() noexcept
         {
             m_ptr++;
             return *this;
         }
 
         // Postfix operator++
-        self_type operator++(int) noexcept
+        constexpr self_type operator++(int) noexcept
         {
             self_type iterator = *this;
             ++(*this);
             return iterator;
         }
 
-        self_type &operator--() noexcept
+        constexpr self_type &operator--() noexcept
         {
             m_ptr--;
             return *this;
         }
 
-        self_type operator--(int) noexcept
+        constexpr self_type operator--(int) noexcept
         {
             self_type iterator = *this;
             --(*this);
             return iterator;
         }
 
-        self_type &operator+=(SizeType offset) noexcept
+        constexpr self_type &operator+=(SizeType offset) noexcept
         {
             m_ptr += offset;
             return *this;
         }
 
-        self_type &operator-=(SizeType offset) noexcept
+        constexpr self_type &operator-=(SizeType offset) noexcept
         {
             m_ptr -= offset;
             return *this;
         }
 
-        self_type operator+(SizeType offset) const noexcept
+        constexpr self_type operator+(SizeType offset) const noexcept
         {
             self_type result(*this);
             result.m_ptr += offset;
             return result;
         }
 
-        self_type operator-(SizeType offset) const noexcept
+        constexpr self_type operator-(SizeType offset) const noexcept
         {
             self_type result(*this);
             result.m_ptr -= offset;
             return result;
         }
 
-        reference operator[](SizeType index) const noexcept
+        constexpr reference operator[](SizeType index) const noexcept
         {
             return *(m_ptr + index);
         }
 
-        pointer operator->() const noexcept
+        constexpr pointer operator->() const noexcept
         {
             return m_ptr;
         }
 
-        reference operator*() const noexcept
+        constexpr reference operator*() const noexcept
         {
             return *m_ptr;
         }
 
-        friend self_type operator+(SizeType offset, const self_type &iter)
+        friend constexpr self_type operator+(SizeType offset, const self_type &iter)
         {
             return iter + offset;
         }
 
-        friend difference_type operator+(self_type const &lhs, self_type const &rhs)
+        friend constexpr difference_type operator+(self_type const &lhs, self_type const &rhs)
         {
             return lhs.m_ptr + rhs.m_ptr;
         }
 
-        friend difference_type operator-(self_type const &lhs, self_type const &rhs)
+        friend constexpr difference_type operator-(self_type const &lhs, self_type const &rhs)
         {
             return lhs.m_ptr - rhs.m_ptr;
         }
 
-        bool operator<(self_type const &rhs) const
+        constexpr bool operator<(self_type const &rhs) const
         {
             return m_ptr < rhs.m_ptr;
         }
-        bool operator<=(self_type const &rhs) const
+        constexpr bool operator<=(self_type const &rhs) const
         {
             return m_ptr <= rhs.m_ptr;
         }
-        bool operator>(self_type const &rhs) const
+        constexpr bool operator>(self_type const &rhs) const
         {
             return m_ptr > rhs.m_ptr;
         }
-        bool operator>=(self_type const &rhs) const
+        constexpr bool operator>=(self_type const &rhs) const
         {
             return m_ptr >= rhs.m_ptr;
         }
 
-        friend bool operator==(const self_type &lhs, const self_type &rhs) noexcept
+        friend constexpr bool operator==(const self_type &lhs, const self_type &rhs) noexcept
         {
             return lhs.m_ptr == rhs.m_ptr;
         }
 
-        friend bool operator!=(const self_type &lhs, const self_type &rhs) noexcept
+        friend constexpr bool operator!=(const self_type &lhs, const self_type &rhs) noexcept
         {
             return lhs.m_ptr != rhs.m_ptr;
         }
 
-        friend class Vector<T>;
+        friend class Vector;
 
       private:
         pointer m_ptr;
@@ -181,7 +402,12 @@ template <typename T> class Vector
   public:
     Vector() = default;
 
-    template <typename InputIterator> Vector(InputIterator first, InputIterator last)
+    explicit Vector(const Allocator &allocator) noexcept : m_allocator(allocator)
+    {
+    }
+
+    template <typename InputIterator>
+    Vector(InputIterator first, InputIterator last, const Allocator &allocator = Allocator()) : m_allocator(allocator)
     {
         // Reserve once initially, so that PushBack wouldn't need to reallocate incrementally
         Reserve(static_cast<SizeType>(std::distance(first, last)));
@@ -189,37 +415,70 @@ template <typename T> class Vector
             PushBack(*first);
     }
 
-    Vector(std::initializer_list<ValueType> il) : Vector(il.begin(), il.end())
+    Vector(std::initializer_list<ValueType> il, const Allocator &allocator = Allocator())
+        : Vector(il.begin(), il.end(), allocator)
     {
     }
 
-    // copy ctor
-    Vector(const Vector &other) : Vector(other.cbegin, other.cend())
+    // copy ctor, a single memcpy for trivially copyable types
+    Vector(const Vector &other)
+        : Vector(other, AllocatorTraits::select_on_container_copy_construction(other.m_allocator))
     {
     }
 
-    // move ctor
-    Vector(Vector &&other) noexcept
+    // copy ctor into memory from the given allocator
+    Vector(const Vector &other, const Allocator &allocator) : m_allocator(allocator)
+    {
+        Reserve(other.m_size);
+        try
+        {
+            appendCopies(other.m_data, other.m_size);
+        }
+        catch (...)
+        {
+            Clear();
+            deallocate(m_data, m_capacity);
+            throw;
+        }
+    }
+
+    // move ctor, the allocator comes along with the buffer
+    Vector(Vector &&other) noexcept : m_allocator(other.m_allocator)
     {
         std::swap(m_data, other.m_data);
         std::swap(m_size, other.m_size);
         std::swap(m_capacity, other.m_capacity);
     }
 
-    // move assignment
-    Vector &operator=(Vector &&other) noexcept
+    // move assignment, steals the buffer when both allocators can free it, otherwise moves the elements one by one
+    Vector &operator=(Vector &&other) noexcept(AllocatorTraits::is_always_equal::value)
     {
-        if (this != &other)
+        if (this == &other)
+        {
+            return *this;
+        }
+
+        if (AllocatorTraits::is_always_equal::value || m_allocator == other.m_allocator)
         {
             std::swap(m_data, other.m_data);
             std::swap(m_size, other.m_size);
             std::swap(m_capacity, other.m_capacity);
         }
+        else
+        {
+            Clear();
+            Reserve(other.m_size);
+            for (SizeType i = 0; i < other.m_size; ++i)
+            {
+                EmplaceBack(std::move(other.m_data[i]));
+            }
+            other.Clear();
+        }
 
         return *this;
     }
 
-    // copy assignment
+    // copy assignment, reuses the buffer when it is big enough
     Vector &operator=(const Vector &other)
     {
         if (this == &other)
@@ -227,27 +486,25 @@ template <typename T> class Vector
             return *this;
         }
 
-        if (other.Size())
+        if (other.m_size > m_capacity)
         {
-            if (other.Capacity() > m_capacity)
-            {
-                ValueType *newData = new ValueType[other.Capacity()];
-
-                for (SizeType i = 0; i < m_size; ++i)
-                {
-                    newData[i] = other.m_data[i];
-                }
-
-                delete[] m_data;
-                m_data = newData;
-                m_capacity = other.Capacity();
-            }
-            m_size = other.Size();
+            Vector copy(other, m_allocator);
+            *this = std::move(copy);
+        }
+        else
+        {
+            Clear();
+            appendCopies(other.m_data, other.m_size);
         }
 
         return *this;
     }
 
+    Allocator GetAllocator() const noexcept
+    {
+        return m_allocator;
+    }
+
     SizeType Size() const noexcept
     {
         return m_size;
@@ -305,10 +562,7 @@ template <typename T> class Vector
 
         if (newSize < m_size)
         {
-            for (SizeType i = m_size - 1; i >= newSize; --i)
-            {
-                m_data[i].~ValueType();
-            }
+            destroy(newSize, m_size);
         }
 
         m_size = newSize;
@@ -321,76 +575,143 @@ template <typename T> class Vector
 
         if (newSize > m_size)
         {
+            // value may be one of the elements, which reallocating would move away
+            const ValueType copy(value);
             if (newSize > m_capacity)
             {
                 reallocate(newSize + (newSize + 2) / 2);
             }
 
-            for (SizeType i = m_size; i < newSize; ++i)
+            for (; m_size < newSize; ++m_size)
             {
-                m_data[i] = std::move(value);
+                new (&m_data[m_size]) ValueType(copy);
             }
         }
 
         if (newSize < m_size)
         {
-            for (SizeType i = m_size - 1; i >= newSize; --i)
-            {
-                m_data[i].~ValueType();
-            }
+            destroy(newSize, m_size);
         }
 
         m_size = newSize;
     }
 
-    [[deprecated("not implemented")]] void Insert([[maybe_unused]] Iterator position, [[maybe_unused]] ValueType value)
+    // copy
+    Iterator Insert(ConstIterator position, const ValueType &value)
     {
+        return Emplace(position, value);
     }
 
-    Iterator Erase(Iterator position)
+    // move
+    Iterator Insert(ConstIterator position, ValueType &&value)
     {
-        (*position).~ValueType();
+        return Emplace(position, std::move(value));
+    }
 
-        if (position + 1 != end())
+    /**
+     * @brief Inserts copies of [first, last) before position
+     *
+     * For trivially copyable types and a forward range, the tail is moved once with memmove to open the gap.
+     * The range mustn't point into this vector.
+     *
+     * @return Iterator to the first inserted element, or position if the range is empty
+     */
+    template <typename InputIterator> Iterator Insert(ConstIterator position, InputIterator first, InputIterator last)
+    {
+        const SizeType index = indexOf(position);
+
+        if constexpr (std::is_trivially_copyable_v<ValueType> &&
+                      std::is_base_of_v<std::forward_iterator_tag,
+                                        typename std::iterator_traits<InputIterator>::iterator_category>)
+        {
+            const SizeType count = static_cast<SizeType>(std::distance(first, last));
+            if (m_size + count > m_capacity)
+            {
+                reallocate(std::max(m_size + count, detail::GrownCapacity(m_capacity)));
+            }
+            detail::InsertCopies(m_data, m_size, index, first, count);
+        }
+        else
         {
-            std::copy(position + 1, end(), position);
+            // appended, then rotated into place
+            const SizeType oldSize = m_size;
+            for (; first != last; ++first)
+            {
+                EmplaceBack(*first);
+            }
+            std::rotate(m_data + index, m_data + oldSize, m_data + m_size);
         }
-        --m_size;
-        return position;
+
+        return begin() + index;
     }
 
-    void Clear()
+    /**
+     * @brief Constructs an element before position, shifting the tail up by one
+     *
+     * @return Iterator to the new element
+     */
+    template <typename... Args> Iterator Emplace(ConstIterator position, Args &&...args)
     {
-        for (SizeType i = 0; i < m_size; ++i)
+        const SizeType index = indexOf(position);
+        if (index == m_size)
         {
-            m_data[i].~ValueType();
+            EmplaceBack(std::forward<Args>(args)...);
+            return begin() + index;
         }
 
+        // built first, the arguments may refer to elements that are about to move
+        ValueType value(std::forward<Args>(args)...);
+        if (m_size == m_capacity)
+        {
+            reallocate(detail::GrownCapacity(m_capacity));
+        }
+        detail::InsertShifting(m_data, m_size, index, std::move(value));
+
+        return begin() + index;
+    }
+
+    Iterator Erase(ConstIterator position)
+    {
+        return Erase(position, position + 1);
+    }
+
+    /**
+     * @brief Erases [first, last), moving the tail down over the gap
+     *
+     * @return Iterator to the element after the erased ones
+     */
+    Iterator Erase(ConstIterator first, ConstIterator last)
+    {
+        const SizeType index = indexOf(first);
+        const SizeType count = static_cast<SizeType>(last - first);
+        assert(index + count <= m_size && "Vector::Erase range out of bounds");
+
+        detail::CloseGap(m_data, m_size, index, count);
+        return begin() + index;
+    }
+
+    void Clear()
+    {
+        destroy(0, m_size);
         m_size = 0;
     }
 
+    // copy
     void PushBack(const ValueType &value)
     {
-        if (m_size >= m_capacity)
-            reallocate(m_capacity + (m_capacity + 2) / 2);
-
-        m_data[m_size] = value;
-        ++m_size;
+        EmplaceBack(value);
     }
 
+    // move
     void PushBack(ValueType &&value)
     {
-        if (m_size >= m_capacity)
-            reallocate(m_capacity + (m_capacity + 2) / 2);
-
-        m_data[m_size] = std::move(value);
-        ++m_size;
+        EmplaceBack(std::move(value));
     }
 
     template <typename... Args> ValueType &EmplaceBack(Args &&...args)
     {
-        if (m_size >= m_capacity)
-            reallocate(m_capacity + (m_capacity + 2) / 2);
+        if (m_size == m_capacity)
+            return growAndEmplaceBack(std::forward<Args>(args)...);
 
         new (&m_data[m_size]) ValueType(std::forward<Args>(args)...);
         // m_data[m_size] = ValueType(std::forward<Args>(args)...);
@@ -399,8 +720,7 @@ template <typename T> class Vector
          * we can use placement new, where we provide a valid address inside m_data where the construction
          * would take place.
          */
-        ++m_size;
-        return m_data[m_size];
+        return m_data[m_size++];
     }
 
     void PopBack()
@@ -440,6 +760,16 @@ template <typename T> class Vector
         return Iterator(m_data + m_size);
     }
 
+    ConstIterator begin() const
+    {
+        return ConstIterator(m_data);
+    }
+
+    ConstIterator end() const
+    {
+        return ConstIterator(m_data + m_size);
+    }
+
     ConstIterator cbegin() const
     {
         return ConstIterator(m_data);
@@ -462,59 +792,148 @@ template <typename T> class Vector
          *
          * This happens because delete[] will not stop at our m_size like our Clear function does.
          */
-        Clear();                                                   // Clear will call all the destructors
-        ::operator delete(m_data, m_capacity * sizeof(ValueType)); // this delete will not call any destructors.
+        Clear();                         // Clear will call all the destructors
+        deallocate(m_data, m_capacity); // this will not call any destructors.
     }
 
   private:
-    void reallocate(SizeType newCapacity)
+    // elements can be moved around with memmove, see IsTriviallyRelocatable
+    static constexpr bool relocatable = detail::relocatableElements<ValueType>;
+
+    // realloc only works on malloc'd memory, which is only aligned for fundamental types, and only stands in for the
+    // default allocator
+    static constexpr bool growInPlace = relocatable && alignof(ValueType) <= alignof(std::max_align_t) &&
+                                        std::is_same_v<Allocator, std::allocator<ValueType>>;
+
+    ValueType *allocate(SizeType capacity)
     {
-        /*
-         * Using memcpy will not call copy constructors and will be a shallow copy. It is fine for primitive types like
-         * int. Hence, use a for loop.
-         */
+        if constexpr (growInPlace)
+        {
+            void *memory = std::malloc(capacity * sizeof(ValueType));
+            if (!memory)
+                throw std::bad_alloc();
+            return static_cast<ValueType *>(memory);
+        }
+        else
+        {
+            return AllocatorTraits::allocate(m_allocator, capacity);
+        }
+    }
 
-        /*
-         * We don't need to call constructors here, because we want uninitialized data that will be
-         * pushed back to instead of creating default objects waiting to be overwritten.
-         */
-        ValueType *newData = (ValueType *)::operator new(newCapacity * sizeof(ValueType));
+    void deallocate(ValueType *data, SizeType capacity) noexcept
+    {
+        if (!data)
+            return;
+
+        if constexpr (growInPlace)
+        {
+            std::free(data);
+        }
+        else
+        {
+            AllocatorTraits::deallocate(m_allocator, data, capacity);
+        }
+    }
+
+    void reallocate(SizeType newCapacity)
+    {
+        assert(newCapacity && "Vector::reallocate to zero capacity");
 
         // for downsizing, otherwise would cause an overflow.
         // could argue that this is not the responsibility of this function though.
         if (newCapacity < m_size)
+        {
+            destroy(newCapacity, m_size);
             m_size = newCapacity;
+        }
 
-        for (SizeType i = 0; i < m_size; ++i)
+        if constexpr (growInPlace)
+        {
+            // extends the block where it is when the allocator can, otherwise it copies the bytes over itself
+            void *memory = std::realloc(static_cast<void *>(m_data), newCapacity * sizeof(ValueType));
+            if (!memory)
+                throw std::bad_alloc();
+            m_data = static_cast<ValueType *>(memory);
+        }
+        else
         {
-            new (&newData[i]) ValueType(std::move(m_data[i]));
-            // newData[i] = std::move(m_data[i]);
             /*
-             * Can't use the assigment operator, either copy or move.
-             * Assignment operator requires newData[i] object to actually exist,
-             * but we never called a constructor on it due to the ::operator new above.
-             *
+             * We don't need to call constructors here, because we want uninitialized data that will be
+             * pushed back to instead of creating default objects waiting to be overwritten.
              */
+            ValueType *newData = allocate(newCapacity);
+            try
+            {
+                detail::RelocateElements(m_data, m_size, newData);
+            }
+            catch (...)
+            {
+                deallocate(newData, newCapacity);
+                throw;
+            }
+            deallocate(m_data, m_capacity);
+            m_data = newData;
         }
+        m_capacity = newCapacity;
+    }
 
-        /*
-         * Everything that has been moved to newData is safe, and we can call the destructors on m_data here.
-         *
-         */
-        for (SizeType i = 0; i < m_size; ++i)
+    // the new element is built in the new buffer before the old ones leave, the arguments may refer to one of them
+    template <typename... Args> ValueType &growAndEmplaceBack(Args &&...args)
+    {
+        const SizeType newCapacity = detail::GrownCapacity(m_capacity);
+
+        if constexpr (growInPlace)
         {
-            m_data[i].~ValueType();
+            ValueType value(std::forward<Args>(args)...);
+            reallocate(newCapacity);
+            new (&m_data[m_size]) ValueType(std::move(value));
+        }
+        else
+        {
+            ValueType *newData = allocate(newCapacity);
+            try
+            {
+                detail::EmplaceAndRelocate(m_data, m_size, newData, std::forward<Args>(args)...);
+            }
+            catch (...)
+            {
+                deallocate(newData, newCapacity);
+                throw;
+            }
+            deallocate(m_data, m_capacity);
+            m_data = newData;
+            m_capacity = newCapacity;
         }
-        if (m_capacity)
-            ::operator delete(m_data, m_capacity * sizeof(ValueType));
 
-        m_data = newData;
-        m_capacity = newCapacity;
+        return m_data[m_size++];
+    }
+
+    // copy constructs count elements after the last one, the capacity has to be there
+    void appendCopies(const ValueType *source, SizeType count)
+    {
+        detail::AppendCopies(m_data, m_size, source, count);
+    }
+
+    void destroy(SizeType from, SizeType to) noexcept
+    {
+        detail::DestroyElements(m_data + from, m_data + to);
+    }
+
+    SizeType indexOf(ConstIterator position) const
+    {
+        return detail::IndexOf(position, cbegin(), m_size);
     }
 
   private:
     ValueType *m_data = nullptr;
     SizeType m_size = 0;
     SizeType m_capacity = 0;
+    [[no_unique_address]] Allocator m_allocator;
 };
+
+namespace pmr
+{
+// a Vector whose buffer comes from a std::pmr::memory_resource
+template <typename T> using Vector = icb::Vector<T, std::pmr::polymorphic_allocator<T>>;
+} // namespace pmr
 } // namespace icb
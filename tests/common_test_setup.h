@@ -2,6 +2,7 @@
 
 #include <gtest/gtest.h>
 #include <iostream>
+#include <memory_resource>
 
 // breaks CI with std::chrono on Ubuntu Clang
 // #include "../utils/Timer.h"
@@ -48,3 +49,38 @@ struct TestStruct
     {
     }
 };
+
+// counts what goes through it on the way to upstream, for checking where containers get their memory
+class CountingResource : public std::pmr::memory_resource
+{
+  public:
+    explicit CountingResource(std::pmr::memory_resource *upstream = std::pmr::new_delete_resource())
+        : m_upstream(upstream)
+    {
+    }
+
+    size_t allocations = 0;
+    size_t bytesInUse = 0;
+
+  private:
+    void *do_allocate(size_t bytes, size_t alignment) override
+    {
+        void *memory = m_upstream->allocate(bytes, alignment);
+        ++allocations;
+        bytesInUse += bytes;
+        return memory;
+    }
+
+    void do_deallocate(void *memory, size_t bytes, size_t alignment) override
+    {
+        bytesInUse -= bytes;
+        m_upstream->deallocate(memory, bytes, alignment);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override
+    {
+        return this == &other;
+    }
+
+    std::pmr::memory_resource *m_upstream;
+};
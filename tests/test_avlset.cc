@@ -214,3 +214,32 @@ TEST(ICBAVLSetCustomType, InsertAndContains)
     EXPECT_TRUE(tree.Contains(CustomType{8}));
     EXPECT_FALSE(tree.Contains(CustomType{10}));
 }
+
+TEST(ICBAVLSetAllocator, AllocatesFromResource)
+{
+    CountingResource resource;
+    {
+        icb::pmr::AVLSet<int> tree(&resource);
+        for (int i = 0; i < 100; ++i)
+        {
+            tree.Insert(i);
+        }
+        EXPECT_EQ(resource.allocations, 100);
+
+        CountingResource other;
+        icb::pmr::AVLSet<int> elsewhere(&other);
+        elsewhere.Insert(-1);
+        elsewhere = tree;
+        EXPECT_TRUE(elsewhere.Contains(99));
+        EXPECT_FALSE(elsewhere.Contains(-1));
+        EXPECT_EQ(other.allocations, 101);
+
+        // the nodes are copied into other's memory and tree's are freed
+        elsewhere = std::move(tree);
+        EXPECT_TRUE(elsewhere.Contains(50));
+        EXPECT_EQ(resource.bytesInUse, 0);
+
+        elsewhere = icb::pmr::AVLSet<int>(&other);
+        EXPECT_EQ(other.bytesInUse, 0);
+    }
+}
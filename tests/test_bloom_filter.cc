@@ -0,0 +1,87 @@
+#include "icb/bloom_filter.h"
+
+#include <string>
+#include <string_view>
+
+#include "common_test_setup.h"
+
+class ICBBloomFilterTestFixture : public ICBTestFixture
+{
+  protected:
+    icb::BloomFilter<std::string> filter;
+};
+
+class ICBBloomFilterIntTestFixture : public ICBTestFixture
+{
+  protected:
+    icb::BloomFilter<int> filter{100000};
+};
+
+TEST_F(ICBBloomFilterTestFixture, EmptyFilter)
+{
+    EXPECT_TRUE(filter.Empty());
+    EXPECT_EQ(filter.Size(), 0);
+    EXPECT_FALSE(filter.MayContain("apple"));
+    EXPECT_GE(filter.SizeInBytes(), 64);
+}
+
+TEST_F(ICBBloomFilterTestFixture, InsertAndQuery)
+{
+    filter.Insert("apple");
+    filter.Insert(std::string("banana"));
+
+    EXPECT_EQ(filter.Size(), 2);
+    EXPECT_TRUE(filter.MayContain("apple"));
+    EXPECT_TRUE(filter.MayContain(std::string_view("banana")));
+    EXPECT_TRUE(filter.MayContain(std::string("banana")));
+
+    filter.Clear();
+    EXPECT_TRUE(filter.Empty());
+    EXPECT_FALSE(filter.MayContain("apple"));
+}
+
+TEST_F(ICBBloomFilterIntTestFixture, NoFalseNegatives)
+{
+    for (int i = 0; i < 100000; ++i)
+    {
+        filter.Insert(i * 7);
+    }
+
+    for (int i = 0; i < 100000; ++i)
+    {
+        ASSERT_TRUE(filter.MayContain(i * 7));
+    }
+}
+
+TEST_F(ICBBloomFilterIntTestFixture, FalsePositiveRate)
+{
+    for (int i = 0; i < 100000; ++i)
+    {
+        filter.Insert(i);
+    }
+
+    int falsePositives = 0;
+    for (int i = 100000; i < 200000; ++i)
+    {
+        falsePositives += filter.MayContain(i);
+    }
+
+    // about 0.5% expected at the default bits per key
+    EXPECT_LT(falsePositives, 2000);
+}
+
+TEST_F(ICBBloomFilterIntTestFixture, CopyAndMove)
+{
+    filter.Insert(42);
+
+    icb::BloomFilter<int> copy(filter);
+    EXPECT_TRUE(copy.MayContain(42));
+    copy.Insert(43);
+    EXPECT_EQ(filter.Size(), 1);
+
+    icb::BloomFilter<int> moved(std::move(copy));
+    EXPECT_TRUE(moved.MayContain(43));
+
+    filter = moved;
+    EXPECT_TRUE(filter.MayContain(43));
+}
@@ -0,0 +1,141 @@
+#include "icb/clock_cache.h"
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "common_test_setup.h"
+
+class ICBClockCacheTestFixture : public ICBTestFixture
+{
+  protected:
+    icb::ConcurrentClockCache<std::string, int> cache{3, 1};
+};
+
+class ICBClockCacheIntTestFixture : public ICBTestFixture
+{
+  protected:
+    icb::ConcurrentClockCache<int, int> cache{1024, 8};
+};
+
+TEST_F(ICBClockCacheTestFixture, EmptyCache)
+{
+    EXPECT_TRUE(cache.Empty());
+    EXPECT_EQ(cache.Capacity(), 3);
+    EXPECT_EQ(cache.ShardCount(), 1);
+    EXPECT_EQ(cache.Get("apple"), std::nullopt);
+}
+
+TEST_F(ICBClockCacheTestFixture, PutGetVisit)
+{
+    EXPECT_TRUE(cache.Put("apple", 1));
+    EXPECT_FALSE(cache.Put("apple", 10));
+    EXPECT_EQ(cache.Get("apple"), 10);
+
+    int seen = 0;
+    EXPECT_TRUE(cache.Visit("apple", [&](const int &value) { seen = value; }));
+    EXPECT_EQ(seen, 10);
+    EXPECT_FALSE(cache.Visit("banana", [&](const int &) {}));
+}
+
+TEST_F(ICBClockCacheTestFixture, EvictsUnreferenced)
+{
+    cache.Put("a", 1);
+    cache.Put("b", 2);
+    cache.Put("c", 3);
+
+    // "a" and "c" get a second chance, "b" doesn't
+    cache.Get("a");
+    cache.Get("c");
+    cache.Put("d", 4);
+    EXPECT_FALSE(cache.Contains("b"));
+    EXPECT_TRUE(cache.Contains("a"));
+    EXPECT_TRUE(cache.Contains("c"));
+
+    // the hand passes "c" once more, clearing its bit, and takes "a", whose bit the first sweep cleared
+    cache.Put("e", 5);
+    EXPECT_FALSE(cache.Contains("a"));
+    EXPECT_TRUE(cache.Contains("c"));
+    EXPECT_EQ(cache.Size(), 3);
+
+    // everything referenced: one full turn, then the hand's own slot goes
+    cache.Get("c");
+    cache.Get("d");
+    cache.Get("e");
+    cache.Put("f", 6);
+    EXPECT_EQ(cache.Size(), 3);
+    EXPECT_TRUE(cache.Contains("f"));
+}
+
+TEST_F(ICBClockCacheTestFixture, EraseAndClear)
+{
+    cache.Put("a", 1);
+    cache.Put("b", 2);
+    cache.Put("c", 3);
+
+    cache.Erase("a");
+    cache.Erase("missing");
+    EXPECT_EQ(cache.Size(), 2);
+    EXPECT_EQ(cache.Get("c"), 3);
+
+    cache.Put("d", 4);
+    cache.Put("e", 5);
+    EXPECT_EQ(cache.Size(), 3);
+    EXPECT_EQ(cache.Get("e"), 5);
+
+    cache.Clear();
+    EXPECT_TRUE(cache.Empty());
+    cache.Put("a", 1);
+    EXPECT_EQ(cache.Get("a"), 1);
+}
+
+TEST_F(ICBClockCacheIntTestFixture, StaysWithinCapacity)
+{
+    EXPECT_EQ(cache.Capacity(), 1024);
+
+    for (int i = 0; i < 10000; ++i)
+    {
+        cache.Put(i, i);
+        ASSERT_EQ(cache.Get(i), i);
+    }
+    EXPECT_LE(cache.Size(), 1024);
+
+    int present = 0;
+    for (int i = 0; i < 10000; ++i)
+    {
+        if (auto value = cache.Get(i))
+        {
+            ASSERT_EQ(*value, i);
+            ++present;
+        }
+    }
+    EXPECT_EQ(present, static_cast<int>(cache.Size()));
+}
+
+TEST_F(ICBClockCacheIntTestFixture, ConcurrentPutAndGet)
+{
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t)
+    {
+        threads.emplace_back([&, t] {
+            for (int i = 0; i < 20000; ++i)
+            {
+                const int key = (i * 7 + t) % 3000;
+                if (i % 4 == 0)
+                {
+                    cache.Put(key, key * 2);
+                }
+                else if (auto value = cache.Get(key))
+                {
+                    ASSERT_EQ(*value, key * 2);
+                }
+            }
+        });
+    }
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+
+    EXPECT_LE(cache.Size(), 1024);
+}
@@ -0,0 +1,165 @@
+#include "icb/concurrent_hash_table.h"
+
+#include <thread>
+#include <vector>
+
+#include "common_test_setup.h"
+
+class ICBConcurrentHashTableTestFixture : public ICBTestFixture
+{
+  protected:
+    icb::ConcurrentHashTable<std::string, int> table;
+};
+
+class ICBConcurrentHashTableIntTestFixture : public ICBTestFixture
+{
+  protected:
+    icb::ConcurrentHashTable<int, int> table{8};
+};
+
+TEST_F(ICBConcurrentHashTableTestFixture, EmptyTable)
+{
+    EXPECT_TRUE(table.Empty());
+    EXPECT_EQ(table.Size(), 0);
+    EXPECT_EQ(table.ShardCount(), CHT_SHARD_COUNT);
+}
+
+TEST_F(ICBConcurrentHashTableTestFixture, InsertFindErase)
+{
+    table.Insert("apple", 5);
+    table.Insert("banana", 10);
+    table.Insert("apple", 50);
+
+    EXPECT_EQ(table.Size(), 2);
+    EXPECT_EQ(table.Find("apple"), 5);
+    EXPECT_EQ(table.Find(std::string_view("banana")), 10);
+    EXPECT_TRUE(table.Contains("banana"));
+
+    table.Erase("apple");
+    EXPECT_EQ(table.Find("apple"), std::nullopt);
+    EXPECT_EQ(table.Size(), 1);
+}
+
+TEST_F(ICBConcurrentHashTableTestFixture, TryEmplaceAndInsertOrAssign)
+{
+    EXPECT_TRUE(table.TryEmplace("apple", 5));
+    EXPECT_FALSE(table.TryEmplace("apple", 6));
+    EXPECT_EQ(table.Find("apple"), 5);
+
+    EXPECT_FALSE(table.InsertOrAssign("apple", 7));
+    EXPECT_TRUE(table.InsertOrAssign("banana", 8));
+    EXPECT_EQ(table.Find("apple"), 7);
+    EXPECT_EQ(table.Find("banana"), 8);
+}
+
+TEST_F(ICBConcurrentHashTableTestFixture, VisitAndUpdate)
+{
+    table.Insert("apple", 5);
+
+    int seen = 0;
+    EXPECT_TRUE(table.Visit("apple", [&](const int &value) { seen = value; }));
+    EXPECT_EQ(seen, 5);
+    EXPECT_FALSE(table.Visit("banana", [&](const int &value) { seen = value; }));
+
+    EXPECT_TRUE(table.Update("apple", [](int &value) { value *= 2; }));
+    EXPECT_EQ(table.Find("apple"), 10);
+}
+
+TEST_F(ICBConcurrentHashTableIntTestFixture, ShardsAndRehash)
+{
+    EXPECT_EQ(table.ShardCount(), 8);
+
+    icb::ConcurrentHashTable<int, int> oddShards(5);
+    EXPECT_EQ(oddShards.ShardCount(), 8);
+
+    bool used[8] = {};
+    for (int i = 0; i < 1000; ++i)
+    {
+        table.Insert(i, i);
+        used[table.ShardIndex(i)] = true;
+    }
+    for (bool shardUsed : used)
+    {
+        EXPECT_TRUE(shardUsed);
+    }
+
+    table.RehashShard(3, 1024);
+    table.Rehash(4096);
+    EXPECT_EQ(table.Size(), 1000);
+    for (int i = 0; i < 1000; ++i)
+    {
+        EXPECT_EQ(table.Find(i), i);
+    }
+
+    table.Clear();
+    EXPECT_TRUE(table.Empty());
+}
+
+TEST_F(ICBConcurrentHashTableIntTestFixture, ConcurrentInserts)
+{
+    constexpr int threadCount = 4;
+    constexpr int perThread = 2000;
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threadCount; ++t)
+    {
+        threads.emplace_back([this, t] {
+            for (int i = 0; i < perThread; ++i)
+            {
+                table.Insert(t * perThread + i, t);
+            }
+        });
+    }
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+
+    EXPECT_EQ(table.Size(), threadCount * perThread);
+    for (int i = 0; i < threadCount * perThread; ++i)
+    {
+        EXPECT_EQ(table.Find(i), i / perThread);
+    }
+}
+
+TEST_F(ICBConcurrentHashTableIntTestFixture, ConcurrentReadersAndWriters)
+{
+    for (int i = 0; i < 1000; ++i)
+    {
+        table.Insert(i, 0);
+    }
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 2; ++t)
+    {
+        threads.emplace_back([this] {
+            for (int i = 0; i < 1000; ++i)
+            {
+                table.Update(i, [](int &value) { ++value; });
+            }
+        });
+        threads.emplace_back([this] {
+            for (int round = 0; round < 3; ++round)
+            {
+                for (int i = 0; i < 1000; ++i)
+                {
+                    auto value = table.Find(i);
+                    EXPECT_TRUE(value.has_value());
+                    EXPECT_GE(*value, 0);
+                    EXPECT_LE(*value, 2);
+                }
+            }
+        });
+    }
+    threads.emplace_back([this] { table.Rehash(8192); });
+
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        EXPECT_EQ(table.Find(i), 2);
+    }
+}
@@ -0,0 +1,140 @@
+#include "icb/filtered_hash_table.h"
+
+#include <functional>
+#include <string>
+#include <string_view>
+
+#include "common_test_setup.h"
+
+// a key whose std::hash counts its calls, icb::Hash goes through it
+struct CountedKey
+{
+    int value;
+
+    bool operator==(const CountedKey &) const = default;
+
+    static inline int hashes = 0;
+};
+
+template <> struct std::hash<CountedKey>
+{
+    size_t operator()(const CountedKey &key) const noexcept
+    {
+        ++CountedKey::hashes;
+        return std::hash<int>{}(key.value);
+    }
+};
+
+class ICBFilteredHashTableTestFixture : public ICBTestFixture
+{
+  protected:
+    icb::FilteredHashTable<std::string, int> table;
+};
+
+class ICBFilteredHashTableIntTestFixture : public ICBTestFixture
+{
+  protected:
+    icb::FilteredHashTable<int, int> table;
+};
+
+TEST_F(ICBFilteredHashTableTestFixture, InsertAndFind)
+{
+    table.Insert("apple", 5);
+    table.Insert("banana", 10);
+    table.InsertOrAssign("apple", 6);
+    table["cherry"] = 15;
+
+    EXPECT_EQ(table.Size(), 3);
+    EXPECT_EQ(table.Find("apple"), 6);
+    EXPECT_EQ(table.Find(std::string_view("banana")), 10);
+    EXPECT_EQ(*table.FindPtr("cherry"), 15);
+    EXPECT_EQ(table.Find("date"), std::nullopt);
+    EXPECT_FALSE(table.Contains("date"));
+    EXPECT_TRUE(table.GetFilter().MayContain("apple"));
+}
+
+TEST_F(ICBFilteredHashTableIntTestFixture, FilterGrowsWithTable)
+{
+    for (int i = 0; i < 100000; ++i)
+    {
+        table.Insert(i, i * 2);
+    }
+
+    EXPECT_EQ(table.Size(), 100000);
+    EXPECT_GE(table.GetFilter().Capacity(), 100000);
+    for (int i = 0; i < 100000; ++i)
+    {
+        ASSERT_EQ(*table.FindPtr(i), i * 2);
+    }
+    EXPECT_FALSE(table.Contains(-1));
+}
+
+TEST_F(ICBFilteredHashTableIntTestFixture, EraseAndRebuild)
+{
+    for (int i = 0; i < 1000; ++i)
+    {
+        table.Insert(i, i);
+    }
+    for (int i = 0; i < 1000; i += 2)
+    {
+        table.Erase(i);
+    }
+
+    EXPECT_EQ(table.Size(), 500);
+    EXPECT_FALSE(table.Contains(0));
+    EXPECT_TRUE(table.Contains(1));
+
+    // churn: stale keys make the filter rebuild instead of growing forever
+    for (int round = 0; round < 50; ++round)
+    {
+        for (int i = 0; i < 1000; ++i)
+        {
+            table.Insert(100000 + i, i);
+        }
+        for (int i = 0; i < 1000; ++i)
+        {
+            table.Erase(100000 + i);
+        }
+    }
+
+    EXPECT_EQ(table.Size(), 500);
+    EXPECT_LE(table.GetFilter().Capacity(), 4000);
+    for (int i = 1; i < 1000; i += 2)
+    {
+        ASSERT_TRUE(table.Contains(i));
+    }
+}
+
+TEST_F(ICBFilteredHashTableIntTestFixture, ClearAndIterate)
+{
+    table.Insert(1, 10);
+    table.Insert(2, 20);
+
+    int sum = 0;
+    for (const auto &[key, value] : table)
+    {
+        sum += key + value;
+    }
+    EXPECT_EQ(sum, 33);
+
+    table.Clear();
+    EXPECT_TRUE(table.Empty());
+    EXPECT_FALSE(table.Contains(1));
+}
+
+TEST_F(ICBFilteredHashTableIntTestFixture, HashesEachKeyOnce)
+{
+    // the initial capacity keeps the filter from being rebuilt, which hashes every key again
+    icb::FilteredHashTable<CountedKey, int> counted(64);
+
+    CountedKey::hashes = 0;
+    counted.Insert(CountedKey{1}, 1);
+    EXPECT_EQ(CountedKey::hashes, 1);
+    counted.InsertOrAssign(CountedKey{1}, 2);
+    EXPECT_EQ(CountedKey::hashes, 2);
+
+    EXPECT_EQ(counted.Find(CountedKey{1}), 2);
+    EXPECT_EQ(CountedKey::hashes, 3);
+    EXPECT_FALSE(counted.Contains(CountedKey{2}));
+    EXPECT_EQ(CountedKey::hashes, 4);
+}
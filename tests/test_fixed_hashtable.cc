@@ -0,0 +1,166 @@
+#include "icb/fixed_hash_table.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "common_test_setup.h"
+
+class ICBFixedHashTableTestFixture : public ICBTestFixture
+{
+  protected:
+    icb::FixedHashTable<int, int, 64> test_table;
+};
+
+class ICBFixedHashTableStringTestFixture : public ICBTestFixture
+{
+  protected:
+    icb::FixedHashTable<std::string, std::string, 16> test_table;
+};
+
+// every key lands in the same home slot, so all of them share one probe sequence
+struct CollidingHash
+{
+    constexpr size_t operator()(int) const
+    {
+        return 3;
+    }
+};
+
+template <typename Table> static auto Contents(const Table &table)
+{
+    std::vector<typename Table::Pair> contents(table.begin(), table.end());
+    std::sort(contents.begin(), contents.end());
+    return contents;
+}
+
+static constexpr icb::FixedHashTable<int, int, 16> Powers()
+{
+    icb::FixedHashTable<int, int, 16> powers;
+    for (int i = 0; i < 16; ++i)
+    {
+        powers.Insert(i, 1 << i);
+    }
+    powers.Erase(3);
+    powers[3] = 7;
+    return powers;
+}
+
+TEST_F(ICBFixedHashTableTestFixture, UsableInConstantExpressions)
+{
+    constexpr icb::FixedHashTable<int, int, 16> powers = Powers();
+    static_assert(powers.Full());
+    static_assert(powers.Find(10) == 1024);
+    static_assert(powers.Find(3) == 7);
+    static_assert(!powers.Contains(16));
+    static_assert(icb::FixedHashTable<int, int, 4>{{1, 2}, {3, 4}}.Find(3) == 4);
+
+    EXPECT_EQ(*powers.FindPtr(15), 1 << 15);
+    EXPECT_EQ(powers.BucketCount(), 32);
+}
+
+TEST_F(ICBFixedHashTableTestFixture, InsertFindErase)
+{
+    EXPECT_TRUE(test_table.Empty());
+    EXPECT_EQ(test_table.Capacity(), 64);
+    EXPECT_GT(test_table.BucketCount(), 64 + 32);
+
+    for (int i = 0; i < 64; ++i)
+    {
+        test_table.Insert(i * 7, i);
+    }
+    EXPECT_TRUE(test_table.Full());
+    EXPECT_LT(test_table.LoadFactor(), 2.0f / 3.0f);
+    for (int i = 0; i < 64; ++i)
+    {
+        EXPECT_EQ(test_table.Find(i * 7), i);
+    }
+    EXPECT_FALSE(test_table.Find(1).has_value());
+
+    // an existing key doesn't need room
+    test_table.Insert(0, 100);
+    EXPECT_EQ(test_table.Find(0), 0);
+    EXPECT_EQ(test_table.InsertOrAssign(0, 100).second, false);
+    EXPECT_EQ(test_table.Find(0), 100);
+    EXPECT_THROW(test_table.Insert(1, 1), std::length_error);
+    EXPECT_THROW(test_table[1], std::length_error);
+    EXPECT_EQ(test_table.Size(), 64);
+
+    for (int i = 0; i < 64; i += 2)
+    {
+        test_table.Erase(i * 7);
+    }
+    EXPECT_EQ(test_table.Size(), 32);
+    for (int i = 0; i < 64; ++i)
+    {
+        EXPECT_EQ(test_table.Contains(i * 7), i % 2 == 1);
+    }
+
+    test_table.Clear();
+    EXPECT_TRUE(test_table.Empty());
+    EXPECT_EQ(test_table.begin(), test_table.end());
+}
+
+TEST_F(ICBFixedHashTableTestFixture, SharedProbeSequence)
+{
+    icb::FixedHashTable<int, int, 8, CollidingHash> table;
+    for (int i = 0; i < 8; ++i)
+    {
+        table.Insert(i, i * 10);
+    }
+
+    // erasing from the middle shifts the rest of the sequence back, nothing is lost
+    table.Erase(2);
+    table.Erase(5);
+    table.Erase(42);
+    EXPECT_EQ(Contents(table), (std::vector<std::pair<int, int>>{{0, 0}, {1, 10}, {3, 30}, {4, 40}, {6, 60}, {7, 70}}));
+
+    table.Insert(2, 20);
+    EXPECT_EQ(table.Find(2), 20);
+    EXPECT_EQ(table.Find(7), 70);
+    EXPECT_FALSE(table.Contains(5));
+}
+
+TEST_F(ICBFixedHashTableTestFixture, ReturnedPointerFollowsDisplacement)
+{
+    // the new key takes over a slot whose element moves further down, the pointer must be to the new one
+    for (int i = 0; i < 48; ++i)
+    {
+        auto [value, inserted] = test_table.TryEmplace(i * 31, i);
+        ASSERT_TRUE(inserted);
+        EXPECT_EQ(*value, i);
+        *value += 1000;
+    }
+    for (int i = 0; i < 48; ++i)
+    {
+        EXPECT_EQ(test_table.Find(i * 31), i + 1000);
+    }
+}
+
+TEST_F(ICBFixedHashTableStringTestFixture, StringKeysAndIteration)
+{
+    test_table.Insert("one", "1");
+    test_table.TryEmplace("many", 40, 'x');
+    test_table["two"] = "2";
+    test_table.InsertOrAssign("one", std::string("uno"));
+
+    EXPECT_EQ(test_table.Find("one"), "uno");
+    EXPECT_EQ(*test_table.FindPtr("many"), std::string(40, 'x'));
+    EXPECT_EQ(test_table.FindPtr("three"), nullptr);
+
+    for (auto &[key, value] : test_table)
+    {
+        value += "!";
+    }
+    EXPECT_EQ(Contents(test_table), (std::vector<std::pair<std::string, std::string>>{
+                                        {"many", std::string(40, 'x') + "!"}, {"one", "uno!"}, {"two", "2!"}}));
+
+    test_table.Erase("one");
+    EXPECT_EQ(test_table.Size(), 2);
+    EXPECT_FALSE(test_table.Contains("one"));
+
+    const auto &view = test_table;
+    EXPECT_EQ(std::distance(view.cbegin(), view.cend()), 2);
+}
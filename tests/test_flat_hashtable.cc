@@ -0,0 +1,242 @@
+#include "icb/flat_hash_table.h"
+
+#include <stdexcept>
+#include <string>
+
+#include "common_test_setup.h"
+
+class ICBFlatHashTableTestFixture : public ICBTestFixture
+{
+  protected:
+    icb::FlatHashTable<std::string, int> table;
+};
+
+class ICBFlatHashTableIntTestFixture : public ICBTestFixture
+{
+  protected:
+    icb::FlatHashTable<int, int> table;
+};
+
+TEST_F(ICBFlatHashTableTestFixture, EmptyTable)
+{
+    EXPECT_TRUE(table.Empty());
+    EXPECT_EQ(table.Size(), 0);
+    EXPECT_EQ(table.Find("apple"), std::nullopt);
+}
+
+TEST_F(ICBFlatHashTableTestFixture, InsertionAndFind)
+{
+    table.Insert("apple", 5);
+    table.Insert("banana", 10);
+    table.Insert("cherry", 15);
+
+    EXPECT_EQ(table.Find("apple"), 5);
+    EXPECT_EQ(table.Find("banana"), 10);
+    EXPECT_EQ(table.Find("cherry"), 15);
+
+    // Test move insertion
+    std::string key = "date";
+    table.Insert(std::move(key), 20);
+    EXPECT_EQ(table.Find("date"), 20);
+    EXPECT_TRUE(key.empty());
+
+    // Test that existing values are not overwritten
+    table.Insert("apple", 50);
+    EXPECT_EQ(table.Find("apple"), 5);
+    EXPECT_EQ(table.Size(), 4);
+}
+
+TEST_F(ICBFlatHashTableTestFixture, Erase)
+{
+    table.Insert("grape", 25);
+    EXPECT_EQ(table.Find("grape"), 25);
+    table.Erase("grape");
+    EXPECT_EQ(table.Find("grape"), std::nullopt);
+    EXPECT_FALSE(table.Contains("grape"));
+
+    // Test erasing a non-existent key
+    table.Erase("fig");
+    EXPECT_EQ(table.Size(), 0);
+}
+
+TEST_F(ICBFlatHashTableTestFixture, Rehash)
+{
+    table.Insert("lemon", 30);
+    table.Insert("mango", 35);
+    table.Insert("orange", 40);
+
+    table.Rehash(200);
+    EXPECT_EQ(table.Capacity(), 256);
+
+    EXPECT_EQ(table.Find("lemon"), 30);
+    EXPECT_EQ(table.Find("mango"), 35);
+    EXPECT_EQ(table.Find("orange"), 40);
+
+    // never shrinks below what the elements need
+    table.Rehash(1);
+    EXPECT_GE(table.Capacity(), 3);
+    EXPECT_EQ(table.Find("mango"), 35);
+}
+
+TEST_F(ICBFlatHashTableTestFixture, ManyInsertions)
+{
+    for (int i = 0; i < 1000; ++i)
+    {
+        table.Insert(std::to_string(i), i);
+    }
+
+    EXPECT_EQ(table.Size(), 1000);
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        EXPECT_EQ(table.Find(std::to_string(i)), i);
+    }
+    EXPECT_EQ(table.Find("1000"), std::nullopt);
+}
+
+TEST_F(ICBFlatHashTableIntTestFixture, PoorlyDistributedKeys)
+{
+    // multiples of 128 would all share the same H2 without hash mixing
+    for (int i = 0; i < 5000; ++i)
+    {
+        table.Insert(i * 128, i);
+    }
+
+    for (int i = 0; i < 5000; ++i)
+    {
+        EXPECT_EQ(table.Find(i * 128), i);
+    }
+    EXPECT_EQ(table.Find(1), std::nullopt);
+}
+
+TEST_F(ICBFlatHashTableIntTestFixture, EraseChurn)
+{
+    // tombstones must be reused or cleaned up, so the capacity stays bounded
+    for (int round = 0; round < 100; ++round)
+    {
+        for (int i = 0; i < 10; ++i)
+        {
+            table.Insert(round * 10 + i, i);
+        }
+        for (int i = 0; i < 10; ++i)
+        {
+            table.Erase(round * 10 + i);
+        }
+    }
+
+    EXPECT_TRUE(table.Empty());
+    EXPECT_LE(table.Capacity(), 64);
+
+    table.Insert(7, 7);
+    EXPECT_EQ(table.Find(7), 7);
+}
+
+TEST_F(ICBFlatHashTableIntTestFixture, EraseKeepsProbeSequences)
+{
+    for (int i = 0; i < 100; ++i)
+    {
+        table.Insert(i, i);
+    }
+    for (int i = 0; i < 100; i += 2)
+    {
+        table.Erase(i);
+    }
+
+    EXPECT_EQ(table.Size(), 50);
+    for (int i = 0; i < 100; ++i)
+    {
+        if (i % 2)
+            EXPECT_EQ(table.Find(i), i);
+        else
+            EXPECT_EQ(table.Find(i), std::nullopt);
+    }
+}
+
+TEST_F(ICBFlatHashTableTestFixture, CopyAndMove)
+{
+    table.Insert("apple", 5);
+    table.Insert("banana", 10);
+
+    icb::FlatHashTable<std::string, int> copy(table);
+    EXPECT_EQ(copy.Size(), 2);
+    EXPECT_EQ(copy.Find("banana"), 10);
+
+    copy.Erase("apple");
+    EXPECT_EQ(table.Find("apple"), 5);
+
+    icb::FlatHashTable<std::string, int> moved(std::move(copy));
+    EXPECT_EQ(moved.Size(), 1);
+    EXPECT_EQ(moved.Find("banana"), 10);
+
+    // moved-from table is still usable
+    EXPECT_TRUE(copy.Empty());
+    EXPECT_EQ(copy.Find("banana"), std::nullopt);
+    copy.Insert("cherry", 15);
+    EXPECT_EQ(copy.Find("cherry"), 15);
+}
+
+// copying throws once armed copies reach zero
+struct ThrowingCopy
+{
+    static inline int armed = -1;
+    std::string value;
+
+    ThrowingCopy() = default;
+
+    ThrowingCopy(std::string value) : value(std::move(value))
+    {
+    }
+
+    ThrowingCopy(const ThrowingCopy &other) : value(other.value)
+    {
+        if (armed >= 0 && armed-- == 0)
+        {
+            throw std::runtime_error("copy");
+        }
+    }
+
+    ThrowingCopy(ThrowingCopy &&) = default;
+};
+
+TEST_F(ICBFlatHashTableIntTestFixture, CopyThrows)
+{
+    icb::FlatHashTable<int, ThrowingCopy> source;
+    for (int i = 0; i < 20; ++i)
+    {
+        source.Insert(i, ThrowingCopy(std::string(40, 'a' + static_cast<char>(i))));
+    }
+    source.Erase(3);
+
+    // the pairs copied before the throw are destroyed with the arrays
+    ThrowingCopy::armed = 10;
+    EXPECT_THROW((icb::FlatHashTable<int, ThrowingCopy>(source)), std::runtime_error);
+    ThrowingCopy::armed = -1;
+
+    icb::FlatHashTable<int, ThrowingCopy> copy(source);
+    EXPECT_EQ(copy.Size(), 19);
+    EXPECT_FALSE(copy.Contains(3));
+    EXPECT_EQ(copy.Find(19)->value, std::string(40, 'a' + 19));
+}
+
+TEST_F(ICBFlatHashTableTestFixture, Clear)
+{
+    for (int i = 0; i < 100; ++i)
+    {
+        table.Insert(std::to_string(i), i);
+    }
+
+    table.Clear();
+    EXPECT_TRUE(table.Empty());
+    EXPECT_EQ(table.Find("5"), std::nullopt);
+
+    table.Insert("5", 5);
+    EXPECT_EQ(table.Find("5"), 5);
+}
+
+TEST_F(ICBFlatHashTableTestFixture, InitializerListConstructor)
+{
+    icb::FlatHashTable<std::string, int> table2{{"apple", 5}, {"banana", 10}, {"cherry", 15}};
+
+    EXPECT_EQ(table2.Size(), 3);
+    EXPECT_EQ(table2.Find("banana"), 10);
+}
@@ -0,0 +1,124 @@
+#include "icb/frozen_hash_table.h"
+#include "icb/hash_table.h"
+
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+#include "common_test_setup.h"
+
+class ICBFrozenHashTableTestFixture : public ICBTestFixture
+{
+  protected:
+    icb::HashTable<std::string, int> table;
+};
+
+class ICBFrozenHashTableIntTestFixture : public ICBTestFixture
+{
+  protected:
+    icb::HashTable<int, int> table;
+};
+
+TEST_F(ICBFrozenHashTableTestFixture, EmptyTable)
+{
+    icb::FrozenHashTable<std::string, int> frozen = table.Freeze();
+
+    EXPECT_TRUE(frozen.Empty());
+    EXPECT_EQ(frozen.Size(), 0);
+    EXPECT_EQ(frozen.Find("apple"), std::nullopt);
+    EXPECT_EQ(frozen.begin(), frozen.end());
+}
+
+TEST_F(ICBFrozenHashTableTestFixture, FreezeAndFind)
+{
+    table.Insert("apple", 5);
+    table.Insert("banana", 10);
+    table.Insert("cherry", 15);
+
+    auto frozen = table.Freeze();
+    EXPECT_EQ(frozen.Size(), 3);
+    EXPECT_EQ(frozen.Find("apple"), 5);
+    EXPECT_EQ(frozen.Find("banana"), 10);
+    EXPECT_EQ(frozen.Find("cherry"), 15);
+    EXPECT_EQ(frozen.Find("date"), std::nullopt);
+
+    EXPECT_TRUE(frozen.Contains(std::string_view("banana")));
+    EXPECT_EQ(*frozen.FindPtr("cherry"), 15);
+
+    // the source table is left as it was
+    EXPECT_EQ(table.Size(), 3);
+}
+
+TEST_F(ICBFrozenHashTableIntTestFixture, ManyKeysAreMinimal)
+{
+    for (int i = 0; i < 100000; ++i)
+    {
+        table.Insert(i * 3, i);
+    }
+
+    auto frozen = table.Freeze();
+    ASSERT_EQ(frozen.Size(), 100000);
+    EXPECT_EQ(frozen.end() - frozen.begin(), 100000);
+
+    for (int i = 0; i < 100000; ++i)
+    {
+        ASSERT_EQ(frozen.Find(i * 3), i);
+        ASSERT_FALSE(frozen.Contains(i * 3 + 1));
+    }
+
+    // every slot is used by exactly one key
+    std::vector<int> seen(100000, 0);
+    for (const auto &[key, value] : frozen)
+    {
+        ++seen[value];
+    }
+    for (int count : seen)
+    {
+        EXPECT_EQ(count, 1);
+    }
+}
+
+TEST_F(ICBFrozenHashTableIntTestFixture, SmallSets)
+{
+    // sizes around the bucket count, where single-key buckets fill everything
+    for (int n = 1; n < 40; ++n)
+    {
+        std::vector<std::pair<int, int>> pairs;
+        for (int i = 0; i < n; ++i)
+        {
+            pairs.emplace_back(i, -i);
+        }
+
+        icb::FrozenHashTable<int, int> frozen(pairs.begin(), pairs.end());
+        for (int i = 0; i < n; ++i)
+        {
+            ASSERT_EQ(frozen.Find(i), -i);
+        }
+        EXPECT_FALSE(frozen.Contains(n));
+    }
+}
+
+TEST_F(ICBFrozenHashTableTestFixture, DuplicateKeysThrow)
+{
+    std::vector<std::pair<std::string, int>> pairs{{"apple", 1}, {"banana", 2}, {"apple", 3}};
+
+    EXPECT_THROW((icb::FrozenHashTable<std::string, int>(pairs.begin(), pairs.end())), std::runtime_error);
+}
+
+TEST_F(ICBFrozenHashTableTestFixture, CopyAndMove)
+{
+    icb::FrozenHashTable<std::string, int> frozen{{"apple", 5}, {"banana", 10}};
+
+    icb::FrozenHashTable<std::string, int> copy(frozen);
+    EXPECT_EQ(copy.Find("banana"), 10);
+
+    icb::FrozenHashTable<std::string, int> moved(std::move(copy));
+    EXPECT_EQ(moved.Find("apple"), 5);
+    EXPECT_TRUE(copy.Empty());
+    EXPECT_FALSE(copy.Contains("apple"));
+
+    copy = frozen;
+    EXPECT_EQ(copy.Size(), 2);
+    moved = std::move(copy);
+    EXPECT_EQ(moved.Find("banana"), 10);
+}
@@ -1,5 +1,14 @@
 #include "icb/hash_table.h"
 
+#include <algorithm>
+#include <cctype>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+#include <vector>
+
 #include "common_test_setup.h"
 
 class ICBHashTableTestFixture : public ICBTestFixture
@@ -8,6 +17,12 @@ class ICBHashTableTestFixture : public ICBTestFixture
     icb::HashTable<std::string, int> table;
 };
 
+class ICBHashTableIntTestFixture : public ICBTestFixture
+{
+  protected:
+    icb::HashTable<int, int> table;
+};
+
 TEST_F(ICBHashTableTestFixture, EmptyTable)
 {
     EXPECT_TRUE(table.Empty());
@@ -129,3 +144,847 @@ TEST_F(ICBHashTableTestFixture, InitializerListConstructor)
     EXPECT_EQ(table2.Size(), 3);
     EXPECT_EQ(table2.Find("banana"), 10);
 }
+
+TEST_F(ICBHashTableTestFixture, PowerOfTwoBuckets)
+{
+    EXPECT_EQ(table.BucketCount(), 16);
+
+    table.Rehash(20);
+    EXPECT_EQ(table.BucketCount(), 32);
+
+    icb::HashTable<std::string, int> table2(11);
+    EXPECT_EQ(table2.BucketCount(), 16);
+}
+
+TEST_F(ICBHashTableTestFixture, AutomaticGrowth)
+{
+    for (int i = 0; i < 10000; ++i)
+    {
+        table.Insert(std::to_string(i), i);
+        EXPECT_LE(table.LoadFactor(), table.MaxLoadFactor());
+    }
+
+    EXPECT_GE(table.BucketCount(), 10000);
+    for (int i = 0; i < 10000; ++i)
+    {
+        EXPECT_EQ(table.Find(std::to_string(i)), i);
+    }
+}
+
+TEST_F(ICBHashTableTestFixture, MaxLoadFactor)
+{
+    for (int i = 0; i < 64; ++i)
+    {
+        table.Insert(std::to_string(i), i);
+    }
+    EXPECT_EQ(table.BucketCount(), 64);
+
+    // lowering it rehashes right away
+    table.MaxLoadFactor(0.5f);
+    EXPECT_EQ(table.BucketCount(), 128);
+    EXPECT_LE(table.LoadFactor(), 0.5f);
+
+    table.MaxLoadFactor(4.0f);
+    for (int i = 64; i < 256; ++i)
+    {
+        table.Insert(std::to_string(i), i);
+    }
+    EXPECT_EQ(table.BucketCount(), 128);
+    EXPECT_EQ(table.Find("200"), 200);
+}
+
+TEST_F(ICBHashTableTestFixture, ClearAndReuse)
+{
+    for (int i = 0; i < 100; ++i)
+    {
+        table.Insert(std::to_string(i), i);
+    }
+
+    table.Clear();
+    EXPECT_TRUE(table.Empty());
+    EXPECT_EQ(table.Find("1"), std::nullopt);
+
+    table.Insert("1", 1);
+    EXPECT_EQ(table.Find("1"), 1);
+    EXPECT_EQ(table.Size(), 1);
+}
+
+TEST_F(ICBHashTableIntTestFixture, StridedIntegerKeys)
+{
+    // identity std::hash + masking would put all of these into bucket 0 without mixing
+    for (int i = 0; i < 4096; ++i)
+    {
+        table.Insert(i * 4096, i);
+    }
+
+    for (int i = 0; i < 4096; ++i)
+    {
+        EXPECT_EQ(table.Find(i * 4096), i);
+    }
+}
+
+TEST_F(ICBHashTableTestFixture, FindPtr)
+{
+    table.Insert("apple", 5);
+
+    int *value = table.FindPtr("apple");
+    ASSERT_NE(value, nullptr);
+    EXPECT_EQ(*value, 5);
+
+    // points into the table, no copy
+    *value = 6;
+    EXPECT_EQ(table.Find("apple"), 6);
+
+    EXPECT_EQ(table.FindPtr("banana"), nullptr);
+
+    const auto &constTable = table;
+    EXPECT_EQ(*constTable.FindPtr("apple"), 6);
+    EXPECT_TRUE(constTable.Contains("apple"));
+    EXPECT_FALSE(constTable.Contains("banana"));
+}
+
+TEST_F(ICBHashTableTestFixture, TryEmplace)
+{
+    auto [value, inserted] = table.TryEmplace("apple", 5);
+    EXPECT_TRUE(inserted);
+    EXPECT_EQ(*value, 5);
+
+    auto [existing, insertedAgain] = table.TryEmplace("apple", 50);
+    EXPECT_FALSE(insertedAgain);
+    EXPECT_EQ(existing, value);
+    EXPECT_EQ(*existing, 5);
+    EXPECT_EQ(table.Size(), 1);
+}
+
+TEST_F(ICBHashTableTestFixture, InsertOrAssign)
+{
+    EXPECT_TRUE(table.InsertOrAssign("apple", 5).second);
+    EXPECT_FALSE(table.InsertOrAssign("apple", 50).second);
+
+    EXPECT_EQ(table.Find("apple"), 50);
+    EXPECT_EQ(table.Size(), 1);
+}
+
+TEST_F(ICBHashTableTestFixture, SubscriptOperator)
+{
+    table["apple"] = 5;
+    table["apple"] += 1;
+    ++table["banana"];
+
+    EXPECT_EQ(table.Find("apple"), 6);
+    EXPECT_EQ(table.Find("banana"), 1);
+    EXPECT_EQ(table.Size(), 2);
+}
+
+TEST_F(ICBHashTableTestFixture, HeterogeneousLookup)
+{
+    table.Insert("apple", 5);
+
+    std::string_view view = "apple";
+    EXPECT_EQ(table.Find(view), 5);
+    EXPECT_NE(table.FindPtr(view), nullptr);
+    EXPECT_TRUE(table.Contains(view));
+    EXPECT_FALSE(table.Contains(std::string_view("banana")));
+
+    auto [value, inserted] = table.TryEmplace(std::string_view("banana"), 10);
+    EXPECT_TRUE(inserted);
+    EXPECT_EQ(*value, 10);
+    EXPECT_EQ(table.Find(std::string("banana")), 10);
+
+    table.Erase(view);
+    EXPECT_FALSE(table.Contains("apple"));
+    EXPECT_EQ(table.Size(), 1);
+}
+
+TEST_F(ICBHashTableTestFixture, MoveOnlyValues)
+{
+    icb::HashTable<std::string, std::unique_ptr<int>> owners;
+
+    owners.TryEmplace("apple", std::make_unique<int>(5));
+    owners.InsertOrAssign("banana", std::make_unique<int>(10));
+
+    for (int i = 0; i < 100; ++i)
+    {
+        owners.TryEmplace(std::to_string(i), std::make_unique<int>(i));
+    }
+
+    EXPECT_EQ(**owners.FindPtr("apple"), 5);
+    EXPECT_EQ(**owners.FindPtr("banana"), 10);
+    EXPECT_EQ(**owners.FindPtr("42"), 42);
+}
+
+TEST_F(ICBHashTableIntTestFixture, IncrementalRehash)
+{
+    table.IncrementalRehash(true);
+    EXPECT_TRUE(table.IncrementalRehash());
+
+    bool sawRehashing = false;
+    for (int i = 0; i < 5000; ++i)
+    {
+        table.Insert(i, i);
+        sawRehashing |= table.Rehashing();
+
+        // everything stays reachable while old and new buckets coexist
+        if (i % 97 == 0)
+        {
+            for (int j = 0; j <= i; ++j)
+            {
+                ASSERT_EQ(table.Find(j), j);
+            }
+        }
+    }
+
+    EXPECT_TRUE(sawRehashing);
+    EXPECT_EQ(table.Size(), 5000);
+    EXPECT_LE(table.LoadFactor(), table.MaxLoadFactor());
+}
+
+TEST_F(ICBHashTableIntTestFixture, IncrementalRehashEraseAndAssign)
+{
+    table.IncrementalRehash(true);
+
+    // fill up to the growth point, so the next insert starts a migration
+    for (int i = 0; i < 16; ++i)
+    {
+        table.Insert(i, i);
+    }
+    table.Insert(16, 16);
+    ASSERT_TRUE(table.Rehashing());
+
+    // keys still in old buckets can be erased and assigned
+    for (int i = 0; i < 17; i += 2)
+    {
+        table.Erase(i);
+    }
+    table.InsertOrAssign(1, 100);
+    table[3] = 300;
+
+    EXPECT_EQ(table.Size(), 8);
+    for (int i = 0; i < 17; ++i)
+    {
+        if (i % 2 == 0)
+        {
+            EXPECT_EQ(table.Find(i), std::nullopt);
+        }
+    }
+    EXPECT_EQ(table.Find(1), 100);
+    EXPECT_EQ(table.Find(3), 300);
+    EXPECT_EQ(table.Find(5), 5);
+}
+
+TEST_F(ICBHashTableIntTestFixture, IncrementalRehashFinishes)
+{
+    table.IncrementalRehash(true);
+    for (int i = 0; i < 17; ++i)
+    {
+        table.Insert(i, i);
+    }
+    ASSERT_TRUE(table.Rehashing());
+
+    // non-const lookups drive the migration too
+    while (table.Rehashing())
+    {
+        table.FindPtr(0);
+    }
+    EXPECT_EQ(table.BucketCount(), 32);
+
+    table.Insert(17, 17);
+    for (int i = 0; i < 18; ++i)
+    {
+        EXPECT_EQ(table.Find(i), i);
+    }
+}
+
+TEST_F(ICBHashTableIntTestFixture, RehashAndClearDuringIncrementalRehash)
+{
+    table.IncrementalRehash(true);
+    for (int i = 0; i < 17; ++i)
+    {
+        table.Insert(i, i);
+    }
+    ASSERT_TRUE(table.Rehashing());
+
+    table.Rehash(128);
+    EXPECT_FALSE(table.Rehashing());
+    EXPECT_EQ(table.BucketCount(), 128);
+    for (int i = 0; i < 17; ++i)
+    {
+        EXPECT_EQ(table.Find(i), i);
+    }
+
+    // 17 elements fit in 128 buckets at this load factor, the 18th starts a migration
+    table.MaxLoadFactor(0.14f);
+    ASSERT_FALSE(table.Rehashing());
+    table.Insert(17, 17);
+    ASSERT_TRUE(table.Rehashing());
+    table.Clear();
+    EXPECT_FALSE(table.Rehashing());
+    EXPECT_TRUE(table.Empty());
+    EXPECT_EQ(table.Find(3), std::nullopt);
+
+    table.Insert(3, 3);
+    EXPECT_EQ(table.Find(3), 3);
+}
+
+TEST_F(ICBHashTableIntTestFixture, RehashKeepsLoadFactor)
+{
+    for (int i = 0; i < 100; ++i)
+    {
+        table.Insert(i, i);
+    }
+
+    // asking for fewer buckets than the elements need is rounded up
+    table.Rehash(1);
+    EXPECT_EQ(table.BucketCount(), 128);
+    EXPECT_EQ(table.Find(42), 42);
+}
+
+TEST_F(ICBHashTableIntTestFixture, FindBatch)
+{
+    for (int i = 0; i < 1000; i += 2)
+    {
+        table.Insert(i, i * 10);
+    }
+
+    // more keys than one prefetch group, half of them missing
+    std::vector<int> keys;
+    for (int i = 0; i < 100; ++i)
+    {
+        keys.push_back(i * 7);
+    }
+
+    std::vector<int *> values(keys.size());
+    table.FindBatch(keys, values);
+
+    std::vector<bool> expected;
+    for (size_t i = 0; i < keys.size(); ++i)
+    {
+        if (keys[i] % 2 == 0)
+        {
+            ASSERT_NE(values[i], nullptr);
+            EXPECT_EQ(*values[i], keys[i] * 10);
+            EXPECT_EQ(values[i], table.FindPtr(keys[i]));
+        }
+        else
+        {
+            EXPECT_EQ(values[i], nullptr);
+        }
+    }
+
+    const auto &constTable = table;
+    std::vector<const int *> constValues(keys.size());
+    constTable.FindBatch(keys, constValues);
+    EXPECT_EQ(constValues[2], values[2]);
+
+    bool found[100];
+    constTable.ContainsBatch(keys, found);
+    for (size_t i = 0; i < keys.size(); ++i)
+    {
+        EXPECT_EQ(found[i], keys[i] % 2 == 0);
+    }
+
+    table.FindBatch({}, values);
+}
+
+TEST_F(ICBHashTableIntTestFixture, FindBatchDuringIncrementalRehash)
+{
+    table.IncrementalRehash(true);
+    for (int i = 0; i < 17; ++i)
+    {
+        table.Insert(i, i);
+    }
+    ASSERT_TRUE(table.Rehashing());
+
+    int keys[] = {0, 5, 16, 17, 3};
+    bool found[5];
+    table.ContainsBatch(keys, found);
+
+    EXPECT_TRUE(found[0]);
+    EXPECT_TRUE(found[1]);
+    EXPECT_TRUE(found[2]);
+    EXPECT_FALSE(found[3]);
+    EXPECT_TRUE(found[4]);
+}
+
+TEST_F(ICBHashTableIntTestFixture, Iteration)
+{
+    EXPECT_EQ(table.begin(), table.end());
+
+    for (int i = 0; i < 100; ++i)
+    {
+        table.Insert(i, i * 2);
+    }
+
+    std::vector<bool> seen(100, false);
+    size_t visited = 0;
+    for (auto &[key, value] : table)
+    {
+        EXPECT_EQ(value, key * 2);
+        EXPECT_FALSE(seen[key]);
+        seen[key] = true;
+        ++visited;
+
+        value = -key;
+    }
+    EXPECT_EQ(visited, table.Size());
+    EXPECT_EQ(table.Find(42), -42);
+
+    const auto &constTable = table;
+    icb::HashTable<int, int>::ConstIterator it = table.begin();
+    EXPECT_EQ(it, constTable.cbegin());
+    EXPECT_EQ(std::distance(constTable.begin(), constTable.end()), 100);
+}
+
+TEST_F(ICBHashTableIntTestFixture, IterationDuringIncrementalRehash)
+{
+    table.IncrementalRehash(true);
+    for (int i = 0; i < 40; ++i)
+    {
+        table.Insert(i, i);
+    }
+    ASSERT_TRUE(table.Rehashing());
+
+    // elements are split over both bucket arrays, every one is visited once
+    std::vector<int> seen(40, 0);
+    for (const auto &[key, value] : std::as_const(table))
+    {
+        ++seen[key];
+    }
+    EXPECT_EQ(std::count(seen.begin(), seen.end(), 1), 40);
+}
+
+TEST_F(ICBHashTableIntTestFixture, ValuesStayPutAcrossRehash)
+{
+    table.Insert(7, 70);
+    const int *value = table.FindPtr(7);
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        table.Insert(i + 100, i);
+    }
+    table.Rehash(4096);
+
+    EXPECT_EQ(table.FindPtr(7), value);
+    EXPECT_EQ(*value, 70);
+}
+
+TEST_F(ICBHashTableTestFixture, CopyAndMove)
+{
+    table.IncrementalRehash(true);
+    for (int i = 0; i < 50; ++i)
+    {
+        table.Insert("key" + std::to_string(i), i);
+    }
+
+    icb::HashTable<std::string, int> copy(table);
+    EXPECT_EQ(copy.Size(), 50);
+    EXPECT_FALSE(copy.Rehashing());
+    for (int i = 0; i < 50; ++i)
+    {
+        EXPECT_EQ(copy.Find("key" + std::to_string(i)), i);
+    }
+
+    copy.Erase("key0");
+    EXPECT_TRUE(table.Contains("key0"));
+
+    icb::HashTable<std::string, int> moved(std::move(copy));
+    EXPECT_EQ(moved.Size(), 49);
+    EXPECT_FALSE(moved.Contains("key0"));
+
+    // the moved-from table is empty but usable
+    EXPECT_TRUE(copy.Empty());
+    EXPECT_FALSE(copy.Contains("key1"));
+    copy.Erase("key1");
+    copy.Insert("fresh", 1);
+    EXPECT_EQ(copy.Find("fresh"), 1);
+
+    copy = table;
+    EXPECT_EQ(copy.Size(), 50);
+    moved = std::move(copy);
+    EXPECT_EQ(moved.Size(), 50);
+    EXPECT_EQ(moved.Find("key49"), 49);
+}
+
+struct CaseInsensitiveHash
+{
+    size_t operator()(const std::string &key) const
+    {
+        std::string lower(key);
+        std::transform(lower.begin(), lower.end(), lower.begin(), [](unsigned char c) { return std::tolower(c); });
+        return icb::Hash<std::string>{}(lower);
+    }
+};
+
+struct CaseInsensitiveEqual
+{
+    bool operator()(const std::string &x, const std::string &y) const
+    {
+        return std::equal(x.begin(), x.end(), y.begin(), y.end(),
+                          [](unsigned char a, unsigned char b) { return std::tolower(a) == std::tolower(b); });
+    }
+};
+
+TEST_F(ICBHashTableTestFixture, CustomHasherAndKeyEqual)
+{
+    icb::HashTable<std::string, int, CaseInsensitiveHash, CaseInsensitiveEqual> custom;
+    custom.Insert("Apple", 5);
+    custom.Insert("APPLE", 6);
+
+    EXPECT_EQ(custom.Size(), 1);
+    EXPECT_EQ(custom.Find("apple"), 5);
+    EXPECT_TRUE(custom.Contains("aPpLe"));
+    EXPECT_FALSE(custom.Contains("banana"));
+
+    custom.Erase("APPLE");
+    EXPECT_TRUE(custom.Empty());
+}
+
+TEST_F(ICBHashTableTestFixture, DefaultHashes)
+{
+    // strings hash alike whatever they are passed as
+    const size_t h = icb::Hash<std::string>{}(std::string("apple"));
+    EXPECT_EQ(icb::Hash<std::string>{}(std::string_view("apple")), h);
+    EXPECT_EQ(icb::Hash<std::string>{}("apple"), h);
+    EXPECT_EQ(icb::Hash<std::string_view>{}("apple"), h);
+
+    // every length path of the byte hash, including the ones crossing 16 and 48 bytes
+    std::vector<size_t> hashes;
+    std::string bytes;
+    for (int length = 0; length < 200; ++length)
+    {
+        hashes.push_back(icb::Hash<std::string>{}(bytes));
+        bytes.push_back('a');
+    }
+    std::sort(hashes.begin(), hashes.end());
+    EXPECT_EQ(std::adjacent_find(hashes.begin(), hashes.end()), hashes.end());
+
+    EXPECT_NE(icb::Hash<int>{}(0), icb::Hash<int>{}(1));
+}
+
+TEST_F(ICBHashTableIntTestFixture, Stats)
+{
+    icb::HashTableStats empty = table.Stats();
+    EXPECT_EQ(empty.size, 0);
+    EXPECT_EQ(empty.maxChainLength, 0);
+    EXPECT_EQ(empty.emptyBuckets, table.BucketCount());
+
+    // keys that differ only in high bits, which an identity hash would put into a single bucket
+    for (int i = 0; i < 4096; ++i)
+    {
+        table.Insert(i << 16, i);
+    }
+
+    icb::HashTableStats stats = table.Stats();
+    EXPECT_EQ(stats.size, 4096);
+    EXPECT_EQ(stats.bucketCount, table.BucketCount());
+    EXPECT_FLOAT_EQ(stats.loadFactor, table.LoadFactor());
+    EXPECT_LT(stats.maxChainLength, 10);
+    EXPECT_LT(stats.averageProbeLength, 2.0);
+    EXPECT_EQ(stats.chainLengthHistogram.size(), stats.maxChainLength + 1);
+
+    size_t buckets = 0;
+    size_t elements = 0;
+    for (size_t length = 0; length < stats.chainLengthHistogram.size(); ++length)
+    {
+        buckets += stats.chainLengthHistogram[length];
+        elements += length * stats.chainLengthHistogram[length];
+    }
+    EXPECT_EQ(buckets, stats.bucketCount);
+    EXPECT_EQ(elements, stats.size);
+}
+
+struct ConstantHash
+{
+    size_t operator()(int) const
+    {
+        return 42;
+    }
+};
+
+TEST_F(ICBHashTableIntTestFixture, StatsCatchBadHash)
+{
+    icb::HashTable<int, int, ConstantHash> bad;
+    for (int i = 0; i < 100; ++i)
+    {
+        bad.Insert(i, i);
+    }
+
+    icb::HashTableStats stats = bad.Stats();
+    EXPECT_EQ(stats.maxChainLength, 100);
+    EXPECT_EQ(stats.emptyBuckets, stats.bucketCount - 1);
+    EXPECT_DOUBLE_EQ(stats.averageProbeLength, 50.5);
+    EXPECT_EQ(*bad.Find(7), 7);
+}
+
+// keys in [0, count / 2), so about half the input repeats an earlier key, in a scrambled order
+static std::vector<std::pair<int, int>> BulkInput(int count)
+{
+    std::vector<std::pair<int, int>> input;
+    for (int i = 0; i < count; ++i)
+    {
+        input.emplace_back(static_cast<int>((static_cast<unsigned>(i) * 2654435761u) % (count / 2)), i);
+    }
+    return input;
+}
+
+template <typename Table> static std::vector<std::pair<int, int>> Contents(const Table &table)
+{
+    std::vector<std::pair<int, int>> contents;
+    for (const auto &[key, value] : table)
+    {
+        contents.emplace_back(key, value);
+    }
+    return contents;
+}
+
+TEST_F(ICBHashTableIntTestFixture, BulkInsertMatchesInsert)
+{
+    const std::vector<std::pair<int, int>> input = BulkInput(200000);
+
+    icb::HashTable<int, int> serial;
+    serial.Insert(3, -3);
+    for (const auto &[key, value] : input)
+    {
+        serial.Insert(key, value);
+    }
+
+    icb::ThreadPool single(1);
+    icb::ThreadPool pool(4);
+
+    table.Insert(3, -3);
+    table.BulkInsert(input.begin(), input.end(), pool);
+
+    icb::HashTable<int, int> onOneThread;
+    onOneThread.Insert(3, -3);
+    onOneThread.BulkInsert(input.begin(), input.end(), single);
+
+    EXPECT_EQ(table.Size(), serial.Size());
+    EXPECT_EQ(*table.Find(3), -3);
+    for (const auto &[key, value] : serial)
+    {
+        ASSERT_EQ(*table.Find(key), value);
+    }
+
+    // the same chains whatever the number of threads
+    EXPECT_EQ(Contents(table), Contents(onOneThread));
+}
+
+TEST_F(ICBHashTableIntTestFixture, BulkInsertSmallAndMoved)
+{
+    std::vector<std::pair<int, std::unique_ptr<int>>> input;
+    for (int i = 0; i < 100; ++i)
+    {
+        input.emplace_back(i % 50, std::make_unique<int>(i));
+    }
+
+    icb::HashTable<int, std::unique_ptr<int>> moved;
+    moved.IncrementalRehash(true);
+    moved.BulkInsert(std::make_move_iterator(input.begin()), std::make_move_iterator(input.end()));
+
+    EXPECT_EQ(moved.Size(), 50);
+    EXPECT_FALSE(moved.Rehashing());
+    EXPECT_EQ(**moved.FindPtr(7), 7);
+
+    moved.BulkInsert(std::make_move_iterator(input.end()), std::make_move_iterator(input.end()));
+    EXPECT_EQ(moved.Size(), 50);
+}
+
+// copying key 150000 throws while armed
+struct ThrowingKey
+{
+    static inline bool armed = false;
+    int key;
+
+    ThrowingKey(int key) : key(key)
+    {
+    }
+
+    ThrowingKey(const ThrowingKey &other) : key(other.key)
+    {
+        if (armed && key == 150000)
+        {
+            throw std::runtime_error("copy");
+        }
+    }
+
+    bool operator==(const ThrowingKey &other) const
+    {
+        return key == other.key;
+    }
+};
+
+struct ThrowingKeyHash
+{
+    size_t operator()(const ThrowingKey &k) const
+    {
+        return icb::Hash<int>()(k.key);
+    }
+};
+
+TEST_F(ICBHashTableIntTestFixture, BulkInsertThrows)
+{
+    std::vector<std::pair<ThrowingKey, int>> input;
+    for (int i = 0; i < 200000; ++i)
+    {
+        input.emplace_back(ThrowingKey(i), i);
+    }
+
+    icb::ThreadPool pool(4);
+    icb::HashTable<ThrowingKey, int, ThrowingKeyHash> throwing;
+    throwing.Insert(ThrowingKey(-1), -1);
+
+    ThrowingKey::armed = true;
+    EXPECT_THROW(throwing.BulkInsert(input.begin(), input.end(), pool), std::runtime_error);
+    ThrowingKey::armed = false;
+
+    EXPECT_EQ(throwing.Size(), 1);
+    EXPECT_EQ(*throwing.Find(ThrowingKey(-1)), -1);
+}
+
+// comparing key 150000 throws while armed
+struct ThrowingKeyEqual
+{
+    static inline bool armed = false;
+
+    bool operator()(const ThrowingKey &a, const ThrowingKey &b) const
+    {
+        if (armed && a.key == 150000)
+        {
+            throw std::runtime_error("compare");
+        }
+        return a.key == b.key;
+    }
+};
+
+TEST_F(ICBHashTableIntTestFixture, BulkInsertThrowsWhileLinking)
+{
+    // the second 150000 is compared with the first when it's linked
+    std::vector<std::pair<ThrowingKey, int>> input;
+    for (int i = 0; i < 200000; ++i)
+    {
+        input.emplace_back(ThrowingKey(i), i);
+    }
+    input.emplace_back(ThrowingKey(150000), -1);
+
+    icb::ThreadPool pool(4);
+    CountingResource resource;
+    icb::HashTable<ThrowingKey, int, ThrowingKeyHash, ThrowingKeyEqual> throwing;
+    icb::HashTable<ThrowingKey, int, ThrowingKeyHash, ThrowingKeyEqual,
+                   std::pmr::polymorphic_allocator<std::pair<const ThrowingKey, int>>>
+        fromResource(&resource);
+
+    ThrowingKeyEqual::armed = true;
+    EXPECT_THROW(throwing.BulkInsert(input.begin(), input.end(), pool), std::runtime_error);
+    EXPECT_THROW(fromResource.BulkInsert(input.begin(), input.end(), pool), std::runtime_error);
+    ThrowingKeyEqual::armed = false;
+
+    // whatever got linked is counted, the rest is freed
+    EXPECT_GT(throwing.Size(), 0);
+    EXPECT_EQ(static_cast<size_t>(std::distance(throwing.begin(), throwing.end())), throwing.Size());
+    EXPECT_EQ(static_cast<size_t>(std::distance(fromResource.begin(), fromResource.end())), fromResource.Size());
+    EXPECT_EQ(*throwing.Find(ThrowingKey(7)), 7);
+
+    fromResource.Clear();
+    EXPECT_EQ(resource.bytesInUse, fromResource.BucketCount() * sizeof(void *));
+}
+
+TEST_F(ICBHashTableIntTestFixture, ParallelRehash)
+{
+    icb::ThreadPool pool(4);
+    icb::HashTable<int, int> serial;
+    for (int i = 0; i < 100000; ++i)
+    {
+        table.Insert(i * 7, i);
+        serial.Insert(i * 7, i);
+    }
+
+    for (size_t capacity : {size_t(1) << 19, size_t(1) << 17, size_t(1) << 18})
+    {
+        table.Rehash(capacity, pool);
+        serial.Rehash(capacity);
+
+        EXPECT_EQ(table.BucketCount(), capacity);
+        EXPECT_EQ(Contents(table), Contents(serial));
+    }
+    EXPECT_EQ(*table.Find(700), 100);
+}
+
+TEST_F(ICBHashTableIntTestFixture, AllocatesFromResource)
+{
+    // chain order depends on how a table grew, and copies reverse it
+    auto sorted = [](const auto &table) {
+        std::vector<std::pair<int, int>> contents = Contents(table);
+        std::sort(contents.begin(), contents.end());
+        return contents;
+    };
+
+    CountingResource resource;
+    {
+        icb::pmr::HashTable<int, int> arena(&resource);
+        arena.IncrementalRehash(true);
+        for (int i = 0; i < 10000; ++i)
+        {
+            arena.Insert(i, i);
+            table.Insert(i, i);
+        }
+        for (int i = 0; i < 10000; i += 3)
+        {
+            arena.Erase(i);
+            table.Erase(i);
+        }
+        EXPECT_GT(resource.allocations, 10000);
+        EXPECT_EQ(sorted(arena), sorted(table));
+
+        // a copy goes to the default resource, a move takes the nodes and the resource along
+        icb::pmr::HashTable<int, int> copy(arena);
+        EXPECT_EQ(copy.GetAllocator().resource(), std::pmr::get_default_resource());
+        icb::pmr::HashTable<int, int> moved(std::move(copy));
+        EXPECT_EQ(sorted(moved), sorted(table));
+
+        // assignment keeps the resource, from another one the elements are moved over one by one
+        CountingResource other;
+        icb::pmr::HashTable<int, int> elsewhere(&other);
+        elsewhere = arena;
+        EXPECT_EQ(sorted(elsewhere), sorted(table));
+        elsewhere = std::move(moved);
+        EXPECT_EQ(elsewhere.GetAllocator().resource(), &other);
+        EXPECT_EQ(elsewhere.Size(), table.Size());
+        EXPECT_TRUE(moved.Empty());
+
+        elsewhere = icb::pmr::HashTable<int, int>(&other);
+        EXPECT_TRUE(elsewhere.Empty());
+    }
+    EXPECT_EQ(resource.bytesInUse, 0);
+}
+
+TEST_F(ICBHashTableIntTestFixture, BulkInsertFromResource)
+{
+    const std::vector<std::pair<int, int>> input = BulkInput(200000);
+    icb::ThreadPool pool(4);
+
+    CountingResource resource;
+    {
+        icb::pmr::HashTable<int, int> arena(&resource);
+        arena.BulkInsert(input.begin(), input.end(), pool);
+        table.BulkInsert(input.begin(), input.end(), pool);
+        EXPECT_EQ(Contents(arena), Contents(table));
+    }
+    EXPECT_EQ(resource.bytesInUse, 0);
+
+    // the nodes made before the throw go back to the resource
+    std::vector<std::pair<ThrowingKey, int>> throwingInput;
+    for (int i = 0; i < 200000; ++i)
+    {
+        throwingInput.emplace_back(ThrowingKey(i), i);
+    }
+    icb::HashTable<ThrowingKey, int, ThrowingKeyHash, std::equal_to<>,
+                   std::pmr::polymorphic_allocator<std::pair<const ThrowingKey, int>>>
+        throwing(&resource);
+
+    ThrowingKey::armed = true;
+    EXPECT_THROW(throwing.BulkInsert(throwingInput.begin(), throwingInput.end(), pool), std::runtime_error);
+    ThrowingKey::armed = false;
+
+    throwing.Clear();
+    EXPECT_EQ(resource.bytesInUse, throwing.BucketCount() * sizeof(void *));
+}
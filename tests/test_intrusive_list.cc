@@ -0,0 +1,261 @@
+#include "icb/intrusive_list.h"
+
+#include <memory>
+#include <vector>
+
+#include "common_test_setup.h"
+
+struct ActiveTag;
+struct ExpiredTag;
+
+// sits in two lists at once, one per hook
+struct Timer : icb::ListHook<ActiveTag>, icb::ListHook<ExpiredTag>
+{
+    int id;
+
+    explicit Timer(int id) : id(id)
+    {
+    }
+};
+
+struct Connection : icb::AutoUnlinkListHook<>
+{
+    int id;
+
+    explicit Connection(int id) : id(id)
+    {
+    }
+};
+
+class ICBIntrusiveListFixture : public ICBTestFixture
+{
+  protected:
+    void SetUp() override
+    {
+        for (int i = 0; i < 8; ++i)
+        {
+            timers.push_back(std::make_unique<Timer>(i));
+        }
+    }
+
+    void TearDown() override
+    {
+        // plain hooks assert they are unlinked when destroyed, so the lists go first
+        active.Clear();
+        expired.Clear();
+    }
+
+    template <typename Tag> static std::vector<int> Ids(const icb::IntrusiveList<Timer, Tag> &list)
+    {
+        std::vector<int> ids;
+        for (const Timer &timer : list)
+        {
+            ids.push_back(timer.id);
+        }
+        return ids;
+    }
+
+    std::vector<std::unique_ptr<Timer>> timers;
+    icb::IntrusiveList<Timer, ActiveTag> active;
+    icb::IntrusiveList<Timer, ExpiredTag> expired;
+};
+
+TEST_F(ICBIntrusiveListFixture, Empty)
+{
+    EXPECT_TRUE(active.Empty());
+    EXPECT_EQ(active.Size(), 0);
+    EXPECT_EQ(active.begin(), active.end());
+}
+
+TEST_F(ICBIntrusiveListFixture, PushAndPop)
+{
+    active.PushBack(*timers[1]);
+    active.PushBack(*timers[2]);
+    active.PushFront(*timers[0]);
+
+    EXPECT_EQ(Ids(active), (std::vector<int>{0, 1, 2}));
+    EXPECT_EQ(active.Size(), 3);
+    EXPECT_EQ(active.Front().id, 0);
+    EXPECT_EQ(active.Back().id, 2);
+    EXPECT_TRUE(timers[0]->icb::ListHook<ActiveTag>::IsLinked());
+
+    active.PopFront();
+    active.PopBack();
+    EXPECT_EQ(Ids(active), (std::vector<int>{1}));
+    EXPECT_FALSE(timers[0]->icb::ListHook<ActiveTag>::IsLinked());
+    EXPECT_FALSE(timers[2]->icb::ListHook<ActiveTag>::IsLinked());
+}
+
+TEST_F(ICBIntrusiveListFixture, ElementsLiveInPlace)
+{
+    active.PushBack(*timers[0]);
+    EXPECT_EQ(&active.Front(), timers[0].get());
+
+    timers[0]->id = 42;
+    EXPECT_EQ(active.begin()->id, 42);
+}
+
+TEST_F(ICBIntrusiveListFixture, InsertEraseRemove)
+{
+    active.PushBack(*timers[0]);
+    active.PushBack(*timers[3]);
+
+    auto it = active.Insert(std::next(active.begin()), *timers[1]);
+    EXPECT_EQ(it->id, 1);
+    active.Insert(active.IteratorTo(*timers[3]), *timers[2]);
+    EXPECT_EQ(Ids(active), (std::vector<int>{0, 1, 2, 3}));
+
+    it = active.Erase(active.IteratorTo(*timers[1]));
+    EXPECT_EQ(it->id, 2);
+    active.Remove(*timers[3]);
+    EXPECT_EQ(Ids(active), (std::vector<int>{0, 2}));
+    EXPECT_EQ(active.Size(), 2);
+
+    // an unlinked element can go back in
+    active.PushFront(*timers[3]);
+    EXPECT_EQ(Ids(active), (std::vector<int>{3, 0, 2}));
+}
+
+TEST_F(ICBIntrusiveListFixture, SeveralListsAtOnce)
+{
+    for (auto &timer : timers)
+    {
+        active.PushBack(*timer);
+    }
+    for (int id : {5, 2, 7})
+    {
+        expired.PushBack(*timers[id]);
+    }
+
+    EXPECT_EQ(Ids(expired), (std::vector<int>{5, 2, 7}));
+    EXPECT_EQ(active.Size(), 8);
+
+    // leaving one list doesn't touch the other
+    for (Timer &timer : expired)
+    {
+        active.Remove(timer);
+    }
+    EXPECT_EQ(Ids(active), (std::vector<int>{0, 1, 3, 4, 6}));
+    EXPECT_EQ(Ids(expired), (std::vector<int>{5, 2, 7}));
+}
+
+TEST_F(ICBIntrusiveListFixture, SpliceOne)
+{
+    icb::IntrusiveList<Timer, ActiveTag> other;
+    for (int i = 0; i < 3; ++i)
+    {
+        active.PushBack(*timers[i]);
+        other.PushBack(*timers[i + 3]);
+    }
+
+    active.Splice(active.begin(), other, other.IteratorTo(*timers[4]));
+    EXPECT_EQ(Ids(active), (std::vector<int>{4, 0, 1, 2}));
+    EXPECT_EQ(Ids(other), (std::vector<int>{3, 5}));
+    EXPECT_EQ(active.Size(), 4);
+    EXPECT_EQ(other.Size(), 2);
+
+    // within one list, to the back
+    active.Splice(active.end(), active, active.begin());
+    EXPECT_EQ(Ids(active), (std::vector<int>{0, 1, 2, 4}));
+
+    // before itself is a no-op
+    active.Splice(active.begin(), active, active.begin());
+    EXPECT_EQ(Ids(active), (std::vector<int>{0, 1, 2, 4}));
+    EXPECT_EQ(active.Size(), 4);
+}
+
+TEST_F(ICBIntrusiveListFixture, SpliceAll)
+{
+    icb::IntrusiveList<Timer, ActiveTag> other;
+    for (int i = 0; i < 3; ++i)
+    {
+        active.PushBack(*timers[i]);
+        other.PushBack(*timers[i + 3]);
+    }
+
+    active.Splice(std::next(active.begin()), other);
+    EXPECT_EQ(Ids(active), (std::vector<int>{0, 3, 4, 5, 1, 2}));
+    EXPECT_TRUE(other.Empty());
+    EXPECT_EQ(other.Size(), 0);
+    EXPECT_EQ(active.Size(), 6);
+
+    active.Splice(active.end(), other);
+    EXPECT_EQ(active.Size(), 6);
+}
+
+TEST_F(ICBIntrusiveListFixture, Move)
+{
+    for (int i = 0; i < 3; ++i)
+    {
+        active.PushBack(*timers[i]);
+    }
+
+    icb::IntrusiveList<Timer, ActiveTag> moved(std::move(active));
+    EXPECT_EQ(Ids(moved), (std::vector<int>{0, 1, 2}));
+    EXPECT_TRUE(active.Empty());
+
+    active.PushBack(*timers[3]);
+    active = std::move(moved);
+    EXPECT_EQ(Ids(active), (std::vector<int>{0, 1, 2}));
+    EXPECT_FALSE(timers[3]->icb::ListHook<ActiveTag>::IsLinked());
+}
+
+TEST_F(ICBIntrusiveListFixture, ClearUnlinks)
+{
+    for (auto &timer : timers)
+    {
+        active.PushBack(*timer);
+    }
+
+    active.Clear();
+    EXPECT_TRUE(active.Empty());
+    for (auto &timer : timers)
+    {
+        EXPECT_FALSE(timer->icb::ListHook<ActiveTag>::IsLinked());
+    }
+}
+
+TEST_F(ICBIntrusiveListFixture, CopiedElementIsUnlinked)
+{
+    active.PushBack(*timers[0]);
+
+    Timer copy(*timers[0]);
+    EXPECT_FALSE(copy.icb::ListHook<ActiveTag>::IsLinked());
+
+    *timers[0] = copy;
+    EXPECT_TRUE(timers[0]->icb::ListHook<ActiveTag>::IsLinked());
+    EXPECT_EQ(active.Size(), 1);
+}
+
+TEST(ICBIntrusiveList, AutoUnlink)
+{
+    icb::IntrusiveList<Connection> list;
+    Connection first(1);
+    list.PushBack(first);
+    {
+        Connection second(2);
+        Connection third(3);
+        list.PushBack(second);
+        list.PushBack(third);
+        EXPECT_EQ(list.Size(), 3);
+
+        third.Unlink();
+        EXPECT_FALSE(third.IsLinked());
+        EXPECT_EQ(list.Size(), 2);
+    }
+
+    // second left the list when it was destroyed
+    EXPECT_EQ(list.Size(), 1);
+    EXPECT_EQ(list.Front().id, 1);
+    EXPECT_EQ(&list.Back(), &first);
+}
+
+TEST(ICBIntrusiveList, AutoUnlinkOutlivesList)
+{
+    Connection connection(1);
+    {
+        icb::IntrusiveList<Connection> list;
+        list.PushBack(connection);
+    }
+    EXPECT_FALSE(connection.IsLinked());
+}
@@ -1,7 +1,11 @@
 #include "icb/linkedlist.h"
+#include <algorithm>
+#include <functional>
 #include <list>
+#include <stdexcept>
 #include <string>
 #include <type_traits>
+#include <vector>
 
 #include "common_test_setup.h"
 
@@ -35,6 +39,11 @@ class ICBLinkedListDoubleFixture : public ICBTestFixture
     icb::LinkedList<double> list;
 };
 
+template <typename T, typename Allocator> static std::vector<T> Elements(const icb::LinkedList<T, Allocator> &list)
+{
+    return std::vector<T>(list.begin(), list.end());
+}
+
 // ---
 
 TEST_F(ICBLinkedListIntFixture, Clear)
@@ -237,3 +246,368 @@ TEST_F(ICBLinkedListStringFixture, ConstIterator)
         EXPECT_EQ(it, expected[i++]);
     }
 }
+
+TEST_F(ICBLinkedListIntFixture, ReusesFreedNodes)
+{
+    list = {1, 2, 3};
+    const int *first = &list.Front();
+
+    list.PopFront();
+    list.PushBack(4);
+    EXPECT_EQ(&list.Back(), first);
+
+    list.Clear();
+    list.PushBack(5);
+    EXPECT_EQ(list.Size(), 1);
+    EXPECT_EQ(list.Front(), 5);
+
+    list.ShrinkToFit();
+    list.PushBack(6);
+    EXPECT_EQ(list.Back(), 6);
+}
+
+TEST_F(ICBLinkedListIntFixture, MoveEmptyList)
+{
+    icb::LinkedList<int> moved(std::move(list));
+    EXPECT_TRUE(moved.Empty());
+    EXPECT_EQ(moved.begin(), moved.end());
+
+    moved.PushBack(1);
+    list.PushBack(2);
+    EXPECT_EQ(moved.Front(), 1);
+    EXPECT_EQ(list.Front(), 2);
+}
+
+TEST_F(ICBLinkedListStringFixture, SharedPool)
+{
+    icb::LinkedList<std::string>::Pool pool;
+    {
+        icb::LinkedList<std::string> a(pool);
+        icb::LinkedList<std::string> b(pool);
+
+        for (int i = 0; i < 100; ++i)
+        {
+            a.PushBack(std::to_string(i));
+            b.EmplaceFront(3, 'x');
+        }
+        EXPECT_EQ(pool.InUse(), 200);
+        EXPECT_LT(pool.BlockCount(), 10);
+
+        a.Splice(a.begin(), b, b.begin());
+        EXPECT_EQ(a.Front(), "xxx");
+        EXPECT_EQ(a.Size(), 101);
+
+        // a copy allocates from the same pool
+        icb::LinkedList<std::string> copy = a;
+        EXPECT_EQ(copy.GetPool(), &pool);
+        EXPECT_EQ(pool.InUse(), 301);
+
+        // freed nodes go back to the pool and are handed out again before any new block
+        const size_t slots = pool.SlotCount();
+        copy.Clear();
+        for (int i = 0; i < 101; ++i)
+        {
+            b.PushBack("y");
+        }
+        EXPECT_EQ(pool.SlotCount(), slots);
+
+        // a list with its own nodes can't adopt pooled ones, so they are moved one by one
+        list = std::move(a);
+        EXPECT_EQ(list.Size(), 101);
+        EXPECT_EQ(list.Back(), "99");
+        EXPECT_TRUE(a.Empty());
+    }
+    EXPECT_EQ(pool.InUse(), 0);
+}
+
+TEST_F(ICBLinkedListIntFixture, SpliceOneWithinList)
+{
+    list = {1, 2, 3, 4};
+
+    list.Splice(list.end(), list, list.begin());
+    EXPECT_EQ(Elements(list), (std::vector<int>{2, 3, 4, 1}));
+
+    // before itself or before its successor is a no-op
+    list.Splice(list.begin(), list, list.begin());
+    list.Splice(std::next(list.begin()), list, list.begin());
+    EXPECT_EQ(Elements(list), (std::vector<int>{2, 3, 4, 1}));
+    EXPECT_EQ(list.Size(), 4);
+}
+
+TEST_F(ICBLinkedListIntFixture, SpliceAll)
+{
+    list = {1, 4};
+    icb::LinkedList<int> other = {2, 3};
+    const int *two = &other.Front();
+
+    list.Splice(std::next(list.begin()), other);
+    EXPECT_EQ(Elements(list), (std::vector<int>{1, 2, 3, 4}));
+    EXPECT_EQ(list.Size(), 4);
+    EXPECT_TRUE(other.Empty());
+    EXPECT_EQ(other.begin(), other.end());
+    EXPECT_EQ(&*std::next(list.begin()), two);
+
+    list.Splice(list.begin(), other);
+    EXPECT_EQ(list.Size(), 4);
+
+    other.PushBack(5);
+    EXPECT_EQ(Elements(other), (std::vector<int>{5}));
+}
+
+TEST_F(ICBLinkedListIntFixture, SpliceRange)
+{
+    list = {1, 2, 3};
+    icb::LinkedList<int> other = {4, 5, 6, 7};
+
+    list.Splice(list.end(), other, std::next(other.begin()), std::prev(other.end()));
+    EXPECT_EQ(Elements(list), (std::vector<int>{1, 2, 3, 5, 6}));
+    EXPECT_EQ(Elements(other), (std::vector<int>{4, 7}));
+    EXPECT_EQ(list.Size(), 5);
+    EXPECT_EQ(other.Size(), 2);
+
+    list.Splice(list.begin(), other, other.begin(), other.end(), 2);
+    EXPECT_EQ(Elements(list), (std::vector<int>{4, 7, 1, 2, 3, 5, 6}));
+    EXPECT_TRUE(other.Empty());
+
+    // within one list the size doesn't change
+    list.Splice(list.begin(), list, std::next(list.begin(), 2), std::next(list.begin(), 5));
+    EXPECT_EQ(Elements(list), (std::vector<int>{1, 2, 3, 4, 7, 5, 6}));
+    EXPECT_EQ(list.Size(), 7);
+
+    list.Splice(list.end(), list, list.begin(), list.begin());
+    EXPECT_EQ(list.Size(), 7);
+}
+
+TEST_F(ICBLinkedListIntFixture, Merge)
+{
+    list = {1, 3, 5, 7};
+    icb::LinkedList<int> other = {0, 2, 3, 8, 9};
+
+    list.Merge(other);
+    EXPECT_EQ(Elements(list), (std::vector<int>{0, 1, 2, 3, 3, 5, 7, 8, 9}));
+    EXPECT_EQ(list.Size(), 9);
+    EXPECT_TRUE(other.Empty());
+
+    // into an empty list, with a comparator
+    other = {9, 4};
+    icb::LinkedList<int> empty;
+    empty.Merge(other, std::greater<>());
+    EXPECT_EQ(Elements(empty), (std::vector<int>{9, 4}));
+    EXPECT_EQ(std::prev(empty.end()), std::next(empty.begin()));
+}
+
+TEST_F(ICBLinkedListIntFixture, MergeIsStable)
+{
+    icb::LinkedList<std::pair<int, char>> a = {{1, 'a'}, {2, 'a'}};
+    icb::LinkedList<std::pair<int, char>> b = {{1, 'b'}, {2, 'b'}};
+
+    a.Merge(b, [](const auto &x, const auto &y) { return x.first < y.first; });
+    std::vector<std::pair<int, char>> expected = {{1, 'a'}, {1, 'b'}, {2, 'a'}, {2, 'b'}};
+    EXPECT_EQ(Elements(a), expected);
+}
+
+TEST_F(ICBLinkedListIntFixture, Sort)
+{
+    list.Sort();
+    EXPECT_TRUE(list.Empty());
+
+    std::vector<int> values;
+    for (int i = 0; i < 1000; ++i)
+    {
+        values.push_back((i * 7919) % 1013 - 500);
+    }
+    list = icb::LinkedList<int>(values.begin(), values.end());
+
+    std::vector<const int *> addresses;
+    for (const int &value : list)
+    {
+        addresses.push_back(&value);
+    }
+
+    list.Sort();
+    std::sort(values.begin(), values.end());
+    EXPECT_EQ(Elements(list), values);
+    EXPECT_EQ(list.Size(), values.size());
+
+    // the nodes were relinked, not rebuilt
+    std::vector<const int *> sortedAddresses;
+    for (const int &value : list)
+    {
+        sortedAddresses.push_back(&value);
+    }
+    std::sort(addresses.begin(), addresses.end());
+    std::sort(sortedAddresses.begin(), sortedAddresses.end());
+    EXPECT_EQ(addresses, sortedAddresses);
+
+    // the prev links are right too
+    std::vector<int> backwards(std::make_reverse_iterator(list.end()), std::make_reverse_iterator(list.begin()));
+    std::reverse(values.begin(), values.end());
+    EXPECT_EQ(backwards, values);
+
+    list.Sort(std::greater<>());
+    EXPECT_EQ(Elements(list), values);
+}
+
+TEST_F(ICBLinkedListStringFixture, SortIsStable)
+{
+    list = {"pear", "fig", "apple", "kiwi", "plum", "date", "lime", "banana"};
+    list.Sort([](const std::string &a, const std::string &b) { return a.size() < b.size(); });
+    EXPECT_EQ(Elements(list),
+              (std::vector<std::string>{"fig", "pear", "kiwi", "plum", "date", "lime", "apple", "banana"}));
+}
+
+// orders strings by length, and throws on the comparison after the first throwAfter
+struct ThrowingLengthLess
+{
+    int *calls;
+    int throwAfter;
+
+    bool operator()(const std::string &a, const std::string &b) const
+    {
+        if ((*calls)++ == throwAfter)
+        {
+            throw std::runtime_error("compare");
+        }
+        return a.size() < b.size();
+    }
+};
+
+// the elements walked forwards, checked against a walk backwards over the prev links
+static std::vector<std::string> LinkedElements(const icb::LinkedList<std::string> &list)
+{
+    std::vector<std::string> forwards(list.begin(), list.end());
+    std::vector<std::string> backwards;
+    for (auto it = list.end(); it != list.begin();)
+    {
+        backwards.push_back(*--it);
+    }
+    std::reverse(backwards.begin(), backwards.end());
+    EXPECT_EQ(forwards, backwards);
+    EXPECT_EQ(forwards.size(), list.Size());
+    return forwards;
+}
+
+TEST_F(ICBLinkedListStringFixture, SortKeepsElementsWhenComparatorThrows)
+{
+    std::vector<std::string> values;
+    for (int i = 0; i < 100; ++i)
+    {
+        values.push_back(std::string(static_cast<size_t>((i * 37) % 23), 'x') + std::to_string(i));
+    }
+
+    // throws in the first merges, in the middle and while merging the bins at the end
+    for (int throwAfter : {0, 1, 5, 100, 300, 450})
+    {
+        list = icb::LinkedList<std::string>(values.begin(), values.end());
+        int calls = 0;
+        EXPECT_THROW(list.Sort(ThrowingLengthLess{&calls, throwAfter}), std::runtime_error);
+        EXPECT_TRUE(std::is_permutation(values.begin(), values.end(), LinkedElements(list).begin()));
+    }
+}
+
+TEST_F(ICBLinkedListStringFixture, MergeKeepsElementsWhenComparatorThrows)
+{
+    const std::vector<std::string> a = {"a", "ccc", "eeeee", "ggggggg"};
+    const std::vector<std::string> b = {"bb", "dddd", "ffffff", "hhhhhhhh"};
+
+    for (int throwAfter : {0, 3, 6})
+    {
+        list = icb::LinkedList<std::string>(a.begin(), a.end());
+        icb::LinkedList<std::string> other(b.begin(), b.end());
+        int calls = 0;
+        EXPECT_THROW(list.Merge(other, ThrowingLengthLess{&calls, throwAfter}), std::runtime_error);
+
+        std::vector<std::string> all = a;
+        all.insert(all.end(), b.begin(), b.end());
+        EXPECT_TRUE(std::is_permutation(all.begin(), all.end(), LinkedElements(list).begin()));
+        EXPECT_TRUE(other.Empty());
+        EXPECT_EQ(other.begin(), other.end());
+    }
+}
+
+TEST_F(ICBLinkedListIntFixture, Unique)
+{
+    list = {1, 1, 2, 3, 3, 3, 1, 4, 4};
+    EXPECT_EQ(list.Unique(), 4);
+    EXPECT_EQ(Elements(list), (std::vector<int>{1, 2, 3, 1, 4}));
+
+    list = {1, 2, 4, 5, 7};
+    EXPECT_EQ(list.Unique([](int a, int b) { return b - a == 1; }), 2);
+    EXPECT_EQ(Elements(list), (std::vector<int>{1, 4, 7}));
+    EXPECT_EQ(list.Back(), 7);
+}
+
+TEST_F(ICBLinkedListIntFixture, RemoveIf)
+{
+    list = {1, 2, 3, 4, 5, 6};
+    EXPECT_EQ(list.RemoveIf([](int value) { return value % 2 == 0; }), 3);
+    EXPECT_EQ(Elements(list), (std::vector<int>{1, 3, 5}));
+
+    EXPECT_EQ(list.RemoveIf([](int) { return true; }), 3);
+    EXPECT_TRUE(list.Empty());
+}
+
+TEST(ICBLinkedList, AllocatesFromResource)
+{
+    CountingResource resource;
+    {
+        icb::pmr::LinkedList<int> a(&resource);
+        icb::pmr::LinkedList<int> b({4, 5, 6}, &resource);
+        for (int i = 0; i < 3; ++i)
+        {
+            a.PushBack(i);
+        }
+        EXPECT_EQ(resource.allocations, 6);
+
+        // same resource, so nodes can move between the lists
+        a.Splice(a.end(), b);
+        a.PopFront();
+        a.EmplaceFront(0);
+        EXPECT_EQ(Elements(a), (std::vector<int>{0, 1, 2, 4, 5, 6}));
+        EXPECT_EQ(resource.allocations, 6);
+
+        CountingResource other;
+        icb::pmr::LinkedList<int> elsewhere(&other);
+        elsewhere = std::move(a);
+        EXPECT_EQ(Elements(elsewhere), (std::vector<int>{0, 1, 2, 4, 5, 6}));
+        EXPECT_EQ(other.allocations, 6);
+        EXPECT_TRUE(a.Empty());
+
+        elsewhere.Clear();
+        elsewhere.ShrinkToFit();
+        EXPECT_EQ(other.bytesInUse, 0);
+    }
+    EXPECT_EQ(resource.bytesInUse, 0);
+
+    // an arena that is never freed node by node
+    std::pmr::monotonic_buffer_resource arena;
+    icb::pmr::LinkedList<std::string> strings(&arena);
+    strings.EmplaceBack(10, 'a');
+    strings.Sort();
+    EXPECT_EQ(strings.Front(), std::string(10, 'a'));
+}
+
+TEST(ICBNodePool, BlocksGrow)
+{
+    icb::NodePool<24, 8> pool;
+    std::vector<void *> nodes;
+    for (int i = 0; i < NP_FIRST_BLOCK_NODES * 3; ++i)
+    {
+        nodes.push_back(pool.Allocate());
+    }
+
+    EXPECT_EQ(pool.BlockCount(), 2);
+    EXPECT_EQ(pool.SlotCount(), NP_FIRST_BLOCK_NODES * 3);
+    EXPECT_EQ(static_cast<char *>(nodes[1]) - static_cast<char *>(nodes[0]), pool.SlotSize());
+
+    pool.Deallocate(nodes[5]);
+    EXPECT_EQ(pool.Allocate(), nodes[5]);
+
+    for (void *node : nodes)
+    {
+        pool.Deallocate(node);
+    }
+    EXPECT_EQ(pool.InUse(), 0);
+    pool.Release();
+    EXPECT_EQ(pool.BlockCount(), 0);
+}
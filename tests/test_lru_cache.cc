@@ -0,0 +1,178 @@
+#include "icb/lru_cache.h"
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common_test_setup.h"
+
+class ICBLRUCacheTestFixture : public ICBTestFixture
+{
+  protected:
+    icb::LRUCache<std::string, int> cache{3};
+};
+
+class ICBLRUCacheIntTestFixture : public ICBTestFixture
+{
+  protected:
+    icb::LRUCache<int, int> cache{100};
+};
+
+static std::vector<std::string> Keys(const icb::LRUCache<std::string, int> &cache)
+{
+    std::vector<std::string> keys;
+    for (const auto &[key, value] : cache)
+    {
+        keys.push_back(key);
+    }
+    return keys;
+}
+
+TEST_F(ICBLRUCacheTestFixture, EmptyCache)
+{
+    EXPECT_TRUE(cache.Empty());
+    EXPECT_EQ(cache.Size(), 0);
+    EXPECT_EQ(cache.Capacity(), 3);
+    EXPECT_EQ(cache.Get("apple"), nullptr);
+}
+
+TEST_F(ICBLRUCacheTestFixture, PutAndGet)
+{
+    EXPECT_TRUE(cache.Put("apple", 1).second);
+    EXPECT_TRUE(cache.Put("banana", 2).second);
+
+    auto [value, inserted] = cache.Put("apple", 10);
+    EXPECT_FALSE(inserted);
+    EXPECT_EQ(*value, 10);
+
+    EXPECT_EQ(*cache.Get("apple"), 10);
+    EXPECT_EQ(*cache.Get("banana"), 2);
+    EXPECT_EQ(cache.Size(), 2);
+    EXPECT_TRUE(cache.Contains("apple"));
+}
+
+TEST_F(ICBLRUCacheTestFixture, EvictsLeastRecentlyUsed)
+{
+    cache.Put("a", 1);
+    cache.Put("b", 2);
+    cache.Put("c", 3);
+    EXPECT_EQ(Keys(cache), (std::vector<std::string>{"c", "b", "a"}));
+
+    // a hit makes "a" the most recent, so "b" goes
+    cache.Get("a");
+    cache.Put("d", 4);
+    EXPECT_EQ(Keys(cache), (std::vector<std::string>{"d", "a", "c"}));
+    EXPECT_FALSE(cache.Contains("b"));
+    EXPECT_EQ(cache.Oldest().first, "c");
+
+    // assigning counts as a use too
+    cache.Put("c", 30);
+    cache.Put("e", 5);
+    EXPECT_EQ(Keys(cache), (std::vector<std::string>{"e", "c", "d"}));
+    EXPECT_EQ(*cache.Get("c"), 30);
+    EXPECT_EQ(cache.Size(), 3);
+}
+
+TEST_F(ICBLRUCacheTestFixture, PeekKeepsOrder)
+{
+    cache.Put("a", 1);
+    cache.Put("b", 2);
+    cache.Put("c", 3);
+
+    EXPECT_EQ(*cache.Peek("a"), 1);
+    EXPECT_EQ(cache.Peek("z"), nullptr);
+    cache.Put("d", 4);
+    EXPECT_FALSE(cache.Contains("a"));
+}
+
+TEST_F(ICBLRUCacheTestFixture, EraseAndClear)
+{
+    cache.Put("a", 1);
+    cache.Put("b", 2);
+    cache.Put("c", 3);
+
+    cache.Erase("b");
+    cache.Erase("missing");
+    EXPECT_EQ(Keys(cache), (std::vector<std::string>{"c", "a"}));
+
+    cache.Put("d", 4);
+    cache.Put("e", 5);
+    EXPECT_EQ(Keys(cache), (std::vector<std::string>{"e", "d", "c"}));
+
+    cache.Clear();
+    EXPECT_TRUE(cache.Empty());
+    cache.Put("a", 1);
+    EXPECT_EQ(*cache.Get("a"), 1);
+}
+
+TEST_F(ICBLRUCacheIntTestFixture, ValuesStayPutOnHits)
+{
+    for (int i = 0; i < 100; ++i)
+    {
+        cache.Put(i, i);
+    }
+
+    int *value = cache.Get(0);
+    for (int i = 1; i < 100; ++i)
+    {
+        cache.Get(i);
+    }
+    EXPECT_EQ(cache.Get(0), value);
+    EXPECT_EQ(cache.Oldest().first, 1);
+}
+
+TEST_F(ICBLRUCacheIntTestFixture, MatchesReferenceModel)
+{
+    // the recency order kept as a plain vector, most recent first
+    std::vector<int> model;
+    uint32_t state = 12345;
+
+    for (int i = 0; i < 20000; ++i)
+    {
+        state = state * 1664525u + 1013904223u;
+        const int key = static_cast<int>((state >> 8) % 300);
+        auto found = std::find(model.begin(), model.end(), key);
+
+        if ((state >> 4) % 2)
+        {
+            ASSERT_EQ(cache.Get(key) != nullptr, found != model.end());
+            if (found != model.end())
+            {
+                model.erase(found);
+                model.insert(model.begin(), key);
+            }
+        }
+        else
+        {
+            cache.Put(key, i);
+            if (found != model.end())
+            {
+                model.erase(found);
+            }
+            else if (model.size() == 100)
+            {
+                model.pop_back();
+            }
+            model.insert(model.begin(), key);
+        }
+    }
+
+    std::vector<int> keys;
+    for (const auto &[key, value] : cache)
+    {
+        keys.push_back(key);
+    }
+    EXPECT_EQ(keys, model);
+}
+
+TEST_F(ICBLRUCacheIntTestFixture, MoveOnlyValues)
+{
+    icb::LRUCache<int, std::unique_ptr<int>> owned(2);
+    owned.Put(1, std::make_unique<int>(1));
+    owned.Put(2, std::make_unique<int>(2));
+    owned.Put(3, std::make_unique<int>(3));
+
+    EXPECT_EQ(owned.Get(1), nullptr);
+    EXPECT_EQ(**owned.Get(3), 3);
+}
@@ -0,0 +1,162 @@
+#include "icb/hash_table.h"
+#include "icb/mapped_hash_table.h"
+
+#include <cstdio>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "common_test_setup.h"
+
+class ICBMappedHashTableTestFixture : public ICBTestFixture
+{
+  protected:
+    void TearDown() override
+    {
+        std::filesystem::remove(path);
+        ICBTestFixture::TearDown();
+    }
+
+    std::string path = (std::filesystem::temp_directory_path() / "icb_mapped_hashtable_test.bin").string();
+};
+
+TEST_F(ICBMappedHashTableTestFixture, EmptyTable)
+{
+    icb::HashTable<int, int> table;
+    icb::MappedHashTable<int, int>::Write(table, path);
+
+    icb::MappedHashTable<int, int> mapped(path);
+    EXPECT_TRUE(mapped.Empty());
+    EXPECT_EQ(mapped.Size(), 0);
+    EXPECT_EQ(mapped.Find(1), std::nullopt);
+    EXPECT_FALSE(mapped.Contains(1));
+}
+
+TEST_F(ICBMappedHashTableTestFixture, IntKeysAndValues)
+{
+    icb::HashTable<int, int> table;
+    for (int i = 0; i < 10000; ++i)
+    {
+        table.Insert(i * 7, i);
+    }
+    icb::MappedHashTable<int, int>::Write(table, path);
+
+    icb::MappedHashTable<int, int> mapped(path);
+    ASSERT_EQ(mapped.Size(), 10000);
+    for (int i = 0; i < 10000; ++i)
+    {
+        ASSERT_EQ(mapped.Find(i * 7), i);
+        ASSERT_FALSE(mapped.Contains(i * 7 + 1));
+    }
+
+    const int *value = mapped.FindPtr(700);
+    ASSERT_NE(value, nullptr);
+    EXPECT_EQ(*value, 100);
+    EXPECT_EQ(mapped.FindPtr(701), nullptr);
+}
+
+TEST_F(ICBMappedHashTableTestFixture, StringKeysAndValues)
+{
+    icb::HashTable<std::string, std::string> table{{"apple", "red"}, {"banana", "yellow"}, {"", "empty key"}};
+    table.Insert("lime", "");
+    icb::MappedHashTable<std::string, std::string>::Write(table, path);
+
+    icb::MappedHashTable<std::string, std::string> mapped(path);
+    EXPECT_EQ(mapped.Size(), 4);
+    EXPECT_EQ(mapped.Find("apple"), "red");
+    EXPECT_EQ(mapped.Find(std::string("banana")), "yellow");
+    EXPECT_EQ(mapped.Find(std::string_view("")), "empty key");
+    EXPECT_EQ(mapped.Find("lime"), "");
+    EXPECT_EQ(mapped.Find("cherry"), std::nullopt);
+    EXPECT_TRUE(mapped.Contains("banana"));
+    EXPECT_FALSE(mapped.Contains("apples"));
+}
+
+TEST_F(ICBMappedHashTableTestFixture, WriteRange)
+{
+    std::vector<std::pair<std::string, double>> pairs{{"pi", 3.14}, {"e", 2.72}};
+    icb::MappedHashTable<std::string, double>::Write(pairs.begin(), pairs.end(), path);
+
+    icb::MappedHashTable<std::string, double> mapped(path);
+    EXPECT_EQ(mapped.Find("pi"), 3.14);
+    EXPECT_EQ(mapped.Find("e"), 2.72);
+
+    // moving hands over the mapping, the source is left empty
+    icb::MappedHashTable<std::string, double> moved(std::move(mapped));
+    EXPECT_EQ(moved.Find("pi"), 3.14);
+    EXPECT_EQ(mapped.Size(), 0);
+    EXPECT_EQ(mapped.Find("pi"), std::nullopt);
+
+    mapped = std::move(moved);
+    EXPECT_EQ(mapped.Find("e"), 2.72);
+    EXPECT_TRUE(moved.Empty());
+    EXPECT_FALSE(moved.Contains("e"));
+}
+
+#if !defined(_WIN32)
+TEST_F(ICBMappedHashTableTestFixture, RewriteKeepsExistingMappings)
+{
+    icb::HashTable<int, int> table;
+    for (int i = 0; i < 1000; ++i)
+    {
+        table.Insert(i, i);
+    }
+    icb::MappedHashTable<int, int>::Write(table, path);
+    icb::MappedHashTable<int, int> old(path);
+
+    // a smaller table, truncating the mapped file in place would cut the old mapping short
+    icb::HashTable<int, int> replacement{{1, -1}};
+    icb::MappedHashTable<int, int>::Write(replacement, path);
+
+    EXPECT_EQ(old.Size(), 1000);
+    for (int i = 0; i < 1000; ++i)
+    {
+        ASSERT_EQ(old.Find(i), i);
+    }
+    icb::MappedHashTable<int, int> current(path);
+    EXPECT_EQ(current.Size(), 1);
+    EXPECT_EQ(current.Find(1), -1);
+
+    // no temporary files left next to it
+    const std::filesystem::path file(path);
+    for (const auto &entry : std::filesystem::directory_iterator(file.parent_path()))
+    {
+        EXPECT_EQ(entry.path().filename().string().rfind(file.filename().string() + ".tmp", 0), std::string::npos);
+    }
+}
+#endif
+
+TEST_F(ICBMappedHashTableTestFixture, RejectsInvalidFiles)
+{
+    EXPECT_THROW((icb::MappedHashTable<int, int>(path)), std::runtime_error);
+
+    std::FILE *file = std::fopen(path.c_str(), "wb");
+    ASSERT_NE(file, nullptr);
+    std::fputs("definitely not a table file, but long enough to hold a header of sixty-four bytes or more", file);
+    std::fclose(file);
+    EXPECT_THROW((icb::MappedHashTable<int, int>(path)), std::runtime_error);
+
+    // written for other types
+    icb::HashTable<int, int> table{{1, 2}};
+    icb::MappedHashTable<int, int>::Write(table, path);
+    EXPECT_THROW((icb::MappedHashTable<int, std::string>(path)), std::runtime_error);
+    EXPECT_EQ((icb::MappedHashTable<int, int>(path).Find(1)), 2);
+
+    // counts large enough that their size in bytes wraps around
+    auto patchHeader = [&](long offset, uint64_t value) {
+        icb::MappedHashTable<int, int>::Write(table, path);
+        std::FILE *patched = std::fopen(path.c_str(), "r+b");
+        ASSERT_NE(patched, nullptr);
+        std::fseek(patched, offset, SEEK_SET);
+        std::fwrite(&value, sizeof(value), 1, patched);
+        std::fclose(patched);
+    };
+    const long countOffset = 40, bucketCountOffset = 48;
+    patchHeader(countOffset, uint64_t(1) << 60);
+    EXPECT_THROW((icb::MappedHashTable<int, int>(path)), std::runtime_error);
+    patchHeader(bucketCountOffset, uint64_t(1) << 62);
+    EXPECT_THROW((icb::MappedHashTable<int, int>(path)), std::runtime_error);
+}
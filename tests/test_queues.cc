@@ -0,0 +1,264 @@
+#include "icb/mpmc_queue.h"
+#include "icb/spsc_queue.h"
+
+#include <atomic>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "common_test_setup.h"
+
+class ICBSPSCQueueTestFixture : public ICBTestFixture
+{
+  protected:
+    icb::SPSCQueue<std::string> queue{8};
+};
+
+class ICBMPMCQueueTestFixture : public ICBTestFixture
+{
+  protected:
+    icb::MPMCQueue<std::string> queue{8};
+};
+
+TEST_F(ICBSPSCQueueTestFixture, PushPopInOrder)
+{
+    EXPECT_TRUE(queue.Empty());
+    EXPECT_FALSE(queue.TryPop());
+
+    EXPECT_TRUE(queue.TryPush("a"));
+    std::string b = "b";
+    EXPECT_TRUE(queue.TryPush(b));
+    EXPECT_TRUE(queue.TryEmplace(3, 'c'));
+    EXPECT_EQ(queue.Size(), 3);
+
+    EXPECT_EQ(queue.TryPop(), "a");
+    EXPECT_EQ(queue.TryPop(), "b");
+    EXPECT_EQ(queue.TryPop(), "ccc");
+    EXPECT_FALSE(queue.TryPop());
+}
+
+TEST_F(ICBSPSCQueueTestFixture, FullAndWrapAround)
+{
+    EXPECT_EQ(queue.Capacity(), 8);
+    EXPECT_EQ(icb::SPSCQueue<int>(5).Capacity(), 8);
+
+    for (int round = 0; round < 5; ++round)
+    {
+        for (int i = 0; i < 8; ++i)
+        {
+            ASSERT_TRUE(queue.TryPush(std::to_string(round * 8 + i)));
+        }
+        EXPECT_FALSE(queue.TryPush("full"));
+
+        for (int i = 0; i < 8; ++i)
+        {
+            ASSERT_EQ(queue.TryPop(), std::to_string(round * 8 + i));
+        }
+    }
+    EXPECT_TRUE(queue.Empty());
+}
+
+TEST_F(ICBSPSCQueueTestFixture, Batches)
+{
+    std::vector<std::string> input = {"0", "1", "2", "3", "4", "5", "6", "7", "8", "9"};
+    EXPECT_EQ(queue.PushBatch(input.begin(), input.end()), 8);
+    EXPECT_EQ(queue.PushBatch(input.begin(), input.end()), 0);
+
+    std::vector<std::string> output;
+    EXPECT_EQ(queue.PopBatch(std::back_inserter(output), 3), 3);
+    EXPECT_EQ(output, std::vector<std::string>(input.begin(), input.begin() + 3));
+
+    // moved in, only as many as fit
+    EXPECT_EQ(queue.PushBatch(std::make_move_iterator(input.begin() + 8), std::make_move_iterator(input.end())), 2);
+    EXPECT_EQ(queue.PopBatch(std::back_inserter(output), 100), 7);
+    EXPECT_EQ(output, (std::vector<std::string>{"0", "1", "2", "3", "4", "5", "6", "7", "8", "9"}));
+    EXPECT_TRUE(queue.Empty());
+}
+
+TEST(ICBSPSCQueue, DestroysLeftovers)
+{
+    auto counter = std::make_shared<int>(0);
+    {
+        icb::SPSCQueue<std::shared_ptr<int>> queue(4);
+        for (int i = 0; i < 6; ++i)
+        {
+            queue.TryPush(counter);
+            queue.TryPop();
+            queue.TryPush(counter);
+        }
+        EXPECT_EQ(counter.use_count(), 5);
+    }
+    EXPECT_EQ(counter.use_count(), 1);
+}
+
+TEST(ICBSPSCQueue, ProducerConsumer)
+{
+    constexpr int count = 200'000;
+    icb::SPSCQueue<int> queue(64);
+
+    std::thread producer([&] {
+        int batch[16];
+        for (int i = 0; i < count;)
+        {
+            if (i % 3 == 0)
+            {
+                // a short batch now and then
+                const int size = std::min(16, count - i);
+                for (int j = 0; j < size; ++j)
+                {
+                    batch[j] = i + j;
+                }
+                i += static_cast<int>(queue.PushBatch(batch, batch + size));
+            }
+            else if (queue.TryPush(i))
+            {
+                ++i;
+            }
+            else
+            {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    int expected = 0;
+    std::vector<int> batch;
+    while (expected < count)
+    {
+        batch.clear();
+        if (queue.PopBatch(std::back_inserter(batch), 10) == 0)
+        {
+            std::this_thread::yield();
+        }
+        for (int value : batch)
+        {
+            ASSERT_EQ(value, expected++);
+        }
+    }
+    producer.join();
+    EXPECT_TRUE(queue.Empty());
+}
+
+TEST_F(ICBMPMCQueueTestFixture, PushPopInOrder)
+{
+    EXPECT_TRUE(queue.Empty());
+    EXPECT_FALSE(queue.TryPop());
+
+    EXPECT_TRUE(queue.TryPush("a"));
+    const std::string b = "b";
+    EXPECT_TRUE(queue.TryPush(b));
+    EXPECT_TRUE(queue.TryEmplace(3, 'c'));
+    EXPECT_EQ(queue.Size(), 3);
+
+    EXPECT_EQ(queue.TryPop(), "a");
+    EXPECT_EQ(queue.TryPop(), "b");
+    EXPECT_EQ(queue.TryPop(), "ccc");
+    EXPECT_FALSE(queue.TryPop());
+}
+
+TEST_F(ICBMPMCQueueTestFixture, FullAndWrapAround)
+{
+    EXPECT_EQ(icb::MPMCQueue<int>(1).Capacity(), 2);
+
+    for (int round = 0; round < 5; ++round)
+    {
+        for (int i = 0; i < 8; ++i)
+        {
+            ASSERT_TRUE(queue.TryPush(std::to_string(round * 8 + i)));
+        }
+
+        // a failed push leaves the value alone
+        std::string full = "full";
+        EXPECT_FALSE(queue.TryPush(std::move(full)));
+        EXPECT_EQ(full, "full");
+
+        for (int i = 0; i < 8; ++i)
+        {
+            ASSERT_EQ(queue.TryPop(), std::to_string(round * 8 + i));
+        }
+    }
+    EXPECT_TRUE(queue.Empty());
+}
+
+TEST(ICBMPMCQueue, DestroysLeftovers)
+{
+    auto counter = std::make_shared<int>(0);
+    {
+        icb::MPMCQueue<std::shared_ptr<int>> queue(4);
+        for (int i = 0; i < 3; ++i)
+        {
+            queue.TryPush(counter);
+        }
+        queue.TryPop();
+        EXPECT_EQ(counter.use_count(), 3);
+    }
+    EXPECT_EQ(counter.use_count(), 1);
+}
+
+TEST(ICBMPMCQueue, ManyProducersManyConsumers)
+{
+    constexpr int producers = 4;
+    constexpr int consumers = 4;
+    constexpr int perProducer = 50'000;
+    icb::MPMCQueue<int> queue(128);
+
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; ++p)
+    {
+        threads.emplace_back([&, p] {
+            for (int i = 0; i < perProducer;)
+            {
+                if (queue.TryPush(p * perProducer + i))
+                {
+                    ++i;
+                }
+                else
+                {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    // every value arrives once, and each producer's values in the order they were pushed
+    std::vector<std::atomic<int>> seen(producers * perProducer);
+    std::atomic<int> popped = 0;
+    std::atomic<bool> ordered = true;
+    for (int c = 0; c < consumers; ++c)
+    {
+        threads.emplace_back([&] {
+            std::vector<int> last(producers, -1);
+            while (popped.load() < producers * perProducer)
+            {
+                std::optional<int> value = queue.TryPop();
+                if (!value)
+                {
+                    std::this_thread::yield();
+                    continue;
+                }
+
+                seen[*value].fetch_add(1);
+                popped.fetch_add(1);
+                if (*value <= last[*value / perProducer])
+                {
+                    ordered = false;
+                }
+                last[*value / perProducer] = *value;
+            }
+        });
+    }
+
+    for (std::thread &thread : threads)
+    {
+        thread.join();
+    }
+
+    EXPECT_TRUE(ordered.load());
+    for (const std::atomic<int> &count : seen)
+    {
+        ASSERT_EQ(count.load(), 1);
+    }
+    EXPECT_TRUE(queue.Empty());
+}
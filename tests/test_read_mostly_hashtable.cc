@@ -0,0 +1,159 @@
+#include "icb/read_mostly_hash_table.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "common_test_setup.h"
+
+class ICBReadMostlyHashTableTestFixture : public ICBTestFixture
+{
+  protected:
+    icb::ReadMostlyHashTable<std::string, int> table;
+};
+
+class ICBReadMostlyHashTableIntTestFixture : public ICBTestFixture
+{
+  protected:
+    icb::ReadMostlyHashTable<int, int> table;
+};
+
+TEST_F(ICBReadMostlyHashTableTestFixture, InsertFindErase)
+{
+    EXPECT_TRUE(table.Empty());
+
+    table.Insert("apple", 5);
+    table.Insert("banana", 10);
+    table.Insert("apple", 50);
+
+    EXPECT_EQ(table.Size(), 2);
+    EXPECT_EQ(table.Find("apple"), 5);
+    EXPECT_EQ(table.Find(std::string_view("banana")), 10);
+    EXPECT_TRUE(table.Contains("banana"));
+    EXPECT_FALSE(table.Contains("cherry"));
+
+    table.Erase("apple");
+    EXPECT_EQ(table.Find("apple"), std::nullopt);
+    EXPECT_EQ(table.Size(), 1);
+}
+
+TEST_F(ICBReadMostlyHashTableTestFixture, InsertOrAssign)
+{
+    EXPECT_TRUE(table.InsertOrAssign("apple", 5));
+    EXPECT_FALSE(table.InsertOrAssign("apple", 6));
+    EXPECT_EQ(table.Find("apple"), 6);
+    EXPECT_EQ(table.Size(), 1);
+}
+
+TEST_F(ICBReadMostlyHashTableTestFixture, Visit)
+{
+    table.Insert("apple", 5);
+
+    int seen = 0;
+    EXPECT_TRUE(table.Visit("apple", [&](const int &value) { seen = value; }));
+    EXPECT_EQ(seen, 5);
+    EXPECT_FALSE(table.Visit("banana", [&](const int &value) { seen = value; }));
+}
+
+TEST_F(ICBReadMostlyHashTableIntTestFixture, GrowthClearAndRehash)
+{
+    for (int i = 0; i < 1000; ++i)
+    {
+        table.Insert(i, i);
+    }
+    EXPECT_GE(table.BucketCount(), 1000);
+
+    table.Rehash(4096);
+    EXPECT_EQ(table.BucketCount(), 4096);
+    for (int i = 0; i < 1000; ++i)
+    {
+        EXPECT_EQ(table.Find(i), i);
+    }
+
+    table.Clear();
+    EXPECT_TRUE(table.Empty());
+    EXPECT_EQ(table.Find(1), std::nullopt);
+
+    icb::EpochManager::Get().Reclaim();
+}
+
+TEST_F(ICBReadMostlyHashTableIntTestFixture, PinnedReaderDelaysReclaim)
+{
+    auto &epochs = icb::EpochManager::Get();
+    epochs.Reclaim();
+    size_t before = epochs.Pending();
+
+    table.Insert(1, 1);
+    {
+        auto guard = epochs.Pin();
+        table.Erase(1);
+
+        epochs.Reclaim();
+        EXPECT_EQ(epochs.Pending(), before + 1);
+    }
+
+    epochs.Reclaim();
+    EXPECT_EQ(epochs.Pending(), before);
+}
+
+TEST_F(ICBReadMostlyHashTableIntTestFixture, ConcurrentReadersWithWriter)
+{
+    constexpr int keyCount = 512;
+    for (int i = 0; i < keyCount; ++i)
+    {
+        table.Insert(i, i);
+    }
+
+    std::atomic<bool> done{false};
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 3; ++t)
+    {
+        readers.emplace_back([&] {
+            while (!done.load())
+            {
+                for (int i = 0; i < keyCount; ++i)
+                {
+                    // even keys are never touched, odd keys only ever hold multiples of themselves
+                    auto value = table.Find(i);
+                    if (i % 2 == 0)
+                    {
+                        ASSERT_EQ(value, i);
+                    }
+                    else if (value)
+                    {
+                        ASSERT_EQ(*value % i, 0);
+                    }
+                }
+            }
+        });
+    }
+
+    // updates, erases and re-inserts of odd keys, plus growth, while the readers run
+    for (int round = 1; round <= 20; ++round)
+    {
+        for (int i = 1; i < keyCount; i += 2)
+        {
+            table.InsertOrAssign(i, i * round);
+        }
+        for (int i = 1; i < keyCount; i += 4)
+        {
+            table.Erase(i);
+        }
+        for (int i = 1; i < keyCount; i += 4)
+        {
+            table.Insert(i, i);
+        }
+        table.Insert(keyCount + round, 0);
+    }
+    table.Rehash(4096);
+
+    done.store(true);
+    for (auto &reader : readers)
+    {
+        reader.join();
+    }
+
+    EXPECT_EQ(table.Size(), keyCount + 20);
+    icb::EpochManager::Get().Reclaim();
+    EXPECT_EQ(icb::EpochManager::Get().Pending(), 0);
+}
@@ -0,0 +1,258 @@
+#include "icb/robin_hood_hash_table.h"
+
+#include <random>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "common_test_setup.h"
+
+class ICBRobinHoodHashTableTestFixture : public ICBTestFixture
+{
+  protected:
+    icb::RobinHoodHashTable<std::string, int> table;
+};
+
+class ICBRobinHoodHashTableIntTestFixture : public ICBTestFixture
+{
+  protected:
+    icb::RobinHoodHashTable<int, int> table;
+};
+
+TEST_F(ICBRobinHoodHashTableTestFixture, EmptyTable)
+{
+    EXPECT_TRUE(table.Empty());
+    EXPECT_EQ(table.Size(), 0);
+    EXPECT_EQ(table.Find("apple"), std::nullopt);
+    EXPECT_EQ(table.begin(), table.end());
+}
+
+TEST_F(ICBRobinHoodHashTableTestFixture, InsertionAndFind)
+{
+    table.Insert("apple", 5);
+    table.Insert("banana", 10);
+    table.Insert("cherry", 15);
+
+    EXPECT_EQ(table.Find("apple"), 5);
+    EXPECT_EQ(table.Find("banana"), 10);
+    EXPECT_EQ(table.Find("cherry"), 15);
+
+    // Test move insertion
+    std::string key = "date";
+    table.Insert(std::move(key), 20);
+    EXPECT_EQ(table.Find("date"), 20);
+    EXPECT_TRUE(key.empty());
+
+    // Test that existing values are not overwritten
+    table.Insert("apple", 50);
+    EXPECT_EQ(table.Find("apple"), 5);
+    EXPECT_EQ(table.Size(), 4);
+}
+
+TEST_F(ICBRobinHoodHashTableTestFixture, Erase)
+{
+    table.Insert("grape", 25);
+    EXPECT_EQ(table.Find("grape"), 25);
+    table.Erase("grape");
+    EXPECT_EQ(table.Find("grape"), std::nullopt);
+    EXPECT_FALSE(table.Contains("grape"));
+
+    // Test erasing a non-existent key
+    table.Erase("fig");
+    EXPECT_EQ(table.Size(), 0);
+}
+
+TEST_F(ICBRobinHoodHashTableTestFixture, Rehash)
+{
+    table.Insert("lemon", 30);
+    table.Insert("mango", 35);
+    table.Insert("orange", 40);
+
+    table.Rehash(200);
+    EXPECT_EQ(table.BucketCount(), 256);
+
+    EXPECT_EQ(table.Find("lemon"), 30);
+    EXPECT_EQ(table.Find("mango"), 35);
+    EXPECT_EQ(table.Find("orange"), 40);
+
+    // never shrinks below what the elements need
+    table.Rehash(1);
+    EXPECT_GE(table.BucketCount(), 4);
+    EXPECT_EQ(table.Find("mango"), 35);
+}
+
+TEST_F(ICBRobinHoodHashTableTestFixture, TryEmplaceAndAssign)
+{
+    auto [value, inserted] = table.TryEmplace("apple", 5);
+    EXPECT_TRUE(inserted);
+    EXPECT_EQ(*value, 5);
+
+    auto [existing, insertedAgain] = table.TryEmplace(std::string_view("apple"), 7);
+    EXPECT_FALSE(insertedAgain);
+    EXPECT_EQ(*existing, 5);
+
+    EXPECT_FALSE(table.InsertOrAssign("apple", 8).second);
+    EXPECT_EQ(table.Find("apple"), 8);
+
+    ++table["banana"];
+    EXPECT_EQ(table.Find(std::string_view("banana")), 1);
+    EXPECT_TRUE(table.Contains("banana"));
+
+    *table.FindPtr("banana") = 3;
+    EXPECT_EQ(table.Find("banana"), 3);
+}
+
+TEST_F(ICBRobinHoodHashTableIntTestFixture, HighLoadFactor)
+{
+    table.MaxLoadFactor(0.95f);
+    table.Rehash(1024);
+
+    for (int i = 0; i < 972; ++i)
+    {
+        table.Insert(i, i);
+    }
+    EXPECT_EQ(table.BucketCount(), 1024);
+    EXPECT_GT(table.LoadFactor(), 0.94f);
+
+    for (int i = 0; i < 972; ++i)
+    {
+        EXPECT_EQ(table.Find(i), i);
+    }
+    for (int i = 972; i < 2000; ++i)
+    {
+        EXPECT_FALSE(table.Contains(i));
+    }
+
+    // 1024 * 0.95 fits 972, one more grows the table
+    table.Insert(972, 972);
+    EXPECT_EQ(table.BucketCount(), 2048);
+}
+
+TEST_F(ICBRobinHoodHashTableIntTestFixture, ChurnMatchesReference)
+{
+    // backward-shift deletion has to keep every remaining cluster reachable
+    table.MaxLoadFactor(0.95f);
+    std::unordered_map<int, int> reference;
+    std::mt19937 rng(7);
+
+    for (int step = 0; step < 20000; ++step)
+    {
+        int key = static_cast<int>(rng() % 600);
+        if (rng() % 2)
+        {
+            table.InsertOrAssign(key, step);
+            reference[key] = step;
+        }
+        else
+        {
+            table.Erase(key);
+            reference.erase(key);
+        }
+    }
+
+    ASSERT_EQ(table.Size(), reference.size());
+    for (int key = 0; key < 600; ++key)
+    {
+        auto it = reference.find(key);
+        if (it == reference.end())
+        {
+            EXPECT_FALSE(table.Contains(key));
+        }
+        else
+        {
+            EXPECT_EQ(table.Find(key), it->second);
+        }
+    }
+}
+
+TEST_F(ICBRobinHoodHashTableIntTestFixture, EraseChurnKeepsCapacity)
+{
+    // no tombstones, so churn never forces a rehash
+    table.Rehash(64);
+    for (int round = 0; round < 1000; ++round)
+    {
+        for (int i = 0; i < 10; ++i)
+        {
+            table.Insert(round * 10 + i, i);
+        }
+        for (int i = 0; i < 10; ++i)
+        {
+            table.Erase(round * 10 + i);
+        }
+    }
+
+    EXPECT_TRUE(table.Empty());
+    EXPECT_EQ(table.BucketCount(), 64);
+    EXPECT_EQ(table.MaxProbeLength(), 0);
+}
+
+TEST_F(ICBRobinHoodHashTableIntTestFixture, Iteration)
+{
+    for (int i = 0; i < 100; ++i)
+    {
+        table.Insert(i, i * 2);
+    }
+
+    std::vector<int> seen(100, 0);
+    for (auto &[key, value] : table)
+    {
+        EXPECT_EQ(value, key * 2);
+        ++seen[key];
+        value = -key;
+    }
+    for (int count : seen)
+    {
+        EXPECT_EQ(count, 1);
+    }
+    EXPECT_EQ(table.Find(42), -42);
+
+    const auto &constTable = table;
+    icb::RobinHoodHashTable<int, int>::ConstIterator it = table.begin();
+    EXPECT_EQ(it, constTable.cbegin());
+    EXPECT_EQ(std::distance(constTable.begin(), constTable.end()), 100);
+}
+
+TEST_F(ICBRobinHoodHashTableTestFixture, CopyAndMove)
+{
+    for (int i = 0; i < 50; ++i)
+    {
+        table.Insert(std::to_string(i), i);
+    }
+
+    icb::RobinHoodHashTable<std::string, int> copy(table);
+    EXPECT_EQ(copy.Size(), 50);
+    EXPECT_EQ(copy.Find("49"), 49);
+
+    copy.Erase("0");
+    EXPECT_EQ(table.Find("0"), 0);
+
+    icb::RobinHoodHashTable<std::string, int> moved(std::move(copy));
+    EXPECT_EQ(moved.Size(), 49);
+    EXPECT_EQ(moved.Find("1"), 1);
+
+    // moved-from table is still usable
+    EXPECT_TRUE(copy.Empty());
+    EXPECT_EQ(copy.Find("1"), std::nullopt);
+    copy.Erase("1");
+    copy.Insert("fresh", 1);
+    EXPECT_EQ(copy.Find("fresh"), 1);
+
+    copy = table;
+    EXPECT_EQ(copy.Size(), 50);
+    moved = std::move(copy);
+    EXPECT_EQ(moved.Find("0"), 0);
+}
+
+TEST_F(ICBRobinHoodHashTableTestFixture, ClearAndInitializerList)
+{
+    icb::RobinHoodHashTable<std::string, int> table2{{"apple", 5}, {"banana", 10}, {"cherry", 15}};
+    EXPECT_EQ(table2.Size(), 3);
+    EXPECT_EQ(table2.Find("banana"), 10);
+
+    table2.Clear();
+    EXPECT_TRUE(table2.Empty());
+    EXPECT_EQ(table2.Find("banana"), std::nullopt);
+
+    table2.Insert("banana", 11);
+    EXPECT_EQ(table2.Find("banana"), 11);
+}
@@ -0,0 +1,172 @@
+#include "icb/small_vector.h"
+
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common_test_setup.h"
+
+class ICBSmallVectorIntTestFixture : public ICBTestFixture
+{
+  protected:
+    icb::SmallVector<int, 4> test_vector;
+};
+
+class ICBSmallVectorStringTestFixture : public ICBTestFixture
+{
+  protected:
+    icb::SmallVector<std::string, 4> test_vector;
+};
+
+template <typename T, size_t N> static std::vector<T> Elements(const icb::SmallVector<T, N> &vector)
+{
+    return std::vector<T>(vector.begin(), vector.end());
+}
+
+TEST_F(ICBSmallVectorIntTestFixture, StaysInlineUpToN)
+{
+    EXPECT_EQ(test_vector.Size(), 0);
+    EXPECT_EQ(test_vector.Capacity(), 4);
+    EXPECT_TRUE(test_vector.IsInline());
+
+    const int *inlineData = test_vector.Data();
+    for (int i = 0; i < 4; ++i)
+    {
+        test_vector.PushBack(i);
+    }
+    EXPECT_TRUE(test_vector.IsInline());
+    EXPECT_EQ(test_vector.Data(), inlineData);
+
+    test_vector.PushBack(4);
+    EXPECT_FALSE(test_vector.IsInline());
+    EXPECT_GT(test_vector.Capacity(), 4);
+    EXPECT_EQ(Elements(test_vector), (std::vector<int>{0, 1, 2, 3, 4}));
+
+    // the heap buffer is kept
+    test_vector.Clear();
+    EXPECT_FALSE(test_vector.IsInline());
+}
+
+TEST_F(ICBSmallVectorIntTestFixture, IteratorsMatchVector)
+{
+    static_assert(std::is_same_v<icb::SmallVector<int, 4>::Iterator, icb::Vector<int>::Iterator>);
+    static_assert(std::random_access_iterator<icb::SmallVector<int, 4>::ConstIterator>);
+
+    test_vector = {5, 3, 1};
+    std::sort(test_vector.begin(), test_vector.end());
+    EXPECT_EQ(Elements(test_vector), (std::vector<int>{1, 3, 5}));
+    EXPECT_EQ(test_vector.end() - test_vector.begin(), 3);
+}
+
+TEST_F(ICBSmallVectorStringTestFixture, GrowsPastInline)
+{
+    for (int i = 0; i < 100; ++i)
+    {
+        test_vector.PushBack(std::to_string(i) + std::string(20, 'x'));
+    }
+    EXPECT_EQ(test_vector.Size(), 100);
+    for (int i = 0; i < 100; ++i)
+    {
+        ASSERT_EQ(test_vector[i], std::to_string(i) + std::string(20, 'x'));
+    }
+
+    // an element of the vector itself, while it reallocates
+    icb::SmallVector<std::string, 2> small = {"a", "b"};
+    small.PushBack(small[0]);
+    small.EmplaceBack(small[2]);
+    EXPECT_EQ(Elements(small), (std::vector<std::string>{"a", "b", "a", "a"}));
+}
+
+TEST_F(ICBSmallVectorStringTestFixture, CopyAndMove)
+{
+    test_vector = {"a", "b"};
+    icb::SmallVector<std::string, 4> copy(test_vector);
+    EXPECT_EQ(Elements(copy), Elements(test_vector));
+
+    // inline elements are moved one by one, and other is left empty
+    icb::SmallVector<std::string, 4> moved(std::move(copy));
+    EXPECT_EQ(Elements(moved), (std::vector<std::string>{"a", "b"}));
+    EXPECT_TRUE(moved.IsInline());
+    EXPECT_EQ(copy.Size(), 0);
+
+    // a heap buffer is stolen
+    icb::SmallVector<std::string, 4> large = {"1", "2", "3", "4", "5", "6"};
+    const std::string *heap = large.Data();
+    moved = std::move(large);
+    EXPECT_EQ(moved.Data(), heap);
+    EXPECT_EQ(moved.Size(), 6);
+    EXPECT_TRUE(large.IsInline());
+    EXPECT_EQ(large.Size(), 0);
+
+    moved = test_vector;
+    EXPECT_EQ(Elements(moved), (std::vector<std::string>{"a", "b"}));
+    large = moved;
+    large.PushBack("c");
+    EXPECT_EQ(Elements(large), (std::vector<std::string>{"a", "b", "c"}));
+
+    moved = moved;
+    EXPECT_EQ(moved.Size(), 2);
+}
+
+TEST_F(ICBSmallVectorIntTestFixture, InsertAndErase)
+{
+    test_vector = {1, 5};
+    test_vector.Insert(test_vector.begin() + 1, 2);
+    std::vector<int> middle = {3, 4};
+    auto it = test_vector.Insert(test_vector.begin() + 2, middle.begin(), middle.end());
+    EXPECT_EQ(*it, 3);
+    test_vector.Emplace(test_vector.begin(), 0);
+    EXPECT_EQ(Elements(test_vector), (std::vector<int>{0, 1, 2, 3, 4, 5}));
+
+    it = test_vector.Erase(test_vector.begin() + 1, test_vector.begin() + 3);
+    EXPECT_EQ(*it, 3);
+    test_vector.Erase(test_vector.end() - 1);
+    EXPECT_EQ(Elements(test_vector), (std::vector<int>{0, 3, 4}));
+}
+
+TEST_F(ICBSmallVectorStringTestFixture, InsertAndErase)
+{
+    test_vector = {"b", "e"};
+    test_vector.Insert(test_vector.begin(), "a");
+    test_vector.Emplace(test_vector.begin() + 2, 1, 'c');
+    std::vector<std::string> middle = {"d"};
+    test_vector.Insert(test_vector.begin() + 3, middle.begin(), middle.end());
+    EXPECT_EQ(Elements(test_vector), (std::vector<std::string>{"a", "b", "c", "d", "e"}));
+
+    test_vector.Erase(test_vector.begin());
+    test_vector.Erase(test_vector.begin() + 1, test_vector.begin() + 3);
+    EXPECT_EQ(Elements(test_vector), (std::vector<std::string>{"b", "e"}));
+}
+
+TEST_F(ICBSmallVectorIntTestFixture, ResizeAndAt)
+{
+    test_vector.Resize(3);
+    EXPECT_EQ(Elements(test_vector), (std::vector<int>{0, 0, 0}));
+    test_vector.Resize(10, 7);
+    EXPECT_EQ(test_vector.At(9), 7);
+    test_vector.Resize(2);
+    EXPECT_EQ(test_vector.Size(), 2);
+    EXPECT_THROW(test_vector.At(2), std::out_of_range);
+
+    test_vector.PopBack();
+    EXPECT_EQ(Elements(test_vector), (std::vector<int>{0}));
+}
+
+TEST(ICBSmallVector, DestroysElements)
+{
+    auto counter = std::make_shared<int>(0);
+    {
+        icb::SmallVector<std::shared_ptr<int>, 2> vector;
+        vector.PushBack(counter);
+        icb::SmallVector<std::shared_ptr<int>, 2> moved(std::move(vector));
+        for (int i = 0; i < 5; ++i)
+        {
+            moved.PushBack(counter);
+        }
+        icb::SmallVector<std::shared_ptr<int>, 2> copy(moved);
+        EXPECT_EQ(counter.use_count(), 13);
+    }
+    EXPECT_EQ(counter.use_count(), 1);
+}
@@ -0,0 +1,161 @@
+#include "icb/static_vector.h"
+
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "common_test_setup.h"
+
+class ICBStaticVectorIntTestFixture : public ICBTestFixture
+{
+  protected:
+    icb::StaticVector<int, 4> test_vector;
+};
+
+class ICBStaticVectorStringTestFixture : public ICBTestFixture
+{
+  protected:
+    icb::StaticVector<std::string, 4> test_vector;
+};
+
+template <typename T, size_t N> static std::vector<T> Elements(const icb::StaticVector<T, N> &vector)
+{
+    return std::vector<T>(vector.begin(), vector.end());
+}
+
+// built and read entirely at compile time
+static constexpr icb::StaticVector<int, 8> Squares(int count)
+{
+    icb::StaticVector<int, 8> squares;
+    for (int i = 0; i < count; ++i)
+    {
+        squares.PushBack(i * i);
+    }
+    squares.Insert(squares.begin(), -1);
+    squares.Erase(squares.begin() + 1);
+    return squares;
+}
+
+// copies squares with its middle element replaced by two
+static constexpr icb::StaticVector<int, 8> Split(const icb::StaticVector<int, 8> &squares)
+{
+    icb::StaticVector<int, 8> split = squares;
+    const int halves[] = {2, 2};
+    split.Insert(split.begin() + 2, halves, halves + 2);
+    split.Erase(split.begin() + 4);
+    return split;
+}
+
+static constexpr int Sum(const icb::StaticVector<int, 8> &vector)
+{
+    int sum = 0;
+    for (int value : vector)
+    {
+        sum += value;
+    }
+    return sum;
+}
+
+TEST_F(ICBStaticVectorIntTestFixture, UsableInConstantExpressions)
+{
+    constexpr icb::StaticVector<int, 8> squares = Squares(5);
+    static_assert(squares.Size() == 5);
+    static_assert(squares[0] == -1 && squares[4] == 16);
+    static_assert(Sum(squares) == -1 + 1 + 4 + 9 + 16);
+    static_assert(Sum(icb::StaticVector<int, 8>{1, 2, 3}) == 6);
+    static_assert(Sum(Split(squares)) == Sum(squares));
+
+    EXPECT_EQ(Elements(squares), (std::vector<int>{-1, 1, 4, 9, 16}));
+}
+
+TEST_F(ICBStaticVectorIntTestFixture, HoldsUpToN)
+{
+    static_assert(sizeof(icb::StaticVector<int, 4>) <= sizeof(size_t) + 4 * sizeof(int));
+    static_assert(std::is_same_v<icb::StaticVector<int, 4>::Iterator, icb::Vector<int>::Iterator>);
+
+    EXPECT_EQ(test_vector.Capacity(), 4);
+    for (int i = 0; i < 4; ++i)
+    {
+        test_vector.PushBack(i);
+    }
+    EXPECT_TRUE(test_vector.Full());
+    EXPECT_THROW(test_vector.PushBack(4), std::length_error);
+    EXPECT_THROW(test_vector.Insert(test_vector.begin(), 4), std::length_error);
+    EXPECT_EQ(test_vector.TryEmplaceBack(4), nullptr);
+    EXPECT_EQ(Elements(test_vector), (std::vector<int>{0, 1, 2, 3}));
+
+    test_vector.PopBack();
+    ASSERT_NE(test_vector.TryEmplaceBack(7), nullptr);
+    EXPECT_EQ(test_vector[3], 7);
+}
+
+TEST_F(ICBStaticVectorIntTestFixture, ReserveAndResizeCheckCapacity)
+{
+    EXPECT_NO_THROW(test_vector.Reserve(4));
+    EXPECT_THROW(test_vector.Reserve(5), std::length_error);
+
+    test_vector.Resize(3, 9);
+    EXPECT_EQ(Elements(test_vector), (std::vector<int>{9, 9, 9}));
+    test_vector.Resize(1);
+    EXPECT_EQ(Elements(test_vector), (std::vector<int>{9}));
+    EXPECT_THROW(test_vector.Resize(5), std::length_error);
+    EXPECT_THROW(test_vector.At(1), std::out_of_range);
+}
+
+TEST_F(ICBStaticVectorIntTestFixture, InsertAndEraseRanges)
+{
+    test_vector = {1, 4};
+    const std::vector<int> middle = {2, 3};
+    auto inserted = test_vector.Insert(test_vector.begin() + 1, middle.begin(), middle.end());
+    EXPECT_EQ(*inserted, 2);
+    EXPECT_EQ(Elements(test_vector), (std::vector<int>{1, 2, 3, 4}));
+
+    auto next = test_vector.Erase(test_vector.begin(), test_vector.begin() + 2);
+    EXPECT_EQ(*next, 3);
+    EXPECT_EQ(Elements(test_vector), (std::vector<int>{3, 4}));
+
+    // a forward range is measured before anything moves
+    const std::vector<int> tooMany(test_vector.Capacity(), 0);
+    EXPECT_THROW(test_vector.Insert(test_vector.begin(), tooMany.begin(), tooMany.end()), std::length_error);
+    EXPECT_EQ(Elements(test_vector), (std::vector<int>{3, 4}));
+
+    std::sort(test_vector.begin(), test_vector.end(), std::greater<>());
+    EXPECT_EQ(Elements(test_vector), (std::vector<int>{4, 3}));
+}
+
+TEST_F(ICBStaticVectorStringTestFixture, ConstructsElementsOnlyWhenAdded)
+{
+    test_vector.EmplaceBack(30, 'a');
+    test_vector.PushBack("b");
+    test_vector.Emplace(test_vector.begin(), "front");
+    EXPECT_EQ(Elements(test_vector), (std::vector<std::string>{"front", std::string(30, 'a'), "b"}));
+
+    // the argument refers to an element that moves to make room
+    test_vector.Insert(test_vector.begin(), test_vector[2]);
+    EXPECT_EQ(Elements(test_vector), (std::vector<std::string>{"b", "front", std::string(30, 'a'), "b"}));
+    EXPECT_THROW(test_vector.EmplaceBack("full"), std::length_error);
+
+    test_vector.Erase(test_vector.begin() + 1);
+    EXPECT_EQ(Elements(test_vector), (std::vector<std::string>{"b", std::string(30, 'a'), "b"}));
+}
+
+TEST_F(ICBStaticVectorStringTestFixture, CopyAndMove)
+{
+    test_vector = {"one", "two", std::string(40, 'x')};
+
+    icb::StaticVector<std::string, 4> copy(test_vector);
+    EXPECT_EQ(Elements(copy), Elements(test_vector));
+
+    icb::StaticVector<std::string, 4> moved(std::move(copy));
+    EXPECT_EQ(Elements(moved), Elements(test_vector));
+
+    icb::StaticVector<std::string, 4> shorter = {"a"};
+    shorter = test_vector;
+    EXPECT_EQ(Elements(shorter), Elements(test_vector));
+
+    icb::StaticVector<std::string, 4> longer = {"a", "b", "c", "d"};
+    longer = std::move(moved);
+    EXPECT_EQ(Elements(longer), Elements(test_vector));
+}
@@ -0,0 +1,189 @@
+#include "icb/string_hash_table.h"
+
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <string_view>
+
+#include "common_test_setup.h"
+
+class ICBStringHashTableTestFixture : public ICBTestFixture
+{
+  protected:
+    icb::StringHashTable<int> table;
+};
+
+TEST_F(ICBStringHashTableTestFixture, EmptyTable)
+{
+    EXPECT_TRUE(table.Empty());
+    EXPECT_EQ(table.Size(), 0);
+    EXPECT_EQ(table.Find("apple"), std::nullopt);
+    EXPECT_EQ(table.begin(), table.end());
+    table.Erase("apple");
+}
+
+TEST_F(ICBStringHashTableTestFixture, InsertAndFind)
+{
+    table.Insert("apple", 5);
+    table.Insert(std::string("banana"), 10);
+    table.Insert(std::string_view("cherry"), 15);
+    table.Insert("", 20);
+    table.Insert("apple", 50);
+
+    EXPECT_EQ(table.Size(), 4);
+    EXPECT_EQ(table.Find("apple"), 5);
+    EXPECT_EQ(table.Find("banana"), 10);
+    EXPECT_EQ(*table.FindPtr("cherry"), 15);
+    EXPECT_EQ(table.Find(""), 20);
+    EXPECT_EQ(table.Find("appl"), std::nullopt);
+    EXPECT_FALSE(table.Contains("apples"));
+
+    // the arena holds each key once
+    EXPECT_EQ(table.ArenaSize(), 5 + 6 + 6);
+}
+
+TEST_F(ICBStringHashTableTestFixture, TryEmplaceAndAssign)
+{
+    auto [value, inserted] = table.TryEmplace("apple", 1);
+    EXPECT_TRUE(inserted);
+    EXPECT_EQ(*value, 1);
+
+    std::tie(value, inserted) = table.TryEmplace("apple", 2);
+    EXPECT_FALSE(inserted);
+    EXPECT_EQ(*value, 1);
+
+    EXPECT_FALSE(table.InsertOrAssign("apple", 3).second);
+    EXPECT_EQ(table.Find("apple"), 3);
+
+    table["banana"] += 7;
+    EXPECT_EQ(table.Find("banana"), 7);
+}
+
+TEST_F(ICBStringHashTableTestFixture, ManyKeysMatchStdMap)
+{
+    std::map<std::string, int> reference;
+    std::mt19937 random(1);
+
+    for (int i = 0; i < 20000; ++i)
+    {
+        std::string key = "key:" + std::to_string(random() % 5000);
+        if (random() % 3 == 0)
+        {
+            table.Erase(key);
+            reference.erase(key);
+        }
+        else
+        {
+            table.InsertOrAssign(key, i);
+            reference[key] = i;
+        }
+    }
+
+    ASSERT_EQ(table.Size(), reference.size());
+    for (const auto &[key, value] : reference)
+    {
+        ASSERT_EQ(table.Find(key), value);
+    }
+
+    size_t visited = 0;
+    for (auto [key, value] : table)
+    {
+        ASSERT_EQ(reference.at(std::string(key)), value);
+        ++visited;
+    }
+    EXPECT_EQ(visited, reference.size());
+}
+
+TEST_F(ICBStringHashTableTestFixture, EraseCompactsArena)
+{
+    std::string padding(100, 'x');
+    for (int i = 0; i < 1000; ++i)
+    {
+        table.Insert(padding + std::to_string(i), i);
+    }
+    for (int i = 0; i < 900; ++i)
+    {
+        table.Erase(padding + std::to_string(i));
+    }
+
+    EXPECT_EQ(table.Size(), 100);
+    EXPECT_LT(table.ArenaSize(), 2 * 100 * (padding.size() + 3));
+    for (int i = 900; i < 1000; ++i)
+    {
+        ASSERT_EQ(table.Find(padding + std::to_string(i)), i);
+    }
+}
+
+TEST_F(ICBStringHashTableTestFixture, KeysFromItsOwnArena)
+{
+    const std::string longKey(200, 'a');
+    table.Insert(longKey, 0);
+
+    // every new key points into the arena that inserting it may grow
+    for (int i = 1; i < 200; ++i)
+    {
+        std::string_view key = (*table.begin()).first;
+        table.Insert(key.substr(static_cast<size_t>(i)), i);
+    }
+
+    EXPECT_EQ(table.Size(), 200);
+    for (int i = 0; i < 200; ++i)
+    {
+        ASSERT_EQ(table.Find(std::string_view(longKey).substr(static_cast<size_t>(i))), i);
+    }
+}
+
+TEST_F(ICBStringHashTableTestFixture, ClearAndRehash)
+{
+    for (int i = 0; i < 100; ++i)
+    {
+        table.Insert(std::to_string(i), i);
+    }
+    table.Rehash(1024);
+    EXPECT_EQ(table.BucketCount(), 1024);
+    EXPECT_EQ(table.Find("42"), 42);
+
+    table.Clear();
+    EXPECT_TRUE(table.Empty());
+    EXPECT_EQ(table.ArenaSize(), 0);
+    EXPECT_FALSE(table.Contains("42"));
+
+    table.Insert("42", 1);
+    EXPECT_EQ(table.Find("42"), 1);
+}
+
+TEST_F(ICBStringHashTableTestFixture, CopyAndMove)
+{
+    table.Insert("apple", 5);
+    table.Insert("banana", 10);
+    table.Erase("apple");
+
+    icb::StringHashTable<int> copy(table);
+    EXPECT_EQ(copy.Size(), 1);
+    EXPECT_EQ(copy.Find("banana"), 10);
+    EXPECT_EQ(copy.ArenaSize(), 6);
+
+    icb::StringHashTable<int> moved(std::move(copy));
+    EXPECT_EQ(moved.Find("banana"), 10);
+
+    // a moved-from table can be used again
+    copy.Insert("cherry", 15);
+    EXPECT_EQ(copy.Find("cherry"), 15);
+
+    table = moved;
+    EXPECT_EQ(table.Find("banana"), 10);
+}
+
+TEST_F(ICBStringHashTableTestFixture, MoveOnlyValues)
+{
+    icb::StringHashTable<std::unique_ptr<int>> owners;
+    for (int i = 0; i < 100; ++i)
+    {
+        owners.Insert(std::to_string(i), std::make_unique<int>(i));
+    }
+    owners.Erase("3");
+
+    EXPECT_EQ(**owners.FindPtr("99"), 99);
+    EXPECT_EQ(owners.FindPtr("3"), nullptr);
+}
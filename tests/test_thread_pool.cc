@@ -0,0 +1,61 @@
+#include "icb/thread_pool.h"
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+#include "common_test_setup.h"
+
+class ICBThreadPoolTestFixture : public ICBTestFixture
+{
+  protected:
+    icb::ThreadPool pool{4};
+};
+
+TEST_F(ICBThreadPoolTestFixture, RunsEveryTaskOnce)
+{
+    EXPECT_EQ(pool.ThreadCount(), 4);
+
+    for (size_t tasks : {size_t(0), size_t(1), size_t(3), size_t(1000)})
+    {
+        std::vector<std::atomic<int>> runs(tasks);
+        pool.Run(tasks, [&](size_t task) { runs[task].fetch_add(1); });
+
+        for (const std::atomic<int> &count : runs)
+        {
+            ASSERT_EQ(count.load(), 1);
+        }
+    }
+}
+
+TEST_F(ICBThreadPoolTestFixture, RethrowsAfterAllTasks)
+{
+    std::atomic<int> finished = 0;
+    auto run = [&] {
+        pool.Run(100, [&](size_t task) {
+            if (task % 10 == 3)
+            {
+                throw std::runtime_error("task");
+            }
+            ++finished;
+        });
+    };
+
+    EXPECT_THROW(run(), std::runtime_error);
+    EXPECT_EQ(finished.load(), 90);
+
+    // still usable afterwards
+    finished = 0;
+    pool.Run(10, [&](size_t) { ++finished; });
+    EXPECT_EQ(finished.load(), 10);
+}
+
+TEST_F(ICBThreadPoolTestFixture, SingleThread)
+{
+    icb::ThreadPool single(1);
+    EXPECT_EQ(single.ThreadCount(), 1);
+
+    int sum = 0; // no other thread touches it
+    single.Run(5, [&](size_t task) { sum += static_cast<int>(task); });
+    EXPECT_EQ(sum, 10);
+}
@@ -0,0 +1,379 @@
+#include "icb/unrolled_list.h"
+
+#include <algorithm>
+#include <iterator>
+#include <list>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "common_test_setup.h"
+
+class ICBUnrolledListIntFixture : public ICBTestFixture
+{
+  protected:
+    icb::UnrolledList<int> list;
+};
+
+class ICBUnrolledListStringFixture : public ICBTestFixture
+{
+  protected:
+    icb::UnrolledList<std::string> list;
+};
+
+template <typename T> static std::vector<T> Elements(const icb::UnrolledList<T> &list)
+{
+    return std::vector<T>(list.begin(), list.end());
+}
+
+TEST_F(ICBUnrolledListIntFixture, Empty)
+{
+    EXPECT_TRUE(list.Empty());
+    EXPECT_EQ(list.Size(), 0);
+    EXPECT_EQ(list.NodeCount(), 0);
+    EXPECT_EQ(list.begin(), list.end());
+}
+
+TEST_F(ICBUnrolledListIntFixture, PushKeepsNodesFull)
+{
+    const int count = static_cast<int>(icb::UnrolledList<int>::NODE_CAPACITY) * 3;
+    for (int i = 0; i < count; ++i)
+    {
+        list.PushBack(i);
+    }
+    EXPECT_EQ(list.NodeCount(), 3);
+
+    for (int i = 1; i <= count; ++i)
+    {
+        list.PushFront(-i);
+    }
+    EXPECT_EQ(list.NodeCount(), 6);
+    EXPECT_EQ(list.Size(), static_cast<size_t>(2 * count));
+    EXPECT_EQ(list.Front(), -count);
+    EXPECT_EQ(list.Back(), count - 1);
+
+    int expected = -count;
+    for (int value : list)
+    {
+        ASSERT_EQ(value, expected++);
+    }
+}
+
+TEST_F(ICBUnrolledListIntFixture, BidirectionalIteration)
+{
+    list = {1, 2, 3, 4, 5};
+
+    std::vector<int> reversed;
+    for (auto it = list.end(); it != list.begin();)
+    {
+        reversed.push_back(*--it);
+    }
+    EXPECT_EQ(reversed, (std::vector<int>{5, 4, 3, 2, 1}));
+    static_assert(std::bidirectional_iterator<icb::UnrolledList<int>::Iterator>);
+    static_assert(std::bidirectional_iterator<icb::UnrolledList<int>::ConstIterator>);
+}
+
+TEST_F(ICBUnrolledListIntFixture, InsertSplitsFullNode)
+{
+    const int capacity = static_cast<int>(icb::UnrolledList<int>::NODE_CAPACITY);
+    for (int i = 0; i < capacity; ++i)
+    {
+        list.PushBack(i * 2);
+    }
+    EXPECT_EQ(list.NodeCount(), 1);
+
+    auto it = list.Insert(std::next(list.begin(), capacity - 1), -1);
+    EXPECT_EQ(*it, -1);
+    EXPECT_EQ(list.NodeCount(), 2);
+    EXPECT_EQ(*std::next(it), (capacity - 1) * 2);
+    EXPECT_EQ(*std::prev(it), (capacity - 2) * 2);
+}
+
+TEST_F(ICBUnrolledListIntFixture, EraseMergesNodes)
+{
+    const int count = static_cast<int>(icb::UnrolledList<int>::NODE_CAPACITY) * 4;
+    for (int i = 0; i < count; ++i)
+    {
+        list.PushBack(i);
+    }
+
+    // erase every element but multiples of 8, walking with the returned iterators
+    for (auto it = list.begin(); it != list.end();)
+    {
+        it = *it % 8 ? list.Erase(it) : std::next(it);
+    }
+
+    EXPECT_EQ(list.Size(), static_cast<size_t>(count / 8));
+    EXPECT_LT(list.NodeCount(), 4);
+    int expected = 0;
+    for (int value : list)
+    {
+        ASSERT_EQ(value, expected);
+        expected += 8;
+    }
+
+    while (!list.Empty())
+    {
+        list.PopBack();
+    }
+    EXPECT_EQ(list.NodeCount(), 0);
+}
+
+TEST_F(ICBUnrolledListIntFixture, MatchesStdList)
+{
+    std::list<int> model;
+    uint32_t state = 99;
+
+    for (int i = 0; i < 20000; ++i)
+    {
+        state = state * 1664525u + 1013904223u;
+        const size_t position = model.empty() ? 0 : (state >> 8) % (model.size() + 1);
+        auto modelIt = std::next(model.begin(), static_cast<std::ptrdiff_t>(position));
+        auto it = std::next(list.begin(), static_cast<std::ptrdiff_t>(position));
+
+        if ((state >> 4) % 5 < 3 || model.empty())
+        {
+            EXPECT_EQ(*list.Insert(it, i), i);
+            model.insert(modelIt, i);
+        }
+        else if (modelIt != model.end())
+        {
+            auto next = list.Erase(it);
+            auto modelNext = model.erase(modelIt);
+            ASSERT_EQ(next == list.end(), modelNext == model.end());
+            if (next != list.end())
+            {
+                ASSERT_EQ(*next, *modelNext);
+            }
+        }
+    }
+
+    EXPECT_EQ(Elements(list), std::vector<int>(model.begin(), model.end()));
+    EXPECT_EQ(list.Size(), model.size());
+}
+
+TEST_F(ICBUnrolledListIntFixture, SpliceElement)
+{
+    list = {1, 2, 3, 4, 5};
+    icb::UnrolledList<int> other = {10, 20, 30};
+
+    list.Splice(std::next(list.begin()), other, std::next(other.begin()));
+    EXPECT_EQ(Elements(list), (std::vector<int>{1, 20, 2, 3, 4, 5}));
+    EXPECT_EQ(Elements(other), (std::vector<int>{10, 30}));
+
+    // within the list, both directions
+    list.Splice(list.begin(), list, std::prev(list.end()));
+    EXPECT_EQ(Elements(list), (std::vector<int>{5, 1, 20, 2, 3, 4}));
+    list.Splice(list.end(), list, list.begin());
+    EXPECT_EQ(Elements(list), (std::vector<int>{1, 20, 2, 3, 4, 5}));
+    list.Splice(std::next(list.begin(), 4), list, std::next(list.begin()));
+    EXPECT_EQ(Elements(list), (std::vector<int>{1, 2, 3, 20, 4, 5}));
+
+    list.Splice(list.end(), other, other.begin());
+    list.Splice(list.end(), other, other.begin());
+    EXPECT_TRUE(other.Empty());
+    EXPECT_EQ(other.NodeCount(), 0);
+    EXPECT_EQ(list.Size(), 8);
+}
+
+// move construction throws while armed, after movesBeforeThrow more moves
+struct ThrowingMove
+{
+    static inline bool armed = false;
+    static inline int movesBeforeThrow = 0;
+    std::string value;
+
+    ThrowingMove(std::string value) : value(std::move(value))
+    {
+    }
+
+    ThrowingMove(const ThrowingMove &) = default;
+    ThrowingMove &operator=(const ThrowingMove &) = default;
+    ThrowingMove &operator=(ThrowingMove &&) = default;
+
+    ThrowingMove(ThrowingMove &&other) : value(other.value)
+    {
+        if (armed && movesBeforeThrow-- == 0)
+        {
+            throw std::runtime_error("move");
+        }
+        other.value.clear();
+    }
+};
+
+// the elements walked forwards, checked against the size and a walk backwards
+static std::vector<std::string> LinkedValues(const icb::UnrolledList<ThrowingMove> &list)
+{
+    std::vector<std::string> forwards;
+    for (const ThrowingMove &element : list)
+    {
+        forwards.push_back(element.value);
+    }
+    std::vector<std::string> backwards;
+    for (auto it = list.end(); it != list.begin();)
+    {
+        backwards.push_back((--it)->value);
+    }
+    std::reverse(backwards.begin(), backwards.end());
+    EXPECT_EQ(forwards, backwards);
+    EXPECT_EQ(forwards.size(), list.Size());
+    EXPECT_EQ(forwards.empty(), list.Empty());
+    return forwards;
+}
+
+// splices with every move construction in turn throwing, the lists have to stay valid whether or not it did
+template <typename Setup, typename SpliceFn, typename Check>
+static void SpliceAtEveryMove(Setup &&setup, SpliceFn &&splice, Check &&check)
+{
+    for (int movesBeforeThrow = 0; movesBeforeThrow < 4; ++movesBeforeThrow)
+    {
+        auto lists = setup();
+        bool threw = false;
+        ThrowingMove::armed = true;
+        ThrowingMove::movesBeforeThrow = movesBeforeThrow;
+        try
+        {
+            splice(lists);
+        }
+        catch (const std::runtime_error &)
+        {
+            threw = true;
+        }
+        ThrowingMove::armed = false;
+        check(lists, threw);
+    }
+}
+
+TEST_F(ICBUnrolledListIntFixture, SpliceElementThrowingMove)
+{
+    const std::string longValue(40, 'x');
+    using List = icb::UnrolledList<ThrowingMove>;
+
+    // between lists, nothing is lost
+    SpliceAtEveryMove(
+        [&] {
+            std::pair<List, List> lists;
+            lists.first.EmplaceBack(longValue);
+            lists.second.EmplaceBack("b");
+            return lists;
+        },
+        [](auto &lists) { lists.second.Splice(lists.second.begin(), lists.first, lists.first.begin()); },
+        [&](auto &lists, bool threw) {
+            EXPECT_EQ(LinkedValues(lists.first),
+                      threw ? std::vector<std::string>{longValue} : std::vector<std::string>{});
+            EXPECT_EQ(LinkedValues(lists.second),
+                      threw ? std::vector<std::string>{"b"} : (std::vector<std::string>{longValue, "b"}));
+        });
+
+    // within a list, an element alone in its node isn't lost either
+    std::vector<std::string> values;
+    for (size_t i = 0; i <= List::NODE_CAPACITY; ++i)
+    {
+        values.push_back(std::to_string(i) + longValue);
+    }
+    auto fill = [&] {
+        std::pair<List, List> lists;
+        for (const std::string &value : values)
+        {
+            lists.first.EmplaceBack(value);
+        }
+        return lists;
+    };
+    SpliceAtEveryMove(
+        fill, [](auto &lists) { lists.first.Splice(lists.first.begin(), lists.first, std::prev(lists.first.end())); },
+        [&](auto &lists, bool threw) {
+            std::vector<std::string> expected = values;
+            if (!threw)
+            {
+                std::rotate(expected.begin(), expected.end() - 1, expected.end());
+            }
+            EXPECT_EQ(LinkedValues(lists.first), expected);
+        });
+
+    // within a list, from a node with other elements, the list stays valid without it
+    SpliceAtEveryMove(
+        fill, [](auto &lists) { lists.first.Splice(lists.first.end(), lists.first, std::next(lists.first.begin())); },
+        [&](auto &lists, bool threw) {
+            std::vector<std::string> expected = values;
+            if (!threw)
+            {
+                std::rotate(expected.begin() + 1, expected.begin() + 2, expected.end());
+            }
+            std::vector<std::string> actual = LinkedValues(lists.first);
+            if (threw && actual.size() < expected.size())
+            {
+                expected.erase(expected.begin() + 1);
+            }
+            EXPECT_EQ(actual, expected);
+        });
+}
+
+TEST_F(ICBUnrolledListIntFixture, SpliceList)
+{
+    const int capacity = static_cast<int>(icb::UnrolledList<int>::NODE_CAPACITY);
+    for (int i = 0; i < capacity; ++i)
+    {
+        list.PushBack(i);
+    }
+
+    icb::UnrolledList<int> other = {-1, -2};
+    list.Splice(std::next(list.begin(), 3), other);
+    EXPECT_TRUE(other.Empty());
+    EXPECT_EQ(list.Size(), static_cast<size_t>(capacity + 2));
+    EXPECT_EQ(list.NodeCount(), 3);
+
+    std::vector<int> expected;
+    for (int i = 0; i < capacity; ++i)
+    {
+        if (i == 3)
+        {
+            expected.insert(expected.end(), {-1, -2});
+        }
+        expected.push_back(i);
+    }
+    EXPECT_EQ(Elements(list), expected);
+
+    other = {7};
+    list.Splice(list.end(), other);
+    list.Splice(list.begin(), other);
+    EXPECT_EQ(list.Back(), 7);
+}
+
+TEST_F(ICBUnrolledListStringFixture, CopyMoveAndStrings)
+{
+    for (int i = 0; i < 100; ++i)
+    {
+        list.PushBack(std::string(20, static_cast<char>('a' + i % 26)));
+    }
+    list.Insert(std::next(list.begin(), 50), "middle");
+
+    icb::UnrolledList<std::string> copy = list;
+    EXPECT_EQ(Elements(copy), Elements(list));
+
+    icb::UnrolledList<std::string> moved = std::move(copy);
+    EXPECT_TRUE(copy.Empty());
+    EXPECT_EQ(*std::next(moved.begin(), 50), "middle");
+
+    // inserting an element of the list itself, which is about to move
+    moved.Insert(moved.begin(), *std::next(moved.begin(), 1));
+    EXPECT_EQ(moved.Front(), std::string(20, 'b'));
+
+    copy = moved;
+    moved.Clear();
+    EXPECT_EQ(copy.Size(), 102);
+}
+
+TEST_F(ICBUnrolledListIntFixture, MoveOnly)
+{
+    icb::UnrolledList<std::unique_ptr<int>> owned;
+    for (int i = 0; i < 200; ++i)
+    {
+        owned.EmplaceBack(std::make_unique<int>(i));
+    }
+    owned.Insert(std::next(owned.begin(), 10), std::make_unique<int>(-1));
+    owned.Erase(owned.begin());
+
+    EXPECT_EQ(**owned.begin(), 1);
+    EXPECT_EQ(**std::next(owned.begin(), 9), -1);
+}
@@ -1,5 +1,9 @@
 #include "icb/vector.h"
 
+#include <memory>
+#include <string>
+#include <vector>
+
 #include "common_test_setup.h"
 
 // Fixture for general icb::Vector<int> tests
@@ -78,4 +82,244 @@ TEST_F(ICBTestFixture, RandomAccessIteratorConcept)
 
     static_assert(std::is_copy_constructible_v<icb::Vector<int>::ConstIterator>);
     static_assert(std::is_trivially_copy_constructible_v<icb::Vector<int>::ConstIterator>);
-}
\ No newline at end of file
+}
+
+// std::string isn't trivially copyable, so it takes the element-by-element paths
+class ICBVectorStringTestFixture : public ICBTestFixture
+{
+  protected:
+    icb::Vector<std::string> test_vector;
+};
+
+// owns a heap object, not trivially copyable, but fine to move by its bytes
+struct Boxed
+{
+    std::unique_ptr<int> value;
+
+    Boxed(int value) : value(std::make_unique<int>(value))
+    {
+    }
+};
+
+template <> struct icb::IsTriviallyRelocatable<Boxed> : std::true_type
+{
+};
+
+template <typename T, typename Allocator> static std::vector<T> Elements(const icb::Vector<T, Allocator> &vector)
+{
+    return std::vector<T>(vector.begin(), vector.end());
+}
+
+TEST_F(ICBVectorIntTestFixture, EmplaceBackReturnsNewElement)
+{
+    for (int i = 0; i < 100; ++i)
+    {
+        int &added = test_vector.EmplaceBack(i);
+        ASSERT_EQ(&added, &test_vector[i]);
+        ASSERT_EQ(added, i);
+    }
+}
+
+TEST_F(ICBVectorIntTestFixture, Growth)
+{
+    for (int i = 0; i < 10000; ++i)
+    {
+        test_vector.PushBack(i);
+    }
+    EXPECT_EQ(test_vector.Size(), 10000);
+    EXPECT_GE(test_vector.Capacity(), 10000);
+    for (int i = 0; i < 10000; ++i)
+    {
+        ASSERT_EQ(test_vector[i], i);
+    }
+}
+
+TEST_F(ICBVectorStringTestFixture, PushBackOwnElement)
+{
+    test_vector.PushBack(std::string(100, 'a'));
+    for (int i = 0; i < 20; ++i)
+    {
+        // reallocates while the argument still lives in the old buffer
+        test_vector.PushBack(test_vector[0]);
+        test_vector.EmplaceBack(test_vector[test_vector.Size() - 1]);
+    }
+    EXPECT_EQ(test_vector.Size(), 41);
+    for (const std::string &value : test_vector)
+    {
+        ASSERT_EQ(value, std::string(100, 'a'));
+    }
+}
+
+TEST_F(ICBVectorStringTestFixture, CopyConstructorAndAssignment)
+{
+    for (int i = 0; i < 10; ++i)
+    {
+        test_vector.PushBack(std::to_string(i) + std::string(20, 'x'));
+    }
+
+    icb::Vector<std::string> copy(test_vector);
+    EXPECT_EQ(Elements(copy), Elements(test_vector));
+    copy[0] = "changed";
+    EXPECT_NE(test_vector[0], "changed");
+
+    // into a vector that is big enough, and one that has to grow
+    icb::Vector<std::string> small = {"a"};
+    icb::Vector<std::string> large = {"a", "b", "c", "d", "e", "f", "g", "h", "i", "j", "k", "l"};
+    small = test_vector;
+    large = test_vector;
+    EXPECT_EQ(Elements(small), Elements(test_vector));
+    EXPECT_EQ(Elements(large), Elements(test_vector));
+    EXPECT_EQ(large.Size(), 10);
+
+    large = large;
+    EXPECT_EQ(Elements(large), Elements(test_vector));
+}
+
+TEST_F(ICBVectorIntTestFixture, CopyConstructorAndAssignment)
+{
+    test_vector = {1, 2, 3, 4, 5};
+    icb::Vector<int> copy = test_vector;
+    EXPECT_EQ(Elements(copy), (std::vector<int>{1, 2, 3, 4, 5}));
+
+    icb::Vector<int> other = {9};
+    other = copy;
+    EXPECT_EQ(Elements(other), (std::vector<int>{1, 2, 3, 4, 5}));
+
+    icb::Vector<int> empty;
+    other = empty;
+    EXPECT_EQ(other.Size(), 0);
+}
+
+TEST_F(ICBVectorIntTestFixture, Insert)
+{
+    test_vector = {1, 5};
+    auto it = test_vector.Insert(test_vector.begin() + 1, 2);
+    EXPECT_EQ(*it, 2);
+    test_vector.Insert(test_vector.end(), 6);
+    test_vector.Insert(test_vector.begin(), 0);
+    std::vector<int> middle = {3, 4};
+    it = test_vector.Insert(test_vector.begin() + 3, middle.begin(), middle.end());
+    EXPECT_EQ(*it, 3);
+    EXPECT_EQ(Elements(test_vector), (std::vector<int>{0, 1, 2, 3, 4, 5, 6}));
+
+    // an element of the vector itself
+    test_vector.Insert(test_vector.begin(), test_vector[6]);
+    EXPECT_EQ(Elements(test_vector), (std::vector<int>{6, 0, 1, 2, 3, 4, 5, 6}));
+}
+
+TEST_F(ICBVectorStringTestFixture, Insert)
+{
+    test_vector = {"b", "e"};
+    test_vector.Insert(test_vector.begin(), "a");
+    test_vector.Emplace(test_vector.begin() + 2, 1, 'c');
+    std::vector<std::string> tail = {"f", "g"};
+    test_vector.Insert(test_vector.end(), tail.begin(), tail.end());
+    std::vector<std::string> middle = {"d"};
+    test_vector.Insert(test_vector.begin() + 3, middle.begin(), middle.end());
+    EXPECT_EQ(Elements(test_vector), (std::vector<std::string>{"a", "b", "c", "d", "e", "f", "g"}));
+
+    test_vector.Insert(test_vector.begin() + 1, test_vector[6]);
+    EXPECT_EQ(test_vector[1], "g");
+    EXPECT_EQ(test_vector.Size(), 8);
+}
+
+TEST_F(ICBVectorIntTestFixture, Erase)
+{
+    test_vector = {0, 1, 2, 3, 4, 5, 6};
+    auto it = test_vector.Erase(test_vector.begin() + 1);
+    EXPECT_EQ(*it, 2);
+    it = test_vector.Erase(test_vector.begin() + 2, test_vector.begin() + 4);
+    EXPECT_EQ(*it, 5);
+    EXPECT_EQ(Elements(test_vector), (std::vector<int>{0, 2, 5, 6}));
+
+    it = test_vector.Erase(test_vector.end() - 1);
+    EXPECT_EQ(it, test_vector.end());
+    test_vector.Erase(test_vector.begin(), test_vector.begin());
+    EXPECT_EQ(Elements(test_vector), (std::vector<int>{0, 2, 5}));
+}
+
+TEST_F(ICBVectorStringTestFixture, Erase)
+{
+    test_vector = {"a", "b", "c", "d", "e"};
+    test_vector.Erase(test_vector.begin());
+    test_vector.Erase(test_vector.begin() + 1, test_vector.begin() + 3);
+    EXPECT_EQ(Elements(test_vector), (std::vector<std::string>{"b", "e"}));
+}
+
+TEST_F(ICBTestFixture, VectorRelocatesSpecializedTypes)
+{
+    static_assert(icb::isTriviallyRelocatable<int>);
+    static_assert(!icb::isTriviallyRelocatable<std::string>);
+    static_assert(icb::isTriviallyRelocatable<Boxed>);
+
+    icb::Vector<Boxed> vector;
+    for (int i = 0; i < 100; ++i)
+    {
+        vector.EmplaceBack(i);
+    }
+    vector.Emplace(vector.begin(), -1);
+    vector.Erase(vector.begin() + 10, vector.begin() + 20);
+
+    EXPECT_EQ(vector.Size(), 91);
+    EXPECT_EQ(*vector[0].value, -1);
+    EXPECT_EQ(*vector[10].value, 19);
+    EXPECT_EQ(*vector[90].value, 99);
+}
+
+TEST_F(ICBVectorIntTestFixture, ResizeWithValue)
+{
+    test_vector = {7};
+    test_vector.Resize(100, test_vector[0]);
+    EXPECT_EQ(test_vector.Size(), 100);
+    EXPECT_EQ(test_vector[99], 7);
+
+    test_vector.Resize(2, 0);
+    EXPECT_EQ(Elements(test_vector), (std::vector<int>{7, 7}));
+}
+
+TEST_F(ICBTestFixture, VectorAllocatesFromResource)
+{
+    CountingResource resource;
+    {
+        icb::pmr::Vector<std::string> vector(&resource);
+        for (int i = 0; i < 100; ++i)
+        {
+            vector.PushBack(std::to_string(i) + std::string(20, 'x'));
+        }
+        vector.Insert(vector.begin(), "first");
+        EXPECT_GT(resource.allocations, 0);
+        EXPECT_GT(resource.bytesInUse, 0);
+
+        // a copy goes to the default resource, a move takes the buffer and the resource along
+        icb::pmr::Vector<std::string> copy(vector);
+        EXPECT_EQ(copy.GetAllocator().resource(), std::pmr::get_default_resource());
+        icb::pmr::Vector<std::string> moved(std::move(copy));
+        EXPECT_EQ(moved.GetAllocator().resource(), std::pmr::get_default_resource());
+        EXPECT_EQ(Elements(moved), Elements(vector));
+    }
+    EXPECT_EQ(resource.bytesInUse, 0);
+}
+
+TEST_F(ICBTestFixture, VectorAssignmentKeepsAllocator)
+{
+    CountingResource first, second;
+    icb::pmr::Vector<std::string> a({"a", "b"}, &first);
+    icb::pmr::Vector<std::string> b({"c", "d", "e", "f", "g"}, &second);
+
+    a = b;
+    EXPECT_EQ(a.GetAllocator().resource(), &first);
+    EXPECT_EQ(Elements(a), Elements(b));
+
+    // different resources, so the elements move over one by one
+    const size_t secondInUse = second.bytesInUse;
+    a = std::move(b);
+    EXPECT_EQ(a.GetAllocator().resource(), &first);
+    EXPECT_EQ(Elements(a), (std::vector<std::string>{"c", "d", "e", "f", "g"}));
+    EXPECT_EQ(b.Size(), 0);
+    EXPECT_EQ(second.bytesInUse, secondInUse);
+
+    icb::pmr::Vector<std::string> c(&first);
+    c = std::move(a);
+    EXPECT_EQ(Elements(c).size(), 5);
+    EXPECT_EQ(a.Capacity(), 0);
+}